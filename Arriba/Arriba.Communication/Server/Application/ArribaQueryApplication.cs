@@ -503,6 +503,10 @@ namespace Arriba.Server
             string take = p["t"];
             if (!String.IsNullOrEmpty(take)) query.Count = UInt16.Parse(take);
 
+            // Approximate [approx=true] estimates the distinct count and top values with sketches, for high cardinality columns
+            string approximate = p["approx"];
+            if (!String.IsNullOrEmpty(approximate)) query.Approximate = Boolean.Parse(approximate);
+
             return query;
         }
     }
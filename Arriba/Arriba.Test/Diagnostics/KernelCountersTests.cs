@@ -0,0 +1,82 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System.Threading.Tasks;
+
+using Arriba.Diagnostics;
+using Arriba.Structures;
+
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace Arriba.Test
+{
+    [TestClass]
+    public class KernelCountersTests
+    {
+        [TestMethod]
+        public void KernelCounters_Basics()
+        {
+            ShortSet left = new ShortSet(1000);
+            ShortSet right = new ShortSet(1000);
+            for (ushort i = 0; i < 1000; i += 3)
+            {
+                left.Add(i);
+            }
+
+            right.Not();
+
+            // Nothing is counted when counters are off
+            KernelCounterSnapshot before = KernelCounters.Read();
+            left.And(right);
+            Assert.AreEqual(334, left.Count());
+            Assert.AreEqual("", KernelCounters.Read().Subtract(before).ToString());
+
+            try
+            {
+                KernelCounters.IsEnabled = true;
+                KernelCounters.Reset();
+
+                left.And(right);
+                Assert.AreEqual(334, left.Count());
+                Assert.AreEqual(334, left.Values.Length);
+
+                KernelCounterSnapshot counters = KernelCounters.Read();
+                Assert.AreEqual(1, counters.Calls(Kernel.SetOperation));
+                Assert.AreEqual(1024, counters.Elements(Kernel.SetOperation));
+                Assert.AreEqual(2, counters.Calls(Kernel.Count));
+                Assert.AreEqual(668, counters.Matched(Kernel.Count));
+                Assert.AreEqual(1, counters.Calls(Kernel.Enumerate));
+                Assert.AreEqual(334, counters.Matched(Kernel.Enumerate));
+
+                // Reset starts over from zero
+                KernelCounters.Reset();
+                Assert.AreEqual(0, KernelCounters.Read().Calls(Kernel.Count));
+            }
+            finally
+            {
+                KernelCounters.IsEnabled = false;
+            }
+        }
+
+        [TestMethod]
+        public void KernelCounters_ConcurrentThreads()
+        {
+            KernelCounterSnapshot before = KernelCounters.Read();
+
+            // Threads sharing slots must not lose counts
+            Parallel.For(0, 64, (i) =>
+            {
+                for (int j = 0; j < 1000; ++j)
+                {
+                    KernelCounters.RecordElapsed(Kernel.Enumerate, 1, 2, 3, 4);
+                }
+            });
+
+            KernelCounterSnapshot counters = KernelCounters.Read().Subtract(before);
+            Assert.AreEqual(64000, counters.Calls(Kernel.Enumerate));
+            Assert.AreEqual(128000, counters.Elements(Kernel.Enumerate));
+            Assert.AreEqual(192000, counters.Bytes(Kernel.Enumerate));
+            Assert.AreEqual(256000, counters.Matched(Kernel.Enumerate));
+        }
+    }
+}
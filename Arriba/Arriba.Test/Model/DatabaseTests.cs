@@ -10,6 +10,7 @@ using System.Threading.Tasks;
 
 using Arriba.Model;
 using Arriba.Model.Correctors;
+using Arriba.Model.Expressions;
 using Arriba.Model.Query;
 using Arriba.Structures;
 
@@ -76,6 +77,98 @@ namespace Arriba.Test.Model
             //  Nested Join
         }
 
+        [TestMethod]
+        public void Database_JoinManyValues()
+        {
+            Database db = new Database();
+
+            // Join to many values relative to the rows, so partitions are scanned against a Bloom filter of the values
+            Table people = db.AddTable("People", 1000);
+            people.AddOrUpdate(new DataBlock(new string[] { "Alias", "Team", "Level" }, 500,
+                new Array[]
+                {
+                    Enumerable.Range(0, 500).Select((i) => "p" + i.ToString()).ToArray(),
+                    Enumerable.Range(0, 500).Select((i) => (i % 3 == 0 ? "T1" : "T2")).ToArray(),
+                    Enumerable.Range(0, 500).Select((i) => i).ToArray()
+                }), new AddOrUpdateOptions() { AddMissingColumns = true });
+
+            Table orders = db.AddTable("Orders", 1000);
+            orders.AddOrUpdate(new DataBlock(new string[] { "OrderNumber", "OrderedByAlias", "Level" }, 1000,
+                new Array[]
+                {
+                    Enumerable.Range(0, 1000).Select((i) => "O" + i.ToString()).ToArray(),
+                    Enumerable.Range(0, 1000).Select((i) => "p" + ((i * 7) % 1000).ToString()).ToArray(),
+                    Enumerable.Range(0, 1000).Select((i) => (i * 7) % 1000).ToArray()
+                }), new AddOrUpdateOptions() { AddMissingColumns = true });
+
+            int expected = Enumerable.Range(0, 1000).Count((i) => ((i * 7) % 1000) < 500 && ((i * 7) % 1000) % 3 == 0);
+
+            // Join on a string column
+            JoinQuery<SelectResult> q = new JoinQuery<SelectResult>(
+                db,
+                new SelectQuery() { Where = SelectQuery.ParseWhere("OrderedByAlias=#Q1[Alias]"), TableName = "Orders", Columns = new string[] { "OrderNumber" }, Count = ushort.MaxValue },
+                new SelectQuery() { Where = SelectQuery.ParseWhere("Team=T1"), TableName = "People" }
+            );
+
+            q.Correct(null);
+            Assert.AreEqual(expected, (int)db.Query(q).Total);
+
+            // Join on an integer column
+            q = new JoinQuery<SelectResult>(
+                db,
+                new SelectQuery() { Where = SelectQuery.ParseWhere("Level=#Q1[Level]"), TableName = "Orders", Columns = new string[] { "OrderNumber" }, Count = ushort.MaxValue },
+                new SelectQuery() { Where = SelectQuery.ParseWhere("Team=T1"), TableName = "People" }
+            );
+
+            q.Correct(null);
+            Assert.AreEqual(expected, (int)db.Query(q).Total);
+        }
+
+        [TestMethod]
+        public void Database_JoinManyValues_MultiplePartition()
+        {
+            Database db = new Database();
+
+            // Join from a two partition table, so the joined values are merged into an object[]
+            Table people = db.AddTable("People", 75000);
+            people.AddOrUpdate(new DataBlock(new string[] { "Alias", "Team", "Level" }, 500,
+                new Array[]
+                {
+                    Enumerable.Range(0, 500).Select((i) => "p" + i.ToString()).ToArray(),
+                    Enumerable.Range(0, 500).Select((i) => (i % 3 == 0 ? "T1" : "T2")).ToArray(),
+                    Enumerable.Range(0, 500).Select((i) => i).ToArray()
+                }), new AddOrUpdateOptions() { AddMissingColumns = true });
+            Assert.AreEqual(2, people.PartitionCount);
+
+            Table orders = db.AddTable("Orders", 1000);
+            orders.AddOrUpdate(new DataBlock(new string[] { "OrderNumber", "OrderedByAlias", "Level" }, 1000,
+                new Array[]
+                {
+                    Enumerable.Range(0, 1000).Select((i) => "O" + i.ToString()).ToArray(),
+                    Enumerable.Range(0, 1000).Select((i) => "p" + ((i * 7) % 1000).ToString()).ToArray(),
+                    Enumerable.Range(0, 1000).Select((i) => (i * 7) % 1000).ToArray()
+                }), new AddOrUpdateOptions() { AddMissingColumns = true });
+
+            int expected = Enumerable.Range(0, 1000).Count((i) => ((i * 7) % 1000) < 500 && ((i * 7) % 1000) % 3 == 0);
+
+            // Verify string and integer joins are correct and scan the Orders partition against the Bloom filter
+            foreach (string where in new string[] { "OrderedByAlias=#Q1[Alias]", "Level=#Q1[Level]" })
+            {
+                JoinQuery<SelectResult> q = new JoinQuery<SelectResult>(
+                    db,
+                    new SelectQuery() { Where = SelectQuery.ParseWhere(where), TableName = "Orders", Columns = new string[] { "OrderNumber" }, Count = ushort.MaxValue },
+                    new SelectQuery() { Where = SelectQuery.ParseWhere("Team=T1"), TableName = "People" }
+                );
+
+                q.Correct(null);
+                TermInExpression join = (TermInExpression)q.Where;
+                Assert.AreEqual(typeof(object[]), join.Values.GetType());
+
+                Assert.AreEqual(expected, (int)db.Query(q).Total);
+                Assert.AreEqual(1, join.FilteredPartitionCount);
+            }
+        }
+
         private string JoinResultColumn(SelectResult result, int columnIndex = 0)
         {
             StringBuilder values = new StringBuilder();
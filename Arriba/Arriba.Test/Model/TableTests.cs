@@ -394,6 +394,7 @@ namespace Arriba.Test.Model
             ITable_ComplexAndOr(factoryMethod);
             ITable_Distinct(factoryMethod);
             ITable_DistinctTop(factoryMethod);
+            ITable_DistinctTopApproximate(factoryMethod);
             ITable_Aggregate_Count(factoryMethod);
             ITable_Aggregate_Sum(factoryMethod);
             ITable_Aggregate_Min(factoryMethod);
@@ -657,6 +658,81 @@ namespace Arriba.Test.Model
             Assert.IsFalse(result.AllValuesReturned);
         }
 
+        public void ITable_DistinctTopApproximate(Func<ITable> factoryMethod)
+        {
+            // Define columns and add sample data
+            ITable table = factoryMethod();
+            AddSampleData(table);
+
+            // Get approximate Distinct Priority for all bugs; with few values, the sketches are exact
+            DistinctQueryTop query = new DistinctQueryTop("Priority", "", 5) { Approximate = true };
+            DistinctResult result = table.Query(query);
+
+            Assert.AreEqual("3", result.Values[0, 0].ToString());
+            Assert.AreEqual("3", result.Values[0, 1].ToString());
+            Assert.AreEqual(3, result.Values.RowCount);
+            Assert.AreEqual(5, result.Total);
+            Assert.AreEqual(3, result.DistinctCountEstimate);
+            Assert.IsFalse(result.AllValuesReturned);
+
+            // Verify the where clause and count limit apply
+            query.Where = QueryParser.Parse("Priority != 1");
+            query.Count = 1;
+            result = table.Query(query);
+
+            Assert.AreEqual("3", result.Values[0, 0].ToString());
+            Assert.AreEqual(1, result.Values.RowCount);
+            Assert.AreEqual(4, result.Total);
+            Assert.AreEqual(2, result.DistinctCountEstimate);
+            Assert.IsFalse(result.AllValuesReturned);
+        }
+
+        [TestMethod]
+        public void DistinctTopApproximate_MergeKeepsCandidateLimit()
+        {
+            DistinctQueryTop query = new DistinctQueryTop("Machine", "", 5) { Approximate = true };
+
+            // Build partition results with 100 rare values each and one value common to all of them
+            DistinctResult[] partitionResults = new DistinctResult[10];
+            for (int partition = 0; partition < partitionResults.Length; ++partition)
+            {
+                DistinctResult result = new DistinctResult(query);
+                result.DistinctSketch = new HyperLogLog();
+                result.CountSketch = new CountMinSketch();
+
+                List<object> candidates = new List<object>();
+                for (int i = 0; i < 100; ++i)
+                {
+                    object value = (i == 0 ? -1 : partition * 1000 + i);
+                    int count = (i == 0 ? 50 : 1);
+
+                    for (int j = 0; j < count; ++j)
+                    {
+                        result.DistinctSketch.Add(DistinctQueryTop.HashValue(value));
+                        result.CountSketch.Add(DistinctQueryTop.HashValue(value));
+                    }
+
+                    candidates.Add(value);
+                }
+
+                result.Candidates = candidates.ToArray();
+                partitionResults[partition] = result;
+            }
+
+            // Verify merged candidates are trimmed to the most common (64 for five values), and the common value is first
+            DistinctResult merged = query.Merge(partitionResults);
+            Assert.AreEqual(64, merged.Candidates.Length);
+            Assert.IsTrue(merged.Candidates.Contains(-1));
+            Assert.AreEqual(-1, merged.Values[0, 0]);
+            Assert.IsTrue((int)merged.Values[0, 1] >= 500);
+            Assert.IsFalse(merged.AllValuesReturned);
+
+            // Verify merging merged results stays within the limit
+            merged = query.Merge(new DistinctResult[] { merged, merged });
+            Assert.AreEqual(64, merged.Candidates.Length);
+            Assert.IsFalse(merged.AllValuesReturned);
+        }
+
         public void ITable_Aggregate_Count(Func<ITable> factoryMethod)
         {
             // Define columns and add sample data
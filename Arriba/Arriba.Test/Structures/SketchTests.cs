@@ -0,0 +1,86 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+using Arriba.Structures;
+
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace Arriba.Test.Structures
+{
+    [TestClass]
+    public class SketchTests
+    {
+        [TestMethod]
+        public void BloomFilter_Basic()
+        {
+            BloomFilter filter = new BloomFilter(10000);
+            for (long i = 0; i < 10000; ++i) filter.Add(Hashing.MurmurHash3(i, 0));
+
+            // Every added value is found
+            for (long i = 0; i < 10000; ++i) Assert.IsTrue(filter.Contains(Hashing.MurmurHash3(i, 0)));
+
+            // About 1% of other values are false positives at ten bits per value
+            int falsePositives = 0;
+            for (long i = 10000; i < 110000; ++i)
+            {
+                if (filter.Contains(Hashing.MurmurHash3(i, 0))) falsePositives++;
+            }
+
+            Assert.IsTrue(falsePositives < 3000, "{0:n0} false positives for 100,000 values.", falsePositives);
+
+            Assert.IsFalse(new BloomFilter(0).Contains(Hashing.MurmurHash3(1L, 0)));
+        }
+
+        [TestMethod]
+        public void HyperLogLog_Basic()
+        {
+            HyperLogLog left = new HyperLogLog();
+            HyperLogLog right = new HyperLogLog();
+
+            // Add overlapping ranges twice; estimates must be within 8% (five standard errors)
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                for (long i = 0; i < 30000; ++i) left.Add(Hashing.MurmurHash3(i, 0));
+                for (long i = 20000; i < 50000; ++i) right.Add(Hashing.MurmurHash3(i, 0));
+            }
+
+            Assert.AreEqual(30000, left.Estimate(), 2400);
+
+            // Merging estimates the union
+            left.Merge(right);
+            Assert.AreEqual(50000, left.Estimate(), 4000);
+
+            Assert.AreEqual(0, new HyperLogLog().Estimate());
+            Verify.Exception<ArgumentException>(() => left.Merge(new HyperLogLog(10)));
+        }
+
+        [TestMethod]
+        public void CountMinSketch_Basic()
+        {
+            CountMinSketch sketch = new CountMinSketch();
+
+            // Value 7 is added 1,000 times among 10,000 values added once
+            for (long i = 0; i < 10000; ++i)
+            {
+                sketch.Add(Hashing.MurmurHash3(i + 100, 0));
+                if (i % 10 == 0) Assert.AreEqual((uint)(i / 10 + 1), sketch.Add(Hashing.MurmurHash3(7L, 0)), 50);
+            }
+
+            // Estimates never undercount
+            Assert.AreEqual(11000, sketch.TotalCount);
+            Assert.IsTrue(sketch.Estimate(Hashing.MurmurHash3(7L, 0)) >= 1000);
+            Assert.IsTrue(sketch.Estimate(Hashing.MurmurHash3(7L, 0)) <= 1050);
+
+            // Merging adds counts
+            CountMinSketch other = new CountMinSketch();
+            other.Merge(sketch);
+            other.Merge(sketch);
+            Assert.AreEqual(22000, other.TotalCount);
+            Assert.AreEqual(2 * sketch.Estimate(Hashing.MurmurHash3(7L, 0)), other.Estimate(Hashing.MurmurHash3(7L, 0)));
+
+            Verify.Exception<ArgumentException>(() => other.Merge(new CountMinSketch(256, 4)));
+        }
+    }
+}
@@ -0,0 +1,171 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Diagnostics;
+using System.Diagnostics.Tracing;
+using System.Text;
+using System.Threading;
+
+namespace Arriba.Diagnostics
+{
+    /// <summary>
+    ///  Kernels with counters. Where is one column clause evaluated on one partition;
+    ///  SetOperation is a ShortSet And, Or, AndNot, OrNot, Not, or FromAnd.
+    /// </summary>
+    public enum Kernel
+    {
+        Where = 0,
+        Count = 1,
+        SetOperation = 2,
+        Enumerate = 3
+    }
+
+    /// <summary>
+    ///  KernelCounters records, for each hot-path kernel, the calls, values processed, bytes read, rows matched,
+    ///  and time spent (in Stopwatch ticks). Counting is off by default and costs one flag check per kernel call when off.
+    ///
+    ///  Counters are kept in a fixed table of slots chosen by thread ID, so concurrent threads rarely write the same cache lines.
+    ///  Slots may still be shared, so values are added with interlocked adds. Read() adds the slots together.
+    ///  Counters are process-wide, so queries running at the same time are counted together.
+    ///
+    ///  Usage:
+    ///    long start = KernelCounters.Start();
+    ///    [kernel]
+    ///    if (start != 0) KernelCounters.Record(Kernel.Count, start, elements, bytes, matched);
+    /// </summary>
+    public static class KernelCounters
+    {
+        public const int FieldCount = 5;
+        private const int SlotCount = 64;
+        private static readonly int s_kernelCount = Enum.GetValues(typeof(Kernel)).Length;
+
+        public static bool IsEnabled;
+
+        // SlotCount slots of [Kernel][Field] values
+        private static long[] s_values = new long[SlotCount * s_kernelCount * FieldCount];
+
+        /// <summary>
+        ///  Return the start timestamp for a kernel call, or zero if counters are off.
+        /// </summary>
+        public static long Start()
+        {
+            return (IsEnabled ? Stopwatch.GetTimestamp() : 0);
+        }
+
+        public static void Record(Kernel kernel, long start, long elements, long bytes, long matched)
+        {
+            RecordElapsed(kernel, Stopwatch.GetTimestamp() - start, elements, bytes, matched);
+        }
+
+        /// <summary>
+        ///  Record a kernel call which was timed separately, for callers which compute counts after the timed work.
+        /// </summary>
+        public static void RecordElapsed(Kernel kernel, long ticks, long elements, long bytes, long matched)
+        {
+            int slot = (Thread.CurrentThread.ManagedThreadId % SlotCount);
+            int index = (slot * s_kernelCount + (int)kernel) * FieldCount;
+
+            Interlocked.Increment(ref s_values[index]);
+            Interlocked.Add(ref s_values[index + 1], elements);
+            Interlocked.Add(ref s_values[index + 2], bytes);
+            Interlocked.Add(ref s_values[index + 3], matched);
+            Interlocked.Add(ref s_values[index + 4], ticks);
+        }
+
+        /// <summary>
+        ///  Return the totals across threads since the last Reset. Subtract an earlier snapshot to get the counts for one query.
+        /// </summary>
+        public static KernelCounterSnapshot Read()
+        {
+            long[] totals = new long[s_kernelCount * FieldCount];
+
+            for (int slot = 0; slot < SlotCount; ++slot)
+            {
+                int slotStart = slot * totals.Length;
+                for (int i = 0; i < totals.Length; ++i)
+                {
+                    totals[i] += Interlocked.Read(ref s_values[slotStart + i]);
+                }
+            }
+
+            return new KernelCounterSnapshot(totals);
+        }
+
+        /// <summary>
+        ///  Start counting again from zero. Calls in progress on other threads may be partly counted.
+        /// </summary>
+        public static void Reset()
+        {
+            for (int i = 0; i < s_values.Length; ++i)
+            {
+                Interlocked.Exchange(ref s_values[i], 0);
+            }
+        }
+
+        /// <summary>
+        ///  Write a marker event (provider "Arriba-Kernels") so profiler traces can be lined up with queries.
+        /// </summary>
+        public static void Mark(string label)
+        {
+            KernelEventSource.Log.Marker(label);
+        }
+    }
+
+    public class KernelCounterSnapshot
+    {
+        internal long[] Values { get; private set; }
+
+        internal KernelCounterSnapshot(long[] values)
+        {
+            this.Values = values;
+        }
+
+        public long Calls(Kernel kernel) => this.Values[(int)kernel * KernelCounters.FieldCount];
+        public long Elements(Kernel kernel) => this.Values[(int)kernel * KernelCounters.FieldCount + 1];
+        public long Bytes(Kernel kernel) => this.Values[(int)kernel * KernelCounters.FieldCount + 2];
+        public long Matched(Kernel kernel) => this.Values[(int)kernel * KernelCounters.FieldCount + 3];
+        public TimeSpan Elapsed(Kernel kernel) => TimeSpan.FromSeconds((double)this.Values[(int)kernel * KernelCounters.FieldCount + 4] / Stopwatch.Frequency);
+
+        public KernelCounterSnapshot Subtract(KernelCounterSnapshot earlier)
+        {
+            long[] difference = new long[this.Values.Length];
+            for (int i = 0; i < difference.Length; ++i)
+            {
+                difference[i] = this.Values[i] - earlier.Values[i];
+            }
+
+            return new KernelCounterSnapshot(difference);
+        }
+
+        /// <summary>
+        ///  Return a summary of each kernel which ran, like "Where: 48 calls, 3,145,728 values, 1,024 matched, 2.1ms; Count: ...".
+        /// </summary>
+        public override string ToString()
+        {
+            StringBuilder result = new StringBuilder();
+
+            foreach (Kernel kernel in Enum.GetValues(typeof(Kernel)))
+            {
+                if (Calls(kernel) == 0) continue;
+
+                if (result.Length > 0) result.Append("; ");
+                result.Append($"{kernel}: {Calls(kernel):n0} calls, {Elements(kernel):n0} values, {Bytes(kernel):n0} bytes, {Matched(kernel):n0} matched, {Elapsed(kernel).TotalMilliseconds:n1}ms");
+            }
+
+            return result.ToString();
+        }
+    }
+
+    [EventSource(Name = "Arriba-Kernels")]
+    internal sealed class KernelEventSource : EventSource
+    {
+        public static KernelEventSource Log = new KernelEventSource();
+
+        [Event(1, Level = EventLevel.Informational)]
+        public void Marker(string label)
+        {
+            WriteEvent(1, label);
+        }
+    }
+}
@@ -112,6 +112,11 @@ namespace Arriba.Model
             get { return _accessDeniedColumns; }
         }
 
+        /// <summary>
+        ///  Calls, values, matches, and time for each kernel the operation ran, when KernelCounters are enabled.
+        /// </summary>
+        public string Kernels { get; set; }
+
         public void Merge(ExecutionDetails other)
         {
             if (other == null) return;
@@ -119,6 +124,7 @@ namespace Arriba.Model
             lock (this)
             {
                 this.Succeeded &= other.Succeeded;
+                if (this.Kernels == null) this.Kernels = other.Kernels;
 
                 if (other._errors != null)
                 {
@@ -3,9 +3,12 @@
 
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Linq;
 using System.Text;
+using System.Threading;
 
+using Arriba.Diagnostics;
 using Arriba.Extensions;
 using Arriba.Indexing;
 using Arriba.Model.Query;
@@ -267,7 +270,15 @@ namespace Arriba.Model.Expressions
                 }
                 else
                 {
+                    long start = KernelCounters.Start();
                     partition.Columns[this.ColumnName].TryWhere(this.Operator, this.Value, result, details);
+
+                    if (start != 0)
+                    {
+                        // Stop timing the Where before counting its matches, and count them only once
+                        long ticks = Stopwatch.GetTimestamp() - start;
+                        KernelCounters.RecordElapsed(Kernel.Where, ticks, partition.Count, 0, result.Count());
+                    }
                 }
             }
         }
@@ -333,6 +344,19 @@ namespace Arriba.Model.Expressions
         public Operator Operator;
         public Array Values;
 
+        // Partitions with fewer than (ScanRowsPerValue * Values.Length) rows are scanned against a filter of the values instead of searched per value
+        private const int ScanRowsPerValue = 8;
+
+        // Types whose equal values always hash equally (doubles and DateTimes can be equal with different bits)
+        private static readonly Type[] s_scanTypes = new Type[] { typeof(ByteBlock), typeof(long), typeof(ulong), typeof(int), typeof(uint), typeof(short), typeof(ushort), typeof(byte), typeof(sbyte), typeof(bool), typeof(Guid), typeof(TimeSpan) };
+
+        // The Bloom filter and set of Values are built once and shared by every partition
+        private object _valueFilterLock = new object();
+        private Type _valueFilterType;
+        private BloomFilter _valueFilter;
+        private HashSet<object> _valueSet;
+        private int _filteredPartitionCount;
+
         public TermInExpression(string columnName, Array values) : this(columnName, Operator.Equals, values)
         { }
 
@@ -392,13 +416,79 @@ namespace Arriba.Model.Expressions
             }
             else
             {
-                IColumn<object> column = partition.Columns[this.ColumnName];
+                IUntypedColumn column = partition.Columns[this.ColumnName];
+
+                BloomFilter filter;
+                HashSet<object> set;
+                if (this.Operator == Operator.Equals && partition.Count < (long)ScanRowsPerValue * this.Values.Length && TryGetValueFilter(column.ColumnType, out filter, out set))
+                {
+                    // Many values: scan the column, checking the set only for rows the Bloom filter passes
+                    Interlocked.Increment(ref _filteredPartitionCount);
+                    for (int lid = 0; lid < partition.Count; ++lid)
+                    {
+                        object value = column[(ushort)lid];
+                        if (filter.Contains(DistinctQueryTop.HashValue(value)) && set.Contains(value)) result.Add((ushort)lid);
+                    }
+                }
+                else
+                {
+                    for (int i = 0; i < this.Values.Length; ++i)
+                    {
+                        column.TryWhere(this.Operator, this.Values.GetValue(i), result, details);
+                    }
+                }
+            }
+        }
 
-                for (int i = 0; i < this.Values.Length; ++i)
+        /// <summary>
+        ///  Return the number of partitions scanned against the Bloom filter of the values rather than searched per value.
+        /// </summary>
+        internal int FilteredPartitionCount => _filteredPartitionCount;
+
+        private bool TryGetValueFilter(Type columnType, out BloomFilter filter, out HashSet<object> set)
+        {
+            lock (_valueFilterLock)
+            {
+                if (_valueFilterType != columnType)
                 {
-                    column.TryWhere(this.Operator, this.Values.GetValue(i), result, details);
+                    _valueFilterType = columnType;
+                    _valueFilter = null;
+                    _valueSet = null;
+
+                    // Values are converted to the column type once, since rows are compared to them as column values
+                    object[] values = (Array.IndexOf(s_scanTypes, columnType) != -1 ? ConvertValues(columnType) : null);
+                    if (values != null)
+                    {
+                        _valueFilter = new BloomFilter(values.Length);
+                        _valueSet = new HashSet<object>();
+                        for (int i = 0; i < values.Length; ++i)
+                        {
+                            _valueFilter.Add(DistinctQueryTop.HashValue(values[i]));
+                            _valueSet.Add(values[i]);
+                        }
+                    }
                 }
+
+                filter = _valueFilter;
+                set = _valueSet;
+                return filter != null;
+            }
+        }
+
+        private object[] ConvertValues(Type columnType)
+        {
+            // Values joined from a multi-partition table are merged as an object[], so convert each one.
+            // If any value is null or can't be converted, search per value so it's handled as column searches handle it.
+            object[] result = new object[this.Values.Length];
+            for (int i = 0; i < result.Length; ++i)
+            {
+                object value = this.Values.GetValue(i);
+                if (value == null) return null;
+                if (value.GetType() != columnType && !Value.Create(value).TryConvert(columnType, out value)) return null;
+                result[i] = value;
             }
+
+            return result;
         }
 
         public IList<IExpression> Children()
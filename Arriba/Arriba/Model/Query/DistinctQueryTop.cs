@@ -13,11 +13,27 @@ namespace Arriba.Model.Query
     /// <summary>
     ///  DistinctQueryTop returns the most common unique values for a given column
     ///  in a given query. It is used to provide Inline Insight results for "[Column] = ".
+    ///  
+    ///  When Approximate is set, each partition sketches the column instead of counting every
+    ///  value: a HyperLogLog estimates the distinct count and a count-min sketch estimates value
+    ///  counts, with only the most common values kept as candidates. Sketches merge across
+    ///  partitions by register max and counter sum, so memory stays bounded for high cardinality
+    ///  columns (machine names, GUIDs) and the counts returned may be slightly high.
+    ///  Approximate results never report AllValuesReturned, since the values and counts are estimates.
     /// </summary>
     public class DistinctQueryTop : DistinctQuery
     {
+        // Keep this many candidates per requested value in approximate mode, so values common overall but not in one partition survive the merge
+        private const int CandidatesPerValue = 4;
+        private const int MinimumCandidates = 64;
+
         public string ValuePrefix { get; set; }
 
+        /// <summary>
+        ///  Estimate the distinct count and top values with sketches rather than counting every value exactly.
+        /// </summary>
+        public bool Approximate { get; set; }
+
         public DistinctQueryTop() : base()
         { }
 
@@ -59,7 +75,11 @@ namespace Arriba.Model.Query
                 if (prefixDetails.Succeeded) whereSet.And(prefixSet);
             }
 
-            if (result.Details.Succeeded)
+            if (result.Details.Succeeded && this.Approximate)
+            {
+                ComputeApproximate(p.Columns[this.Column], whereSet, result);
+            }
+            else if (result.Details.Succeeded)
             {
                 // Count the occurences of each value
                 Dictionary<object, int> countByValue = new Dictionary<object, int>();
@@ -88,6 +108,125 @@ namespace Arriba.Model.Query
             return result;
         }
 
+        private void ComputeApproximate(IUntypedColumn column, ShortSet whereSet, DistinctResult result)
+        {
+            HyperLogLog distinct = new HyperLogLog();
+            CountMinSketch counts = new CountMinSketch();
+
+            // Track the values with the highest estimated counts so far
+            int candidateLimit = this.CandidateLimit;
+            Dictionary<object, int> candidates = new Dictionary<object, int>();
+            uint lowestCandidateCount = 0;
+
+            for (int i = 0; i < column.Count; ++i)
+            {
+                ushort lid = (ushort)i;
+                if (!whereSet.Contains(lid)) continue;
+
+                object value = column[lid];
+                ulong hash = HashValue(value);
+                distinct.Add(hash);
+                uint estimate = counts.Add(hash);
+
+                if (candidates.Count < candidateLimit || candidates.ContainsKey(value))
+                {
+                    candidates[value] = (int)Math.Min(int.MaxValue, estimate);
+                }
+                else if (estimate > lowestCandidateCount)
+                {
+                    // lowestCandidateCount is a lower bound (candidate counts only grow); find the real lowest and replace it if this value is now more common
+                    object lowestValue = null;
+                    int lowestCount = int.MaxValue;
+                    foreach (KeyValuePair<object, int> candidate in candidates)
+                    {
+                        if (candidate.Value < lowestCount)
+                        {
+                            lowestValue = candidate.Key;
+                            lowestCount = candidate.Value;
+                        }
+                    }
+
+                    lowestCandidateCount = (uint)lowestCount;
+                    if (estimate > lowestCandidateCount)
+                    {
+                        candidates.Remove(lowestValue);
+                        candidates[value] = (int)Math.Min(int.MaxValue, estimate);
+                    }
+                }
+            }
+
+            result.ColumnType = column.ColumnType;
+            result.DistinctSketch = distinct;
+            result.CountSketch = counts;
+            result.Candidates = candidates.Keys.ToArray();
+            result.DistinctCountEstimate = distinct.Estimate();
+
+            result.Values = ToDataBlock(candidates, this.Column, (int)this.Count);
+            result.AllValuesReturned = false;
+        }
+
+        private int CandidateLimit => Math.Max(MinimumCandidates, CandidatesPerValue * (int)Math.Min(this.Count, ushort.MaxValue));
+
+        private DistinctResult MergeApproximate(DistinctResult[] partitionResults)
+        {
+            DistinctResult mergedResult = new DistinctResult(this);
+            mergedResult.ColumnType = partitionResults[0].ColumnType;
+            HyperLogLog distinct = new HyperLogLog();
+            CountMinSketch counts = new CountMinSketch();
+            HashSet<object> candidates = new HashSet<object>();
+
+            for (int partitionIndex = 0; partitionIndex < partitionResults.Length; ++partitionIndex)
+            {
+                DistinctResult result = partitionResults[partitionIndex];
+                mergedResult.Details.Merge(result.Details);
+                mergedResult.Total += result.Total;
+
+                if (result.DistinctSketch != null) distinct.Merge(result.DistinctSketch);
+                if (result.CountSketch != null) counts.Merge(result.CountSketch);
+                if (result.Candidates != null) candidates.UnionWith(result.Candidates);
+            }
+
+            // Re-estimate every partition's candidates from the merged counts
+            Dictionary<object, int> countByValue = new Dictionary<object, int>();
+            foreach (object value in candidates)
+            {
+                countByValue[value] = (int)Math.Min(int.MaxValue, counts.Estimate(HashValue(value)));
+            }
+
+            // Keep only the most common candidates, so candidates stay bounded as results are merged again
+            int candidateLimit = this.CandidateLimit;
+            if (countByValue.Count > candidateLimit)
+            {
+                countByValue = countByValue.OrderByDescending((kvp) => kvp.Value).Take(candidateLimit).ToDictionary((kvp) => kvp.Key, (kvp) => kvp.Value);
+            }
+
+            mergedResult.DistinctSketch = distinct;
+            mergedResult.CountSketch = counts;
+            mergedResult.Candidates = countByValue.Keys.ToArray();
+            mergedResult.DistinctCountEstimate = distinct.Estimate();
+
+            mergedResult.Values = ToDataBlock(countByValue, this.Column, (int)this.Count);
+            mergedResult.AllValuesReturned = false;
+
+            return mergedResult;
+        }
+
+        internal static ulong HashValue(object value)
+        {
+            if (value == null) return 0;
+
+            if (value is ByteBlock) return ((ByteBlock)value).GetHashULong();
+            if (value is long) return Hashing.MurmurHash3((long)value, 0);
+            if (value is ulong) return Hashing.MurmurHash3((ulong)value, 0);
+            if (value is double) return Hashing.MurmurHash3((double)value, 0);
+            if (value is Guid) return Hashing.MurmurHash3((Guid)value, 0);
+            if (value is DateTime) return Hashing.MurmurHash3((DateTime)value, 0);
+            if (value is TimeSpan) return Hashing.MurmurHash3((TimeSpan)value, 0);
+            if (value is int || value is uint || value is short || value is ushort || value is byte || value is sbyte || value is bool) return Hashing.MurmurHash3(Convert.ToInt64(value), 0);
+
+            return Hashing.MurmurHash3((long)value.GetHashCode(), 0);
+        }
+
         private static DataBlock ToDataBlock(Dictionary<object, int> countByValue, string columnName, int desiredCount)
         {
             // Determine how many items to return
@@ -115,6 +254,7 @@ namespace Arriba.Model.Query
             if (partitionResults == null) throw new ArgumentNullException("partitionResults");
             if (partitionResults.Length == 0) throw new ArgumentException("Length==0 not supported", "partitionResults");
             if (!partitionResults[0].Details.Succeeded) return partitionResults[0];
+            if (this.Approximate) return MergeApproximate(partitionResults);
 
             DistinctResult mergedResult = new DistinctResult(this);
             mergedResult.ColumnType = partitionResults[0].ColumnType;
@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 using Arriba.Model.Expressions;
+using Arriba.Structures;
 
 namespace Arriba.Model.Query
 {
@@ -14,8 +15,20 @@ namespace Arriba.Model.Query
         public System.Type ColumnType { get; set; }
         public bool AllValuesReturned { get; set; }
 
+        /// <summary>
+        ///  Estimated count of distinct values matching the query, from approximate DistinctQueryTop queries (-1 otherwise).
+        /// </summary>
+        public long DistinctCountEstimate { get; set; }
+
+        // Per-partition sketches and top value candidates for approximate queries, merged across partitions
+        internal HyperLogLog DistinctSketch { get; set; }
+        internal CountMinSketch CountSketch { get; set; }
+        internal object[] Candidates { get; set; }
+
         public DistinctResult(DistinctQuery query) : base(query)
-        { }
+        {
+            this.DistinctCountEstimate = -1;
+        }
 
         /// <summary>
         ///  Convert the set of values returned into a dimension for an aggregation.
@@ -10,6 +10,7 @@ using System.Linq;
 using System.Threading;
 using System.Threading.Tasks;
 
+using Arriba.Diagnostics;
 using Arriba.Extensions;
 using Arriba.Model.Column;
 using Arriba.Model.Correctors;
@@ -583,6 +584,14 @@ namespace Arriba.Model
             {
                 Stopwatch w = Stopwatch.StartNew();
 
+                // Snapshot kernel counters, if counting
+                KernelCounterSnapshot countersBefore = null;
+                if (KernelCounters.IsEnabled)
+                {
+                    KernelCounters.Mark(query.ToString());
+                    countersBefore = KernelCounters.Read();
+                }
+
                 // Notify query
                 query.OnBeforeQuery(this);
 
@@ -592,33 +601,39 @@ namespace Arriba.Model
                 // Non-Parallel implementation
                 if (_partitions.Count == 1 && query.RequireMerge == false)
                 {
-                    return _partitions[0].Query(query);
+                    return AddKernelCounters(_partitions[0].Query(query), countersBefore);
                 }
 
                 // Determine the aggregate value per partition
                 ObjectCache<T> mergePool = new ObjectCache<T>(null);
                 if (this.RunParallel)
                 {
-                    Parallel.For(0, _partitions.Count, (i) =>
-                    {
-                        T partitionResult = _partitions[i].Query(query);
-
-                        // Merge results in pairs and put back each merged result to
-                        // a pool to be merged with a future result.  This allows merging
-                        // to be a primarily parallel operation.  A final merge of the oustanding
-                        // items in the pool will be done afterwards.
-                        T mergeResult;
-                        bool gotFromPool = mergePool.TryGet(out mergeResult);
-                        if (gotFromPool)
+                    // Hand out partitions one at a time, largest first, so that threads which finish
+                    // small partitions take the remaining ones instead of idling behind a static split.
+                    var partitioner = Partitioner.Create(PartitionIndicesByCost(), EnumerablePartitionerOptions.NoBuffering);
+
+                    // Each thread merges the results of the partitions it ran, and the per-thread
+                    // results are merged once at the end.
+                    Parallel.ForEach(
+                        partitioner,
+                        this.ParallelOptions,
+                        () => new List<T>(),
+                        (i, state, threadResults) =>
                         {
-                            T afterMergeResult = query.Merge(new T[] { partitionResult, mergeResult });
-                            mergePool.Put(afterMergeResult);
-                        }
-                        else
+                            threadResults.Add(_partitions[i].Query(query));
+                            if (threadResults.Count > 1)
+                            {
+                                T merged = query.Merge(threadResults.ToArray());
+                                threadResults.Clear();
+                                threadResults.Add(merged);
+                            }
+
+                            return threadResults;
+                        },
+                        (threadResults) =>
                         {
-                            mergePool.Put(partitionResult);
-                        }
-                    });
+                            if (threadResults.Count > 0) mergePool.Put(threadResults[0]);
+                        });
                 }
                 else
                 {
@@ -633,13 +648,43 @@ namespace Arriba.Model
                 T mergedResult = query.Merge(mergePool.ClearAndReturnAllItems());
                 if (mergedResult is IBaseResult) ((IBaseResult)(object)mergedResult).Runtime = w.Elapsed;
 
-                return mergedResult;
+                return AddKernelCounters(mergedResult, countersBefore);
             }
             finally
             {
                 _locker.ExitReadLock();
             }
         }
+
+        /// <summary>
+        ///  Return partition indices with the partitions with the most items first, so that
+        ///  the most expensive partitions start first and don't finish last.
+        /// </summary>
+        private int[] PartitionIndicesByCost()
+        {
+            int[] indices = new int[_partitions.Count];
+            int[] itemCounts = new int[_partitions.Count];
+            for (int i = 0; i < indices.Length; ++i)
+            {
+                indices[i] = i;
+                itemCounts[i] = -_partitions[i].Count;
+            }
+
+            Array.Sort(itemCounts, indices);
+            return indices;
+        }
+
+        private static T AddKernelCounters<T>(T result, KernelCounterSnapshot countersBefore)
+        {
+            // Counters are process-wide, so they include any other queries running at the same time
+            IBaseResult baseResult = result as IBaseResult;
+            if (countersBefore != null && baseResult != null && baseResult.Details != null)
+            {
+                baseResult.Details.Kernels = KernelCounters.Read().Subtract(countersBefore).ToString();
+            }
+
+            return result;
+        }
         #endregion
 
         #region Split
@@ -0,0 +1,64 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+namespace Arriba.Structures
+{
+    /// <summary>
+    ///  BloomFilter is a split block Bloom filter over 64-bit hashes. It answers whether a value might have been
+    ///  added with no false negatives and about 1% false positives at ten bits per value.
+    ///  
+    ///  Each value sets one bit in each of the eight 32-bit words of one 256-bit block, so a lookup reads only one
+    ///  block. The filter stays small enough to stay in cache when shared across partitions, unlike a set of the values.
+    /// </summary>
+    public class BloomFilter
+    {
+        private const int BitsPerValue = 10;
+        private const int BitsPerBlock = 256;
+
+        private static readonly uint[] Salts = new uint[] { 0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d, 0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31 };
+
+        private uint[] _blocks;
+        private uint _blockCount;
+
+        public BloomFilter(int expectedCount)
+        {
+            if (expectedCount < 0) throw new ArgumentOutOfRangeException("expectedCount");
+            _blockCount = (uint)Math.Max(1, ((long)expectedCount * BitsPerValue + BitsPerBlock - 1) / BitsPerBlock);
+            _blocks = new uint[8 * _blockCount];
+        }
+
+        public void Add(ulong hash)
+        {
+            int block = Block(hash);
+            for (int word = 0; word < 8; ++word)
+            {
+                _blocks[block + word] |= Bit(hash, word);
+            }
+        }
+
+        public bool Contains(ulong hash)
+        {
+            int block = Block(hash);
+            for (int word = 0; word < 8; ++word)
+            {
+                if ((_blocks[block + word] & Bit(hash, word)) == 0) return false;
+            }
+
+            return true;
+        }
+
+        private int Block(ulong hash)
+        {
+            // The top hash half picks the block (by multiply-shift, so any block count works)
+            return 8 * (int)(((hash >> 32) * _blockCount) >> 32);
+        }
+
+        private static uint Bit(ulong hash, int word)
+        {
+            // The bottom hash half picks the bit in each word
+            return 1U << (int)(((uint)hash * Salts[word]) >> 27);
+        }
+    }
+}
@@ -304,7 +304,7 @@ namespace Arriba.Structures
             );
         }
 
-        private unsafe ulong GetHashULong()
+        internal unsafe ulong GetHashULong()
         {
             fixed (byte* a = this.Array)
             {
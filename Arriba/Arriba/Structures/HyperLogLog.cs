@@ -0,0 +1,86 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+namespace Arriba.Structures
+{
+    /// <summary>
+    ///  HyperLogLog estimates the number of distinct values added in fixed memory (2^precision bytes).
+    ///  The standard error is about 1.04 / sqrt(2^precision); 1.6% at the default precision of 12.
+    ///  
+    ///  Values are added as 64-bit hashes. The top 'precision' bits choose a register, and each register keeps the
+    ///  longest run of leading zeros seen in the remaining bits. Sketches of the same precision merge by taking the
+    ///  maximum of each register, so each partition is sketched independently and the results combine cheaply.
+    /// </summary>
+    public class HyperLogLog
+    {
+        public const int DefaultPrecision = 12;
+
+        private byte[] _registers;
+        private int _precision;
+
+        public HyperLogLog() : this(DefaultPrecision)
+        { }
+
+        public HyperLogLog(int precision)
+        {
+            if (precision < 4 || precision > 16) throw new ArgumentOutOfRangeException("precision");
+            _precision = precision;
+            _registers = new byte[1 << precision];
+        }
+
+        public int Precision
+        {
+            get { return _precision; }
+        }
+
+        public void Add(ulong hash)
+        {
+            int index = (int)(hash >> (64 - _precision));
+
+            // The rank is one more than the leading zeros after the register bits; the guard bit caps it at (64 - precision + 1)
+            ulong remaining = (hash << _precision) | (1UL << (_precision - 1));
+            byte rank = 1;
+            while ((remaining & 0x8000000000000000UL) == 0)
+            {
+                rank++;
+                remaining <<= 1;
+            }
+
+            if (rank > _registers[index]) _registers[index] = rank;
+        }
+
+        public void Merge(HyperLogLog other)
+        {
+            if (other == null) throw new ArgumentNullException("other");
+            if (other._precision != _precision) throw new ArgumentException("Only HyperLogLogs with the same precision can be merged.", "other");
+
+            for (int i = 0; i < _registers.Length; ++i)
+            {
+                if (other._registers[i] > _registers[i]) _registers[i] = other._registers[i];
+            }
+        }
+
+        public long Estimate()
+        {
+            int m = _registers.Length;
+
+            double sum = 0;
+            int zeroCount = 0;
+            for (int i = 0; i < m; ++i)
+            {
+                sum += 1.0 / (1UL << _registers[i]);
+                if (_registers[i] == 0) zeroCount++;
+            }
+
+            double alpha = (m == 16 ? 0.673 : (m == 32 ? 0.697 : (m == 64 ? 0.709 : 0.7213 / (1.0 + 1.079 / m))));
+            double estimate = alpha * m * m / sum;
+
+            // Use linear counting for small cardinalities, where it's more accurate. 64-bit hashes don't need a large range correction.
+            if (estimate <= 2.5 * m && zeroCount > 0) estimate = m * Math.Log((double)m / zeroCount);
+
+            return (long)Math.Round(estimate);
+        }
+    }
+}
@@ -8,6 +8,7 @@ using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.Security;
 
+using Arriba.Diagnostics;
 using Arriba.Extensions;
 using Arriba.Serialization;
 
@@ -122,6 +123,7 @@ namespace Arriba.Structures
                 if (count == 0) return items;
 
                 int length = _bitVector.Length;
+                long start = KernelCounters.Start();
 
                 fixed (ulong* pbitVector = &_bitVector[0])
                 {
@@ -154,6 +156,7 @@ namespace Arriba.Structures
                     }
                 }
 
+                if (start != 0) KernelCounters.Record(Kernel.Enumerate, start, 64 * length, 8 * length, count);
                 return items;
             }
         }
@@ -165,6 +168,15 @@ namespace Arriba.Structures
         {
             if (_bitVector.Length == 0) return 0;
 
+            long start = KernelCounters.Start();
+            ushort count = CountInternal();
+            if (start != 0) KernelCounters.Record(Kernel.Count, start, 64 * _bitVector.Length, 8 * _bitVector.Length, count);
+
+            return count;
+        }
+
+        private unsafe ushort CountInternal()
+        {
             if (UseNativeSupport)
             {
                 // Count directly using the POPCNT instruction (one ulong per instruction)
@@ -214,6 +226,8 @@ namespace Arriba.Structures
         /// </summary>
         public void Not()
         {
+            long start = KernelCounters.Start();
+
             int length = _bitVector.Length;
             for (int i = 0; i < length; ++i)
             {
@@ -221,6 +235,7 @@ namespace Arriba.Structures
             }
 
             TrimToCapacity();
+            if (start != 0) KernelCounters.Record(Kernel.SetOperation, start, 64 * length, 8 * length, 0);
         }
 
         /// <summary>
@@ -243,6 +258,8 @@ namespace Arriba.Structures
         {
             if (other == null) throw new ArgumentNullException("other");
 
+            long start = KernelCounters.Start();
+
             // And parts in both. Values above other capacity will be zero, clearing them in our set.
             int length = Math.Min(_bitVector.Length, other._bitVector.Length);
             for (int i = 0; i < length; ++i)
@@ -252,6 +269,7 @@ namespace Arriba.Structures
 
             // Clear our values above other capacity, if any
             ClearAboveLength(length);
+            if (start != 0) KernelCounters.Record(Kernel.SetOperation, start, 64 * length, 16 * length, 0);
         }
 
         /// <summary>
@@ -263,6 +281,8 @@ namespace Arriba.Structures
         {
             if (other == null) throw new ArgumentNullException("other");
 
+            long start = KernelCounters.Start();
+
             // Or parts in both. This may set values above our capacity in the last ulong.
             int length = Math.Min(_bitVector.Length, other._bitVector.Length);
             for (int i = 0; i < length; ++i)
@@ -272,6 +292,7 @@ namespace Arriba.Structures
 
             // Clear back to our capacity.
             TrimToCapacity();
+            if (start != 0) KernelCounters.Record(Kernel.SetOperation, start, 64 * length, 16 * length, 0);
         }
 
         /// <summary>
@@ -283,6 +304,8 @@ namespace Arriba.Structures
         {
             if (other == null) throw new ArgumentNullException("other");
 
+            long start = KernelCounters.Start();
+
             // OrNot away values in other.
             int length = Math.Min(_bitVector.Length, other._bitVector.Length);
             for (int i = 0; i < length; ++i)
@@ -292,6 +315,7 @@ namespace Arriba.Structures
 
             // Clear back to our capacity.
             TrimToCapacity();
+            if (start != 0) KernelCounters.Record(Kernel.SetOperation, start, 64 * length, 16 * length, 0);
         }
 
         /// <summary>
@@ -303,6 +327,8 @@ namespace Arriba.Structures
         {
             if (other == null) throw new ArgumentNullException("other");
 
+            long start = KernelCounters.Start();
+
             // AndNot away values in other. This will not set values above our capacity,
             // since they're already 0 on our side. This will not clear values above their
             // capacity, because they are already 0 on their side.
@@ -311,6 +337,8 @@ namespace Arriba.Structures
             {
                 _bitVector[i] = _bitVector[i] & ~other._bitVector[i];
             }
+
+            if (start != 0) KernelCounters.Record(Kernel.SetOperation, start, 64 * length, 16 * length, 0);
         }
         #endregion
 
@@ -345,6 +373,7 @@ namespace Arriba.Structures
             if (right == null) throw new ArgumentNullException("right");
 
             int length = Math.Min(_bitVector.Length, Math.Min(left._bitVector.Length, right._bitVector.Length));
+            long start = KernelCounters.Start();
 
             if (UseNativeSupport)
             {
@@ -370,6 +399,7 @@ namespace Arriba.Structures
 
             // Clear our values above other capacity, if any
             ClearAboveLength(length);
+            if (start != 0) KernelCounters.Record(Kernel.SetOperation, start, 64 * length, 16 * length, 0);
         }
         #endregion
 
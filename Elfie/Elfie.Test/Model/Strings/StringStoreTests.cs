@@ -117,6 +117,51 @@ namespace Microsoft.CodeAnalysis.Elfie.Test.Model
             Assert.AreEqual(string.Empty, GetRangeValuesAsString("ZZ", iStore), "Prefix after last item has empty range");
         }
 
+        [TestMethod]
+        public void ImmutableStringStore_Search()
+        {
+            // Values sharing the first eight bytes (which searches narrow to first) and shorter values, in several casings
+            string[] strings = { "GetValue", "GetValues", "getvalue", "GETVALUE", "GetValueOrDefault", "GetValueOrDefaults", "GetVal", "Get", "get", "G", "GetValueAsync", "IsEmpty", "IsEmptyOrWhitespace", "Z", "_Name", "[Name]", "Éclair" };
+
+            MutableStringStore store = new MutableStringStore();
+            for (int i = 0; i < strings.Length; ++i)
+            {
+                store.FindOrAddString(strings[i]);
+            }
+
+            IStringStore iStore = Convert(store);
+
+            // Verify exact and prefix searches for values, prefixes of values, and values not present against a linear scan
+            string[] searches = { "GetValue", "getvalues", "GetValueOrDefault", "GetValueOr", "GetValueA", "GetValueB", "GetVal", "GetV", "Get", "g", "IsEmptyO", "IsEmptyOrWhitespaceX", "Z", "ZZ", "A", "_", "[", "É", "Éclair", "AA" };
+            byte[] buffer = new byte[64];
+            for (int i = 0; i < searches.Length; ++i)
+            {
+                String8 value = String8.Convert(searches[i], buffer);
+
+                Range matches, expected;
+                bool found = iStore.TryFindString(value, out matches);
+                Assert.AreEqual(LinearSearch(iStore, value, false, out expected), found, "TryFindString(\"{0}\")", searches[i]);
+                Assert.AreEqual(expected.ToString(), matches.ToString(), "TryFindString(\"{0}\")", searches[i]);
+
+                found = iStore.TryGetRangeStartingWith(value, out matches);
+                Assert.AreEqual(LinearSearch(iStore, value, true, out expected), found, "TryGetRangeStartingWith(\"{0}\")", searches[i]);
+                if (found) Assert.AreEqual(expected.ToString(), matches.ToString(), "TryGetRangeStartingWith(\"{0}\")", searches[i]);
+            }
+        }
+
+        private static bool LinearSearch(IStringStore store, String8 value, bool isPrefix, out Range matches)
+        {
+            // Find the first and last matching value, or the insertion position if none match
+            int start = 0;
+            while (start < store.Count && value.CompareTo(store[start], true) > 0) start++;
+
+            int end = start;
+            while (end < store.Count && (isPrefix ? value.CompareAsPrefixTo(store[end], true) == 0 : value.CompareTo(store[end], true) == 0)) end++;
+
+            matches = (end > start ? new Range(start, end - 1) : new Range(start));
+            return end > start;
+        }
+
         [TestMethod]
         public void StringStore_CaseSensitivity()
         {
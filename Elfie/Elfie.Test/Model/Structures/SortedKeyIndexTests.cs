@@ -0,0 +1,57 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+using Microsoft.CodeAnalysis.Elfie.Model.Structures;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace Microsoft.CodeAnalysis.Elfie.Test.Model.Structures
+{
+    [TestClass]
+    public class SortedKeyIndexTests
+    {
+        [TestMethod]
+        public void SortedKeyIndex_Basics()
+        {
+            Random r = new Random(5);
+
+            // Verify for empty, single and many blocks, full and partial last blocks, with duplicate keys
+            for (int count = 0; count < 600; count += (count < 40 ? 1 : 37))
+            {
+                ulong[] keys = new ulong[count];
+                for (int i = 0; i < count; ++i)
+                {
+                    keys[i] = (ulong)r.Next(count) * 3;
+                }
+
+                Array.Sort(keys);
+                SortedKeyIndex index = new SortedKeyIndex(keys);
+                Assert.AreEqual(count, index.Count);
+
+                // Search for every key, the values between keys, and values before and after all keys
+                for (ulong key = 0; key < (ulong)count * 3 + 2; ++key)
+                {
+                    Assert.AreEqual(LowerBound(keys, key), index.LowerBound(key), "LowerBound({0}) of {1} keys", key, count);
+                    Assert.AreEqual(UpperBound(keys, key), index.UpperBound(key), "UpperBound({0}) of {1} keys", key, count);
+                }
+
+                Assert.AreEqual(count, index.UpperBound(ulong.MaxValue));
+            }
+        }
+
+        private static int LowerBound(ulong[] keys, ulong key)
+        {
+            int i = 0;
+            while (i < keys.Length && keys[i] < key) ++i;
+            return i;
+        }
+
+        private static int UpperBound(ulong[] keys, ulong key)
+        {
+            int i = 0;
+            while (i < keys.Length && keys[i] <= key) ++i;
+            return i;
+        }
+    }
+}
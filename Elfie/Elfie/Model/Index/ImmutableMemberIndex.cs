@@ -16,6 +16,7 @@ namespace Microsoft.CodeAnalysis.Elfie.Model.Index
         private int[] _sortedWordIdentifiers;
         private int[] _indexOfFirstMatch;
         private int[] _matchesBlock;
+        private SortedKeyIndex _wordIndex;
 
         /// <summary>
         ///  Serialization Constructor
@@ -42,11 +43,10 @@ namespace Microsoft.CodeAnalysis.Elfie.Model.Index
             }
             else
             {
-                firstWordIndex = Array.BinarySearch(_sortedWordIdentifiers, range.Start);
-                if (firstWordIndex < 0) firstWordIndex = ~firstWordIndex;
-
-                lastWordIndex = Array.BinarySearch(_sortedWordIdentifiers, range.End);
-                if (lastWordIndex < 0) lastWordIndex = ~lastWordIndex - 1;
+                // Find the first word at or after the range start and the last word at or before the range end
+                SortedKeyIndex wordIndex = WordIndex;
+                firstWordIndex = wordIndex.LowerBound(WordKey(range.Start));
+                lastWordIndex = wordIndex.UpperBound(WordKey(range.End)) - 1;
             }
 
             if (firstWordIndex < _indexOfFirstMatch.Length)
@@ -65,6 +65,34 @@ namespace Microsoft.CodeAnalysis.Elfie.Model.Index
             }
         }
 
+        private SortedKeyIndex WordIndex
+        {
+            get
+            {
+                // Build the search index on the sorted word identifiers on first use
+                SortedKeyIndex index = _wordIndex;
+                if (index == null)
+                {
+                    ulong[] keys = new ulong[_sortedWordIdentifiers.Length];
+                    for (int i = 0; i < keys.Length; ++i)
+                    {
+                        keys[i] = WordKey(_sortedWordIdentifiers[i]);
+                    }
+
+                    index = new SortedKeyIndex(keys);
+                    _wordIndex = index;
+                }
+
+                return index;
+            }
+        }
+
+        private static ulong WordKey(int wordIdentifier)
+        {
+            // Offset so negative identifiers sort before positive ones as unsigned keys
+            return (ulong)((long)wordIdentifier - int.MinValue);
+        }
+
         private int GetIndexAfterLastMatch(int wordIndex)
         {
             if (wordIndex >= _indexOfFirstMatch.Length - 1)
@@ -126,6 +154,7 @@ namespace Microsoft.CodeAnalysis.Elfie.Model.Index
 
             _indexOfFirstMatch = r.ReadPrimitiveArray<int>();
             _matchesBlock = r.ReadPrimitiveArray<int>();
+            _wordIndex = null;
         }
         #endregion
     }
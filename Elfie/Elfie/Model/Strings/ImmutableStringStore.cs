@@ -19,7 +19,9 @@ namespace Microsoft.CodeAnalysis.Elfie.Model.Strings
     internal class ImmutableStringStore : IStringStore
     {
         private const bool IgnoreCase = true;
+        private const int PrefixKeyLength = 8;
         private String8Set _sortedExistingValues;
+        private SortedKeyIndex _prefixIndex;
 
         /// <summary>
         ///  Serialization-only constructor
@@ -79,51 +81,24 @@ namespace Microsoft.CodeAnalysis.Elfie.Model.Strings
                 return true;
             }
 
-            // Binary search sorted strings for the value
-            int min = 0;
-            int max = _sortedExistingValues.Count - 1;
-            int mid = 0;
-            int cmp = 0;
-            String8 valueHere = String8.Empty;
+            // Find the values sharing the first eight bytes of 'value' (usually only its casings)
+            ulong key = PrefixKey(value);
+            int start = PrefixIndex.LowerBound(key);
+            int end = PrefixIndex.UpperBound(key);
 
-            while (min <= max)
-            {
-                mid = (min + max) / 2;
-                valueHere = this[mid];
-
-                cmp = value.CompareTo(valueHere, IgnoreCase);
-                if (cmp == 0)
-                {
-                    // 'value' Found - look for bounds
-                    break;
-                }
-                else if (cmp > 0)
-                {
-                    // 'value' is later - look after valueHere
-                    min = mid + 1;
-                }
-                else
-                {
-                    // 'value' is earlier - look before valueHere
-                    max = mid - 1;
-                }
-            }
+            // Compare in full only within them; the values equal to 'value' are its few casings after the first
+            start = FindFirstNotBefore(value, start, end);
+            int afterLast = start;
+            while (afterLast < end && value.CompareTo(this[afterLast], IgnoreCase) == 0) afterLast++;
 
-            // If no match, set both bounds to insertion position
-            if (cmp > 0)
-            {
-                // If 'value' was after last comparison, we'd insert after it
-                matches = new Range(mid + 1);
-                return false;
-            }
-            else if (cmp < 0)
+            // If no match, return the insertion position
+            if (afterLast == start)
             {
-                // If 'value' was before last comparison, we'd insert before it
-                matches = new Range(mid);
+                matches = new Range(start);
                 return false;
             }
 
-            matches = RangeForString(mid);
+            matches = new Range(start, afterLast - 1);
             return true;
         }
 
@@ -135,43 +110,113 @@ namespace Microsoft.CodeAnalysis.Elfie.Model.Strings
                 return false;
             }
 
-            // Find the index of the prefix (or the first value after where it would be inserted)
-            TryFindString(prefix, out matches);
+            // Values starting with 'prefix' have keys from the prefix key to the prefix key with the bytes after the prefix all set
+            ulong key = PrefixKey(prefix);
+            ulong lastKey = (prefix.Length >= PrefixKeyLength ? key : key | (ulong.MaxValue >> (8 * prefix.Length)));
+            int start = PrefixIndex.LowerBound(key);
+            int end = PrefixIndex.UpperBound(lastKey);
 
-            // Binary search sorted strings for the last value containing the prefix
-            int min = matches.End;
-            int max = _sortedExistingValues.Count - 1;
-            int cmp = 0;
-            int lastMatch = 0;
-            String8 valueHere = String8.Empty;
+            // Shorter prefixes are matched exactly by the keys. Longer ones (or ones containing NUL, which pads keys) are compared in full within the range.
+            if (prefix.Length >= PrefixKeyLength || prefix.IndexOf((byte)0) != -1)
+            {
+                start = FindFirstNotBefore(prefix, start, end);
+                end = FindFirstNotStartingWith(prefix, start, end);
+            }
 
-            while (min <= max)
+            // If we found at least one value with the prefix, we were successful
+            matches = new Range(start, end - 1);
+            return end > start;
+        }
+
+        private int FindFirstNotBefore(String8 value, int min, int max)
+        {
+            // Binary search [min, max) for the first value equal to or after 'value'
+            while (min < max)
             {
                 int mid = (min + max) / 2;
-                valueHere = this[mid];
-
-                cmp = prefix.CompareAsPrefixTo(valueHere, IgnoreCase);
-                if (cmp == 0)
+                if (value.CompareTo(this[mid], IgnoreCase) > 0)
                 {
-                    // 'prefix' is a prefix - keep looking for last instance
-                    lastMatch = mid;
                     min = mid + 1;
                 }
-                else if (cmp > 0)
+                else
+                {
+                    max = mid;
+                }
+            }
+
+            return min;
+        }
+
+        private int FindFirstNotStartingWith(String8 prefix, int min, int max)
+        {
+            // Binary search [min, max) for the first value after all values starting with 'prefix'
+            while (min < max)
+            {
+                int mid = (min + max) / 2;
+                if (prefix.CompareAsPrefixTo(this[mid], IgnoreCase) >= 0)
                 {
-                    // 'prefix' is later - look after valueHere
                     min = mid + 1;
                 }
                 else
                 {
-                    // 'prefix' is earlier - look before valueHere
-                    max = mid - 1;
+                    max = mid;
                 }
             }
 
-            // If we found at least one value with the prefix, we were successful
-            matches = new Range(matches.Start, lastMatch);
-            return lastMatch != 0;
+            return min;
+        }
+        #endregion
+
+        #region Prefix Index
+        /// <summary>
+        ///  Search index on the first eight bytes of each value, built on first use.
+        ///  Searches find the range of values with the same first eight bytes in
+        ///  a few cache lines and only compare full values within that range.
+        /// </summary>
+        private SortedKeyIndex PrefixIndex
+        {
+            get
+            {
+                SortedKeyIndex index = _prefixIndex;
+                if (index == null)
+                {
+                    ulong[] keys = new ulong[_sortedExistingValues.Count];
+                    for (int i = 0; i < keys.Length; ++i)
+                    {
+                        keys[i] = PrefixKey(_sortedExistingValues[i]);
+                    }
+
+                    index = new SortedKeyIndex(keys);
+                    _prefixIndex = index;
+                }
+
+                return index;
+            }
+        }
+
+        /// <summary>
+        ///  Pack the first eight bytes of a value, uppercased as CompareTo does when
+        ///  ignoring case, high byte first and zero padded, so that keys are in the
+        ///  same order as the values.
+        /// </summary>
+        private static ulong PrefixKey(String8 value)
+        {
+            ulong key = 0;
+            int length = Math.Min(value.Length, PrefixKeyLength);
+
+            for (int i = 0; i < PrefixKeyLength; ++i)
+            {
+                byte c = 0;
+                if (i < length)
+                {
+                    c = value[i];
+                    if ((byte)(c - UTF8.a) < UTF8.AlphabetLength) c -= UTF8.ToUpperSubtract;
+                }
+
+                key = (key << 8) | c;
+            }
+
+            return key;
         }
         #endregion
 
@@ -197,6 +242,7 @@ namespace Microsoft.CodeAnalysis.Elfie.Model.Strings
         public void ReadBinary(BinaryReader r)
         {
             _sortedExistingValues.ReadBinary(r);
+            _prefixIndex = null;
         }
         #endregion
 
@@ -0,0 +1,121 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+namespace Microsoft.CodeAnalysis.Elfie.Model.Structures
+{
+    /// <summary>
+    ///  SortedKeyIndex finds positions in a sorted array of ulong keys in a few cache lines.
+    ///  The keys are kept in blocks of sixteen (two cache lines), and the first key of each
+    ///  block is copied into breadth-first (Eytzinger) tree order. The top of the tree is
+    ///  shared by every search and stays cached; a search walks the tree to one block and
+    ///  counts the keys before the target within it.
+    /// </summary>
+    internal class SortedKeyIndex
+    {
+        private const int BlockLengthShift = 4;
+        private const int BlockLength = 1 << BlockLengthShift;
+
+        private ulong[] _keys;
+
+        // First key of each block in tree order from index one; the children of k are 2k and 2k + 1
+        private ulong[] _blockFirstKeys;
+
+        // Block number of each tree node
+        private int[] _blockIndices;
+
+        public int Count
+        {
+            get { return _keys.Length; }
+        }
+
+        public SortedKeyIndex(ulong[] sortedKeys)
+        {
+            if (sortedKeys == null) throw new ArgumentNullException("sortedKeys");
+            _keys = sortedKeys;
+
+            int blockCount = (_keys.Length + BlockLength - 1) >> BlockLengthShift;
+            _blockFirstKeys = new ulong[blockCount + 1];
+            _blockIndices = new int[blockCount + 1];
+
+            Fill(0, 1);
+        }
+
+        private int Fill(int blockIndex, int treeIndex)
+        {
+            // Walk the tree in order, so each node gets the next block
+            if (treeIndex < _blockFirstKeys.Length)
+            {
+                blockIndex = Fill(blockIndex, 2 * treeIndex);
+
+                _blockFirstKeys[treeIndex] = _keys[blockIndex << BlockLengthShift];
+                _blockIndices[treeIndex] = blockIndex;
+                blockIndex++;
+
+                blockIndex = Fill(blockIndex, 2 * treeIndex + 1);
+            }
+
+            return blockIndex;
+        }
+
+        /// <summary>
+        ///  Return the sorted index of the first key greater than or equal to key,
+        ///  or Count if all keys are less than key.
+        /// </summary>
+        public int LowerBound(ulong key)
+        {
+            // Find the last block starting before key; the first key not before it is in that block or starts the next one
+            int k = 1;
+            while (k < _blockFirstKeys.Length)
+            {
+                k = 2 * k + (_blockFirstKeys[k] < key ? 1 : 0);
+            }
+
+            int start = LastRightTurnBlock(k) << BlockLengthShift;
+            int end = Math.Min(start + BlockLength, _keys.Length);
+
+            int result = start;
+            for (int i = start; i < end; ++i)
+            {
+                result += (_keys[i] < key ? 1 : 0);
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        ///  Return the sorted index of the first key greater than key, or Count if
+        ///  all keys are less than or equal to key.
+        /// </summary>
+        public int UpperBound(ulong key)
+        {
+            int k = 1;
+            while (k < _blockFirstKeys.Length)
+            {
+                k = 2 * k + (_blockFirstKeys[k] <= key ? 1 : 0);
+            }
+
+            int start = LastRightTurnBlock(k) << BlockLengthShift;
+            int end = Math.Min(start + BlockLength, _keys.Length);
+
+            int result = start;
+            for (int i = start; i < end; ++i)
+            {
+                result += (_keys[i] <= key ? 1 : 0);
+            }
+
+            return result;
+        }
+
+        private int LastRightTurnBlock(int k)
+        {
+            // The search ended after the last right turn (a 1 bit) and some left turns (0 bits);
+            // the node where it last went right is the last block passed. No right turns means block zero.
+            while ((k & 1) == 0) k >>= 1;
+            k >>= 1;
+
+            return (k == 0 ? 0 : _blockIndices[k]);
+        }
+    }
+}
@@ -26,6 +26,7 @@ namespace XForm.Types.Comparers
     internal class LongComparer : IXArrayComparer, IXArrayComparer<long>
     {
         internal static ComparerExtensions.WhereSingle<long> s_WhereSingleNative = null;
+        internal static ComparerExtensions.WhereSingleNullable<long> s_WhereSingleNullableNative = null;
         internal static ComparerExtensions.Where<long> s_WhereNative = null;
 
         public void GetHashCodes(XArray xarray, int[] hashes)
@@ -92,7 +93,14 @@ namespace XForm.Types.Comparers
                 int zeroOffset = left.Selector.StartIndexInclusive;
                 long rightValue = rightArray[0];
 
-                if (s_WhereSingleNative != null)
+                if (s_WhereSingleNullableNative != null)
+                {
+                    // Compare and remove left nulls in the same pass
+                    s_WhereSingleNullableNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.Equal, rightValue, left.NullRows, left.Selector.StartIndexInclusive, (byte)BooleanOperator.Or, vector.Array, 0);
+                    BoolComparer.AndNotNull(right, vector);
+                    return;
+                }
+                else if (s_WhereSingleNative != null)
                 {
                     s_WhereSingleNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.Equal, rightValue, (byte)BooleanOperator.Or, vector.Array, 0);
                 }
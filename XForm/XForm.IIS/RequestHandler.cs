@@ -29,6 +29,10 @@ public class RequestHandler : IHttpHandler
         db.StreamProvider = new StreamProviderCache(new LocalFileStreamProvider(productionFolderPath));
         db.Runner = new WorkflowRunner(db);
 
+        // Read ahead binary columns, if configured. Query timeouts cancel reads through each table reader's Next.
+        bool readAhead;
+        if (bool.TryParse(ConfigurationManager.AppSettings["XFormReadAhead"], out readAhead) && readAhead) db.StreamProvider = new ReadAheadStreamProvider(db.StreamProvider);
+
         // Build and save an HttpService instance to run queries
         s_httpService = new HttpService(db);
     }
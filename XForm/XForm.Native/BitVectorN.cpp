@@ -5,6 +5,7 @@
 #include <intrin.h>
 #include <nmmintrin.h>
 #include "BitVectorN.h"
+#include "KernelCountersN.h"
 
 #pragma unmanaged
 int CountN(unsigned __int64* matchVector, int length)
@@ -29,6 +30,44 @@ int CountN(unsigned __int64* matchVector, int length)
 	return (int)(count);
 }
 
+// For each byte of a match block, the positions of its set bits packed one per byte (lowest first). Expanding one entry to eight
+// 32-bit lanes and adding the byte's base index compacts eight bits of the vector to row indices with one store.
+static const unsigned __int64 PageLanesN[256] =
+{
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL, 0x0000000000000100ULL, 0x0000000000000002ULL, 0x0000000000000200ULL, 0x0000000000000201ULL, 0x0000000000020100ULL,
+	0x0000000000000003ULL, 0x0000000000000300ULL, 0x0000000000000301ULL, 0x0000000000030100ULL, 0x0000000000000302ULL, 0x0000000000030200ULL, 0x0000000000030201ULL, 0x0000000003020100ULL,
+	0x0000000000000004ULL, 0x0000000000000400ULL, 0x0000000000000401ULL, 0x0000000000040100ULL, 0x0000000000000402ULL, 0x0000000000040200ULL, 0x0000000000040201ULL, 0x0000000004020100ULL,
+	0x0000000000000403ULL, 0x0000000000040300ULL, 0x0000000000040301ULL, 0x0000000004030100ULL, 0x0000000000040302ULL, 0x0000000004030200ULL, 0x0000000004030201ULL, 0x0000000403020100ULL,
+	0x0000000000000005ULL, 0x0000000000000500ULL, 0x0000000000000501ULL, 0x0000000000050100ULL, 0x0000000000000502ULL, 0x0000000000050200ULL, 0x0000000000050201ULL, 0x0000000005020100ULL,
+	0x0000000000000503ULL, 0x0000000000050300ULL, 0x0000000000050301ULL, 0x0000000005030100ULL, 0x0000000000050302ULL, 0x0000000005030200ULL, 0x0000000005030201ULL, 0x0000000503020100ULL,
+	0x0000000000000504ULL, 0x0000000000050400ULL, 0x0000000000050401ULL, 0x0000000005040100ULL, 0x0000000000050402ULL, 0x0000000005040200ULL, 0x0000000005040201ULL, 0x0000000504020100ULL,
+	0x0000000000050403ULL, 0x0000000005040300ULL, 0x0000000005040301ULL, 0x0000000504030100ULL, 0x0000000005040302ULL, 0x0000000504030200ULL, 0x0000000504030201ULL, 0x0000050403020100ULL,
+	0x0000000000000006ULL, 0x0000000000000600ULL, 0x0000000000000601ULL, 0x0000000000060100ULL, 0x0000000000000602ULL, 0x0000000000060200ULL, 0x0000000000060201ULL, 0x0000000006020100ULL,
+	0x0000000000000603ULL, 0x0000000000060300ULL, 0x0000000000060301ULL, 0x0000000006030100ULL, 0x0000000000060302ULL, 0x0000000006030200ULL, 0x0000000006030201ULL, 0x0000000603020100ULL,
+	0x0000000000000604ULL, 0x0000000000060400ULL, 0x0000000000060401ULL, 0x0000000006040100ULL, 0x0000000000060402ULL, 0x0000000006040200ULL, 0x0000000006040201ULL, 0x0000000604020100ULL,
+	0x0000000000060403ULL, 0x0000000006040300ULL, 0x0000000006040301ULL, 0x0000000604030100ULL, 0x0000000006040302ULL, 0x0000000604030200ULL, 0x0000000604030201ULL, 0x0000060403020100ULL,
+	0x0000000000000605ULL, 0x0000000000060500ULL, 0x0000000000060501ULL, 0x0000000006050100ULL, 0x0000000000060502ULL, 0x0000000006050200ULL, 0x0000000006050201ULL, 0x0000000605020100ULL,
+	0x0000000000060503ULL, 0x0000000006050300ULL, 0x0000000006050301ULL, 0x0000000605030100ULL, 0x0000000006050302ULL, 0x0000000605030200ULL, 0x0000000605030201ULL, 0x0000060503020100ULL,
+	0x0000000000060504ULL, 0x0000000006050400ULL, 0x0000000006050401ULL, 0x0000000605040100ULL, 0x0000000006050402ULL, 0x0000000605040200ULL, 0x0000000605040201ULL, 0x0000060504020100ULL,
+	0x0000000006050403ULL, 0x0000000605040300ULL, 0x0000000605040301ULL, 0x0000060504030100ULL, 0x0000000605040302ULL, 0x0000060504030200ULL, 0x0000060504030201ULL, 0x0006050403020100ULL,
+	0x0000000000000007ULL, 0x0000000000000700ULL, 0x0000000000000701ULL, 0x0000000000070100ULL, 0x0000000000000702ULL, 0x0000000000070200ULL, 0x0000000000070201ULL, 0x0000000007020100ULL,
+	0x0000000000000703ULL, 0x0000000000070300ULL, 0x0000000000070301ULL, 0x0000000007030100ULL, 0x0000000000070302ULL, 0x0000000007030200ULL, 0x0000000007030201ULL, 0x0000000703020100ULL,
+	0x0000000000000704ULL, 0x0000000000070400ULL, 0x0000000000070401ULL, 0x0000000007040100ULL, 0x0000000000070402ULL, 0x0000000007040200ULL, 0x0000000007040201ULL, 0x0000000704020100ULL,
+	0x0000000000070403ULL, 0x0000000007040300ULL, 0x0000000007040301ULL, 0x0000000704030100ULL, 0x0000000007040302ULL, 0x0000000704030200ULL, 0x0000000704030201ULL, 0x0000070403020100ULL,
+	0x0000000000000705ULL, 0x0000000000070500ULL, 0x0000000000070501ULL, 0x0000000007050100ULL, 0x0000000000070502ULL, 0x0000000007050200ULL, 0x0000000007050201ULL, 0x0000000705020100ULL,
+	0x0000000000070503ULL, 0x0000000007050300ULL, 0x0000000007050301ULL, 0x0000000705030100ULL, 0x0000000007050302ULL, 0x0000000705030200ULL, 0x0000000705030201ULL, 0x0000070503020100ULL,
+	0x0000000000070504ULL, 0x0000000007050400ULL, 0x0000000007050401ULL, 0x0000000705040100ULL, 0x0000000007050402ULL, 0x0000000705040200ULL, 0x0000000705040201ULL, 0x0000070504020100ULL,
+	0x0000000007050403ULL, 0x0000000705040300ULL, 0x0000000705040301ULL, 0x0000070504030100ULL, 0x0000000705040302ULL, 0x0000070504030200ULL, 0x0000070504030201ULL, 0x0007050403020100ULL,
+	0x0000000000000706ULL, 0x0000000000070600ULL, 0x0000000000070601ULL, 0x0000000007060100ULL, 0x0000000000070602ULL, 0x0000000007060200ULL, 0x0000000007060201ULL, 0x0000000706020100ULL,
+	0x0000000000070603ULL, 0x0000000007060300ULL, 0x0000000007060301ULL, 0x0000000706030100ULL, 0x0000000007060302ULL, 0x0000000706030200ULL, 0x0000000706030201ULL, 0x0000070603020100ULL,
+	0x0000000000070604ULL, 0x0000000007060400ULL, 0x0000000007060401ULL, 0x0000000706040100ULL, 0x0000000007060402ULL, 0x0000000706040200ULL, 0x0000000706040201ULL, 0x0000070604020100ULL,
+	0x0000000007060403ULL, 0x0000000706040300ULL, 0x0000000706040301ULL, 0x0000070604030100ULL, 0x0000000706040302ULL, 0x0000070604030200ULL, 0x0000070604030201ULL, 0x0007060403020100ULL,
+	0x0000000000070605ULL, 0x0000000007060500ULL, 0x0000000007060501ULL, 0x0000000706050100ULL, 0x0000000007060502ULL, 0x0000000706050200ULL, 0x0000000706050201ULL, 0x0000070605020100ULL,
+	0x0000000007060503ULL, 0x0000000706050300ULL, 0x0000000706050301ULL, 0x0000070605030100ULL, 0x0000000706050302ULL, 0x0000070605030200ULL, 0x0000070605030201ULL, 0x0007060503020100ULL,
+	0x0000000007060504ULL, 0x0000000706050400ULL, 0x0000000706050401ULL, 0x0000070605040100ULL, 0x0000000706050402ULL, 0x0000070605040200ULL, 0x0000070605040201ULL, 0x0007060504020100ULL,
+	0x0000000706050403ULL, 0x0000070605040300ULL, 0x0000070605040301ULL, 0x0007060504030100ULL, 0x0000070605040302ULL, 0x0007060504030200ULL, 0x0007060504030201ULL, 0x0706050403020100ULL,
+};
+
 unsigned int __inline ctz(unsigned __int64 value)
 {
 	unsigned long trailingZero = 0;
@@ -47,6 +86,13 @@ int PageN(unsigned __int64* matchVector, int length, int* start, int* result, in
 	int end = length << 6;
 	int matchWithinBlock = *start & 63;
 
+	// If the previous page ended on the last bit, there's nothing left to scan
+	if (base >= end)
+	{
+		*start = -1;
+		return 0;
+	}
+
 	// Get the first block
 	unsigned __int64 block = matchVector[base >> 6];
 
@@ -56,6 +102,24 @@ int PageN(unsigned __int64* matchVector, int length, int* start, int* result, in
 	// Look for matches in each block
 	while (resultNext < resultEnd)
 	{
+		// Compact dense blocks eight bits at a time; each store writes eight lanes, so there must be room for a whole block
+		if (resultEnd - resultNext >= 64 && _mm_popcnt_u64(block) >= 16)
+		{
+			__m256i byteBase = _mm256_set1_epi32(base);
+			for (int shift = 0; shift < 64; shift += 8)
+			{
+				unsigned int bits = (unsigned int)(block >> shift) & 0xFF;
+				__m256i lanes = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((__int64)PageLanesN[bits]));
+				_mm256_storeu_si256((__m256i*)resultNext, _mm256_add_epi32(lanes, byteBase));
+				resultNext += _mm_popcnt_u32(bits);
+				byteBase = _mm256_add_epi32(byteBase, _mm256_set1_epi32(8));
+			}
+
+			// Every match in the block was written
+			matchWithinBlock = 63;
+			block = 0;
+		}
+
 		while (block != 0 && resultNext != resultEnd)
 		{
 			// The index of the next match is the same as the number of trailing zero bits
@@ -92,7 +156,11 @@ namespace XForm
 		Int32 BitVectorN::Count(array<UInt64>^ vector)
 		{
 			pin_ptr<UInt64> pVector = &vector[0];
-			return CountN(pVector, vector->Length);
+			KernelScopeN scope(KernelN::Count, 64 * (__int64)vector->Length, 8 * (__int64)vector->Length);
+
+			int count = CountN(pVector, vector->Length);
+			scope.Matched(count);
+			return count;
 		}
 
 		Int32 BitVectorN::Page(array<UInt64>^ vector, array<Int32>^ indicesFound, Int32% fromIndex, Int32 countLimit)
@@ -102,9 +170,15 @@ namespace XForm
 			if (countLimit > indicesFound->Length) throw gcnew ArgumentOutOfRangeException("countLimit");
 
 			int nextIndex = fromIndex;
-			int countFound = PageN(pVector, vector->Length, &nextIndex, pIndices, countLimit);
+			int countFound;
+			{
+				KernelScopeN scope(KernelN::Page, 64 * (__int64)vector->Length - fromIndex, 8 * (__int64)vector->Length - fromIndex / 8);
+				countFound = PageN(pVector, vector->Length, &nextIndex, pIndices, countLimit);
+				scope.Matched(countFound);
+			}
+
 			fromIndex = nextIndex;
-			return countFound;  
+			return countFound;
 		}
 	}
 }
@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <intrin.h>
+#include "BloomFilterN.h"
+#include "KernelCountersN.h"
+
+#pragma unmanaged
+
+// Split block Bloom filter: each value sets one bit in each of the eight 32-bit words of one 256-bit block.
+// A probe reads one block (within one cache line) and checks all eight bits with one AVX2 test.
+
+// WARNING: Must stay in sync with BloomFilter.Salts
+#define BLOOM_SALTS_N 0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d, 0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31
+
+// The top hash half picks the block (by multiply-shift, so any block count works); the bottom half picks the bits
+static __inline unsigned int BloomBlockN(unsigned __int64 hash, unsigned int blockCount)
+{
+	return (unsigned int)(((hash >> 32) * blockCount) >> 32);
+}
+
+static __inline __m256i BloomMaskN(unsigned __int64 hash, __m256i salts)
+{
+	__m256i bitIndices = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32((int)hash), salts), 27);
+	return _mm256_sllv_epi32(_mm256_set1_epi32(1), bitIndices);
+}
+
+void BloomFilterAddN(const unsigned __int64* hashes, int length, unsigned __int32* blocks, unsigned int blockCount)
+{
+	__m256i salts = _mm256_setr_epi32(BLOOM_SALTS_N);
+
+	for (int i = 0; i < length; ++i)
+	{
+		__m256i* block = (__m256i*)(&blocks[8 * BloomBlockN(hashes[i], blockCount)]);
+		_mm256_storeu_si256(block, _mm256_or_si256(_mm256_loadu_si256(block), BloomMaskN(hashes[i], salts)));
+	}
+}
+
+int BloomFilterContainsN(const unsigned __int64* hashes, int length, const unsigned __int32* blocks, unsigned int blockCount, unsigned __int64* vector)
+{
+	__m256i salts = _mm256_setr_epi32(BLOOM_SALTS_N);
+	int count = 0;
+
+	// Probe eight values per step, so the block loads are independent and overlap, and write the match bits a byte at a time
+	int i = 0;
+	int end = length & ~7;
+	for (; i < end; i += 8)
+	{
+		unsigned int matches = 0;
+		for (int j = 0; j < 8; ++j)
+		{
+			unsigned __int64 hash = hashes[i + j];
+			__m256i block = _mm256_loadu_si256((__m256i*)(&blocks[8 * BloomBlockN(hash, blockCount)]));
+			matches |= (unsigned int)_mm256_testc_si256(block, BloomMaskN(hash, salts)) << j;
+		}
+
+		((unsigned __int8*)vector)[i >> 3] = (unsigned __int8)matches;
+		count += (int)_mm_popcnt_u32(matches);
+	}
+
+	// Set the remaining bits one at a time, leaving bits past length in the last byte clear
+	if (i < length) ((unsigned __int8*)vector)[i >> 3] = 0;
+	for (; i < length; ++i)
+	{
+		__m256i block = _mm256_loadu_si256((__m256i*)(&blocks[8 * BloomBlockN(hashes[i], blockCount)]));
+		if (_mm256_testc_si256(block, BloomMaskN(hashes[i], salts)))
+		{
+			vector[i >> 6] |= (1ULL << (i & 63));
+			count++;
+		}
+	}
+
+	return count;
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		static void ValidateBloomArguments(array<UInt64>^ hashes, Int32 index, Int32 length, array<UInt32>^ blocks)
+		{
+			if (index < 0 || length < 0 || index + length > hashes->Length) throw gcnew IndexOutOfRangeException();
+			if (blocks->Length == 0 || (blocks->Length & 7) != 0) throw gcnew ArgumentException("blocks must be a non-empty multiple of eight long.", "blocks");
+		}
+
+		void BloomFilterN::Add(array<UInt64>^ hashes, Int32 index, Int32 length, array<UInt32>^ blocks)
+		{
+			ValidateBloomArguments(hashes, index, length, blocks);
+			if (length == 0) return;
+
+			pin_ptr<UInt64> pHashes = &hashes[index];
+			pin_ptr<UInt32> pBlocks = &blocks[0];
+			KernelScopeN scope(KernelN::BloomFilter, length, 8 * (__int64)length);
+
+			BloomFilterAddN((unsigned __int64*)pHashes, length, (unsigned __int32*)pBlocks, (unsigned int)(blocks->Length / 8));
+		}
+
+		Int32 BloomFilterN::Contains(array<UInt64>^ hashes, Int32 index, Int32 length, array<UInt32>^ blocks, array<UInt64>^ vector)
+		{
+			ValidateBloomArguments(hashes, index, length, blocks);
+			if (vector->Length < (length + 63) / 64) throw gcnew IndexOutOfRangeException();
+			if (length == 0) return 0;
+
+			pin_ptr<UInt64> pHashes = &hashes[index];
+			pin_ptr<UInt32> pBlocks = &blocks[0];
+			pin_ptr<UInt64> pVector = &vector[0];
+			KernelScopeN scope(KernelN::BloomFilter, length, 8 * (__int64)length, (unsigned __int64*)pVector, length);
+
+			return BloomFilterContainsN((unsigned __int64*)pHashes, length, (unsigned __int32*)pBlocks, (unsigned int)(blocks->Length / 8), (unsigned __int64*)pVector);
+		}
+	}
+}
@@ -0,0 +1,21 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+using namespace System;
+
+namespace XForm
+{
+	namespace Native
+	{
+		public ref class BloomFilterN
+		{
+		public:
+			// Add hashes[index, index + length) to the filter; blocks holds 256-bit blocks as eight UInt32s each.
+			static void Add(array<UInt64>^ hashes, Int32 index, Int32 length, array<UInt32>^ blocks);
+
+			// Set bit i in vector if hashes[index + i] may be in the filter, clearing it otherwise. Returns the count set.
+			static Int32 Contains(array<UInt64>^ hashes, Int32 index, Int32 length, array<UInt32>^ blocks, array<UInt64>^ vector);
+		};
+	}
+}
@@ -14,13 +14,26 @@ namespace XForm
 			// AVX2 accelerated where comparing [byte and short] (array to array) and (array to constant)
 			static void Where(array<Byte>^ left, Int32 index, Int32 length, Byte compareOperator, Byte right, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
 			static void Where(array<SByte>^ left, Int32 index, Int32 length, Byte compareOperator, SByte right, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
+			static void Where(array<Byte>^ left, Int32 leftIndex, Byte compareOperator, array<Byte>^ right, Int32 rightIndex, Int32 length, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
+			static void Where(array<SByte>^ left, Int32 leftIndex, Byte compareOperator, array<SByte>^ right, Int32 rightIndex, Int32 length, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
 			static void Where(array<Boolean>^ left, Int32 index, Int32 length, Byte cOp, Boolean right, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex);
 
+			// AVX2 accelerated where matching bytes in a 256-bit set of values (array IN set)
+			static void WhereIn(array<Byte>^ left, Int32 index, Int32 length, array<UInt64>^ valueSet, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
+
 			static void Where(array<UInt16>^ left, Int32 leftIndex, Int32 length, Byte compareOperator, UInt16 right, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
 			static void Where(array<UInt16>^ left, Int32 leftIndex, Byte compareOperator, array<UInt16>^ right, Int32 rightIndex, Int32 length, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
 			static void Where(array<Int16>^ left, Int32 leftIndex, Int32 length, Byte compareOperator, Int16 right, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
 			static void Where(array<Int16>^ left, Int32 leftIndex, Byte compareOperator, array<Int16>^ right, Int32 rightIndex, Int32 length, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
 
+			// AVX2 accelerated where comparing [32-bit and 64-bit] (array to constant), clearing rows marked in nulls (if not null) in the same pass
+			static void Where(array<Int32>^ left, Int32 index, Int32 length, Byte compareOperator, Int32 right, array<Boolean>^ nulls, Int32 nullsIndex, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
+			static void Where(array<UInt32>^ left, Int32 index, Int32 length, Byte compareOperator, UInt32 right, array<Boolean>^ nulls, Int32 nullsIndex, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
+			static void Where(array<Int64>^ left, Int32 index, Int32 length, Byte compareOperator, Int64 right, array<Boolean>^ nulls, Int32 nullsIndex, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
+			static void Where(array<UInt64>^ left, Int32 index, Int32 length, Byte compareOperator, UInt64 right, array<Boolean>^ nulls, Int32 nullsIndex, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
+			static void Where(array<Single>^ left, Int32 index, Int32 length, Byte compareOperator, Single right, array<Boolean>^ nulls, Int32 nullsIndex, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
+			static void Where(array<Double>^ left, Int32 index, Int32 length, Byte compareOperator, Double right, array<Boolean>^ nulls, Int32 nullsIndex, Byte booleanOperator, array<UInt64>^ vector, Int32 vectorIndex);
+
 			// Compare values to a constant [non-vector]
 			template<typename T>
 			static void WhereSingle(T* set, int length, Byte compareOperator, T value, Byte booleanOperator, unsigned __int64* matchVector);
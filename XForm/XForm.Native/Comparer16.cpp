@@ -7,6 +7,8 @@
 #include "Operator.h"
 #include "ComparerSingle.cpp"
 #include "Comparer.h"
+#include "ComparerN.h"
+#include "KernelCountersN.h"
 
 #pragma unmanaged
 
@@ -259,6 +261,11 @@ static void WhereN(CompareOperatorN cOp, BooleanOperatorN bOp, SigningN sign, un
 	}
 }
 
+void Where16N(CompareOperatorN cOp, BooleanOperatorN bOp, SigningN sign, unsigned __int16* set, int length, unsigned __int16 value, unsigned __int64* matchVector)
+{
+	WhereN(cOp, bOp, sign, set, length, value, matchVector);
+}
+
 #pragma managed
 
 namespace XForm
@@ -274,6 +281,7 @@ namespace XForm
 
 			pin_ptr<UInt16> pLeft = &left[index];
 			pin_ptr<UInt64> pVector = &vector[vectorIndex >> 6];
+			KernelScopeN scope(KernelN::Where, length, 2 * (__int64)length, pVector, length);
 
 			WhereN((CompareOperatorN)cOp, (BooleanOperatorN)bOp, SigningN::Unsigned, pLeft, length, right, pVector);
 		}
@@ -289,6 +297,7 @@ namespace XForm
 			pin_ptr<UInt16> pLeft = &left[leftIndex];
 			pin_ptr<UInt16> pRight = &right[rightIndex];
 			pin_ptr<UInt64> pVector = &vector[vectorIndex >> 6];
+			KernelScopeN scope(KernelN::Where, length, 4 * (__int64)length, pVector, length);
 
 			WhereN((CompareOperatorN)cOp, (BooleanOperatorN)bOp, SigningN::Unsigned, pLeft, length, pRight, pVector);
 		}
@@ -302,6 +311,7 @@ namespace XForm
 
 			pin_ptr<Int16> pLeft = &left[index];
 			pin_ptr<UInt64> pVector = &vector[vectorIndex >> 6];
+			KernelScopeN scope(KernelN::Where, length, 2 * (__int64)length, pVector, length);
 
 			WhereN((CompareOperatorN)cOp, (BooleanOperatorN)bOp, SigningN::Signed, (unsigned __int16*)pLeft, length, (unsigned __int16)right, pVector);
 		}
@@ -317,6 +327,7 @@ namespace XForm
 			pin_ptr<Int16> pLeft = &left[leftIndex];
 			pin_ptr<Int16> pRight = &right[rightIndex];
 			pin_ptr<UInt64> pVector = &vector[vectorIndex >> 6];
+			KernelScopeN scope(KernelN::Where, length, 4 * (__int64)length, pVector, length);
 
 			WhereN((CompareOperatorN)cOp, (BooleanOperatorN)bOp, SigningN::Signed, (unsigned __int16*)pLeft, length, (unsigned __int16*)pRight, pVector);
 		}
@@ -7,6 +7,8 @@
 #include "Operator.h"
 #include "ComparerSingle.cpp"
 #include "Comparer.h"
+#include "ComparerN.h"
+#include "KernelCountersN.h"
 
 #pragma unmanaged
 
@@ -96,6 +98,224 @@ static void WhereN(unsigned __int8* set, int length, unsigned __int8 value, Bool
 	}
 }
 
+template<CompareOperatorN cOp, SigningN sign>
+static void WhereN(unsigned __int8* left, int length, unsigned __int8* right, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	int i = 0;
+	unsigned __int64 result;
+
+	// Load a mask to convert unsigned values for signed comparison
+	__m256i unsignedToSigned = _mm256_set1_epi8(-128);
+
+	// Compare 64-byte blocks and generate a 64-bit result while there's enough data
+	int blockLength = length & ~63;
+	for (; i < blockLength; i += 64)
+	{
+		// Load 64 bytes from each side to compare
+		__m256i left1 = _mm256_loadu_si256((__m256i*)(&left[i]));
+		__m256i left2 = _mm256_loadu_si256((__m256i*)(&left[i + 32]));
+		__m256i right1 = _mm256_loadu_si256((__m256i*)(&right[i]));
+		__m256i right2 = _mm256_loadu_si256((__m256i*)(&right[i + 32]));
+
+		// Convert them to signed form, if needed
+		if (sign == SigningN::Unsigned)
+		{
+			left1 = _mm256_sub_epi8(left1, unsignedToSigned);
+			left2 = _mm256_sub_epi8(left2, unsignedToSigned);
+			right1 = _mm256_sub_epi8(right1, unsignedToSigned);
+			right2 = _mm256_sub_epi8(right2, unsignedToSigned);
+		}
+
+		// Compare them, building a mask with 0xFF for matches and 0x00 for non-matches
+		__m256i matchMask1;
+		__m256i matchMask2;
+
+		switch (cOp)
+		{
+		case CompareOperatorN::GreaterThan:
+		case CompareOperatorN::LessThanOrEqual:
+			matchMask1 = _mm256_cmpgt_epi8(left1, right1);
+			matchMask2 = _mm256_cmpgt_epi8(left2, right2);
+			break;
+		case CompareOperatorN::LessThan:
+		case CompareOperatorN::GreaterThanOrEqual:
+			matchMask1 = _mm256_cmpgt_epi8(right1, left1);
+			matchMask2 = _mm256_cmpgt_epi8(right2, left2);
+			break;
+		case CompareOperatorN::Equal:
+		case CompareOperatorN::NotEqual:
+			matchMask1 = _mm256_cmpeq_epi8(left1, right1);
+			matchMask2 = _mm256_cmpeq_epi8(left2, right2);
+			break;
+		}
+
+		// Convert the masks into bits (one bit per byte) and merge them to get 64 bits for whether 64 rows matched
+		unsigned int matchBits1 = _mm256_movemask_epi8(matchMask1);
+		unsigned int matchBits2 = _mm256_movemask_epi8(matchMask2);
+		result = ((unsigned __int64)matchBits2) << 32 | matchBits1;
+
+		// Negate the result for operators we ran the opposites of
+		if (cOp == CompareOperatorN::LessThanOrEqual || cOp == CompareOperatorN::GreaterThanOrEqual || cOp == CompareOperatorN::NotEqual)
+		{
+			result = ~result;
+		}
+
+		// Merge the result with the existing bit vector bits based on the boolean operator requested
+		switch (bOp)
+		{
+		case BooleanOperatorN::And:
+			matchVector[i >> 6] &= result;
+			break;
+		case BooleanOperatorN::Or:
+			matchVector[i >> 6] |= result;
+			break;
+		}
+	}
+
+	// Match remaining values individually
+	if (length & 63)
+	{
+		if (sign == SigningN::Unsigned)
+			WhereSingle<cOp, unsigned __int8>(&left[i], length - i, &right[i], bOp, &matchVector[i >> 6]);
+		else
+			WhereSingle<cOp, __int8>((__int8*)&left[i], length - i, (__int8*)&right[i], bOp, &matchVector[i >> 6]);
+	}
+}
+
+template<SigningN sign>
+static void WhereN(CompareOperatorN cOp, unsigned __int8* left, int length, unsigned __int8* right, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	switch (cOp)
+	{
+	case CompareOperatorN::Equal:
+		WhereN<CompareOperatorN::Equal, sign>(left, length, right, bOp, matchVector);
+		break;
+	case CompareOperatorN::NotEqual:
+		WhereN<CompareOperatorN::NotEqual, sign>(left, length, right, bOp, matchVector);
+		break;
+	case CompareOperatorN::LessThan:
+		WhereN<CompareOperatorN::LessThan, sign>(left, length, right, bOp, matchVector);
+		break;
+	case CompareOperatorN::LessThanOrEqual:
+		WhereN<CompareOperatorN::LessThanOrEqual, sign>(left, length, right, bOp, matchVector);
+		break;
+	case CompareOperatorN::GreaterThan:
+		WhereN<CompareOperatorN::GreaterThan, sign>(left, length, right, bOp, matchVector);
+		break;
+	case CompareOperatorN::GreaterThanOrEqual:
+		WhereN<CompareOperatorN::GreaterThanOrEqual, sign>(left, length, right, bOp, matchVector);
+		break;
+	}
+}
+
+template<SigningN sign>
+static void WhereN(CompareOperatorN cOp, unsigned __int8* set, int length, unsigned __int8 value, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	switch (cOp)
+	{
+	case CompareOperatorN::Equal:
+		WhereN<CompareOperatorN::Equal, sign>(set, length, value, bOp, matchVector);
+		break;
+	case CompareOperatorN::NotEqual:
+		WhereN<CompareOperatorN::NotEqual, sign>(set, length, value, bOp, matchVector);
+		break;
+	case CompareOperatorN::LessThan:
+		WhereN<CompareOperatorN::LessThan, sign>(set, length, value, bOp, matchVector);
+		break;
+	case CompareOperatorN::LessThanOrEqual:
+		WhereN<CompareOperatorN::LessThanOrEqual, sign>(set, length, value, bOp, matchVector);
+		break;
+	case CompareOperatorN::GreaterThan:
+		WhereN<CompareOperatorN::GreaterThan, sign>(set, length, value, bOp, matchVector);
+		break;
+	case CompareOperatorN::GreaterThanOrEqual:
+		WhereN<CompareOperatorN::GreaterThanOrEqual, sign>(set, length, value, bOp, matchVector);
+		break;
+	}
+}
+
+void Where8N(CompareOperatorN cOp, SigningN sign, unsigned __int8* set, int length, unsigned __int8 value, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	if (sign == SigningN::Unsigned)
+		WhereN<SigningN::Unsigned>(cOp, set, length, value, bOp, matchVector);
+	else
+		WhereN<SigningN::Signed>(cOp, set, length, value, bOp, matchVector);
+}
+
+// Match values whose bit is set in the 256-bit valueSet (an IN list of byte values, like Enum column indices)
+static void WhereInN(unsigned __int8* set, int length, const unsigned __int64* valueSet, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	// Build tables indexed by the low nibble with a bit for each high nibble present (0-7 and 8-15)
+	__declspec(align(32)) unsigned __int8 lowHalf[32] = { 0 };
+	__declspec(align(32)) unsigned __int8 highHalf[32] = { 0 };
+	for (int value = 0; value < 256; ++value)
+	{
+		if ((valueSet[value >> 6] & (0x1ULL << (value & 63))) == 0) continue;
+
+		unsigned __int8* table = ((value >> 4) < 8 ? lowHalf : highHalf);
+		table[value & 15] |= (unsigned __int8)(1 << ((value >> 4) & 7));
+		table[16 + (value & 15)] |= (unsigned __int8)(1 << ((value >> 4) & 7));
+	}
+
+	// Shuffles look up within each 128-bit lane, so each table is repeated in both lanes
+	__m256i lowTable = _mm256_load_si256((__m256i*)lowHalf);
+	__m256i highTable = _mm256_load_si256((__m256i*)highHalf);
+	__m256i bitForHighNibble = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+	__m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+	int i = 0;
+	int blockLength = length & ~63;
+	for (; i < blockLength; i += 64)
+	{
+		unsigned __int64 result = 0;
+
+		for (int half = 0; half < 2; ++half)
+		{
+			__m256i block = _mm256_loadu_si256((__m256i*)(&set[i + 32 * half]));
+			__m256i lowNibble = _mm256_and_si256(block, nibbleMask);
+			__m256i highNibble = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibbleMask);
+
+			// Get the table byte for the low nibble (from the high table when the value's top bit is set) and the bit for the high nibble
+			__m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(lowTable, lowNibble), _mm256_shuffle_epi8(highTable, lowNibble), block);
+			__m256i bit = _mm256_shuffle_epi8(bitForHighNibble, highNibble);
+
+			// Values match if the bit is set in the row
+			__m256i matchMask = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+			result |= ((unsigned __int64)(unsigned int)_mm256_movemask_epi8(matchMask)) << (32 * half);
+		}
+
+		switch (bOp)
+		{
+		case BooleanOperatorN::And:
+			matchVector[i >> 6] &= result;
+			break;
+		case BooleanOperatorN::Or:
+			matchVector[i >> 6] |= result;
+			break;
+		}
+	}
+
+	// Match remaining values individually
+	if (i < length)
+	{
+		unsigned __int64 result = 0;
+		for (int j = i; j < length; ++j)
+		{
+			if (valueSet[set[j] >> 6] & (0x1ULL << (set[j] & 63))) result |= (0x1ULL << (j & 63));
+		}
+
+		switch (bOp)
+		{
+		case BooleanOperatorN::And:
+			matchVector[i >> 6] &= result;
+			break;
+		case BooleanOperatorN::Or:
+			matchVector[i >> 6] |= result;
+			break;
+		}
+	}
+}
+
 #pragma managed
 
 namespace XForm
@@ -111,6 +331,7 @@ namespace XForm
 
 			pin_ptr<Byte> pLeft = &left[index];
 			pin_ptr<UInt64> pVector = &vector[vectorIndex >> 6];
+			KernelScopeN scope(KernelN::Where, length, length, pVector, length);
 
 			switch ((CompareOperatorN)cOp)
 			{
@@ -137,6 +358,23 @@ namespace XForm
 			}
 		}
 
+		void Comparer::WhereIn(array<Byte>^ left, Int32 index, Int32 length, array<UInt64>^ valueSet, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
+		{
+			if (index < 0 || length < 0 || vectorIndex < 0) throw gcnew IndexOutOfRangeException();
+			if (index + length > left->Length) throw gcnew IndexOutOfRangeException();
+			if (vectorIndex + length > (vector->Length * 64)) throw gcnew IndexOutOfRangeException();
+			if ((vectorIndex & 63) != 0) throw gcnew ArgumentException("Offset Where must run on a multiple of 64 offset.");
+			if (valueSet->Length != 4) throw gcnew ArgumentException("valueSet must have 256 bits.");
+			if (length == 0) return;
+
+			pin_ptr<Byte> pLeft = &left[index];
+			pin_ptr<UInt64> pValueSet = &valueSet[0];
+			pin_ptr<UInt64> pVector = &vector[vectorIndex >> 6];
+			KernelScopeN scope(KernelN::Where, length, length, pVector, length);
+
+			WhereInN(pLeft, length, pValueSet, (BooleanOperatorN)bOp, pVector);
+		}
+
 		void Comparer::Where(array<SByte>^ left, Int32 index, Int32 length, Byte cOp, SByte right, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
 		{
 			if (index < 0 || length < 0 || vectorIndex < 0) throw gcnew IndexOutOfRangeException();
@@ -146,6 +384,7 @@ namespace XForm
 
 			pin_ptr<SByte> pLeft = &left[index];
 			pin_ptr<UInt64> pVector = &vector[vectorIndex >> 6];
+			KernelScopeN scope(KernelN::Where, length, length, pVector, length);
 
 			switch ((CompareOperatorN)cOp)
 			{
@@ -172,6 +411,42 @@ namespace XForm
 			}
 		}
 
+		void Comparer::Where(array<Byte>^ left, Int32 leftIndex, Byte cOp, array<Byte>^ right, Int32 rightIndex, Int32 length, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
+		{
+			if (leftIndex < 0 || rightIndex < 0 || length < 0 || vectorIndex < 0) throw gcnew IndexOutOfRangeException();
+			if (leftIndex + length > left->Length) throw gcnew IndexOutOfRangeException("left");
+			if (rightIndex + length > right->Length) throw gcnew IndexOutOfRangeException("right");
+			if (vectorIndex + length > (vector->Length * 64)) throw gcnew IndexOutOfRangeException("vector");
+			if ((vectorIndex & 63) != 0) throw gcnew ArgumentException("Offset Where must run on a multiple of 64 offset.");
+			if (cOp > (Byte)CompareOperatorN::GreaterThanOrEqual) throw gcnew ArgumentException("cOp");
+			if (length == 0) return;
+
+			pin_ptr<Byte> pLeft = &left[leftIndex];
+			pin_ptr<Byte> pRight = &right[rightIndex];
+			pin_ptr<UInt64> pVector = &vector[vectorIndex >> 6];
+			KernelScopeN scope(KernelN::Where, length, 2 * (__int64)length, pVector, length);
+
+			WhereN<SigningN::Unsigned>((CompareOperatorN)cOp, pLeft, length, pRight, (BooleanOperatorN)bOp, pVector);
+		}
+
+		void Comparer::Where(array<SByte>^ left, Int32 leftIndex, Byte cOp, array<SByte>^ right, Int32 rightIndex, Int32 length, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
+		{
+			if (leftIndex < 0 || rightIndex < 0 || length < 0 || vectorIndex < 0) throw gcnew IndexOutOfRangeException();
+			if (leftIndex + length > left->Length) throw gcnew IndexOutOfRangeException("left");
+			if (rightIndex + length > right->Length) throw gcnew IndexOutOfRangeException("right");
+			if (vectorIndex + length > (vector->Length * 64)) throw gcnew IndexOutOfRangeException("vector");
+			if ((vectorIndex & 63) != 0) throw gcnew ArgumentException("Offset Where must run on a multiple of 64 offset.");
+			if (cOp > (Byte)CompareOperatorN::GreaterThanOrEqual) throw gcnew ArgumentException("cOp");
+			if (length == 0) return;
+
+			pin_ptr<SByte> pLeft = &left[leftIndex];
+			pin_ptr<SByte> pRight = &right[rightIndex];
+			pin_ptr<UInt64> pVector = &vector[vectorIndex >> 6];
+			KernelScopeN scope(KernelN::Where, length, 2 * (__int64)length, pVector, length);
+
+			WhereN<SigningN::Signed>((CompareOperatorN)cOp, (unsigned __int8*)pLeft, length, (unsigned __int8*)pRight, (BooleanOperatorN)bOp, pVector);
+		}
+
 		void Comparer::Where(array<Boolean>^ left, Int32 index, Int32 length, Byte cOp, Boolean right, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
 		{
 			if (index < 0 || length < 0 || vectorIndex < 0) throw gcnew IndexOutOfRangeException();
@@ -181,6 +456,7 @@ namespace XForm
 
 			pin_ptr<Boolean> pLeft = &left[index];
 			pin_ptr<UInt64> pVector = &vector[vectorIndex >> 6];
+			KernelScopeN scope(KernelN::Where, length, length, pVector, length);
 
 			switch ((CompareOperatorN)cOp)
 			{
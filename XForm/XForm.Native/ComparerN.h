@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "Operator.h"
+
+// Unmanaged Where kernels shared by the Comparer wrappers and PredicateN.
+// Each compares length values to a constant and merges the matches into matchVector with bOp.
+
+// In Comparer8.cpp
+void Where8N(CompareOperatorN cOp, SigningN sign, unsigned __int8* set, int length, unsigned __int8 value, BooleanOperatorN bOp, unsigned __int64* matchVector);
+
+// In Comparer16.cpp
+void Where16N(CompareOperatorN cOp, BooleanOperatorN bOp, SigningN sign, unsigned __int16* set, int length, unsigned __int16 value, unsigned __int64* matchVector);
+
+// In ComparerWide.cpp; rows with a non-zero byte in nulls (if not null) never match
+void WhereWideN(CompareOperatorN cOp, const __int32* set, int length, __int32 value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector);
+void WhereWideN(CompareOperatorN cOp, const unsigned __int32* set, int length, unsigned __int32 value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector);
+void WhereWideN(CompareOperatorN cOp, const __int64* set, int length, __int64 value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector);
+void WhereWideN(CompareOperatorN cOp, const unsigned __int64* set, int length, unsigned __int64 value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector);
+void WhereWideN(CompareOperatorN cOp, const float* set, int length, float value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector);
+void WhereWideN(CompareOperatorN cOp, const double* set, int length, double value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector);
@@ -0,0 +1,352 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <intrin.h>
+#include "Operator.h"
+#include "Comparer.h"
+#include "ComparerN.h"
+#include "KernelCountersN.h"
+
+#pragma unmanaged
+
+// Build a 64-bit mask with a bit set for each of 64 rows which is not null (null marker byte is zero)
+static __inline unsigned __int64 NotNullBitsN(const unsigned __int8* nulls)
+{
+	__m256i zero = _mm256_setzero_si256();
+	unsigned int low = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)nulls), zero));
+	unsigned int high = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)(nulls + 32)), zero));
+	return ((unsigned __int64)high << 32) | low;
+}
+
+// Integers are compared with (GreaterThan, LessThan, Equal) and the result negated for the opposite operators
+static __inline bool IsNegatedN(CompareOperatorN cOp)
+{
+	return (cOp == CompareOperatorN::LessThanOrEqual || cOp == CompareOperatorN::GreaterThanOrEqual || cOp == CompareOperatorN::NotEqual);
+}
+
+// Compare 64 32-bit integers (eight blocks of eight); flip converts unsigned values to signed order
+template<CompareOperatorN cOp>
+static __inline unsigned __int64 Compare64N(const __int32* set, __m256i value, __m256i flip)
+{
+	unsigned __int64 result = 0;
+
+	for (int j = 0; j < 8; ++j)
+	{
+		__m256i block = _mm256_xor_si256(_mm256_loadu_si256((__m256i*)(&set[j * 8])), flip);
+		__m256i matchMask;
+
+		switch (cOp)
+		{
+		case CompareOperatorN::GreaterThan:
+		case CompareOperatorN::LessThanOrEqual:
+			matchMask = _mm256_cmpgt_epi32(block, value);
+			break;
+		case CompareOperatorN::LessThan:
+		case CompareOperatorN::GreaterThanOrEqual:
+			matchMask = _mm256_cmpgt_epi32(value, block);
+			break;
+		default:
+			matchMask = _mm256_cmpeq_epi32(block, value);
+			break;
+		}
+
+		result |= ((unsigned __int64)(unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(matchMask))) << (j * 8);
+	}
+
+	return (IsNegatedN(cOp) ? ~result : result);
+}
+
+// Compare 64 64-bit integers (sixteen blocks of four)
+template<CompareOperatorN cOp>
+static __inline unsigned __int64 Compare64N(const __int64* set, __m256i value, __m256i flip)
+{
+	unsigned __int64 result = 0;
+
+	for (int j = 0; j < 16; ++j)
+	{
+		__m256i block = _mm256_xor_si256(_mm256_loadu_si256((__m256i*)(&set[j * 4])), flip);
+		__m256i matchMask;
+
+		switch (cOp)
+		{
+		case CompareOperatorN::GreaterThan:
+		case CompareOperatorN::LessThanOrEqual:
+			matchMask = _mm256_cmpgt_epi64(block, value);
+			break;
+		case CompareOperatorN::LessThan:
+		case CompareOperatorN::GreaterThanOrEqual:
+			matchMask = _mm256_cmpgt_epi64(value, block);
+			break;
+		default:
+			matchMask = _mm256_cmpeq_epi64(block, value);
+			break;
+		}
+
+		result |= ((unsigned __int64)(unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(matchMask))) << (j * 4);
+	}
+
+	return (IsNegatedN(cOp) ? ~result : result);
+}
+
+// Compare 64 floats directly, so that NaN matches only NotEqual (like the managed comparison)
+template<CompareOperatorN cOp>
+static __inline unsigned __int64 Compare64N(const float* set, __m256 value, __m256 unused)
+{
+	unsigned __int64 result = 0;
+
+	for (int j = 0; j < 8; ++j)
+	{
+		__m256 block = _mm256_loadu_ps(&set[j * 8]);
+		__m256 matchMask;
+
+		switch (cOp)
+		{
+		case CompareOperatorN::GreaterThan:
+			matchMask = _mm256_cmp_ps(block, value, _CMP_GT_OQ);
+			break;
+		case CompareOperatorN::GreaterThanOrEqual:
+			matchMask = _mm256_cmp_ps(block, value, _CMP_GE_OQ);
+			break;
+		case CompareOperatorN::LessThan:
+			matchMask = _mm256_cmp_ps(block, value, _CMP_LT_OQ);
+			break;
+		case CompareOperatorN::LessThanOrEqual:
+			matchMask = _mm256_cmp_ps(block, value, _CMP_LE_OQ);
+			break;
+		case CompareOperatorN::NotEqual:
+			matchMask = _mm256_cmp_ps(block, value, _CMP_NEQ_UQ);
+			break;
+		default:
+			matchMask = _mm256_cmp_ps(block, value, _CMP_EQ_OQ);
+			break;
+		}
+
+		result |= ((unsigned __int64)(unsigned int)_mm256_movemask_ps(matchMask)) << (j * 8);
+	}
+
+	return result;
+}
+
+template<CompareOperatorN cOp>
+static __inline unsigned __int64 Compare64N(const double* set, __m256d value, __m256d unused)
+{
+	unsigned __int64 result = 0;
+
+	for (int j = 0; j < 16; ++j)
+	{
+		__m256d block = _mm256_loadu_pd(&set[j * 4]);
+		__m256d matchMask;
+
+		switch (cOp)
+		{
+		case CompareOperatorN::GreaterThan:
+			matchMask = _mm256_cmp_pd(block, value, _CMP_GT_OQ);
+			break;
+		case CompareOperatorN::GreaterThanOrEqual:
+			matchMask = _mm256_cmp_pd(block, value, _CMP_GE_OQ);
+			break;
+		case CompareOperatorN::LessThan:
+			matchMask = _mm256_cmp_pd(block, value, _CMP_LT_OQ);
+			break;
+		case CompareOperatorN::LessThanOrEqual:
+			matchMask = _mm256_cmp_pd(block, value, _CMP_LE_OQ);
+			break;
+		case CompareOperatorN::NotEqual:
+			matchMask = _mm256_cmp_pd(block, value, _CMP_NEQ_UQ);
+			break;
+		default:
+			matchMask = _mm256_cmp_pd(block, value, _CMP_EQ_OQ);
+			break;
+		}
+
+		result |= ((unsigned __int64)(unsigned int)_mm256_movemask_pd(matchMask)) << (j * 4);
+	}
+
+	return result;
+}
+
+template<CompareOperatorN cOp, typename T>
+static __inline bool MatchesN(T left, T right)
+{
+	switch (cOp)
+	{
+	case CompareOperatorN::GreaterThan:
+		return left > right;
+	case CompareOperatorN::GreaterThanOrEqual:
+		return left >= right;
+	case CompareOperatorN::LessThan:
+		return left < right;
+	case CompareOperatorN::LessThanOrEqual:
+		return left <= right;
+	case CompareOperatorN::NotEqual:
+		return left != right;
+	default:
+		return left == right;
+	}
+}
+
+// Compare values to a constant, clearing rows marked null in the same pass.
+// T is the value type; L is the signed lane type the AVX2 comparison reads the values as.
+template<CompareOperatorN cOp, typename T, typename L, typename V>
+static void WhereWideN(const T* set, int length, T value, V valueBlock, V flip, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	int i = 0;
+	unsigned __int64 result;
+
+	// Compare 64 rows at a time while there's enough data
+	int blockLength = length & ~63;
+	for (; i < blockLength; i += 64)
+	{
+		result = Compare64N<cOp>((const L*)&set[i], valueBlock, flip);
+		if (nulls != nullptr) result &= NotNullBitsN(&nulls[i]);
+
+		switch (bOp)
+		{
+		case BooleanOperatorN::And:
+			matchVector[i >> 6] &= result;
+			break;
+		case BooleanOperatorN::Or:
+			matchVector[i >> 6] |= result;
+			break;
+		}
+	}
+
+	// Match remaining values individually
+	if (i < length)
+	{
+		result = 0;
+		for (int j = i; j < length; ++j)
+		{
+			if (MatchesN<cOp>(set[j], value) && (nulls == nullptr || nulls[j] == 0)) result |= (0x1ULL << (j & 63));
+		}
+
+		switch (bOp)
+		{
+		case BooleanOperatorN::And:
+			matchVector[i >> 6] &= result;
+			break;
+		case BooleanOperatorN::Or:
+			matchVector[i >> 6] |= result;
+			break;
+		}
+	}
+}
+
+template<typename T, typename L, typename V>
+static void WhereWideN(CompareOperatorN cOp, const T* set, int length, T value, V valueBlock, V flip, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	switch (cOp)
+	{
+	case CompareOperatorN::Equal:
+		WhereWideN<CompareOperatorN::Equal, T, L, V>(set, length, value, valueBlock, flip, nulls, bOp, matchVector);
+		break;
+	case CompareOperatorN::NotEqual:
+		WhereWideN<CompareOperatorN::NotEqual, T, L, V>(set, length, value, valueBlock, flip, nulls, bOp, matchVector);
+		break;
+	case CompareOperatorN::LessThan:
+		WhereWideN<CompareOperatorN::LessThan, T, L, V>(set, length, value, valueBlock, flip, nulls, bOp, matchVector);
+		break;
+	case CompareOperatorN::LessThanOrEqual:
+		WhereWideN<CompareOperatorN::LessThanOrEqual, T, L, V>(set, length, value, valueBlock, flip, nulls, bOp, matchVector);
+		break;
+	case CompareOperatorN::GreaterThan:
+		WhereWideN<CompareOperatorN::GreaterThan, T, L, V>(set, length, value, valueBlock, flip, nulls, bOp, matchVector);
+		break;
+	case CompareOperatorN::GreaterThanOrEqual:
+		WhereWideN<CompareOperatorN::GreaterThanOrEqual, T, L, V>(set, length, value, valueBlock, flip, nulls, bOp, matchVector);
+		break;
+	}
+}
+
+void WhereWideN(CompareOperatorN cOp, const __int32* set, int length, __int32 value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	WhereWideN<__int32, __int32, __m256i>(cOp, set, length, value, _mm256_set1_epi32(value), _mm256_setzero_si256(), nulls, bOp, matchVector);
+}
+
+void WhereWideN(CompareOperatorN cOp, const unsigned __int32* set, int length, unsigned __int32 value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	// Flip the sign bit so that unsigned order becomes signed order
+	__m256i flip = _mm256_set1_epi32((int)0x80000000);
+	WhereWideN<unsigned __int32, __int32, __m256i>(cOp, set, length, value, _mm256_xor_si256(_mm256_set1_epi32((int)value), flip), flip, nulls, bOp, matchVector);
+}
+
+void WhereWideN(CompareOperatorN cOp, const __int64* set, int length, __int64 value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	WhereWideN<__int64, __int64, __m256i>(cOp, set, length, value, _mm256_set1_epi64x(value), _mm256_setzero_si256(), nulls, bOp, matchVector);
+}
+
+void WhereWideN(CompareOperatorN cOp, const unsigned __int64* set, int length, unsigned __int64 value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	__m256i flip = _mm256_set1_epi64x((__int64)0x8000000000000000ULL);
+	WhereWideN<unsigned __int64, __int64, __m256i>(cOp, set, length, value, _mm256_xor_si256(_mm256_set1_epi64x((__int64)value), flip), flip, nulls, bOp, matchVector);
+}
+
+void WhereWideN(CompareOperatorN cOp, const float* set, int length, float value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	WhereWideN<float, float, __m256>(cOp, set, length, value, _mm256_set1_ps(value), _mm256_setzero_ps(), nulls, bOp, matchVector);
+}
+
+void WhereWideN(CompareOperatorN cOp, const double* set, int length, double value, const unsigned __int8* nulls, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	WhereWideN<double, double, __m256d>(cOp, set, length, value, _mm256_set1_pd(value), _mm256_setzero_pd(), nulls, bOp, matchVector);
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		template<typename T, typename N>
+		static void WhereWide(array<T>^ left, Int32 index, Int32 length, Byte cOp, T right, array<Boolean>^ nulls, Int32 nullsIndex, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
+		{
+			if (index < 0 || length < 0 || vectorIndex < 0) throw gcnew IndexOutOfRangeException();
+			if (index + length > left->Length) throw gcnew IndexOutOfRangeException();
+			if (vectorIndex + length > (vector->Length * 64)) throw gcnew IndexOutOfRangeException();
+			if ((vectorIndex & 63) != 0) throw gcnew ArgumentException("Offset Where must run on a multiple of 64 offset.");
+			if (nulls != nullptr && (nullsIndex < 0 || nullsIndex + length > nulls->Length)) throw gcnew IndexOutOfRangeException("nulls");
+			if (cOp > (Byte)CompareOperatorN::GreaterThanOrEqual) throw gcnew ArgumentException("cOp");
+			if (length == 0) return;
+
+			pin_ptr<T> pLeft = &left[index];
+			pin_ptr<UInt64> pVector = &vector[vectorIndex >> 6];
+
+			pin_ptr<Boolean> pNulls = nullptr;
+			if (nulls != nullptr) pNulls = &nulls[nullsIndex];
+
+			KernelScopeN scope(KernelN::Where, length, (__int64)length * (sizeof(T) + (nulls != nullptr ? 1 : 0)), pVector, length);
+			WhereWideN((CompareOperatorN)cOp, (N*)pLeft, length, (N)right, (unsigned __int8*)pNulls, (BooleanOperatorN)bOp, pVector);
+		}
+
+		void Comparer::Where(array<Int32>^ left, Int32 index, Int32 length, Byte cOp, Int32 right, array<Boolean>^ nulls, Int32 nullsIndex, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
+		{
+			WhereWide<Int32, __int32>(left, index, length, cOp, right, nulls, nullsIndex, bOp, vector, vectorIndex);
+		}
+
+		void Comparer::Where(array<UInt32>^ left, Int32 index, Int32 length, Byte cOp, UInt32 right, array<Boolean>^ nulls, Int32 nullsIndex, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
+		{
+			WhereWide<UInt32, unsigned __int32>(left, index, length, cOp, right, nulls, nullsIndex, bOp, vector, vectorIndex);
+		}
+
+		void Comparer::Where(array<Int64>^ left, Int32 index, Int32 length, Byte cOp, Int64 right, array<Boolean>^ nulls, Int32 nullsIndex, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
+		{
+			WhereWide<Int64, __int64>(left, index, length, cOp, right, nulls, nullsIndex, bOp, vector, vectorIndex);
+		}
+
+		void Comparer::Where(array<UInt64>^ left, Int32 index, Int32 length, Byte cOp, UInt64 right, array<Boolean>^ nulls, Int32 nullsIndex, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
+		{
+			WhereWide<UInt64, unsigned __int64>(left, index, length, cOp, right, nulls, nullsIndex, bOp, vector, vectorIndex);
+		}
+
+		void Comparer::Where(array<Single>^ left, Int32 index, Int32 length, Byte cOp, Single right, array<Boolean>^ nulls, Int32 nullsIndex, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
+		{
+			WhereWide<Single, float>(left, index, length, cOp, right, nulls, nullsIndex, bOp, vector, vectorIndex);
+		}
+
+		void Comparer::Where(array<Double>^ left, Int32 index, Int32 length, Byte cOp, Double right, array<Boolean>^ nulls, Int32 nullsIndex, Byte bOp, array<UInt64>^ vector, Int32 vectorIndex)
+		{
+			WhereWide<Double, double>(left, index, length, cOp, right, nulls, nullsIndex, bOp, vector, vectorIndex);
+		}
+	}
+}
@@ -0,0 +1,248 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <intrin.h>
+#include <string.h>
+#include "ComputerN.h"
+#include "KernelCountersN.h"
+
+#pragma unmanaged
+
+// Spread the low eight bits of a lane mask into one 0/1 byte per lane (four bits at a time, so the partial products don't overlap)
+static __inline unsigned __int64 MaskToBytesN(unsigned int mask)
+{
+	unsigned __int64 low = ((mask & 0xF) * 0x00204081U) & 0x01010101U;
+	unsigned __int64 high = (((mask >> 4) & 0xF) * 0x00204081U) & 0x01010101U;
+	return low | (high << 32);
+}
+
+// Each operation has a Scalar form, computing one row, and a Block form, computing one 32-byte block of four lanes.
+// Both report rows which must be null: Scalar returns true and Block returns a mask with a bit per invalid lane.
+// Results which overflow and quotients with a zero divisor are invalid.
+
+struct AddN
+{
+	static __inline bool Scalar(__int64 left, __int64 right, __int64* result)
+	{
+		__int64 sum = (__int64)((unsigned __int64)left + (unsigned __int64)right);
+		*result = sum;
+		return ((left ^ sum) & (right ^ sum)) < 0;
+	}
+
+	static __inline unsigned int Block(const __int64* left, const __int64* right, __int64* result)
+	{
+		__m256i l = _mm256_loadu_si256((__m256i*)left);
+		__m256i r = _mm256_loadu_si256((__m256i*)right);
+		__m256i sum = _mm256_add_epi64(l, r);
+		_mm256_storeu_si256((__m256i*)result, sum);
+
+		// Overflow if both inputs have a different sign from the sum
+		__m256i overflow = _mm256_and_si256(_mm256_xor_si256(l, sum), _mm256_xor_si256(r, sum));
+		return _mm256_movemask_pd(_mm256_castsi256_pd(overflow));
+	}
+};
+
+struct SubtractN
+{
+	static __inline bool Scalar(__int64 left, __int64 right, __int64* result)
+	{
+		__int64 difference = (__int64)((unsigned __int64)left - (unsigned __int64)right);
+		*result = difference;
+		return ((left ^ right) & (left ^ difference)) < 0;
+	}
+
+	static __inline unsigned int Block(const __int64* left, const __int64* right, __int64* result)
+	{
+		__m256i l = _mm256_loadu_si256((__m256i*)left);
+		__m256i r = _mm256_loadu_si256((__m256i*)right);
+		__m256i difference = _mm256_sub_epi64(l, r);
+		_mm256_storeu_si256((__m256i*)result, difference);
+
+		// Overflow if the inputs have different signs and the difference has the sign of the right side
+		__m256i overflow = _mm256_and_si256(_mm256_xor_si256(l, r), _mm256_xor_si256(l, difference));
+		return _mm256_movemask_pd(_mm256_castsi256_pd(overflow));
+	}
+};
+
+struct MultiplyN
+{
+	static __inline bool Scalar(__int64 left, __int64 right, __int64* result)
+	{
+		__int64 high;
+		__int64 low = _mul128(left, right, &high);
+		*result = low;
+		return high != (low >> 63);
+	}
+
+	static __inline unsigned int Block(const __int64* left, const __int64* right, __int64* result)
+	{
+		// AVX2 has no 64-bit multiply; multiply each lane with an overflow check
+		unsigned int invalid = 0;
+		for (int j = 0; j < 4; ++j)
+		{
+			if (Scalar(left[j], right[j], &result[j])) invalid |= (1 << j);
+		}
+
+		return invalid;
+	}
+};
+
+struct DivideN
+{
+	static __inline bool Scalar(__int64 left, __int64 right, __int64* result)
+	{
+		// Zero divisors and MinValue / -1 (which overflows) are invalid
+		if (right == 0 || (right == -1 && left == (__int64)0x8000000000000000ULL))
+		{
+			*result = 0;
+			return true;
+		}
+
+		*result = left / right;
+		return false;
+	}
+
+	static __inline unsigned int Block(const __int64* left, const __int64* right, __int64* result)
+	{
+		// AVX2 has no integer divide; divide each lane
+		unsigned int invalid = 0;
+		for (int j = 0; j < 4; ++j)
+		{
+			if (Scalar(left[j], right[j], &result[j])) invalid |= (1 << j);
+		}
+
+		return invalid;
+	}
+};
+
+// Compute count rows of left (op) right into result, setting resultNulls for null inputs and invalid results.
+// Single value sides are copied into a block of identical values so that every block is computed the same way.
+template<typename Op, typename T>
+static int ComputeN(const T* left, bool leftIsSingle, const unsigned __int8* leftNulls, const T* right, bool rightIsSingle, const unsigned __int8* rightNulls, int count, T* result, unsigned __int8* resultNulls)
+{
+	const int lanes = 32 / sizeof(T);
+
+	T leftBlock[lanes], rightBlock[lanes];
+	unsigned __int8 leftNullBlock[lanes], rightNullBlock[lanes];
+	unsigned __int8 leftSingleNull = (leftNulls != nullptr && leftNulls[0] != 0);
+	unsigned __int8 rightSingleNull = (rightNulls != nullptr && rightNulls[0] != 0);
+
+	for (int j = 0; j < lanes; ++j)
+	{
+		leftBlock[j] = left[0];
+		rightBlock[j] = right[0];
+		leftNullBlock[j] = leftSingleNull;
+		rightNullBlock[j] = rightSingleNull;
+	}
+
+	// Single values (and missing nulls) read the same block every time
+	const T* l = (leftIsSingle ? leftBlock : left);
+	const T* r = (rightIsSingle ? rightBlock : right);
+	const unsigned __int8* ln = ((leftIsSingle || leftNulls == nullptr) ? leftNullBlock : leftNulls);
+	const unsigned __int8* rn = ((rightIsSingle || rightNulls == nullptr) ? rightNullBlock : rightNulls);
+	int lStep = (leftIsSingle ? 0 : lanes);
+	int rStep = (rightIsSingle ? 0 : lanes);
+	int lnStep = ((leftIsSingle || leftNulls == nullptr) ? 0 : lanes);
+	int rnStep = ((rightIsSingle || rightNulls == nullptr) ? 0 : lanes);
+
+	int nullCount = 0;
+	int i = 0;
+
+	int blockLength = count - (count % lanes);
+	for (; i < blockLength; i += lanes)
+	{
+		unsigned __int64 nulls = MaskToBytesN(Op::Block(l, r, &result[i]));
+
+		unsigned __int64 inputNulls = 0;
+		memcpy(&inputNulls, ln, lanes);
+		nulls |= inputNulls;
+		memcpy(&inputNulls, rn, lanes);
+		nulls |= inputNulls;
+
+		memcpy(&resultNulls[i], &nulls, lanes);
+		nullCount += (int)__popcnt64(nulls);
+
+		l += lStep;
+		r += rStep;
+		ln += lnStep;
+		rn += rnStep;
+	}
+
+	// Compute remaining rows individually
+	for (; i < count; ++i)
+	{
+		bool isNull = Op::Scalar(*l, *r, &result[i]);
+		isNull |= (*ln != 0) | (*rn != 0);
+
+		resultNulls[i] = (isNull ? 1 : 0);
+		nullCount += (isNull ? 1 : 0);
+
+		if (lStep != 0) ++l;
+		if (rStep != 0) ++r;
+		if (lnStep != 0) ++ln;
+		if (rnStep != 0) ++rn;
+	}
+
+	return nullCount;
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		static void CheckRange(Int32 length, Int32 index, Boolean isSingle, Int32 count)
+		{
+			if (index < 0 || index + (isSingle ? 1 : count) > length) throw gcnew IndexOutOfRangeException();
+		}
+
+		template<typename Op, typename T, typename N>
+		static Int32 Compute(array<T>^ left, Int32 leftIndex, Boolean leftIsSingle, array<Boolean>^ leftNulls, array<T>^ right, Int32 rightIndex, Boolean rightIsSingle, array<Boolean>^ rightNulls, Int32 count, array<T>^ result, array<Boolean>^ resultNulls)
+		{
+			if (count < 0) throw gcnew IndexOutOfRangeException();
+			if (count > result->Length || count > resultNulls->Length) throw gcnew IndexOutOfRangeException("result");
+			if (count == 0) return 0;
+
+			CheckRange(left->Length, leftIndex, leftIsSingle, count);
+			CheckRange(right->Length, rightIndex, rightIsSingle, count);
+			if (leftNulls != nullptr) CheckRange(leftNulls->Length, leftIndex, leftIsSingle, count);
+			if (rightNulls != nullptr) CheckRange(rightNulls->Length, rightIndex, rightIsSingle, count);
+
+			pin_ptr<T> pLeft = &left[leftIndex];
+			pin_ptr<T> pRight = &right[rightIndex];
+			pin_ptr<T> pResult = &result[0];
+			pin_ptr<Boolean> pResultNulls = &resultNulls[0];
+
+			pin_ptr<Boolean> pLeftNulls = nullptr;
+			if (leftNulls != nullptr) pLeftNulls = &leftNulls[leftIndex];
+
+			pin_ptr<Boolean> pRightNulls = nullptr;
+			if (rightNulls != nullptr) pRightNulls = &rightNulls[rightIndex];
+
+			KernelScopeN scope(KernelN::Compute, count, (__int64)count * (sizeof(T) * 3 + 1));
+			return ComputeN<Op>((N*)pLeft, leftIsSingle, (unsigned __int8*)pLeftNulls, (N*)pRight, rightIsSingle, (unsigned __int8*)pRightNulls, count, (N*)pResult, (unsigned __int8*)pResultNulls);
+		}
+
+		Int32 ComputerN::Add(array<Int64>^ left, Int32 leftIndex, Boolean leftIsSingle, array<Boolean>^ leftNulls, array<Int64>^ right, Int32 rightIndex, Boolean rightIsSingle, array<Boolean>^ rightNulls, Int32 count, array<Int64>^ result, array<Boolean>^ resultNulls)
+		{
+			return Compute<AddN, Int64, __int64>(left, leftIndex, leftIsSingle, leftNulls, right, rightIndex, rightIsSingle, rightNulls, count, result, resultNulls);
+		}
+
+		Int32 ComputerN::Subtract(array<Int64>^ left, Int32 leftIndex, Boolean leftIsSingle, array<Boolean>^ leftNulls, array<Int64>^ right, Int32 rightIndex, Boolean rightIsSingle, array<Boolean>^ rightNulls, Int32 count, array<Int64>^ result, array<Boolean>^ resultNulls)
+		{
+			return Compute<SubtractN, Int64, __int64>(left, leftIndex, leftIsSingle, leftNulls, right, rightIndex, rightIsSingle, rightNulls, count, result, resultNulls);
+		}
+
+		Int32 ComputerN::Multiply(array<Int64>^ left, Int32 leftIndex, Boolean leftIsSingle, array<Boolean>^ leftNulls, array<Int64>^ right, Int32 rightIndex, Boolean rightIsSingle, array<Boolean>^ rightNulls, Int32 count, array<Int64>^ result, array<Boolean>^ resultNulls)
+		{
+			return Compute<MultiplyN, Int64, __int64>(left, leftIndex, leftIsSingle, leftNulls, right, rightIndex, rightIsSingle, rightNulls, count, result, resultNulls);
+		}
+
+		Int32 ComputerN::Divide(array<Int64>^ left, Int32 leftIndex, Boolean leftIsSingle, array<Boolean>^ leftNulls, array<Int64>^ right, Int32 rightIndex, Boolean rightIsSingle, array<Boolean>^ rightNulls, Int32 count, array<Int64>^ result, array<Boolean>^ resultNulls)
+		{
+			return Compute<DivideN, Int64, __int64>(left, leftIndex, leftIsSingle, leftNulls, right, rightIndex, rightIsSingle, rightNulls, count, result, resultNulls);
+		}
+	}
+}
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+using namespace System;
+
+namespace XForm
+{
+	namespace Native
+	{
+		public ref class ComputerN
+		{
+		public:
+			// Compute result[i] = left[leftIndex + i] (op) right[rightIndex + i] for i in [0, count).
+			// A side marked IsSingle uses the value at its index for every row. Nulls (if not null) are indexed like the values.
+			// resultNulls[i] is set for rows where either side is null, the result overflows, or the divisor is zero.
+			// Returns the number of null result rows.
+			static Int32 Add(array<Int64>^ left, Int32 leftIndex, Boolean leftIsSingle, array<Boolean>^ leftNulls, array<Int64>^ right, Int32 rightIndex, Boolean rightIsSingle, array<Boolean>^ rightNulls, Int32 count, array<Int64>^ result, array<Boolean>^ resultNulls);
+			static Int32 Subtract(array<Int64>^ left, Int32 leftIndex, Boolean leftIsSingle, array<Boolean>^ leftNulls, array<Int64>^ right, Int32 rightIndex, Boolean rightIsSingle, array<Boolean>^ rightNulls, Int32 count, array<Int64>^ result, array<Boolean>^ resultNulls);
+			static Int32 Multiply(array<Int64>^ left, Int32 leftIndex, Boolean leftIsSingle, array<Boolean>^ leftNulls, array<Int64>^ right, Int32 rightIndex, Boolean rightIsSingle, array<Boolean>^ rightNulls, Int32 count, array<Int64>^ result, array<Boolean>^ resultNulls);
+			static Int32 Divide(array<Int64>^ left, Int32 leftIndex, Boolean leftIsSingle, array<Boolean>^ leftNulls, array<Int64>^ right, Int32 rightIndex, Boolean rightIsSingle, array<Boolean>^ rightNulls, Int32 count, array<Int64>^ result, array<Boolean>^ resultNulls);
+		};
+	}
+}
@@ -0,0 +1,362 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <intrin.h>
+#include <string.h>
+#include "DateTimeN.h"
+
+#pragma unmanaged
+
+// DateTime values are a single 64-bit word: ticks in the low 62 bits and DateTimeKind in the top two
+static const unsigned __int64 TicksMaskN = 0x3FFFFFFFFFFFFFFFULL;
+static const unsigned __int64 KindMaskN = 0xC000000000000000ULL;
+static const __int64 MaxTicksN = 3155378975999999999LL;
+
+// TicksPerDay is 2^14 * 52734375
+static const int DayShiftN = 14;
+static const double DayOddN = 52734375.0;
+
+// Must match XForm.Functions.Date.DatePart
+enum class DatePartN : char
+{
+	Year = 0,
+	Month = 1,
+	DayOfMonth = 2,
+	Hour = 3,
+	Minute = 4,
+	Second = 5,
+	Millisecond = 6
+};
+
+// Convert non-negative 64-bit integers below 2^53 to doubles exactly (converting each 32-bit half with the 2^52 exponent trick)
+static __inline __m256d ToDoubleN(__m256i values)
+{
+	__m256i magic = _mm256_set1_epi64x(0x4330000000000000LL);
+	__m256d magicDouble = _mm256_set1_pd(4503599627370496.0);
+
+	__m256d high = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(values, 32), magic)), magicDouble);
+	__m256d low = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(values, _mm256_set1_epi64x(0xFFFFFFFFLL)), magic)), magicDouble);
+	return _mm256_add_pd(_mm256_mul_pd(high, _mm256_set1_pd(4294967296.0)), low);
+}
+
+// floor(x / d) for small non-negative integer-valued doubles, where the quotient rounding can't cross an integer
+static __inline __m256d FloorDivideN(__m256d x, double d)
+{
+	return _mm256_floor_pd(_mm256_div_pd(x, _mm256_set1_pd(d)));
+}
+
+// floor(x / d) and x mod d for non-negative integer-valued doubles below 2^53.
+// The quotient may round up across an integer for large x, so the remainder corrects it.
+static __inline __m256d DivideN(__m256d x, double d, __m256d* remainder)
+{
+	__m256d divisor = _mm256_set1_pd(d);
+	__m256d quotient = _mm256_floor_pd(_mm256_div_pd(x, divisor));
+	__m256d rest = _mm256_sub_pd(x, _mm256_mul_pd(quotient, divisor));
+
+	__m256d isUnder = _mm256_cmp_pd(rest, _mm256_setzero_pd(), _CMP_LT_OQ);
+	quotient = _mm256_sub_pd(quotient, _mm256_and_pd(isUnder, _mm256_set1_pd(1.0)));
+	rest = _mm256_add_pd(rest, _mm256_and_pd(isUnder, divisor));
+
+	*remainder = rest;
+	return quotient;
+}
+
+static __inline __m256d ModN(__m256d x, double d)
+{
+	return _mm256_sub_pd(x, _mm256_mul_pd(FloorDivideN(x, d), _mm256_set1_pd(d)));
+}
+
+// Compute one date part for four DateTimes
+template<DatePartN part>
+static __inline void DatePartBlockN(const unsigned __int64* values, unsigned __int16* result)
+{
+	__m256i ticks = _mm256_and_si256(_mm256_loadu_si256((__m256i*)values), _mm256_set1_epi64x((__int64)TicksMaskN));
+
+	// Split ticks into whole days and ticks within the day
+	__m256d dayRemainder;
+	__m256d days = DivideN(ToDoubleN(_mm256_srli_epi64(ticks, DayShiftN)), DayOddN, &dayRemainder);
+	__m256d timeOfDay = _mm256_add_pd(_mm256_mul_pd(dayRemainder, _mm256_set1_pd((double)(1 << DayShiftN))), ToDoubleN(_mm256_and_si256(ticks, _mm256_set1_epi64x((1 << DayShiftN) - 1))));
+
+	__m256d value;
+	if (part == DatePartN::Hour)
+	{
+		value = FloorDivideN(timeOfDay, 36000000000.0);
+	}
+	else if (part == DatePartN::Minute)
+	{
+		value = ModN(FloorDivideN(timeOfDay, 600000000.0), 60.0);
+	}
+	else if (part == DatePartN::Second)
+	{
+		value = ModN(FloorDivideN(timeOfDay, 10000000.0), 60.0);
+	}
+	else if (part == DatePartN::Millisecond)
+	{
+		value = ModN(FloorDivideN(timeOfDay, 10000.0), 1000.0);
+	}
+	else
+	{
+		// Civil from days (H. Hinnant), on days since 0000-03-01 so that leap days end each 400 year era.
+		// DateTime day zero is 0001-01-01, which is 306 days after 0000-03-01.
+		__m256d z = _mm256_add_pd(days, _mm256_set1_pd(306.0));
+
+		__m256d dayOfEra;
+		__m256d era = DivideN(z, 146097.0, &dayOfEra);
+
+		// yearOfEra = (doe - doe/1460 + doe/36524 - doe/146096) / 365
+		__m256d yearOfEra = _mm256_sub_pd(dayOfEra, FloorDivideN(dayOfEra, 1460.0));
+		yearOfEra = _mm256_add_pd(yearOfEra, FloorDivideN(dayOfEra, 36524.0));
+		yearOfEra = _mm256_sub_pd(yearOfEra, FloorDivideN(dayOfEra, 146096.0));
+		yearOfEra = FloorDivideN(yearOfEra, 365.0);
+
+		// dayOfYear = doe - (365*yoe + yoe/4 - yoe/100), with the year starting March 1
+		__m256d dayOfYear = _mm256_mul_pd(yearOfEra, _mm256_set1_pd(365.0));
+		dayOfYear = _mm256_add_pd(dayOfYear, FloorDivideN(yearOfEra, 4.0));
+		dayOfYear = _mm256_sub_pd(dayOfYear, FloorDivideN(yearOfEra, 100.0));
+		dayOfYear = _mm256_sub_pd(dayOfEra, dayOfYear);
+
+		// monthFromMarch = (5*doy + 2) / 153
+		__m256d monthFromMarch = FloorDivideN(_mm256_add_pd(_mm256_mul_pd(dayOfYear, _mm256_set1_pd(5.0)), _mm256_set1_pd(2.0)), 153.0);
+
+		// month = monthFromMarch < 10 ? monthFromMarch + 3 : monthFromMarch - 9
+		__m256d isJanuaryOrFebruary = _mm256_cmp_pd(monthFromMarch, _mm256_set1_pd(10.0), _CMP_GE_OQ);
+		__m256d month = _mm256_add_pd(monthFromMarch, _mm256_blendv_pd(_mm256_set1_pd(3.0), _mm256_set1_pd(-9.0), isJanuaryOrFebruary));
+
+		if (part == DatePartN::Month)
+		{
+			value = month;
+		}
+		else if (part == DatePartN::DayOfMonth)
+		{
+			// day = doy - (153*mp + 2)/5 + 1
+			__m256d monthStart = FloorDivideN(_mm256_add_pd(_mm256_mul_pd(monthFromMarch, _mm256_set1_pd(153.0)), _mm256_set1_pd(2.0)), 5.0);
+			value = _mm256_add_pd(_mm256_sub_pd(dayOfYear, monthStart), _mm256_set1_pd(1.0));
+		}
+		else
+		{
+			// year = yoe + era*400 + (month <= 2)
+			value = _mm256_add_pd(yearOfEra, _mm256_mul_pd(era, _mm256_set1_pd(400.0)));
+			value = _mm256_add_pd(value, _mm256_and_pd(isJanuaryOrFebruary, _mm256_set1_pd(1.0)));
+		}
+	}
+
+	// Convert the four parts to 16-bit values
+	__m128i parts = _mm256_cvttpd_epi32(value);
+	_mm_storel_epi64((__m128i*)result, _mm_packus_epi32(parts, parts));
+}
+
+template<DatePartN part>
+static void ComputeDatePartN(const unsigned __int64* values, int count, unsigned __int16* result)
+{
+	int i = 0;
+	int blockLength = count & ~3;
+	for (; i < blockLength; i += 4)
+	{
+		DatePartBlockN<part>(&values[i], &result[i]);
+	}
+
+	// Compute the remaining values as a padded block
+	if (i < count)
+	{
+		unsigned __int64 lastValues[4] = { 0 };
+		unsigned __int16 lastResults[4];
+		memcpy(lastValues, &values[i], (count - i) * sizeof(unsigned __int64));
+		DatePartBlockN<part>(lastValues, lastResults);
+		memcpy(&result[i], lastResults, (count - i) * sizeof(unsigned __int16));
+	}
+}
+
+static void ComputeDatePartN(const unsigned __int64* values, int count, DatePartN part, unsigned __int16* result)
+{
+	switch (part)
+	{
+	case DatePartN::Year:
+		ComputeDatePartN<DatePartN::Year>(values, count, result);
+		break;
+	case DatePartN::Month:
+		ComputeDatePartN<DatePartN::Month>(values, count, result);
+		break;
+	case DatePartN::DayOfMonth:
+		ComputeDatePartN<DatePartN::DayOfMonth>(values, count, result);
+		break;
+	case DatePartN::Hour:
+		ComputeDatePartN<DatePartN::Hour>(values, count, result);
+		break;
+	case DatePartN::Minute:
+		ComputeDatePartN<DatePartN::Minute>(values, count, result);
+		break;
+	case DatePartN::Second:
+		ComputeDatePartN<DatePartN::Second>(values, count, result);
+		break;
+	case DatePartN::Millisecond:
+		ComputeDatePartN<DatePartN::Millisecond>(values, count, result);
+		break;
+	}
+}
+
+// Truncate ticks to a multiple of unitTicks, keeping the kind bits.
+// The unit is split into 2^shift * odd; ticks >> shift is exact as a double when shift >= 9, so the division runs in double lanes.
+static void TruncateN(const unsigned __int64* values, int count, __int64 unitTicks, unsigned __int64* result)
+{
+	int shift = 0;
+	while (((unitTicks >> shift) & 1) == 0) shift++;
+	__int64 odd = unitTicks >> shift;
+
+	int i = 0;
+	if (shift >= 9 && odd < 0x7FFFFFFF)
+	{
+		__m256i ticksMask = _mm256_set1_epi64x((__int64)TicksMaskN);
+		__m256i kindMask = _mm256_set1_epi64x((__int64)KindMaskN);
+
+		int blockLength = count & ~3;
+		for (; i < blockLength; i += 4)
+		{
+			__m256i value = _mm256_loadu_si256((__m256i*)&values[i]);
+			__m256i shifted = _mm256_srli_epi64(_mm256_and_si256(value, ticksMask), shift);
+
+			// Remove the remainder of (ticks >> shift) / odd, then shift back
+			__m256d remainder;
+			DivideN(ToDoubleN(shifted), (double)odd, &remainder);
+			__m256i truncated = _mm256_slli_epi64(_mm256_sub_epi64(shifted, _mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(remainder))), shift);
+
+			_mm256_storeu_si256((__m256i*)&result[i], _mm256_or_si256(truncated, _mm256_and_si256(value, kindMask)));
+		}
+	}
+
+	for (; i < count; ++i)
+	{
+		__int64 ticks = (__int64)(values[i] & TicksMaskN);
+		result[i] = (unsigned __int64)(ticks - ticks % unitTicks) | (values[i] & KindMaskN);
+	}
+}
+
+// Add offsetTicks (between -MaxTicks and MaxTicks) to each value, counting results outside [0, MaxTicks]
+static int AddN(const unsigned __int64* values, int count, __int64 offsetTicks, unsigned __int64* result)
+{
+	__m256i ticksMask = _mm256_set1_epi64x((__int64)TicksMaskN);
+	__m256i kindMask = _mm256_set1_epi64x((__int64)KindMaskN);
+	__m256i offset = _mm256_set1_epi64x(offsetTicks);
+	__m256i maxTicks = _mm256_set1_epi64x(MaxTicksN);
+	__m256i zero = _mm256_setzero_si256();
+
+	int outOfRangeCount = 0;
+	int i = 0;
+	int blockLength = count & ~3;
+	for (; i < blockLength; i += 4)
+	{
+		__m256i value = _mm256_loadu_si256((__m256i*)&values[i]);
+		__m256i sum = _mm256_add_epi64(_mm256_and_si256(value, ticksMask), offset);
+
+		__m256i outOfRange = _mm256_or_si256(_mm256_cmpgt_epi64(zero, sum), _mm256_cmpgt_epi64(sum, maxTicks));
+		outOfRangeCount += (int)__popcnt(_mm256_movemask_pd(_mm256_castsi256_pd(outOfRange)));
+
+		_mm256_storeu_si256((__m256i*)&result[i], _mm256_or_si256(_mm256_and_si256(sum, ticksMask), _mm256_and_si256(value, kindMask)));
+	}
+
+	for (; i < count; ++i)
+	{
+		__int64 sum = (__int64)(values[i] & TicksMaskN) + offsetTicks;
+		if (sum < 0 || sum > MaxTicksN) outOfRangeCount++;
+		result[i] = ((unsigned __int64)sum & TicksMaskN) | (values[i] & KindMaskN);
+	}
+
+	return outOfRangeCount;
+}
+
+// Subtract DateTime ticks (ignoring kind) into TimeSpan ticks; single value sides read the same block every time
+static void SubtractN(const unsigned __int64* end, bool endIsSingle, const unsigned __int64* start, bool startIsSingle, int count, __int64* result)
+{
+	unsigned __int64 endBlock[4] = { end[0], end[0], end[0], end[0] };
+	unsigned __int64 startBlock[4] = { start[0], start[0], start[0], start[0] };
+	const unsigned __int64* e = (endIsSingle ? endBlock : end);
+	const unsigned __int64* s = (startIsSingle ? startBlock : start);
+	int endStep = (endIsSingle ? 0 : 4);
+	int startStep = (startIsSingle ? 0 : 4);
+
+	__m256i ticksMask = _mm256_set1_epi64x((__int64)TicksMaskN);
+
+	int i = 0;
+	int blockLength = count & ~3;
+	for (; i < blockLength; i += 4)
+	{
+		__m256i endTicks = _mm256_and_si256(_mm256_loadu_si256((__m256i*)e), ticksMask);
+		__m256i startTicks = _mm256_and_si256(_mm256_loadu_si256((__m256i*)s), ticksMask);
+		_mm256_storeu_si256((__m256i*)&result[i], _mm256_sub_epi64(endTicks, startTicks));
+
+		e += endStep;
+		s += startStep;
+	}
+
+	for (; i < count; ++i)
+	{
+		result[i] = (__int64)(*e & TicksMaskN) - (__int64)(*s & TicksMaskN);
+
+		if (endStep != 0) ++e;
+		if (startStep != 0) ++s;
+	}
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		static void CheckRange(Int32 length, Int32 index, Boolean isSingle, Int32 count)
+		{
+			if (index < 0 || index + (isSingle ? 1 : count) > length) throw gcnew IndexOutOfRangeException();
+		}
+
+		void DateTimeN::DatePart(array<DateTime>^ values, Int32 index, Int32 count, Byte part, array<UInt16>^ result)
+		{
+			if (count < 0 || count > result->Length) throw gcnew IndexOutOfRangeException();
+			CheckRange(values->Length, index, false, count);
+			if (part > (Byte)DatePartN::Millisecond) throw gcnew ArgumentException("part");
+			if (count == 0) return;
+
+			pin_ptr<DateTime> pValues = &values[index];
+			pin_ptr<UInt16> pResult = &result[0];
+			ComputeDatePartN((unsigned __int64*)pValues, count, (DatePartN)part, (unsigned __int16*)pResult);
+		}
+
+		void DateTimeN::Truncate(array<DateTime>^ values, Int32 index, Int32 count, Int64 unitTicks, array<DateTime>^ result)
+		{
+			if (count < 0 || count > result->Length) throw gcnew IndexOutOfRangeException();
+			CheckRange(values->Length, index, false, count);
+			if (unitTicks <= 0) throw gcnew ArgumentOutOfRangeException("unitTicks");
+			if (count == 0) return;
+
+			pin_ptr<DateTime> pValues = &values[index];
+			pin_ptr<DateTime> pResult = &result[0];
+			TruncateN((unsigned __int64*)pValues, count, unitTicks, (unsigned __int64*)pResult);
+		}
+
+		Int32 DateTimeN::Add(array<DateTime>^ values, Int32 index, Int32 count, Int64 offsetTicks, array<DateTime>^ result)
+		{
+			if (count < 0 || count > result->Length) throw gcnew IndexOutOfRangeException();
+			CheckRange(values->Length, index, false, count);
+			if (count == 0) return 0;
+
+			// Offsets larger than the whole DateTime range put every result out of range
+			if (offsetTicks > MaxTicksN || offsetTicks < -MaxTicksN) return count;
+
+			pin_ptr<DateTime> pValues = &values[index];
+			pin_ptr<DateTime> pResult = &result[0];
+			return AddN((unsigned __int64*)pValues, count, offsetTicks, (unsigned __int64*)pResult);
+		}
+
+		void DateTimeN::Subtract(array<DateTime>^ end, Int32 endIndex, Boolean endIsSingle, array<DateTime>^ start, Int32 startIndex, Boolean startIsSingle, Int32 count, array<TimeSpan>^ result)
+		{
+			if (count < 0 || count > result->Length) throw gcnew IndexOutOfRangeException();
+			if (count == 0) return;
+			CheckRange(end->Length, endIndex, endIsSingle, count);
+			CheckRange(start->Length, startIndex, startIsSingle, count);
+
+			pin_ptr<DateTime> pEnd = &end[endIndex];
+			pin_ptr<DateTime> pStart = &start[startIndex];
+			pin_ptr<TimeSpan> pResult = &result[0];
+			SubtractN((unsigned __int64*)pEnd, endIsSingle, (unsigned __int64*)pStart, startIsSingle, count, (__int64*)pResult);
+		}
+	}
+}
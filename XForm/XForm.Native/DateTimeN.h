@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+using namespace System;
+
+namespace XForm
+{
+	namespace Native
+	{
+		public ref class DateTimeN
+		{
+		public:
+			// Set result[i] to the part (XForm.Functions.Date.DatePart: Year, Month, DayOfMonth, Hour, Minute, Second, Millisecond) of values[index + i].
+			static void DatePart(array<DateTime>^ values, Int32 index, Int32 count, Byte part, array<UInt16>^ result);
+
+			// Set result[i] to values[index + i] truncated to a multiple of unitTicks (keeping the DateTimeKind).
+			static void Truncate(array<DateTime>^ values, Int32 index, Int32 count, Int64 unitTicks, array<DateTime>^ result);
+
+			// Set result[i] to values[index + i] plus offsetTicks (keeping the DateTimeKind).
+			// Returns the number of results outside the DateTime range; those result values are undefined.
+			static Int32 Add(array<DateTime>^ values, Int32 index, Int32 count, Int64 offsetTicks, array<DateTime>^ result);
+
+			// Set result[i] to end[endIndex + i] - start[startIndex + i]. A side marked IsSingle uses the value at its index for every row.
+			static void Subtract(array<DateTime>^ end, Int32 endIndex, Boolean endIsSingle, array<DateTime>^ start, Int32 startIndex, Boolean startIsSingle, Int32 count, array<TimeSpan>^ result);
+		};
+	}
+}
@@ -0,0 +1,210 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <intrin.h>
+#include "GatherN.h"
+#include "KernelCountersN.h"
+
+#pragma unmanaged
+
+// Return whether every index is in [0, sourceLength). Negative indices are huge as unsigned, so one unsigned max covers both bounds.
+static bool IndicesInRangeN(int* indices, int count, int sourceLength)
+{
+	__m256i maxBlock = _mm256_setzero_si256();
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		maxBlock = _mm256_max_epu32(maxBlock, _mm256_loadu_si256((__m256i*)(&indices[i])));
+	}
+
+	// Reduce the eight maximums to one
+	__m128i max4 = _mm_max_epu32(_mm256_castsi256_si128(maxBlock), _mm256_extracti128_si256(maxBlock, 1));
+	max4 = _mm_max_epu32(max4, _mm_shuffle_epi32(max4, _MM_SHUFFLE(1, 0, 3, 2)));
+	max4 = _mm_max_epu32(max4, _mm_shuffle_epi32(max4, _MM_SHUFFLE(2, 3, 0, 1)));
+	unsigned int maxIndex = (unsigned int)_mm_cvtsi128_si32(max4);
+
+	for (; i < count; ++i)
+	{
+		if ((unsigned int)indices[i] > maxIndex) maxIndex = (unsigned int)indices[i];
+	}
+
+	return (count == 0 || maxIndex < (unsigned int)sourceLength);
+}
+
+template<typename T>
+static bool GatherN(T* source, int sourceLength, int* indices, int count, T* target)
+{
+	if (!IndicesInRangeN(indices, count, sourceLength)) return false;
+
+	int i = 0;
+
+	if (sizeof(T) == 4)
+	{
+		// Gather eight four-byte values at a time
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256i blockIndices = _mm256_loadu_si256((__m256i*)(&indices[i]));
+			_mm256_storeu_si256((__m256i*)(&target[i]), _mm256_i32gather_epi32((int*)source, blockIndices, 4));
+		}
+	}
+	else if (sizeof(T) == 8)
+	{
+		// Gather four eight-byte values at a time
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i blockIndices = _mm_loadu_si128((__m128i*)(&indices[i]));
+			_mm256_storeu_si256((__m256i*)(&target[i]), _mm256_i32gather_epi64((__int64*)source, blockIndices, 8));
+		}
+	}
+	else
+	{
+		// Copy one and two byte values four at a time, prefetching values a few cache lines ahead
+		for (; i + 4 <= count; i += 4)
+		{
+			if (i + 64 < count) _mm_prefetch((char*)(&source[indices[i + 64]]), _MM_HINT_T0);
+
+			target[i] = source[indices[i]];
+			target[i + 1] = source[indices[i + 1]];
+			target[i + 2] = source[indices[i + 2]];
+			target[i + 3] = source[indices[i + 3]];
+		}
+	}
+
+	// Copy remaining values individually
+	for (; i < count; ++i)
+	{
+		target[i] = source[indices[i]];
+	}
+
+	return true;
+}
+
+// Gather the start and length of each indexed row from row end positions; row r spans [ends[r - 1], ends[r]), and row zero starts at zero.
+static bool GatherRangesN(int* ends, int endsLength, int* indices, int count, int* starts, int* lengths)
+{
+	if (!IndicesInRangeN(indices, count, endsLength)) return false;
+
+	int i = 0;
+	__m256i zero = _mm256_setzero_si256();
+	__m256i one = _mm256_set1_epi32(1);
+
+	// Gather eight row ends and the previous row ends (masked off for row zero) at a time
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i blockIndices = _mm256_loadu_si256((__m256i*)(&indices[i]));
+		__m256i hasPrevious = _mm256_cmpgt_epi32(blockIndices, zero);
+
+		__m256i blockEnds = _mm256_i32gather_epi32(ends, blockIndices, 4);
+		__m256i blockStarts = _mm256_mask_i32gather_epi32(zero, ends, _mm256_sub_epi32(blockIndices, one), hasPrevious, 4);
+
+		_mm256_storeu_si256((__m256i*)(&starts[i]), blockStarts);
+		_mm256_storeu_si256((__m256i*)(&lengths[i]), _mm256_sub_epi32(blockEnds, blockStarts));
+	}
+
+	for (; i < count; ++i)
+	{
+		int row = indices[i];
+		int start = (row == 0 ? 0 : ends[row - 1]);
+		starts[i] = start;
+		lengths[i] = ends[row] - start;
+	}
+
+	return true;
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		template<typename T, typename N>
+		static void GatherArray(array<T>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<T>^ target)
+		{
+			if (sourceIndex < 0 || indicesIndex < 0 || count < 0) throw gcnew IndexOutOfRangeException();
+			if (sourceIndex > source->Length || indicesIndex + count > indices->Length || count > target->Length) throw gcnew IndexOutOfRangeException();
+			if (count == 0) return;
+
+			pin_ptr<T> pSource = nullptr;
+			if (sourceIndex < source->Length) pSource = &source[sourceIndex];
+			pin_ptr<Int32> pIndices = &indices[indicesIndex];
+			pin_ptr<T> pTarget = &target[0];
+			KernelScopeN scope(KernelN::Gather, count, (__int64)count * (sizeof(T) * 2 + sizeof(Int32)));
+
+			if (!GatherN<N>((N*)pSource, source->Length - sourceIndex, pIndices, count, (N*)pTarget)) throw gcnew IndexOutOfRangeException();
+		}
+
+		void GatherN::GatherRanges(array<Int32>^ ends, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Int32>^ starts, array<Int32>^ lengths)
+		{
+			if (indicesIndex < 0 || count < 0) throw gcnew IndexOutOfRangeException();
+			if (indicesIndex + count > indices->Length || count > starts->Length || count > lengths->Length) throw gcnew IndexOutOfRangeException();
+			if (count == 0) return;
+
+			pin_ptr<Int32> pEnds = nullptr;
+			if (ends->Length > 0) pEnds = &ends[0];
+			pin_ptr<Int32> pIndices = &indices[indicesIndex];
+			pin_ptr<Int32> pStarts = &starts[0];
+			pin_ptr<Int32> pLengths = &lengths[0];
+			KernelScopeN scope(KernelN::Gather, count, (__int64)count * (sizeof(Int32) * 5));
+
+			if (!GatherRangesN(pEnds, ends->Length, pIndices, count, pStarts, pLengths)) throw gcnew IndexOutOfRangeException();
+		}
+
+		void GatherN::Gather(array<Byte>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Byte>^ target)
+		{
+			GatherArray<Byte, unsigned __int8>(source, sourceIndex, indices, indicesIndex, count, target);
+		}
+
+		void GatherN::Gather(array<SByte>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<SByte>^ target)
+		{
+			GatherArray<SByte, unsigned __int8>(source, sourceIndex, indices, indicesIndex, count, target);
+		}
+
+		void GatherN::Gather(array<Boolean>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Boolean>^ target)
+		{
+			GatherArray<Boolean, unsigned __int8>(source, sourceIndex, indices, indicesIndex, count, target);
+		}
+
+		void GatherN::Gather(array<Int16>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Int16>^ target)
+		{
+			GatherArray<Int16, unsigned __int16>(source, sourceIndex, indices, indicesIndex, count, target);
+		}
+
+		void GatherN::Gather(array<UInt16>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<UInt16>^ target)
+		{
+			GatherArray<UInt16, unsigned __int16>(source, sourceIndex, indices, indicesIndex, count, target);
+		}
+
+		void GatherN::Gather(array<Int32>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Int32>^ target)
+		{
+			GatherArray<Int32, unsigned __int32>(source, sourceIndex, indices, indicesIndex, count, target);
+		}
+
+		void GatherN::Gather(array<UInt32>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<UInt32>^ target)
+		{
+			GatherArray<UInt32, unsigned __int32>(source, sourceIndex, indices, indicesIndex, count, target);
+		}
+
+		void GatherN::Gather(array<Single>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Single>^ target)
+		{
+			GatherArray<Single, unsigned __int32>(source, sourceIndex, indices, indicesIndex, count, target);
+		}
+
+		void GatherN::Gather(array<Int64>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Int64>^ target)
+		{
+			GatherArray<Int64, unsigned __int64>(source, sourceIndex, indices, indicesIndex, count, target);
+		}
+
+		void GatherN::Gather(array<UInt64>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<UInt64>^ target)
+		{
+			GatherArray<UInt64, unsigned __int64>(source, sourceIndex, indices, indicesIndex, count, target);
+		}
+
+		void GatherN::Gather(array<Double>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Double>^ target)
+		{
+			GatherArray<Double, unsigned __int64>(source, sourceIndex, indices, indicesIndex, count, target);
+		}
+	}
+}
@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+using namespace System;
+
+namespace XForm
+{
+	namespace Native
+	{
+		public ref class GatherN
+		{
+		public:
+			// Gather values by index: target[i] = source[sourceIndex + indices[indicesIndex + i]] for i in [0, count).
+			// Throws IndexOutOfRangeException (before writing) if any index is outside the source.
+			static void Gather(array<Byte>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Byte>^ target);
+			static void Gather(array<SByte>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<SByte>^ target);
+			static void Gather(array<Boolean>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Boolean>^ target);
+			static void Gather(array<Int16>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Int16>^ target);
+			static void Gather(array<UInt16>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<UInt16>^ target);
+			static void Gather(array<Int32>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Int32>^ target);
+			static void Gather(array<UInt32>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<UInt32>^ target);
+			static void Gather(array<Single>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Single>^ target);
+			static void Gather(array<Int64>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Int64>^ target);
+			static void Gather(array<UInt64>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<UInt64>^ target);
+			static void Gather(array<Double>^ source, Int32 sourceIndex, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Double>^ target);
+
+			// Gather String8 row ranges from row end positions: for row = indices[indicesIndex + i], starts[i] = (row == 0 ? 0 : ends[row - 1]) and lengths[i] = ends[row] - starts[i].
+			static void GatherRanges(array<Int32>^ ends, array<Int32>^ indices, Int32 indicesIndex, Int32 count, array<Int32>^ starts, array<Int32>^ lengths);
+		};
+	}
+}
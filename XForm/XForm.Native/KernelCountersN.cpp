@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <intrin.h>
+#include <string.h>
+#include "KernelCountersN.h"
+
+#pragma unmanaged
+
+volatile bool KernelCountersEnabledN = false;
+
+// Counters are kept in slots chosen by thread ID, so concurrent threads rarely write the same cache lines.
+// Slots may still be shared, so values are added with interlocked adds.
+const int KernelSlotCountN = 64;
+
+struct __declspec(align(64)) KernelSlotN
+{
+	volatile __int64 Values[KernelCountN * KernelFieldCountN];
+};
+
+static KernelSlotN KernelSlotsN[KernelSlotCountN];
+
+unsigned __int64 KernelCyclesN()
+{
+	return __rdtsc();
+}
+
+void KernelRecordN(KernelN kernel, unsigned __int64 cycles, __int64 elements, __int64 bytes, __int64 matched)
+{
+	// Windows thread IDs are multiples of four
+	KernelSlotN* slot = &KernelSlotsN[(GetCurrentThreadId() >> 2) % KernelSlotCountN];
+	volatile __int64* values = &slot->Values[(int)kernel * KernelFieldCountN];
+
+	_InterlockedExchangeAdd64(&values[0], 1);
+	_InterlockedExchangeAdd64(&values[1], elements);
+	_InterlockedExchangeAdd64(&values[2], bytes);
+	_InterlockedExchangeAdd64(&values[3], matched);
+	_InterlockedExchangeAdd64(&values[4], (__int64)cycles);
+}
+
+__int64 KernelCountBitsN(const unsigned __int64* vector, int bitCount)
+{
+	__int64 count = 0;
+
+	int blockCount = bitCount >> 6;
+	for (int i = 0; i < blockCount; ++i)
+	{
+		count += _mm_popcnt_u64(vector[i]);
+	}
+
+	// Count only the bits below bitCount in the last partial block
+	if ((bitCount & 63) != 0)
+	{
+		count += _mm_popcnt_u64(vector[blockCount] & (~0ULL >> (64 - (bitCount & 63))));
+	}
+
+	return count;
+}
+
+static void KernelReadN(__int64* values)
+{
+	memset(values, 0, KernelCountN * KernelFieldCountN * sizeof(__int64));
+
+	for (int slot = 0; slot < KernelSlotCountN; ++slot)
+	{
+		for (int i = 0; i < KernelCountN * KernelFieldCountN; ++i)
+		{
+			values[i] += KernelSlotsN[slot].Values[i];
+		}
+	}
+}
+
+static void KernelResetN()
+{
+	for (int slot = 0; slot < KernelSlotCountN; ++slot)
+	{
+		for (int i = 0; i < KernelCountN * KernelFieldCountN; ++i)
+		{
+			_InterlockedExchange64(&KernelSlotsN[slot].Values[i], 0);
+		}
+	}
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		void KernelCountersN::Enable(Boolean enabled)
+		{
+			KernelCountersEnabledN = enabled;
+		}
+
+		void KernelCountersN::Reset()
+		{
+			KernelResetN();
+		}
+
+		void KernelCountersN::Read(array<Int64>^ values)
+		{
+			if (values->Length < KernelCountN * KernelFieldCountN) throw gcnew ArgumentOutOfRangeException("values");
+
+			pin_ptr<Int64> pValues = &values[0];
+			KernelReadN(pValues);
+		}
+	}
+}
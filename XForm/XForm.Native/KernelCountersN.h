@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+using namespace System;
+
+// WARNING: Values must stay in sync with XForm.KernelCounters.KernelNames
+
+enum class KernelN : int
+{
+	Where = 0,
+	WhereString = 1,
+	IndexOfAll = 2,
+	SplitTsv = 3,
+	Count = 4,
+	Page = 5,
+	Gather = 6,
+	Parse = 7,
+	Compute = 8,
+	Read = 9,
+	WriteCells = 10,
+	Sketch = 11,
+	BloomFilter = 12
+};
+
+const int KernelCountN = 13;
+
+// Fields recorded for each kernel: Calls, Elements, Bytes, Matched, Cycles
+const int KernelFieldCountN = 5;
+
+extern volatile bool KernelCountersEnabledN;
+
+unsigned __int64 KernelCyclesN();
+void KernelRecordN(KernelN kernel, unsigned __int64 cycles, __int64 elements, __int64 bytes, __int64 matched);
+__int64 KernelCountBitsN(const unsigned __int64* vector, int bitCount);
+
+// KernelScopeN records one kernel call (calls, elements, bytes, rows matched, and TSC cycles) when counters are enabled.
+// When counters are off, it costs one flag check. Declare it after the pin_ptrs, so it's destroyed while they're still pinned.
+class KernelScopeN
+{
+private:
+	KernelN _kernel;
+	unsigned __int64 _start;
+	__int64 _elements;
+	__int64 _bytes;
+	__int64 _matched;
+	const unsigned __int64* _matchVector;
+	int _matchBitCount;
+
+public:
+	KernelScopeN(KernelN kernel, __int64 elements, __int64 bytes) : _kernel(kernel), _start(0), _elements(elements), _bytes(bytes), _matched(0), _matchVector(nullptr), _matchBitCount(0)
+	{
+		if (KernelCountersEnabledN) _start = KernelCyclesN();
+	}
+
+	// Count the rows matched as the bits set in the first matchBitCount bits of the result vector (counted only when enabled)
+	KernelScopeN(KernelN kernel, __int64 elements, __int64 bytes, const unsigned __int64* matchVector, int matchBitCount) : _kernel(kernel), _start(0), _elements(elements), _bytes(bytes), _matched(0), _matchVector(matchVector), _matchBitCount(matchBitCount)
+	{
+		if (KernelCountersEnabledN) _start = KernelCyclesN();
+	}
+
+	~KernelScopeN()
+	{
+		if (_start == 0) return;
+
+		unsigned __int64 cycles = KernelCyclesN() - _start;
+		if (_matchVector != nullptr) _matched = KernelCountBitsN(_matchVector, _matchBitCount);
+		KernelRecordN(_kernel, cycles, _elements, _bytes, _matched);
+	}
+
+	// Record the rows matched, for kernels which return a count
+	void Matched(__int64 count)
+	{
+		_matched = count;
+	}
+};
+
+namespace XForm
+{
+	namespace Native
+	{
+		public ref class KernelCountersN
+		{
+		public:
+			// Turn counting on or off for all threads.
+			static void Enable(Boolean enabled);
+
+			// Clear all counters. Calls running concurrently may be partially cleared.
+			static void Reset();
+
+			// Write the totals across threads to values, KernelFieldCount values per kernel in KernelN order.
+			static void Read(array<Int64>^ values);
+		};
+	}
+}
@@ -0,0 +1,161 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <vcclr.h>
+#include "MappedFileN.h"
+#include "KernelCountersN.h"
+
+using namespace System::IO;
+using namespace System::Runtime::InteropServices;
+
+#pragma unmanaged
+
+// Bytes to prefetch ahead of a sequential reader
+const __int64 ReadAheadBytesN = 8 * 1024 * 1024;
+
+struct MappedFileData
+{
+	HANDLE file;
+	HANDLE mapping;
+	unsigned __int8* view;
+	__int64 length;
+
+	// End of the last read, to detect sequential access, and end of the prefetched range
+	__int64 lastReadEnd;
+	__int64 prefetchedEnd;
+};
+
+static MappedFileData* OpenN(const wchar_t* filePath, DWORD* error)
+{
+	HANDLE file = CreateFileW(filePath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		*error = GetLastError();
+		return nullptr;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		*error = (size.QuadPart == 0 ? ERROR_SUCCESS : GetLastError());
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void* view = (mapping == nullptr ? nullptr : MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (view == nullptr)
+	{
+		*error = GetLastError();
+		if (mapping != nullptr) CloseHandle(mapping);
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	MappedFileData* data = new MappedFileData();
+	data->file = file;
+	data->mapping = mapping;
+	data->view = (unsigned __int8*)view;
+	data->length = size.QuadPart;
+	data->lastReadEnd = 0;
+	data->prefetchedEnd = 0;
+	return data;
+}
+
+static void FreeN(MappedFileData* data)
+{
+	UnmapViewOfFile(data->view);
+	CloseHandle(data->mapping);
+	CloseHandle(data->file);
+	delete data;
+}
+
+static void ReadN(MappedFileData* data, __int64 byteOffset, unsigned __int8* target, int byteCount)
+{
+	__int64 readEnd = byteOffset + byteCount;
+
+	// If this read continues the last one and runs past the prefetched range, ask the OS to bring in the next window
+	if (byteOffset == data->lastReadEnd && readEnd > data->prefetchedEnd - ReadAheadBytesN / 2)
+	{
+		__int64 prefetchStart = (data->prefetchedEnd > byteOffset ? data->prefetchedEnd : byteOffset);
+		__int64 prefetchEnd = readEnd + ReadAheadBytesN;
+		if (prefetchEnd > data->length) prefetchEnd = data->length;
+
+		if (prefetchStart < prefetchEnd)
+		{
+			WIN32_MEMORY_RANGE_ENTRY range;
+			range.VirtualAddress = data->view + prefetchStart;
+			range.NumberOfBytes = (SIZE_T)(prefetchEnd - prefetchStart);
+
+			// Prefetch is only a hint; reads still work if it's unavailable or fails
+			PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+			data->prefetchedEnd = prefetchEnd;
+		}
+	}
+
+	memcpy(target, data->view + byteOffset, byteCount);
+	data->lastReadEnd = readEnd;
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		IntPtr MappedFileN::Open(String^ filePath, Int64% length)
+		{
+			if (filePath == nullptr) throw gcnew ArgumentNullException("filePath");
+
+			pin_ptr<const wchar_t> pFilePath = PtrToStringChars(filePath);
+			DWORD error = ERROR_SUCCESS;
+			MappedFileData* data = OpenN(pFilePath, &error);
+
+			if (data == nullptr)
+			{
+				if (error != ERROR_SUCCESS) throw gcnew IOException(String::Format("Unable to map \"{0}\". Error {1}.", filePath, error));
+				length = 0;
+				return IntPtr::Zero;
+			}
+
+			length = data->length;
+			return IntPtr(data);
+		}
+
+		void MappedFileN::Free(IntPtr file)
+		{
+			if (file == IntPtr::Zero) return;
+			FreeN((MappedFileData*)file.ToPointer());
+		}
+
+		IntPtr MappedFileN::Address(IntPtr file)
+		{
+			if (file == IntPtr::Zero) throw gcnew ArgumentNullException("file");
+			return IntPtr(((MappedFileData*)file.ToPointer())->view);
+		}
+
+		void MappedFileN::Read(IntPtr file, Int64 byteOffset, Array^ target, Int32 targetByteIndex, Int32 byteCount)
+		{
+			if (byteCount == 0) return;
+			if (file == IntPtr::Zero) throw gcnew ArgumentNullException("file");
+			if (target == nullptr) throw gcnew ArgumentNullException("target");
+
+			MappedFileData* data = (MappedFileData*)file.ToPointer();
+			if (byteOffset < 0 || byteCount < 0 || byteOffset + byteCount > data->length) throw gcnew IndexOutOfRangeException();
+			if (targetByteIndex < 0 || targetByteIndex + byteCount > Buffer::ByteLength(target)) throw gcnew IndexOutOfRangeException();
+
+			GCHandle handle = GCHandle::Alloc(target, GCHandleType::Pinned);
+			try
+			{
+				unsigned __int8* pTarget = (unsigned __int8*)handle.AddrOfPinnedObject().ToPointer();
+				KernelScopeN scope(KernelN::Read, byteCount, byteCount);
+				ReadN(data, byteOffset, pTarget + targetByteIndex, byteCount);
+			}
+			finally
+			{
+				handle.Free();
+			}
+		}
+	}
+}
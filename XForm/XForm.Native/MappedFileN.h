@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+using namespace System;
+
+namespace XForm
+{
+	namespace Native
+	{
+		public ref class MappedFileN
+		{
+		public:
+			// Map a file read-only. Returns IntPtr.Zero for empty files. Must be released with Free.
+			static IntPtr Open(String^ filePath, Int64% length);
+			static void Free(IntPtr file);
+
+			// Copy byteCount bytes at byteOffset in the file into target (any primitive array) at targetByteIndex.
+			// Sequential reads prefetch the following window of the file so the next pages are already resident.
+			static void Read(IntPtr file, Int64 byteOffset, Array^ target, Int32 targetByteIndex, Int32 byteCount);
+
+			// Return the address of the start of the mapped file, valid until Free, for kernels which read the whole file in place.
+			static IntPtr Address(IntPtr file);
+		};
+	}
+}
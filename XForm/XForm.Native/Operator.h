@@ -12,7 +12,11 @@ public enum CompareOperatorN : char
 	LessThan = 2,
 	LessThanOrEqual = 3,
 	GreaterThan = 4,
-	GreaterThanOrEqual = 5
+	GreaterThanOrEqual = 5,
+	Contains = 6,
+	ContainsExact = 7,
+	StartsWith = 8,
+	EndsWith = 9
 };
 
 public enum BooleanOperatorN : char
@@ -0,0 +1,161 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <intrin.h>
+#include "PackedN.h"
+
+#pragma unmanaged
+
+// Read the index'th bitWidth-bit value, which may span two words
+static __inline unsigned __int64 UnpackOneN(unsigned __int64* words, int bitWidth, unsigned __int64 mask, __int64 index)
+{
+	__int64 bit = index * bitWidth;
+	int word = (int)(bit >> 6);
+	int shift = (int)(bit & 63);
+
+	unsigned __int64 value = words[word] >> shift;
+	if (shift + bitWidth > 64) value |= words[word + 1] << (64 - shift);
+	return value & mask;
+}
+
+// Store a block of four 64-bit values to 32-bit or 64-bit targets
+static __inline void StoreN(__int32* target, __m256i values)
+{
+	__m256i low = _mm256_permutevar8x32_epi32(values, _mm256_set_epi32(7, 5, 3, 1, 6, 4, 2, 0));
+	_mm_storeu_si128((__m128i*)target, _mm256_castsi256_si128(low));
+}
+
+static __inline void StoreN(__int64* target, __m256i values)
+{
+	_mm256_storeu_si256((__m256i*)target, values);
+}
+
+template<typename T>
+static void UnpackN(unsigned __int64* words, __int64 wordCount, int bitWidth, __int64 baseValue, int count, T* target)
+{
+	int i = 0;
+
+	if (bitWidth == 0)
+	{
+		for (; i < count; ++i)
+		{
+			target[i] = (T)baseValue;
+		}
+
+		return;
+	}
+
+	unsigned __int64 mask = (bitWidth == 64 ? ~0ULL : (1ULL << bitWidth) - 1);
+
+	if (bitWidth <= 56)
+	{
+		// Any value of 56 bits or less is within one unaligned eight-byte load at (bit / 8), shifted by (bit % 8).
+		// Gather four of those loads at a time, shift and mask each, and add the base.
+		unsigned __int8* bytes = (unsigned __int8*)words;
+		__int64 byteCount = wordCount * 8;
+
+		__m256i bitPosition = _mm256_set_epi64x(3 * bitWidth, 2 * bitWidth, bitWidth, 0);
+		__m256i bitStep = _mm256_set1_epi64x(4 * (__int64)bitWidth);
+		__m256i seven = _mm256_set1_epi64x(7);
+		__m256i maskBlock = _mm256_set1_epi64x((__int64)mask);
+		__m256i baseBlock = _mm256_set1_epi64x(baseValue);
+
+		// Stop while the last load in the block is still inside the words
+		for (; i + 4 <= count && (((__int64)(i + 3) * bitWidth) >> 3) + 8 <= byteCount; i += 4)
+		{
+			__m256i byteOffset = _mm256_srli_epi64(bitPosition, 3);
+			__m256i shift = _mm256_and_si256(bitPosition, seven);
+
+			__m256i values = _mm256_i64gather_epi64((const long long*)bytes, byteOffset, 1);
+			values = _mm256_and_si256(_mm256_srlv_epi64(values, shift), maskBlock);
+			StoreN(&target[i], _mm256_add_epi64(values, baseBlock));
+
+			bitPosition = _mm256_add_epi64(bitPosition, bitStep);
+		}
+	}
+
+	for (; i < count; ++i)
+	{
+		target[i] = (T)(baseValue + (__int64)UnpackOneN(words, bitWidth, mask, i));
+	}
+}
+
+template<typename T>
+static void UnpackDeltaN(unsigned __int64* words, __int64 wordCount, int bitWidth, __int64 firstValue, __int64 deltaBase, int count, T* target)
+{
+	if (count == 0) return;
+
+	// Unpack the deltas after the first value, then add each to the value before it (wrapping, as the encoder subtracted)
+	target[0] = (T)firstValue;
+	UnpackN<T>(words, wordCount, bitWidth, deltaBase, count - 1, &target[1]);
+
+	unsigned __int64 current = (unsigned __int64)firstValue;
+	for (int i = 1; i < count; ++i)
+	{
+		current += (unsigned __int64)(__int64)target[i];
+		target[i] = (T)current;
+	}
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		static void ValidateUnpackArguments(Array^ words, Int32 wordIndex, Int32 bitWidth, Int32 count, Array^ target, Int32 targetIndex)
+		{
+			if (bitWidth < 0 || bitWidth > 64) throw gcnew ArgumentOutOfRangeException("bitWidth");
+			if (count < 0 || wordIndex < 0 || targetIndex < 0 || targetIndex + count > target->Length) throw gcnew IndexOutOfRangeException();
+			if (wordIndex + ((__int64)count * bitWidth + 63) / 64 > words->Length) throw gcnew IndexOutOfRangeException();
+		}
+
+		template<typename T, typename N>
+		static void Unpack(array<UInt64>^ words, Int32 wordIndex, Int32 bitWidth, Int64 baseValue, Int32 count, array<T>^ target, Int32 targetIndex)
+		{
+			ValidateUnpackArguments(words, wordIndex, bitWidth, count, target, targetIndex);
+			if (count == 0) return;
+
+			pin_ptr<UInt64> pWords = nullptr;
+			if (wordIndex < words->Length) pWords = &words[wordIndex];
+			pin_ptr<T> pTarget = &target[targetIndex];
+
+			UnpackN<N>((unsigned __int64*)pWords, words->Length - wordIndex, bitWidth, baseValue, count, (N*)pTarget);
+		}
+
+		template<typename T, typename N>
+		static void UnpackDelta(array<UInt64>^ words, Int32 wordIndex, Int32 bitWidth, Int64 firstValue, Int64 deltaBase, Int32 count, array<T>^ target, Int32 targetIndex)
+		{
+			ValidateUnpackArguments(words, wordIndex, bitWidth, (count > 0 ? count - 1 : 0), target, targetIndex);
+			if (count == 0) return;
+			if (targetIndex + count > target->Length) throw gcnew IndexOutOfRangeException();
+
+			pin_ptr<UInt64> pWords = nullptr;
+			if (wordIndex < words->Length) pWords = &words[wordIndex];
+			pin_ptr<T> pTarget = &target[targetIndex];
+
+			UnpackDeltaN<N>((unsigned __int64*)pWords, words->Length - wordIndex, bitWidth, firstValue, deltaBase, count, (N*)pTarget);
+		}
+
+		void PackedN::Unpack(array<UInt64>^ words, Int32 wordIndex, Int32 bitWidth, Int64 baseValue, Int32 count, array<Int32>^ target, Int32 targetIndex)
+		{
+			XForm::Native::Unpack<Int32, __int32>(words, wordIndex, bitWidth, baseValue, count, target, targetIndex);
+		}
+
+		void PackedN::Unpack(array<UInt64>^ words, Int32 wordIndex, Int32 bitWidth, Int64 baseValue, Int32 count, array<Int64>^ target, Int32 targetIndex)
+		{
+			XForm::Native::Unpack<Int64, __int64>(words, wordIndex, bitWidth, baseValue, count, target, targetIndex);
+		}
+
+		void PackedN::UnpackDelta(array<UInt64>^ words, Int32 wordIndex, Int32 bitWidth, Int64 firstValue, Int64 deltaBase, Int32 count, array<Int32>^ target, Int32 targetIndex)
+		{
+			XForm::Native::UnpackDelta<Int32, __int32>(words, wordIndex, bitWidth, firstValue, deltaBase, count, target, targetIndex);
+		}
+
+		void PackedN::UnpackDelta(array<UInt64>^ words, Int32 wordIndex, Int32 bitWidth, Int64 firstValue, Int64 deltaBase, Int32 count, array<Int64>^ target, Int32 targetIndex)
+		{
+			XForm::Native::UnpackDelta<Int64, __int64>(words, wordIndex, bitWidth, firstValue, deltaBase, count, target, targetIndex);
+		}
+	}
+}
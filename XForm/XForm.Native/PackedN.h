@@ -0,0 +1,23 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+using namespace System;
+
+namespace XForm
+{
+	namespace Native
+	{
+		public ref class PackedN
+		{
+		public:
+			// Unpack count bitWidth-bit values from words (starting at wordIndex), adding baseValue, into target at targetIndex.
+			static void Unpack(array<UInt64>^ words, Int32 wordIndex, Int32 bitWidth, Int64 baseValue, Int32 count, array<Int32>^ target, Int32 targetIndex);
+			static void Unpack(array<UInt64>^ words, Int32 wordIndex, Int32 bitWidth, Int64 baseValue, Int32 count, array<Int64>^ target, Int32 targetIndex);
+
+			// Decode count delta-encoded values: target[0] = firstValue and each following value adds deltaBase and the next (count - 1) unpacked deltas.
+			static void UnpackDelta(array<UInt64>^ words, Int32 wordIndex, Int32 bitWidth, Int64 firstValue, Int64 deltaBase, Int32 count, array<Int32>^ target, Int32 targetIndex);
+			static void UnpackDelta(array<UInt64>^ words, Int32 wordIndex, Int32 bitWidth, Int64 firstValue, Int64 deltaBase, Int32 count, array<Int64>^ target, Int32 targetIndex);
+		};
+	}
+}
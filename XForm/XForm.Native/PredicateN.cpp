@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <string.h>
+#include "Operator.h"
+#include "ComparerN.h"
+#include "PredicateN.h"
+#include "KernelCountersN.h"
+
+#pragma unmanaged
+
+// In BitVectorN.cpp
+int CountN(unsigned __int64* matchVector, int length);
+
+// Rows per chunk; the chunk match bits (512 bytes) stay in L1 while each term is merged into them
+const int PredicateChunkRowsN = 4096;
+
+static int ColumnTypeSizeN(ColumnTypeN type)
+{
+	switch (type)
+	{
+	case ColumnTypeN::Unsigned8:
+	case ColumnTypeN::Signed8:
+		return 1;
+	case ColumnTypeN::Unsigned16:
+	case ColumnTypeN::Signed16:
+		return 2;
+	case ColumnTypeN::Unsigned32:
+	case ColumnTypeN::Signed32:
+	case ColumnTypeN::Float32:
+		return 4;
+	default:
+		return 8;
+	}
+}
+
+static void WhereTermN(ColumnTypeN type, const void* column, __int64 startRow, int length, CompareOperatorN cOp, __int64 constant, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	switch (type)
+	{
+	case ColumnTypeN::Unsigned8:
+		Where8N(cOp, SigningN::Unsigned, (unsigned __int8*)column + startRow, length, (unsigned __int8)constant, bOp, matchVector);
+		break;
+	case ColumnTypeN::Signed8:
+		Where8N(cOp, SigningN::Signed, (unsigned __int8*)column + startRow, length, (unsigned __int8)constant, bOp, matchVector);
+		break;
+	case ColumnTypeN::Unsigned16:
+		Where16N(cOp, bOp, SigningN::Unsigned, (unsigned __int16*)column + startRow, length, (unsigned __int16)constant, matchVector);
+		break;
+	case ColumnTypeN::Signed16:
+		Where16N(cOp, bOp, SigningN::Signed, (unsigned __int16*)column + startRow, length, (unsigned __int16)constant, matchVector);
+		break;
+	case ColumnTypeN::Unsigned32:
+		WhereWideN(cOp, (const unsigned __int32*)column + startRow, length, (unsigned __int32)constant, nullptr, bOp, matchVector);
+		break;
+	case ColumnTypeN::Signed32:
+		WhereWideN(cOp, (const __int32*)column + startRow, length, (__int32)constant, nullptr, bOp, matchVector);
+		break;
+	case ColumnTypeN::Unsigned64:
+		WhereWideN(cOp, (const unsigned __int64*)column + startRow, length, (unsigned __int64)constant, nullptr, bOp, matchVector);
+		break;
+	case ColumnTypeN::Signed64:
+		WhereWideN(cOp, (const __int64*)column + startRow, length, constant, nullptr, bOp, matchVector);
+		break;
+	case ColumnTypeN::Float32:
+	{
+		unsigned __int32 bits = (unsigned __int32)constant;
+		float value;
+		memcpy(&value, &bits, sizeof(float));
+		WhereWideN(cOp, (const float*)column + startRow, length, value, nullptr, bOp, matchVector);
+		break;
+	}
+	case ColumnTypeN::Float64:
+	{
+		double value;
+		memcpy(&value, &constant, sizeof(double));
+		WhereWideN(cOp, (const double*)column + startRow, length, value, nullptr, bOp, matchVector);
+		break;
+	}
+	}
+}
+
+static __int64 EvaluateN(int termCount, const void* const* columns, const ColumnTypeN* types, const CompareOperatorN* cOps, const __int64* constants, const BooleanOperatorN* bOps, __int64 startRow, __int64 endRow, unsigned __int64* vector)
+{
+	unsigned __int64 chunk[PredicateChunkRowsN >> 6];
+	__int64 count = 0;
+
+	for (__int64 chunkStart = startRow; chunkStart < endRow; chunkStart += PredicateChunkRowsN)
+	{
+		int length = (int)(endRow - chunkStart < PredicateChunkRowsN ? endRow - chunkStart : PredicateChunkRowsN);
+		int blockCount = (length + 63) >> 6;
+
+		// Write matches straight to the result vector, if there is one
+		unsigned __int64* matches = (vector != nullptr ? &vector[chunkStart >> 6] : chunk);
+		memset(matches, 0, blockCount * sizeof(unsigned __int64));
+
+		for (int term = 0; term < termCount; ++term)
+		{
+			BooleanOperatorN bOp = (term == 0 ? BooleanOperatorN::Or : bOps[term]);
+
+			// While no rows in the chunk match, terms ANDed in can't change the result
+			if (bOp == BooleanOperatorN::And)
+			{
+				unsigned __int64 any = 0;
+				for (int i = 0; i < blockCount; ++i) any |= matches[i];
+				if (any == 0) continue;
+			}
+
+			WhereTermN(types[term], columns[term], chunkStart, length, cOps[term], constants[term], bOp, matches);
+		}
+
+		count += CountN(matches, blockCount);
+	}
+
+	return count;
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		Int64 PredicateN::Evaluate(array<IntPtr>^ columns, array<Byte>^ types, array<Byte>^ compareOperators, array<Int64>^ constants, array<Byte>^ booleanOperators, Int64 startRow, Int64 endRow, array<UInt64>^ vector)
+		{
+			if (columns == nullptr || types == nullptr || compareOperators == nullptr || constants == nullptr || booleanOperators == nullptr) throw gcnew ArgumentNullException();
+
+			int termCount = columns->Length;
+			if (termCount == 0) throw gcnew ArgumentException("columns");
+			if (types->Length != termCount || compareOperators->Length != termCount || constants->Length != termCount || booleanOperators->Length != termCount) throw gcnew ArgumentException("All predicate term arrays must be the same length.");
+			if (startRow < 0 || endRow < startRow) throw gcnew IndexOutOfRangeException();
+			if ((startRow & 63) != 0) throw gcnew ArgumentException("Predicates must be evaluated from a multiple of 64 row.");
+			if (vector != nullptr && endRow > ((Int64)vector->Length * 64)) throw gcnew IndexOutOfRangeException("vector");
+			if (endRow == startRow) return 0;
+
+			__int64 bytesPerRow = 0;
+			for (int term = 0; term < termCount; ++term)
+			{
+				if (columns[term] == IntPtr::Zero) throw gcnew ArgumentNullException("columns");
+				if (types[term] > (Byte)ColumnTypeN::Float64) throw gcnew ArgumentException("types");
+				if (compareOperators[term] > (Byte)CompareOperatorN::GreaterThanOrEqual) throw gcnew ArgumentException("compareOperators");
+				if (booleanOperators[term] > (Byte)BooleanOperatorN::Or) throw gcnew ArgumentException("booleanOperators");
+				bytesPerRow += ColumnTypeSizeN((ColumnTypeN)types[term]);
+			}
+
+			pin_ptr<IntPtr> pColumns = &columns[0];
+			pin_ptr<Byte> pTypes = &types[0];
+			pin_ptr<Byte> pCompareOperators = &compareOperators[0];
+			pin_ptr<Int64> pConstants = &constants[0];
+			pin_ptr<Byte> pBooleanOperators = &booleanOperators[0];
+
+			pin_ptr<UInt64> pVector = nullptr;
+			if (vector != nullptr) pVector = &vector[0];
+
+			__int64 rowCount = endRow - startRow;
+			KernelScopeN scope(KernelN::Where, rowCount * termCount, rowCount * bytesPerRow);
+			__int64 count = EvaluateN(termCount, (const void* const*)pColumns, (ColumnTypeN*)pTypes, (CompareOperatorN*)pCompareOperators, pConstants, (BooleanOperatorN*)pBooleanOperators, startRow, endRow, pVector);
+			scope.Matched(count);
+
+			return count;
+		}
+	}
+}
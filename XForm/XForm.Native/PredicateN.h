@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+using namespace System;
+
+// WARNING: Values must stay in sync with XForm.Query.Expression.ColumnPredicate.ColumnType
+
+public enum ColumnTypeN : char
+{
+	Unsigned8 = 0,
+	Signed8 = 1,
+	Unsigned16 = 2,
+	Signed16 = 3,
+	Unsigned32 = 4,
+	Signed32 = 5,
+	Unsigned64 = 6,
+	Signed64 = 7,
+	Float32 = 8,
+	Float64 = 9
+};
+
+namespace XForm
+{
+	namespace Native
+	{
+		public ref class PredicateN
+		{
+		public:
+			// Evaluate a compiled predicate on rows [startRow, endRow) of whole columns in memory (mapped files or pinned arrays).
+			// Term i compares the values at columns[i] (of type types[i]) to constants[i] (the value's bits, zero-extended to 64 bits)
+			// with compareOperators[i], and is merged into the result with booleanOperators[i] (ignored for the first term).
+			// Rows are evaluated in small chunks with every term, so the match bits stay in cache and columns are read once.
+			// If vector isn't null, the match bits for the rows are written to it (bit N is row N). Returns the match count.
+			//
+			// Columns must be valid for endRow rows; startRow must be a multiple of 64, so that concurrent calls for
+			// different row ranges never write the same vector blocks.
+			static Int64 Evaluate(array<IntPtr>^ columns, array<Byte>^ types, array<Byte>^ compareOperators, array<Int64>^ constants, array<Byte>^ booleanOperators, Int64 startRow, Int64 endRow, array<UInt64>^ vector);
+		};
+	}
+}
@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <intrin.h>
+#include "SketchN.h"
+#include "KernelCountersN.h"
+
+#pragma unmanaged
+
+// Return the HyperLogLog rank of a hash: one more than the leading zeros after the top 'precision' (register index) bits
+static __inline unsigned __int8 RankN(unsigned __int64 hash, int precision)
+{
+	// The guard bit caps the rank at (64 - precision + 1) when all the remaining bits are zero
+	unsigned __int64 remaining = (hash << precision) | (1ULL << (precision - 1));
+	unsigned long highestSet;
+	_BitScanReverse64(&highestSet, remaining);
+	return (unsigned __int8)(64 - highestSet);
+}
+
+static __inline void HyperLogLogAddOneN(unsigned __int64 hash, unsigned __int8* registers, int precision)
+{
+	unsigned __int8* target = &registers[hash >> (64 - precision)];
+	unsigned __int8 rank = RankN(hash, precision);
+	if (rank > *target) *target = rank;
+}
+
+void HyperLogLogAddN(const unsigned __int64* hashes, int length, unsigned __int8* registers, int precision)
+{
+	// Register updates are scattered and may collide within a block, so they're done one at a time; unrolling lets the ranks overlap
+	int i = 0;
+	int end = length & ~3;
+	for (; i < end; i += 4)
+	{
+		HyperLogLogAddOneN(hashes[i], registers, precision);
+		HyperLogLogAddOneN(hashes[i + 1], registers, precision);
+		HyperLogLogAddOneN(hashes[i + 2], registers, precision);
+		HyperLogLogAddOneN(hashes[i + 3], registers, precision);
+	}
+
+	for (; i < length; ++i)
+	{
+		HyperLogLogAddOneN(hashes[i], registers, precision);
+	}
+}
+
+void HyperLogLogMergeN(unsigned __int8* target, const unsigned __int8* source, int length)
+{
+	int i = 0;
+	int end = length & ~31;
+	for (; i < end; i += 32)
+	{
+		__m256i left = _mm256_loadu_si256((__m256i*)(&target[i]));
+		__m256i right = _mm256_loadu_si256((__m256i*)(&source[i]));
+		_mm256_storeu_si256((__m256i*)(&target[i]), _mm256_max_epu8(left, right));
+	}
+
+	for (; i < length; ++i)
+	{
+		if (source[i] > target[i]) target[i] = source[i];
+	}
+}
+
+// Odd multipliers for each count-min row; the top bits of (hash * multiplier) choose the bucket, so rows collide independently
+// WARNING: Must stay in sync with CountMinSketch.RowMultipliers
+static const unsigned __int64 CountMinRowMultipliersN[] = { 0x9E3779B97F4A7C15, 0xC2B2AE3D27D4EB4F, 0x165667B19E3779F9, 0xD6E8FEB86659FD93, 0xFF51AFD7ED558CCD, 0xC4CEB9FE1A85EC53, 0x87C37B91114253D5, 0x4CF5AD432745937F };
+const int CountMinMaxDepthN = 8;
+
+void CountMinAddN(const unsigned __int64* hashes, int length, unsigned __int32* counters, int depth, int widthBits, unsigned __int32* estimates)
+{
+	unsigned __int32 width = 1U << widthBits;
+	int shift = 64 - widthBits;
+
+	for (int i = 0; i < length; ++i)
+	{
+		unsigned __int64 hash = hashes[i];
+		unsigned __int32 minimum = 0xFFFFFFFF;
+
+		unsigned __int32* row = counters;
+		for (int r = 0; r < depth; ++r)
+		{
+			unsigned __int32* counter = &row[(hash * CountMinRowMultipliersN[r]) >> shift];
+			unsigned __int32 count = *counter + 1;
+			if (count != 0) *counter = count;
+			if (*counter < minimum) minimum = *counter;
+			row += width;
+		}
+
+		if (estimates != nullptr) estimates[i] = minimum;
+	}
+}
+
+void CountMinMergeN(unsigned __int32* target, const unsigned __int32* source, int length)
+{
+	// Counts saturate rather than wrapping, so merged estimates never drop
+	__m256i allOnes = _mm256_set1_epi32(-1);
+
+	int i = 0;
+	int end = length & ~7;
+	for (; i < end; i += 8)
+	{
+		__m256i left = _mm256_loadu_si256((__m256i*)(&target[i]));
+		__m256i right = _mm256_loadu_si256((__m256i*)(&source[i]));
+		__m256i room = _mm256_xor_si256(left, allOnes);
+		_mm256_storeu_si256((__m256i*)(&target[i]), _mm256_add_epi32(left, _mm256_min_epu32(right, room)));
+	}
+
+	for (; i < length; ++i)
+	{
+		unsigned __int32 room = 0xFFFFFFFF - target[i];
+		target[i] += (source[i] < room ? source[i] : room);
+	}
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		static int PowerOfTwoBitsN(int length)
+		{
+			if (length <= 0 || (length & (length - 1)) != 0) return -1;
+
+			unsigned long bits;
+			_BitScanForward64(&bits, (unsigned __int64)length);
+			return (int)bits;
+		}
+
+		void HyperLogLogN::Add(array<UInt64>^ hashes, Int32 index, Int32 length, array<Byte>^ registers)
+		{
+			if (index < 0 || length < 0 || index + length > hashes->Length) throw gcnew IndexOutOfRangeException();
+
+			int precision = PowerOfTwoBitsN(registers->Length);
+			if (precision < 4 || precision > 16) throw gcnew ArgumentException("registers must be a power of two from 16 to 65,536 long.", "registers");
+			if (length == 0) return;
+
+			pin_ptr<UInt64> pHashes = &hashes[index];
+			pin_ptr<Byte> pRegisters = &registers[0];
+			KernelScopeN scope(KernelN::Sketch, length, 8 * (__int64)length);
+
+			HyperLogLogAddN((unsigned __int64*)pHashes, length, (unsigned __int8*)pRegisters, precision);
+		}
+
+		void HyperLogLogN::Merge(array<Byte>^ target, array<Byte>^ source)
+		{
+			if (target->Length != source->Length) throw gcnew ArgumentException("target and source must be the same length.");
+			if (target->Length == 0) return;
+
+			pin_ptr<Byte> pTarget = &target[0];
+			pin_ptr<Byte> pSource = &source[0];
+			KernelScopeN scope(KernelN::Sketch, target->Length, 2 * (__int64)target->Length);
+
+			HyperLogLogMergeN((unsigned __int8*)pTarget, (unsigned __int8*)pSource, target->Length);
+		}
+
+		void CountMinN::Add(array<UInt64>^ hashes, Int32 index, Int32 length, array<UInt32>^ counters, Int32 depth, array<UInt32>^ estimates)
+		{
+			if (index < 0 || length < 0 || index + length > hashes->Length) throw gcnew IndexOutOfRangeException();
+			if (depth <= 0 || depth > CountMinMaxDepthN || counters->Length % depth != 0) throw gcnew ArgumentOutOfRangeException("depth");
+
+			int widthBits = PowerOfTwoBitsN(counters->Length / depth);
+			if (widthBits < 4) throw gcnew ArgumentException("counters must have a power of two width of at least 16.", "counters");
+			if (estimates != nullptr && estimates->Length < length) throw gcnew IndexOutOfRangeException();
+			if (length == 0) return;
+
+			pin_ptr<UInt64> pHashes = &hashes[index];
+			pin_ptr<UInt32> pCounters = &counters[0];
+			pin_ptr<UInt32> pEstimates = nullptr;
+			if (estimates != nullptr) pEstimates = &estimates[0];
+			KernelScopeN scope(KernelN::Sketch, length, 8 * (__int64)length);
+
+			CountMinAddN((unsigned __int64*)pHashes, length, (unsigned __int32*)pCounters, depth, widthBits, (unsigned __int32*)pEstimates);
+		}
+
+		void CountMinN::Merge(array<UInt32>^ target, array<UInt32>^ source)
+		{
+			if (target->Length != source->Length) throw gcnew ArgumentException("target and source must be the same length.");
+			if (target->Length == 0) return;
+
+			pin_ptr<UInt32> pTarget = &target[0];
+			pin_ptr<UInt32> pSource = &source[0];
+			KernelScopeN scope(KernelN::Sketch, target->Length, 8 * (__int64)target->Length);
+
+			CountMinMergeN((unsigned __int32*)pTarget, (unsigned __int32*)pSource, target->Length);
+		}
+	}
+}
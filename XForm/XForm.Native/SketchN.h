@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+using namespace System;
+
+namespace XForm
+{
+	namespace Native
+	{
+		public ref class HyperLogLogN
+		{
+		public:
+			// Add hashes[index, index + length) to the registers, which must be a power of two in length (16 to 65,536).
+			static void Add(array<UInt64>^ hashes, Int32 index, Int32 length, array<Byte>^ registers);
+
+			// Merge source registers into target (the per-register maximum). Both must be the same length.
+			static void Merge(array<Byte>^ target, array<Byte>^ source);
+		};
+
+		public ref class CountMinN
+		{
+		public:
+			// Count hashes[index, index + length) in depth (1 to 8) rows of counters; each row's width must be a power of two of at least 16.
+			// If estimates isn't null, estimates[i] is set to the count of hashes[index + i] after it was added.
+			static void Add(array<UInt64>^ hashes, Int32 index, Int32 length, array<UInt32>^ counters, Int32 depth, array<UInt32>^ estimates);
+
+			// Merge source counters into target (the per-counter sum). Both must be the same length.
+			static void Merge(array<UInt32>^ target, array<UInt32>^ source);
+		};
+	}
+}
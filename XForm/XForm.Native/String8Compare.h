@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+#pragma managed(push, off)
+
+// Lowercase an ASCII letter; leave all other bytes unchanged
+static __inline unsigned __int8 ToLowerN(unsigned __int8 value)
+{
+	return ((unsigned __int8)(value - 'A') < 26 ? value | 0x20 : value);
+}
+
+// Get the bits to OR into a text byte to fold it to lowercase, given the (lowercase) byte to match. Letters fold only to themselves and their uppercase form.
+static __inline unsigned __int8 CaseFoldMaskN(unsigned __int8 lowerValue)
+{
+	return ((unsigned __int8)(lowerValue - 'a') < 26 ? 0x20 : 0x00);
+}
+
+template<bool ignoreCase>
+static bool EqualsN(unsigned __int8* text, unsigned __int8* value, int length)
+{
+	int i = 0;
+
+	if (!ignoreCase)
+	{
+		// Compare eight bytes at a time while there's enough data
+		for (; i + 8 <= length; i += 8)
+		{
+			if (*(unsigned __int64*)(&text[i]) != *(unsigned __int64*)(&value[i])) return false;
+		}
+	}
+
+	for (; i < length; ++i)
+	{
+		if (ignoreCase)
+		{
+			unsigned __int8 lowerValue = ToLowerN(value[i]);
+			if ((text[i] | CaseFoldMaskN(lowerValue)) != lowerValue) return false;
+		}
+		else
+		{
+			if (text[i] != value[i]) return false;
+		}
+	}
+
+	return true;
+}
+
+#pragma managed(pop)
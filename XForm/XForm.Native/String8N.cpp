@@ -4,29 +4,24 @@
 #include "stdafx.h"
 #include <intrin.h>
 #include <nmmintrin.h>
+#include "Operator.h"
+#include "String8Compare.h"
 #include "String8N.h"
+#include "KernelCountersN.h"
 
 #pragma unmanaged
-const int Utf8IndexOfMode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ORDERED;
-const int Utf8FirstDifferentCharacterMode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_EACH | _SIDD_NEGATIVE_POLARITY;
-const int Utf8RangeMaskMode = _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_UNIT_MASK;
-
-const __m128i uppercaseRange = { 'A', 'Z' };
-const __m128i caseConvert = { 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 };
-
+// Word (i - contentIndex) >> 6 of each vector holds the bits for content[i], so the vectors start at contentIndex
 static int SplitTsvN(unsigned __int8* content, int contentIndex, int contentEnd, unsigned __int64* cellVector, unsigned __int64* rowVector)
 {
-	// TODO: Fill only one vector (cells) and return rowCount.
-	// Properly handle uneven last < 64 characters.
-
 	int rowCount = 0;
 
 	// Load vectors of the delimiters we're looking for
 	__m256i newline = _mm256_set1_epi8('\n');
 	__m256i tab = _mm256_set1_epi8('\t');
 
+	// Scan 64-byte blocks while they're entirely within the content
 	int index = contentIndex;
-	for (; index < contentEnd; index += 64)
+	for (; index + 64 <= contentEnd; index += 64)
 	{
 		// Load 64 bytes to scan
 		__m256i block1 = _mm256_loadu_si256((__m256i*)(&content[index]));
@@ -42,149 +37,293 @@ static int SplitTsvN(unsigned __int8* content, int contentIndex, int contentEnd,
 		unsigned __int64 cells = ((unsigned __int64)tabs2 << 32) | tabs1 | lines;
 
 		// Cells are every tab or line and Rows are every line
-		cellVector[index >> 6] = cells;
-		rowVector[index >> 6] = lines;
+		cellVector[(index - contentIndex) >> 6] = cells;
+		rowVector[(index - contentIndex) >> 6] = lines;
 
 		// Count lines
 		rowCount += (int)_mm_popcnt_u64(lines);
 	}
 
-	// Match remaining values individually
+	// Match the remaining (under 64) bytes individually, without reading past the end
+	if (index < contentEnd)
+	{
+		unsigned __int64 lines = 0;
+		unsigned __int64 cells = 0;
+
+		for (int i = index; i < contentEnd; ++i)
+		{
+			if (content[i] == '\n') lines |= (0x1ULL << (i - index));
+			if (content[i] == '\t') cells |= (0x1ULL << (i - index));
+		}
+
+		cells |= lines;
+		cellVector[(index - contentIndex) >> 6] = cells;
+		rowVector[(index - contentIndex) >> 6] = lines;
+		rowCount += (int)_mm_popcnt_u64(lines);
+	}
 
 	return rowCount;
 }
 
 template<bool ignoreCase>
-static bool EqualsShortInternal(Byte* left, Byte* right, Int32 length)
+static int IndexOfAllN(unsigned __int8* text, int textIndex, int textEnd, unsigned __int8* value, int valueLength, int* result, int resultLimit)
 {
-	__m128i uppercaseMask;
-	__m128i corrector;
+	int resultCount = 0;
 
-	__m128i leftBlock = _mm_loadu_si128((__m128i*)(&left[0]));
-	__m128i rightBlock = _mm_loadu_si128((__m128i*)(&right[0]));
+	// Compute the last position at which a match would fit
+	int lastMatchPosition = textEnd - valueLength;
+	if (valueLength <= 0 || resultLimit <= 0 || lastMatchPosition < textIndex) return 0;
+
+	// Get the first and last byte of the value, lowercased if case-insensitive, and the masks to fold text to match them
+	unsigned __int8 first = value[0];
+	unsigned __int8 last = value[valueLength - 1];
+	unsigned __int8 firstFold = 0;
+	unsigned __int8 lastFold = 0;
 
 	if (ignoreCase)
 	{
-		// Left ToLowerInvariant
-		uppercaseMask = _mm_cmpistrm(uppercaseRange, leftBlock, Utf8RangeMaskMode);
-		corrector = _mm_and_si128(uppercaseMask, caseConvert);
-		leftBlock = _mm_xor_si128(leftBlock, corrector);
-
-		// Right ToLowerInvariant
-		uppercaseMask = _mm_cmpistrm(uppercaseRange, rightBlock, Utf8RangeMaskMode);
-		corrector = _mm_and_si128(uppercaseMask, caseConvert);
-		rightBlock = _mm_xor_si128(rightBlock, corrector);
+		first = ToLowerN(first);
+		last = ToLowerN(last);
+		firstFold = CaseFoldMaskN(first);
+		lastFold = CaseFoldMaskN(last);
 	}
 
-	int matchOffset = _mm_cmpestri(leftBlock, length, rightBlock, length, Utf8FirstDifferentCharacterMode);
+	// Broadcast the first and last byte; candidates are positions where both match at the right distance apart
+	__m256i firstBlock = _mm256_set1_epi8(first);
+	__m256i lastBlock = _mm256_set1_epi8(last);
+	__m256i firstFoldBlock = _mm256_set1_epi8(firstFold);
+	__m256i lastFoldBlock = _mm256_set1_epi8(lastFold);
 
-	return (matchOffset >= length);
-}
+	// Match 32 positions at a time while both loads stay within the text
+	int i = textIndex;
+	int lastBlockPosition = lastMatchPosition - 31;
+	for (; i <= lastBlockPosition; i += 32)
+	{
+		// Load the 32 bytes starting at each candidate position and the 32 bytes where each candidate would end
+		__m256i firstText = _mm256_loadu_si256((__m256i*)(&text[i]));
+		__m256i lastText = _mm256_loadu_si256((__m256i*)(&text[i + valueLength - 1]));
 
-template<bool ignoreCase>
-static bool EqualsInternal(Byte* left, Byte* right, Int32 length)
-{
-	int i = 0;
-	while (i < length - 16)
+		// Fold case within the compare (OR 0x20 only where the value byte is a letter)
+		if (ignoreCase)
+		{
+			firstText = _mm256_or_si256(firstText, firstFoldBlock);
+			lastText = _mm256_or_si256(lastText, lastFoldBlock);
+		}
+
+		// Build a bit for each position where both the first and last byte match
+		unsigned int candidates = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(firstText, firstBlock), _mm256_cmpeq_epi8(lastText, lastBlock)));
+
+		// Verify the middle of each candidate, in order
+		while (candidates != 0)
+		{
+			int matchIndex = i + (int)_tzcnt_u32(candidates);
+			if (valueLength <= 2 || EqualsN<ignoreCase>(&text[matchIndex + 1], &value[1], valueLength - 2))
+			{
+				result[resultCount++] = matchIndex;
+				if (resultCount == resultLimit) return resultCount;
+			}
+
+			// Unset the lowest bit and continue
+			candidates &= candidates - 1;
+		}
+	}
+
+	// Match the remaining positions individually
+	for (; i <= lastMatchPosition; ++i)
 	{
-		if (!EqualsShortInternal<ignoreCase>(left + i, right + i, 16)) return false;
-		i += 16;
+		if (EqualsN<ignoreCase>(&text[i], value, valueLength))
+		{
+			result[resultCount++] = i;
+			if (resultCount == resultLimit) return resultCount;
+		}
 	}
 
-	if (i >= length) return false;
-	return EqualsShortInternal<ignoreCase>(left + i, right + i, length - i);
+	return resultCount;
 }
 
-template<bool ignoreCase>
-static int IndexOfAllInternal(Byte* text, Int32 textIndex, Int32 textLength, Byte* value, Int32 valueLength, Int32* result, Int32 resultLimit)
+// Load up to the first eight bytes of a string as a little-endian integer, with bytes past the string length zeroed.
+// Reads a full eight bytes when they're within the buffer, so the string may be followed by other data.
+static __inline unsigned __int64 LoadPrefixN(unsigned __int8* text, int index, int length, int textEnd)
 {
-	int resultCount = 0;
+	if (length >= 8) return *(unsigned __int64*)(&text[index]);
+	if (length <= 0) return 0;
 
-	__m128i uppercaseMask;
-	__m128i corrector;
-
-	// Load the text we're searching for
-	__m128i searchForBlock = _mm_loadu_si128((__m128i*)(&value[0]));
-
-	// Value ToLowerInvariant
-	if (ignoreCase)
+	if (index + 8 <= textEnd)
 	{
-		uppercaseMask = _mm_cmpistrm(uppercaseRange, searchForBlock, Utf8RangeMaskMode);
-		corrector = _mm_and_si128(uppercaseMask, caseConvert);
-		searchForBlock = _mm_xor_si128(searchForBlock, corrector);
+		return *(unsigned __int64*)(&text[index]) & (~0ULL >> (64 - 8 * length));
 	}
 
-	// Compute the last position at which a match would fit
-	int lastMatchPosition = textLength - valueLength;
+	unsigned __int64 prefix = 0;
+	for (int i = 0; i < length; ++i)
+	{
+		prefix |= ((unsigned __int64)text[index + i]) << (8 * i);
+	}
 
-	// Match full blocks while 16+ characters remain to match
-	int fullBlockLength = textLength - 15;
-	if (fullBlockLength > lastMatchPosition) fullBlockLength = lastMatchPosition + 1;
+	return prefix;
+}
 
-	// If a match is found before this index, a second comparison isn't needed
-	int isFullyMatchedAtIndex = 16 - valueLength;
+// Ordinal compare, matching String8.CompareTo: bytes compare unsigned, then the shorter string sorts first.
+// Keys are the first eight bytes in big-endian order, so different keys decide the order without the bytes.
+static __inline int CompareOrdinalN(unsigned __int8* text, int length, unsigned __int64 key, unsigned __int8* value, int valueLength, unsigned __int64 valueKey)
+{
+	if (key != valueKey) return (key < valueKey ? -1 : 1);
 
-	int i;
-	for (i = textIndex; i < fullBlockLength; i += 16)
+	int commonLength = (length < valueLength ? length : valueLength);
+	for (int i = 8; i < commonLength; ++i)
 	{
-		// Load 16 bytes to scan
-		__m128i textBlock = _mm_loadu_si128((__m128i*)(&text[i]));
+		if (text[i] != value[i]) return (text[i] < value[i] ? -1 : 1);
+	}
 
-		// Text ToLowerInvariant
-		if (ignoreCase)
-		{
-			uppercaseMask = _mm_cmpistrm(uppercaseRange, textBlock, Utf8RangeMaskMode);
-			corrector = _mm_and_si128(uppercaseMask, caseConvert);
-			textBlock = _mm_xor_si128(textBlock, corrector);
-		}
+	return length - valueLength;
+}
 
-		// Look for searchFor with cmp*i*stri [performance]
-		int matchOffset = _mm_cmpistri(searchForBlock, textBlock, Utf8IndexOfMode);
+template<CompareOperatorN cOp>
+static void WhereString8N(unsigned __int8* text, int textIndex, int textEnd, int* rowEnds, int rowCount, int rowEndOffset, unsigned __int8* value, int valueLength, BooleanOperatorN bOp, unsigned __int64* matchVector)
+{
+	bool isLengthFiltered = (cOp == CompareOperatorN::Equal || cOp == CompareOperatorN::NotEqual || cOp == CompareOperatorN::StartsWith || cOp == CompareOperatorN::EndsWith);
+	bool isOrdered = (cOp == CompareOperatorN::LessThan || cOp == CompareOperatorN::LessThanOrEqual || cOp == CompareOperatorN::GreaterThan || cOp == CompareOperatorN::GreaterThanOrEqual);
 
-		if (matchOffset < 16)
-		{
-			int matchIndex = i + matchOffset;
-			if (matchOffset <= isFullyMatchedAtIndex || EqualsInternal<ignoreCase>(text + matchIndex, value, valueLength))
-			{
-				result[resultCount++] = matchIndex;
-				if (resultCount == resultLimit) return resultCount;
-			}
+	// StartsWith and EndsWith an empty value match nothing (like String8Comparer.WhereBlock)
+	bool matchesNothing = (valueLength == 0 && (cOp == CompareOperatorN::StartsWith || cOp == CompareOperatorN::EndsWith));
 
-			// Look at the next possible character next iteration
-			i = matchIndex + 1 - 16;
+	// Get the first eight bytes of the value to pre-filter with; lowercase it and get the case fold mask when case-insensitive
+	int prefixLength = (valueLength < 8 ? valueLength : 8);
+	unsigned __int64 valuePrefix = LoadPrefixN(value, 0, prefixLength, 0);
+	unsigned __int64 valueKey = _byteswap_uint64(valuePrefix);
+	unsigned __int64 prefixMask = (prefixLength == 0 ? 0 : ~0ULL >> (64 - 8 * prefixLength));
+	unsigned __int64 foldMask = 0;
+
+	if (cOp == CompareOperatorN::StartsWith || cOp == CompareOperatorN::EndsWith)
+	{
+		valuePrefix = 0;
+		for (int i = 0; i < prefixLength; ++i)
+		{
+			unsigned __int8 lower = ToLowerN(value[i]);
+			valuePrefix |= ((unsigned __int64)lower) << (8 * i);
+			foldMask |= ((unsigned __int64)CaseFoldMaskN(lower)) << (8 * i);
 		}
 	}
 
-	// Match the suffix of the string (won't trigger if valueLength >= 16)
-	while (i < lastMatchPosition)
+	// Equal requires the same length; StartsWith and EndsWith require at least the value length
+	__m256i lengthBlock = _mm256_set1_epi32(cOp == CompareOperatorN::Equal || cOp == CompareOperatorN::NotEqual ? valueLength : valueLength - 1);
+	__m256i shiftOneRow = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+
+	// Row ends are relative to rowEndOffset; the first row starts at textIndex
+	int previousRowEnd = textIndex + rowEndOffset;
+
+	for (int blockStart = 0; blockStart < rowCount; blockStart += 64)
 	{
-		int lengthLeft = textLength - i;
-		__m128i textBlock = _mm_loadu_si128((__m128i*)(&text[i]));
+		int blockCount = (rowCount - blockStart < 64 ? rowCount - blockStart : 64);
+		unsigned __int64 validRows = (blockCount == 64 ? ~0ULL : (1ULL << blockCount) - 1);
+		int* blockRowEnds = &rowEnds[blockStart];
 
-		// Left ToLowerInvariant
-		if (ignoreCase)
+		// Find the rows with a compatible length, eight at a time, by subtracting each row end from the next
+		unsigned __int64 candidates = validRows;
+		if (isLengthFiltered)
 		{
-			uppercaseMask = _mm_cmpistrm(uppercaseRange, textBlock, Utf8RangeMaskMode);
-			corrector = _mm_and_si128(uppercaseMask, caseConvert);
-			textBlock = _mm_xor_si128(textBlock, corrector);
+			candidates = 0;
+
+			if (!matchesNothing)
+			{
+				int i = 0;
+				for (; i + 8 <= blockCount; i += 8)
+				{
+					__m256i ends = _mm256_loadu_si256((__m256i*)(&blockRowEnds[i]));
+					__m256i starts = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(ends, shiftOneRow), _mm256_set1_epi32(previousRowEnd), 0x01);
+					__m256i lengths = _mm256_sub_epi32(ends, starts);
+					previousRowEnd = blockRowEnds[i + 7];
+
+					__m256i lengthMatches;
+					if (cOp == CompareOperatorN::Equal || cOp == CompareOperatorN::NotEqual)
+					{
+						lengthMatches = _mm256_cmpeq_epi32(lengths, lengthBlock);
+					}
+					else
+					{
+						lengthMatches = _mm256_cmpgt_epi32(lengths, lengthBlock);
+					}
+
+					candidates |= ((unsigned __int64)(unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(lengthMatches))) << i;
+				}
+
+				for (; i < blockCount; ++i)
+				{
+					int length = blockRowEnds[i] - previousRowEnd;
+					previousRowEnd = blockRowEnds[i];
+
+					bool lengthMatches = (cOp == CompareOperatorN::Equal || cOp == CompareOperatorN::NotEqual ? length == valueLength : length >= valueLength);
+					if (lengthMatches) candidates |= (1ULL << i);
+				}
+			}
 		}
 
-		int matchOffset = _mm_cmpestri(searchForBlock, valueLength, textBlock, lengthLeft, Utf8IndexOfMode);
-		if (matchOffset <= isFullyMatchedAtIndex)
+		// Verify each candidate row
+		unsigned __int64 result = 0;
+		while (candidates != 0)
 		{
-			int matchIndex = i + matchOffset;
-			result[resultCount++] = i + matchOffset;
-			if (resultCount == resultLimit) return resultCount;
+			int i = (int)_tzcnt_u64(candidates);
+			int row = blockStart + i;
+
+			int rowStart = (row == 0 ? textIndex : rowEnds[row - 1] - rowEndOffset);
+			int rowEnd = rowEnds[row] - rowEndOffset;
+			int length = rowEnd - rowStart;
 
-			i = matchIndex + 1;
+			bool matches = false;
+			if (isOrdered)
+			{
+				unsigned __int64 key = _byteswap_uint64(LoadPrefixN(text, rowStart, (length < 8 ? length : 8), textEnd));
+				int cmp = CompareOrdinalN(&text[rowStart], length, key, value, valueLength, valueKey);
+
+				switch (cOp)
+				{
+				case CompareOperatorN::LessThan:
+					matches = (cmp < 0);
+					break;
+				case CompareOperatorN::LessThanOrEqual:
+					matches = (cmp <= 0);
+					break;
+				case CompareOperatorN::GreaterThan:
+					matches = (cmp > 0);
+					break;
+				case CompareOperatorN::GreaterThanOrEqual:
+					matches = (cmp >= 0);
+					break;
+				}
+			}
+			else if (cOp == CompareOperatorN::Equal || cOp == CompareOperatorN::NotEqual)
+			{
+				// Compare the first eight bytes, then the rest
+				matches = (LoadPrefixN(text, rowStart, prefixLength, textEnd) == valuePrefix)
+					&& (length <= 8 || EqualsN<false>(&text[rowStart + 8], &value[8], length - 8));
+			}
+			else
+			{
+				// Case-insensitive compare of the first eight bytes of the prefix or suffix, then the rest
+				int matchStart = (cOp == CompareOperatorN::StartsWith ? rowStart : rowEnd - valueLength);
+				matches = (((LoadPrefixN(text, matchStart, prefixLength, textEnd) | foldMask) & prefixMask) == valuePrefix)
+					&& (valueLength <= 8 || EqualsN<true>(&text[matchStart + 8], &value[8], valueLength - 8));
+			}
+
+			if (matches) result |= (1ULL << i);
+
+			// Unset the lowest bit and continue
+			candidates &= candidates - 1;
 		}
-		else
+
+		// NotEqual is every row which didn't match Equal
+		if (cOp == CompareOperatorN::NotEqual) result = validRows & ~result;
+
+		// Merge the result with the existing bit vector bits based on the boolean operator requested
+		switch (bOp)
 		{
+		case BooleanOperatorN::And:
+			matchVector[blockStart >> 6] &= result;
+			break;
+		case BooleanOperatorN::Or:
+			matchVector[blockStart >> 6] |= result;
 			break;
 		}
 	}
-
-	return resultCount;
 }
 
 #pragma managed
@@ -195,10 +334,18 @@ namespace XForm
 	{
 		Int32 String8N::SplitTsv(array<Byte>^ content, Int32 index, Int32 length, array<UInt64>^ cellVector, array<UInt64>^ rowVector)
 		{
+			if (index < 0 || length < 0 || index + length > content->Length) throw gcnew IndexOutOfRangeException();
+			if (((length + 63) >> 6) > cellVector->Length || ((length + 63) >> 6) > rowVector->Length) throw gcnew IndexOutOfRangeException();
+			if (length == 0) return 0;
+
 			pin_ptr<Byte> pContent = &content[0];
 			pin_ptr<UInt64> pCellVector = &cellVector[0];
 			pin_ptr<UInt64> pRowVector = &rowVector[0];
-			return SplitTsvN(pContent, index, index + length, pCellVector, pRowVector);
+			KernelScopeN scope(KernelN::SplitTsv, length, length);
+
+			int rowCount = SplitTsvN(pContent, index, index + length, pCellVector, pRowVector);
+			scope.Matched(rowCount);
+			return rowCount;
 		}
 
 		Int32 String8N::IndexOfAll(array<Byte>^ content, Int32 index, Int32 length, array<Byte>^ value, Int32 valueIndex, Int32 valueLength, Boolean ignoreCase, array<Int32>^ matchArray)
@@ -209,14 +356,67 @@ namespace XForm
 			pin_ptr<Byte> pContent = &content[0];
 			pin_ptr<Byte> pValue = &value[valueIndex];
 			pin_ptr<Int32> pMatchArray = &matchArray[0];
+			KernelScopeN scope(KernelN::IndexOfAll, length, length);
 
+			int matchCount;
 			if (ignoreCase)
 			{
-				return IndexOfAllInternal<true>(pContent, index, index + length, pValue, valueLength, pMatchArray, matchArray->Length);
+				matchCount = IndexOfAllN<true>(pContent, index, index + length, pValue, valueLength, pMatchArray, matchArray->Length);
 			}
 			else
 			{
-				return IndexOfAllInternal<false>(pContent, index, index + length, pValue, valueLength, pMatchArray, matchArray->Length);
+				matchCount = IndexOfAllN<false>(pContent, index, index + length, pValue, valueLength, pMatchArray, matchArray->Length);
+			}
+
+			scope.Matched(matchCount);
+			return matchCount;
+		}
+
+		void String8N::Where(array<Byte>^ text, Int32 textIndex, array<Int32>^ rowEnds, Int32 rowEndsIndex, Int32 rowCount, Int32 rowEndOffset, Byte cOp, array<Byte>^ value, Int32 valueIndex, Int32 valueLength, Byte bOp, array<UInt64>^ vector)
+		{
+			if (rowCount <= 0) return;
+			if (textIndex < 0 || rowEndsIndex < 0 || valueIndex < 0 || valueLength < 0) throw gcnew IndexOutOfRangeException();
+			if (rowEndsIndex + rowCount > rowEnds->Length) throw gcnew IndexOutOfRangeException();
+			if (rowEnds[rowEndsIndex + rowCount - 1] - rowEndOffset > text->Length) throw gcnew IndexOutOfRangeException();
+			if (valueLength > 0 && valueIndex + valueLength > value->Length) throw gcnew IndexOutOfRangeException();
+			if (rowCount > (vector->Length * 64)) throw gcnew IndexOutOfRangeException();
+
+			pin_ptr<Byte> pText = nullptr;
+			if (text->Length > 0) pText = &text[0];
+			pin_ptr<Byte> pValue = nullptr;
+			if (valueLength > 0) pValue = &value[valueIndex];
+			pin_ptr<Int32> pRowEnds = &rowEnds[rowEndsIndex];
+			pin_ptr<UInt64> pVector = &vector[0];
+			KernelScopeN scope(KernelN::WhereString, rowCount, rowEnds[rowEndsIndex + rowCount - 1] - rowEndOffset - textIndex, pVector, rowCount);
+
+			switch ((CompareOperatorN)cOp)
+			{
+			case CompareOperatorN::Equal:
+				WhereString8N<CompareOperatorN::Equal>(pText, textIndex, text->Length, pRowEnds, rowCount, rowEndOffset, pValue, valueLength, (BooleanOperatorN)bOp, pVector);
+				break;
+			case CompareOperatorN::NotEqual:
+				WhereString8N<CompareOperatorN::NotEqual>(pText, textIndex, text->Length, pRowEnds, rowCount, rowEndOffset, pValue, valueLength, (BooleanOperatorN)bOp, pVector);
+				break;
+			case CompareOperatorN::LessThan:
+				WhereString8N<CompareOperatorN::LessThan>(pText, textIndex, text->Length, pRowEnds, rowCount, rowEndOffset, pValue, valueLength, (BooleanOperatorN)bOp, pVector);
+				break;
+			case CompareOperatorN::LessThanOrEqual:
+				WhereString8N<CompareOperatorN::LessThanOrEqual>(pText, textIndex, text->Length, pRowEnds, rowCount, rowEndOffset, pValue, valueLength, (BooleanOperatorN)bOp, pVector);
+				break;
+			case CompareOperatorN::GreaterThan:
+				WhereString8N<CompareOperatorN::GreaterThan>(pText, textIndex, text->Length, pRowEnds, rowCount, rowEndOffset, pValue, valueLength, (BooleanOperatorN)bOp, pVector);
+				break;
+			case CompareOperatorN::GreaterThanOrEqual:
+				WhereString8N<CompareOperatorN::GreaterThanOrEqual>(pText, textIndex, text->Length, pRowEnds, rowCount, rowEndOffset, pValue, valueLength, (BooleanOperatorN)bOp, pVector);
+				break;
+			case CompareOperatorN::StartsWith:
+				WhereString8N<CompareOperatorN::StartsWith>(pText, textIndex, text->Length, pRowEnds, rowCount, rowEndOffset, pValue, valueLength, (BooleanOperatorN)bOp, pVector);
+				break;
+			case CompareOperatorN::EndsWith:
+				WhereString8N<CompareOperatorN::EndsWith>(pText, textIndex, text->Length, pRowEnds, rowCount, rowEndOffset, pValue, valueLength, (BooleanOperatorN)bOp, pVector);
+				break;
+			default:
+				throw gcnew ArgumentException("cOp");
 			}
 		}
 	}
@@ -11,8 +11,34 @@ namespace XForm
 		public ref class String8N
 		{
 		public:
+			// Find tabs and newlines in content[index, index + length). Returns the newline count.
+			// The vectors are relative to index, not to the start of content: bit (i & 63) of word (i >> 6) in cellVector (tabs and newlines)
+			// and rowVector (newlines) is for content[index + i]. Each vector needs (length + 63) / 64 words; bits past length are zero.
 			static Int32 SplitTsv(array<Byte>^ content, Int32 index, Int32 length, array<UInt64>^ cellVector, array<UInt64>^ rowVector);
 			static Int32 IndexOfAll(array<Byte>^ content, Int32 index, Int32 length, array<Byte>^ value, Int32 valueIndex, Int32 valueLength, Boolean ignoreCase, array<Int32>^ matchArray);
+
+			// AVX2 accelerated where comparing String8 rows (raw text and row ends) to a constant
+			static void Where(array<Byte>^ text, Int32 textIndex, array<Int32>^ rowEnds, Int32 rowEndsIndex, Int32 rowCount, Int32 rowEndOffset, Byte compareOperator, array<Byte>^ value, Int32 valueIndex, Int32 valueLength, Byte booleanOperator, array<UInt64>^ vector);
+
+			// Parse String8 values (text, start and length per row) to numbers, matching String8.TryToInteger, TryToUInt, TryToLong and TryToDouble.
+			// Returns the number of values which could not be converted.
+			static Int32 Parse(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<Int32>^ result, array<Boolean>^ couldNotConvert);
+			static Int32 Parse(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<UInt32>^ result, array<Boolean>^ couldNotConvert);
+			static Int32 Parse(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<Int64>^ result, array<Boolean>^ couldNotConvert);
+			static Int32 Parse(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<Double>^ result, array<Boolean>^ couldNotConvert);
+
+			// Parse fixed-width ISO-8601 DateTimes and [hh:mm:ss.fffffff] TimeSpans to ticks. Rows in other layouts are marked in couldNotParse for per-row parsing.
+			// Returns the number of values which could not be parsed.
+			static Int32 ParseDateTime(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<Int64>^ ticks, array<Boolean>^ couldNotParse);
+			static Int32 ParseTimeSpan(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<Int64>^ ticks, array<Boolean>^ couldNotParse);
+
+			// Format UTC DateTime ticks as ISO-8601 into buffer (20 bytes per value), writing the end offset of each. Returns the bytes written.
+			static Int32 FormatDateTime(array<Int64>^ ticks, Int32 count, array<Byte>^ buffer, array<Int32>^ ends);
+
+			// Escape String8 values as TSV (format 0) or CSV (format 1) cells. MeasureCells writes the escaped length of each value and returns the total.
+			// WriteCells writes each escaped value at its position in buffer, followed by the cell delimiter or, for the last column, the row separator.
+			static Int64 MeasureCells(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, Byte format, array<Int32>^ cellLengths);
+			static void WriteCells(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, Byte format, Boolean lastColumn, array<Int32>^ positions, array<Byte>^ buffer);
 		};
 	}
 }
@@ -0,0 +1,500 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <intrin.h>
+#include <math.h>
+#include "String8N.h"
+#include "KernelCountersN.h"
+
+#pragma unmanaged
+
+// Mask to keep the last 'length' of 16 bytes; load from &ActiveBytesN[length]
+static const unsigned __int8 ActiveBytesN[32] =
+{
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+// Parse an unsigned decimal number, matching String8.ParseWithCutoff:
+// non-empty, digits only, under 20 digits (20 allowed only with a ulong.MaxValue cutoff), and no more than the cutoff.
+static bool ParseDigitsN(unsigned __int8* text, int start, int length, unsigned __int64 cutoff, unsigned __int64* result)
+{
+	*result = 0;
+	if (length <= 0 || length > 20) return false;
+	if (length == 20 && cutoff != ~0ULL) return false;
+
+	unsigned __int64 value = 0;
+
+	if (length <= 16 && start + length >= 16)
+	{
+		// Load the 16 bytes ending with the value, so the digits are right-aligned, and zero the bytes before it
+		__m128i block = _mm_loadu_si128((__m128i*)(&text[start + length - 16]));
+		__m128i digits = _mm_and_si128(_mm_sub_epi8(block, _mm_set1_epi8('0')), _mm_loadu_si128((__m128i*)(&ActiveBytesN[length])));
+
+		// Verify every byte is a digit (unsigned byte - '0' <= 9)
+		__m128i nine = _mm_set1_epi8(9);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(digits, nine), nine)) != 0xFFFF) return false;
+
+		// Combine pairs of digits, then pairs of pairs, then pairs of four digits into two eight digit halves
+		__m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+		__m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+		__m128i octets = _mm_madd_epi16(_mm_packus_epi32(quads, quads), _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+
+		value = (unsigned __int64)(unsigned int)_mm_cvtsi128_si32(octets) * 100000000ULL + (unsigned int)_mm_extract_epi32(octets, 1);
+	}
+	else
+	{
+		// Parse long values (or values too near the start of the text to load 16 bytes) one digit at a time
+		int digitsEnd = (length == 20 ? 19 : length);
+		for (int i = 0; i < digitsEnd; ++i)
+		{
+			unsigned __int8 digit = text[start + i] - '0';
+			if (digit > 9) return false;
+			value = 10 * value + digit;
+		}
+
+		// For 20 digits, add the last one only if the sum will fit in a ulong
+		if (length == 20)
+		{
+			unsigned __int8 digit = text[start + 19] - '0';
+			if (digit > 9) return false;
+			if (value > (~0ULL - digit) / 10) return false;
+			value = 10 * value + digit;
+		}
+	}
+
+	if (value > cutoff) return false;
+
+	*result = value;
+	return true;
+}
+
+// Parse a signed decimal number, matching String8.TryToInteger and TryToLong: a leading '-' negates, and "-0" is invalid.
+static bool ParseSignedN(unsigned __int8* text, int start, int length, unsigned __int64 maxValue, __int64* result)
+{
+	unsigned __int64 value;
+	*result = 0;
+
+	if (length > 0 && text[start] == '-')
+	{
+		if (!ParseDigitsN(text, start + 1, length - 1, maxValue + 1, &value) || value == 0) return false;
+		*result = -(__int64)(value - 1) - 1;
+		return true;
+	}
+
+	if (!ParseDigitsN(text, start, length, maxValue, &value)) return false;
+	*result = (__int64)value;
+	return true;
+}
+
+// Parse a decimal number, matching String8.TryToDouble: [-][whole][.fraction], computed as fraction / 10^digits + whole.
+static bool ParseDoubleN(unsigned __int8* text, int start, int length, double* result)
+{
+	*result = 0.0;
+	if (length <= 0) return false;
+
+	bool valid = true;
+	bool negative = (text[start] == '-');
+
+	int decimalPointIndex = 0;
+	while (decimalPointIndex < length && text[start + decimalPointIndex] != '.') ++decimalPointIndex;
+
+	unsigned __int64 part;
+	double value = 0.0;
+
+	if (decimalPointIndex != length)
+	{
+		int fractionLength = length - decimalPointIndex - 1;
+		valid &= ParseDigitsN(text, start + decimalPointIndex + 1, fractionLength, ~0ULL, &part);
+		value = (double)part / pow(10.0, fractionLength);
+	}
+
+	int firstDigitIndex = (negative ? 1 : 0);
+	if (decimalPointIndex - firstDigitIndex > 0)
+	{
+		valid &= ParseDigitsN(text, start + firstDigitIndex, decimalPointIndex - firstDigitIndex, ~0ULL, &part);
+		value += (double)part;
+	}
+
+	if (negative) value = -value;
+
+	*result = value;
+	return valid;
+}
+
+template<typename T, bool isSigned>
+static int ParseIntegersN(unsigned __int8* text, int* starts, int* lengths, int count, unsigned __int64 maxValue, T* result, bool* couldNotConvert)
+{
+	int failureCount = 0;
+
+	for (int i = 0; i < count; ++i)
+	{
+		bool valid;
+
+		if (isSigned)
+		{
+			__int64 value;
+			valid = ParseSignedN(text, starts[i], lengths[i], maxValue, &value);
+			result[i] = (T)value;
+		}
+		else
+		{
+			unsigned __int64 value;
+			valid = ParseDigitsN(text, starts[i], lengths[i], maxValue, &value);
+			result[i] = (T)value;
+		}
+
+		couldNotConvert[i] = !valid;
+		failureCount += (valid ? 0 : 1);
+	}
+
+	return failureCount;
+}
+
+static int ParseDoublesN(unsigned __int8* text, int* starts, int* lengths, int count, double* result, bool* couldNotConvert)
+{
+	int failureCount = 0;
+
+	for (int i = 0; i < count; ++i)
+	{
+		bool valid = ParseDoubleN(text, starts[i], lengths[i], &result[i]);
+		couldNotConvert[i] = !valid;
+		failureCount += (valid ? 0 : 1);
+	}
+
+	return failureCount;
+}
+
+static const __int64 TicksPerSecondN = 10000000LL;
+static const __int64 TicksPerDayN = 864000000000LL;
+
+// Days before each month, for non-leap and leap years
+static const int DaysToMonthN[2][13] =
+{
+	{ 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365 },
+	{ 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366 }
+};
+
+static __inline int IsLeapYearN(int year)
+{
+	return ((year % 4) == 0 && ((year % 100) != 0 || (year % 400) == 0) ? 1 : 0);
+}
+
+static __inline bool ParseTwoDigitsN(unsigned __int8* text, int* result)
+{
+	unsigned __int8 tens = text[0] - '0';
+	unsigned __int8 ones = text[1] - '0';
+	*result = 10 * tens + ones;
+	return (tens <= 9 && ones <= 9);
+}
+
+// Parse the fixed-width ISO-8601 layouts String8.TryToDateTime accepts, [yyyy-MM-dd] and [yyyy-MM-ddThh:mm:ss(Z|.)], into UTC ticks.
+// Returns false for anything else (other layouts, partial seconds, invalid values); callers parse those rows individually.
+static bool ParseDateTimeN(unsigned __int8* text, int start, int length, int textEnd, __int64* ticks)
+{
+	*ticks = 0;
+	if (length != 10 && length != 19 && length != 20) return false;
+
+	// Validate separators
+	unsigned __int8* value = &text[start];
+	if (value[4] != '-' || value[7] != '-') return false;
+	if (length > 10)
+	{
+		if (value[10] != 'T' && value[10] != ' ') return false;
+		if (value[13] != ':' || value[16] != ':') return false;
+		if (length == 20 && value[19] != 'Z' && value[19] != '.') return false;
+	}
+
+	// Load the first 16 bytes, copying a date-only value when it's too close to the end of the text
+	__m128i block;
+	if (start + 16 <= textEnd)
+	{
+		block = _mm_loadu_si128((__m128i*)value);
+	}
+	else
+	{
+		unsigned __int8 copy[16] = { 0 };
+		for (int i = 0; i < length && i < 16; ++i) copy[i] = value[i];
+		block = _mm_loadu_si128((__m128i*)copy);
+	}
+
+	// Gather the year, month, day, hour, and minute digits together [yyyyMMddhhmm]
+	__m128i digits = _mm_shuffle_epi8(_mm_sub_epi8(block, _mm_set1_epi8('0')), _mm_setr_epi8(0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, -1, -1, -1, -1));
+
+	// Verify they're all digits (only the date digits for date-only values)
+	__m128i nine = _mm_set1_epi8(9);
+	int digitMask = (length == 10 ? 0xFF : 0xFFF);
+	if ((_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(digits, nine), nine)) & digitMask) != digitMask) return false;
+
+	// Combine digit pairs into [yy, yy, MM, dd, hh, mm]
+	__m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+
+	int year = 100 * _mm_extract_epi16(pairs, 0) + _mm_extract_epi16(pairs, 1);
+	int month = _mm_extract_epi16(pairs, 2);
+	int day = _mm_extract_epi16(pairs, 3);
+
+	// Validate the date (year zero is left to the managed code to reject)
+	if (year < 1) return false;
+	if (month < 1 || month > 12) return false;
+
+	int leap = IsLeapYearN(year);
+	if (day < 1 || day > DaysToMonthN[leap][month] - DaysToMonthN[leap][month - 1]) return false;
+
+	int yearsBefore = year - 1;
+	__int64 days = (__int64)yearsBefore * 365 + yearsBefore / 4 - yearsBefore / 100 + yearsBefore / 400 + DaysToMonthN[leap][month - 1] + day - 1;
+	__int64 result = days * TicksPerDayN;
+
+	if (length > 10)
+	{
+		int hour = _mm_extract_epi16(pairs, 4);
+		int minute = _mm_extract_epi16(pairs, 5);
+		int second;
+		if (!ParseTwoDigitsN(&value[17], &second)) return false;
+		if (hour > 23 || minute > 59 || second > 59) return false;
+
+		result += (__int64)(3600 * hour + 60 * minute + second) * TicksPerSecondN;
+	}
+
+	*ticks = result;
+	return true;
+}
+
+// Parse the fixed-width TimeSpan layouts [hh:mm:ss] and [hh:mm:ss.fffffff] (one to seven fractional digits) into ticks.
+// Returns false for anything else (days, negative values, friendly formats, invalid values); callers parse those rows individually.
+static bool ParseTimeSpanN(unsigned __int8* text, int start, int length, __int64* ticks)
+{
+	*ticks = 0;
+	if (length != 8 && (length < 10 || length > 16)) return false;
+
+	unsigned __int8* value = &text[start];
+	if (value[2] != ':' || value[5] != ':') return false;
+	if (length > 8 && value[8] != '.') return false;
+
+	int hour, minute, second;
+	if (!ParseTwoDigitsN(&value[0], &hour) || !ParseTwoDigitsN(&value[3], &minute) || !ParseTwoDigitsN(&value[6], &second)) return false;
+	if (hour > 23 || minute > 59 || second > 59) return false;
+
+	// Parse partial seconds, scaled to seven digits (ticks)
+	__int64 partialSeconds = 0;
+	for (int i = 9; i < 16; ++i)
+	{
+		unsigned __int8 digit = (i < length ? value[i] - '0' : 0);
+		if (digit > 9) return false;
+		partialSeconds = 10 * partialSeconds + digit;
+	}
+
+	*ticks = (__int64)(3600 * hour + 60 * minute + second) * TicksPerSecondN + partialSeconds;
+	return true;
+}
+
+template<bool isDateTime>
+static int ParseTicksN(unsigned __int8* text, int textEnd, int* starts, int* lengths, int count, __int64* ticks, bool* couldNotParse)
+{
+	int couldNotParseCount = 0;
+
+	for (int i = 0; i < count; ++i)
+	{
+		bool parsed = (isDateTime ? ParseDateTimeN(text, starts[i], lengths[i], textEnd, &ticks[i]) : ParseTimeSpanN(text, starts[i], lengths[i], &ticks[i]));
+		couldNotParse[i] = !parsed;
+		couldNotParseCount += (parsed ? 0 : 1);
+	}
+
+	return couldNotParseCount;
+}
+
+static __inline void WriteTwoDigitsN(unsigned __int8* buffer, int value)
+{
+	buffer[0] = (unsigned __int8)('0' + value / 10);
+	buffer[1] = (unsigned __int8)('0' + value % 10);
+}
+
+// Format UTC ticks as ISO-8601 [yyyy-MM-dd] or [yyyy-MM-ddThh:mm:ssZ] when there's a time part, matching String8.FromDateTime.
+// Values are written consecutively; ends gets the end offset of each. Returns the bytes written.
+static int FormatDateTimeN(__int64* ticks, int count, unsigned __int8* buffer, int* ends)
+{
+	int next = 0;
+
+	for (int i = 0; i < count; ++i)
+	{
+		int days = (int)(ticks[i] / TicksPerDayN);
+		__int64 timeOfDay = ticks[i] % TicksPerDayN;
+
+		// Find the year: count 400, 100, 4, and 1 year periods (as System.DateTime does)
+		int periods400 = days / 146097;
+		days -= periods400 * 146097;
+		int periods100 = days / 36524;
+		if (periods100 == 4) periods100 = 3;
+		days -= periods100 * 36524;
+		int periods4 = days / 1461;
+		days -= periods4 * 1461;
+		int periods1 = days / 365;
+		if (periods1 == 4) periods1 = 3;
+		days -= periods1 * 365;
+
+		int year = 400 * periods400 + 100 * periods100 + 4 * periods4 + periods1 + 1;
+		int leap = (periods1 == 3 && (periods4 != 24 || periods100 == 3) ? 1 : 0);
+
+		int month = 1;
+		while (days >= DaysToMonthN[leap][month]) ++month;
+		int day = days - DaysToMonthN[leap][month - 1] + 1;
+
+		// yyyy-MM-dd
+		unsigned __int8* value = &buffer[next];
+		WriteTwoDigitsN(&value[0], year / 100);
+		WriteTwoDigitsN(&value[2], year % 100);
+		value[4] = '-';
+		WriteTwoDigitsN(&value[5], month);
+		value[7] = '-';
+		WriteTwoDigitsN(&value[8], day);
+		next += 10;
+
+		// Thh:mm:ssZ
+		if (timeOfDay > 0)
+		{
+			int seconds = (int)(timeOfDay / TicksPerSecondN);
+			value[10] = 'T';
+			WriteTwoDigitsN(&value[11], seconds / 3600);
+			value[13] = ':';
+			WriteTwoDigitsN(&value[14], (seconds / 60) % 60);
+			value[16] = ':';
+			WriteTwoDigitsN(&value[17], seconds % 60);
+			value[19] = 'Z';
+			next += 10;
+		}
+
+		ends[i] = next;
+	}
+
+	return next;
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		// Validate the arguments and return the total length of the values
+		static Int64 ValidateParseArguments(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, Array^ result, array<Boolean>^ couldNotConvert)
+		{
+			if (count < 0 || count > starts->Length || count > lengths->Length || count > result->Length || count > couldNotConvert->Length) throw gcnew IndexOutOfRangeException();
+
+			Int64 totalLength = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				if (starts[i] < 0 || lengths[i] < 0 || starts[i] + lengths[i] > text->Length) throw gcnew IndexOutOfRangeException();
+				totalLength += lengths[i];
+			}
+
+			return totalLength;
+		}
+
+		Int32 String8N::Parse(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<Int32>^ result, array<Boolean>^ couldNotConvert)
+		{
+			Int64 totalLength = ValidateParseArguments(text, starts, lengths, count, result, couldNotConvert);
+			if (count == 0) return 0;
+
+			pin_ptr<Byte> pText = nullptr;
+			if (text->Length > 0) pText = &text[0];
+			pin_ptr<Int32> pStarts = &starts[0];
+			pin_ptr<Int32> pLengths = &lengths[0];
+			pin_ptr<Int32> pResult = &result[0];
+			pin_ptr<Boolean> pCouldNotConvert = &couldNotConvert[0];
+			KernelScopeN scope(KernelN::Parse, count, totalLength);
+			return ParseIntegersN<int, true>(pText, pStarts, pLengths, count, 0x7FFFFFFFULL, pResult, pCouldNotConvert);
+		}
+
+		Int32 String8N::Parse(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<UInt32>^ result, array<Boolean>^ couldNotConvert)
+		{
+			Int64 totalLength = ValidateParseArguments(text, starts, lengths, count, result, couldNotConvert);
+			if (count == 0) return 0;
+
+			pin_ptr<Byte> pText = nullptr;
+			if (text->Length > 0) pText = &text[0];
+			pin_ptr<Int32> pStarts = &starts[0];
+			pin_ptr<Int32> pLengths = &lengths[0];
+			pin_ptr<UInt32> pResult = &result[0];
+			pin_ptr<Boolean> pCouldNotConvert = &couldNotConvert[0];
+			KernelScopeN scope(KernelN::Parse, count, totalLength);
+			return ParseIntegersN<unsigned int, false>(pText, pStarts, pLengths, count, 0xFFFFFFFFULL, pResult, pCouldNotConvert);
+		}
+
+		Int32 String8N::Parse(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<Int64>^ result, array<Boolean>^ couldNotConvert)
+		{
+			Int64 totalLength = ValidateParseArguments(text, starts, lengths, count, result, couldNotConvert);
+			if (count == 0) return 0;
+
+			pin_ptr<Byte> pText = nullptr;
+			if (text->Length > 0) pText = &text[0];
+			pin_ptr<Int32> pStarts = &starts[0];
+			pin_ptr<Int32> pLengths = &lengths[0];
+			pin_ptr<Int64> pResult = &result[0];
+			pin_ptr<Boolean> pCouldNotConvert = &couldNotConvert[0];
+			KernelScopeN scope(KernelN::Parse, count, totalLength);
+			return ParseIntegersN<__int64, true>(pText, pStarts, pLengths, count, 0x7FFFFFFFFFFFFFFFULL, pResult, pCouldNotConvert);
+		}
+
+		Int32 String8N::Parse(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<Double>^ result, array<Boolean>^ couldNotConvert)
+		{
+			Int64 totalLength = ValidateParseArguments(text, starts, lengths, count, result, couldNotConvert);
+			if (count == 0) return 0;
+
+			pin_ptr<Byte> pText = nullptr;
+			if (text->Length > 0) pText = &text[0];
+			pin_ptr<Int32> pStarts = &starts[0];
+			pin_ptr<Int32> pLengths = &lengths[0];
+			pin_ptr<Double> pResult = &result[0];
+			pin_ptr<Boolean> pCouldNotConvert = &couldNotConvert[0];
+			KernelScopeN scope(KernelN::Parse, count, totalLength);
+			return ParseDoublesN(pText, pStarts, pLengths, count, pResult, pCouldNotConvert);
+		}
+
+		Int32 String8N::ParseDateTime(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<Int64>^ ticks, array<Boolean>^ couldNotParse)
+		{
+			Int64 totalLength = ValidateParseArguments(text, starts, lengths, count, ticks, couldNotParse);
+			if (count == 0) return 0;
+
+			pin_ptr<Byte> pText = nullptr;
+			if (text->Length > 0) pText = &text[0];
+			pin_ptr<Int32> pStarts = &starts[0];
+			pin_ptr<Int32> pLengths = &lengths[0];
+			pin_ptr<Int64> pTicks = &ticks[0];
+			pin_ptr<Boolean> pCouldNotParse = &couldNotParse[0];
+			KernelScopeN scope(KernelN::Parse, count, totalLength);
+			return ParseTicksN<true>(pText, text->Length, pStarts, pLengths, count, pTicks, pCouldNotParse);
+		}
+
+		Int32 String8N::ParseTimeSpan(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, array<Int64>^ ticks, array<Boolean>^ couldNotParse)
+		{
+			Int64 totalLength = ValidateParseArguments(text, starts, lengths, count, ticks, couldNotParse);
+			if (count == 0) return 0;
+
+			pin_ptr<Byte> pText = nullptr;
+			if (text->Length > 0) pText = &text[0];
+			pin_ptr<Int32> pStarts = &starts[0];
+			pin_ptr<Int32> pLengths = &lengths[0];
+			pin_ptr<Int64> pTicks = &ticks[0];
+			pin_ptr<Boolean> pCouldNotParse = &couldNotParse[0];
+			KernelScopeN scope(KernelN::Parse, count, totalLength);
+			return ParseTicksN<false>(pText, text->Length, pStarts, pLengths, count, pTicks, pCouldNotParse);
+		}
+
+		Int32 String8N::FormatDateTime(array<Int64>^ ticks, Int32 count, array<Byte>^ buffer, array<Int32>^ ends)
+		{
+			if (count < 0 || count > ticks->Length || count > ends->Length) throw gcnew IndexOutOfRangeException();
+			if ((Int64)count * 20 > buffer->Length) throw gcnew ArgumentException("buffer must have 20 bytes per value.");
+			if (count == 0) return 0;
+
+			for (int i = 0; i < count; ++i)
+			{
+				if (ticks[i] < 0 || ticks[i] > DateTime::MaxValue.Ticks) throw gcnew ArgumentOutOfRangeException("ticks");
+			}
+
+			pin_ptr<Int64> pTicks = &ticks[0];
+			pin_ptr<Byte> pBuffer = &buffer[0];
+			pin_ptr<Int32> pEnds = &ends[0];
+			return FormatDateTimeN(pTicks, count, pBuffer, pEnds);
+		}
+	}
+}
@@ -0,0 +1,652 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <intrin.h>
+#include <nmmintrin.h>
+#include "String8Compare.h"
+#include "String8SetN.h"
+#include "KernelCountersN.h"
+
+#pragma unmanaged
+
+// Sets of up to TeddyValueLimit values are matched with the Teddy SIMD prefilter; larger sets use Aho-Corasick.
+const int TeddyValueLimit = 64;
+const int TeddyBucketCount = 8;
+const int TeddyMaxPrefixLength = 3;
+
+struct String8SetData
+{
+	bool ignoreCase;
+	bool useTeddy;
+
+	// Values are concatenated (lowercased if ignoreCase); value i is [valueStarts[i], valueStarts[i + 1])
+	int valueCount;
+	unsigned __int8* values;
+	int* valueStarts;
+	int minLength;
+
+	// Teddy: for each prefix byte, a bit per bucket which could match each low and high nibble
+	int prefixLength;
+	unsigned __int8 lowMasks[TeddyMaxPrefixLength][16];
+	unsigned __int8 highMasks[TeddyMaxPrefixLength][16];
+	int bucketStarts[TeddyBucketCount + 1];
+	int* bucketValues;
+
+	// Aho-Corasick: DFA over byte classes, with the lowest value index ending at each state and the lowest equal to the path to it.
+	// dictionaryLink is the next shorter suffix state which a value equals, so all values ending at a state can be enumerated.
+	int stateCount;
+	int classCount;
+	int maxLength;
+	unsigned __int16 byteClass[256];
+	int* transitions;
+	int* outputValue;
+	int* exactValue;
+	int* dictionaryLink;
+	int* depth;
+};
+
+static __inline int LowestValueN(int left, int right)
+{
+	if (left == -1) return right;
+	if (right == -1) return left;
+	return (left < right ? left : right);
+}
+
+static __inline int ValueLengthN(String8SetData* set, int valueIndex)
+{
+	return set->valueStarts[valueIndex + 1] - set->valueStarts[valueIndex];
+}
+
+template<bool ignoreCase>
+static __inline bool ValueMatchesAtN(String8SetData* set, unsigned __int8* text, int position, int end, int valueIndex)
+{
+	int length = ValueLengthN(set, valueIndex);
+	if (length == 0 || position + length > end) return false;
+	return EqualsN<ignoreCase>(&text[position], &set->values[set->valueStarts[valueIndex]], length);
+}
+
+static void BuildTeddyN(String8SetData* set, int* sortedValues, int sortedCount)
+{
+	set->prefixLength = (set->minLength < TeddyMaxPrefixLength ? set->minLength : TeddyMaxPrefixLength);
+	memset(set->lowMasks, 0, sizeof(set->lowMasks));
+	memset(set->highMasks, 0, sizeof(set->highMasks));
+
+	// Sort values by prefix so values sharing a prefix share a bucket (fewer false positives)
+	for (int i = 1; i < sortedCount; ++i)
+	{
+		int current = sortedValues[i];
+		int j = i - 1;
+		for (; j >= 0; --j)
+		{
+			unsigned __int8* left = &set->values[set->valueStarts[sortedValues[j]]];
+			unsigned __int8* right = &set->values[set->valueStarts[current]];
+			if (memcmp(left, right, set->prefixLength) <= 0) break;
+			sortedValues[j + 1] = sortedValues[j];
+		}
+
+		sortedValues[j + 1] = current;
+	}
+
+	// Split the sorted values into contiguous buckets and record the nibbles each bucket can have at each prefix byte
+	set->bucketValues = new int[sortedCount > 0 ? sortedCount : 1];
+	for (int bucket = 0; bucket < TeddyBucketCount; ++bucket)
+	{
+		set->bucketStarts[bucket] = (bucket * sortedCount) / TeddyBucketCount;
+	}
+	set->bucketStarts[TeddyBucketCount] = sortedCount;
+
+	for (int bucket = 0; bucket < TeddyBucketCount; ++bucket)
+	{
+		for (int i = set->bucketStarts[bucket]; i < set->bucketStarts[bucket + 1]; ++i)
+		{
+			int valueIndex = sortedValues[i];
+			set->bucketValues[i] = valueIndex;
+
+			unsigned __int8* value = &set->values[set->valueStarts[valueIndex]];
+			for (int k = 0; k < set->prefixLength; ++k)
+			{
+				unsigned __int8 c = value[k];
+				set->lowMasks[k][c & 15] |= (1 << bucket);
+				set->highMasks[k][c >> 4] |= (1 << bucket);
+
+				// Allow the uppercase form of letters also
+				if (set->ignoreCase && CaseFoldMaskN(c) != 0)
+				{
+					c ^= 0x20;
+					set->lowMasks[k][c & 15] |= (1 << bucket);
+					set->highMasks[k][c >> 4] |= (1 << bucket);
+				}
+			}
+		}
+	}
+}
+
+static void BuildAhoCorasickN(String8SetData* set)
+{
+	// Map each byte used by any value to a class; all other bytes share class zero
+	memset(set->byteClass, 0, sizeof(set->byteClass));
+	set->classCount = 1;
+	int totalLength = set->valueStarts[set->valueCount];
+	for (int i = 0; i < totalLength; ++i)
+	{
+		unsigned __int8 c = set->values[i];
+		if (set->byteClass[c] == 0) set->byteClass[c] = (unsigned __int16)(set->classCount++);
+	}
+
+	// Uppercase letters share the class of their lowercase form
+	if (set->ignoreCase)
+	{
+		for (int c = 'A'; c <= 'Z'; ++c)
+		{
+			set->byteClass[c] = set->byteClass[c | 0x20];
+		}
+	}
+
+	int maxStates = totalLength + 1;
+	int classCount = set->classCount;
+	set->transitions = new int[maxStates * classCount];
+	set->outputValue = new int[maxStates];
+	set->exactValue = new int[maxStates];
+	set->dictionaryLink = new int[maxStates];
+	set->depth = new int[maxStates];
+
+	for (int i = 0; i < maxStates * classCount; ++i) set->transitions[i] = -1;
+	for (int i = 0; i < maxStates; ++i)
+	{
+		set->outputValue[i] = -1;
+		set->exactValue[i] = -1;
+		set->dictionaryLink[i] = -1;
+		set->depth[i] = 0;
+	}
+
+	// Build the trie of values
+	set->stateCount = 1;
+	for (int valueIndex = 0; valueIndex < set->valueCount; ++valueIndex)
+	{
+		int length = ValueLengthN(set, valueIndex);
+		if (length == 0) continue;
+		if (length > set->maxLength) set->maxLength = length;
+
+		int state = 0;
+		unsigned __int8* value = &set->values[set->valueStarts[valueIndex]];
+		for (int i = 0; i < length; ++i)
+		{
+			int* next = &set->transitions[state * classCount + set->byteClass[value[i]]];
+			if (*next == -1)
+			{
+				*next = set->stateCount++;
+				set->depth[*next] = i + 1;
+			}
+
+			state = *next;
+		}
+
+		// Values are added in order, so the first value to end here is the lowest index
+		if (set->exactValue[state] == -1) set->exactValue[state] = valueIndex;
+	}
+
+	// Convert the trie to a DFA breadth first, following failure links for missing transitions
+	int* failure = new int[set->stateCount];
+	int* queue = new int[set->stateCount];
+	int queueStart = 0;
+	int queueEnd = 0;
+
+	for (int c = 0; c < classCount; ++c)
+	{
+		int* next = &set->transitions[c];
+		if (*next == -1)
+		{
+			*next = 0;
+		}
+		else
+		{
+			failure[*next] = 0;
+			queue[queueEnd++] = *next;
+		}
+	}
+
+	while (queueStart < queueEnd)
+	{
+		int state = queue[queueStart++];
+		set->outputValue[state] = LowestValueN(set->exactValue[state], set->outputValue[failure[state]]);
+		set->dictionaryLink[state] = (set->exactValue[failure[state]] != -1 ? failure[state] : set->dictionaryLink[failure[state]]);
+
+		for (int c = 0; c < classCount; ++c)
+		{
+			int* next = &set->transitions[state * classCount + c];
+			int fallback = set->transitions[failure[state] * classCount + c];
+
+			if (*next == -1)
+			{
+				*next = fallback;
+			}
+			else
+			{
+				failure[*next] = fallback;
+				queue[queueEnd++] = *next;
+			}
+		}
+	}
+
+	delete[] failure;
+	delete[] queue;
+}
+
+static String8SetData* BuildN(unsigned __int8* values, int* valueEnds, int valueCount, bool ignoreCase)
+{
+	String8SetData* set = new String8SetData();
+	memset(set, 0, sizeof(String8SetData));
+	set->ignoreCase = ignoreCase;
+	set->valueCount = valueCount;
+
+	// Copy the values, lowercasing them if ignoring case
+	int totalLength = (valueCount > 0 ? valueEnds[valueCount - 1] : 0);
+	set->values = new unsigned __int8[totalLength + 1];
+	set->valueStarts = new int[valueCount + 1];
+
+	for (int i = 0; i < totalLength; ++i)
+	{
+		set->values[i] = (ignoreCase ? ToLowerN(values[i]) : values[i]);
+	}
+
+	// Find the non-empty values (empty values never match) and the shortest length
+	int* sortedValues = new int[valueCount > 0 ? valueCount : 1];
+	int nonEmptyCount = 0;
+	set->minLength = 0;
+
+	set->valueStarts[0] = 0;
+	for (int i = 0; i < valueCount; ++i)
+	{
+		set->valueStarts[i + 1] = valueEnds[i];
+
+		int length = ValueLengthN(set, i);
+		if (length > 0)
+		{
+			sortedValues[nonEmptyCount++] = i;
+			if (set->minLength == 0 || length < set->minLength) set->minLength = length;
+		}
+	}
+
+	set->useTeddy = (nonEmptyCount <= TeddyValueLimit);
+	if (set->useTeddy)
+	{
+		BuildTeddyN(set, sortedValues, nonEmptyCount);
+	}
+	else
+	{
+		BuildAhoCorasickN(set);
+	}
+
+	delete[] sortedValues;
+	return set;
+}
+
+static void FreeN(String8SetData* set)
+{
+	delete[] set->values;
+	delete[] set->valueStarts;
+	delete[] set->bucketValues;
+	delete[] set->transitions;
+	delete[] set->outputValue;
+	delete[] set->exactValue;
+	delete[] set->dictionaryLink;
+	delete[] set->depth;
+	delete set;
+}
+
+// Find the lowest index of a value in the given buckets which matches at position (and ends by end), or -1
+template<bool ignoreCase>
+static int MatchInBucketsN(String8SetData* set, unsigned __int8* text, int position, int end, unsigned int buckets)
+{
+	int bestValue = -1;
+
+	while (buckets != 0)
+	{
+		int bucket = (int)_tzcnt_u32(buckets);
+		for (int i = set->bucketStarts[bucket]; i < set->bucketStarts[bucket + 1]; ++i)
+		{
+			int valueIndex = set->bucketValues[i];
+			if (bestValue != -1 && valueIndex > bestValue) continue;
+			if (ValueMatchesAtN<ignoreCase>(set, text, position, end, valueIndex)) bestValue = valueIndex;
+		}
+
+		buckets &= buckets - 1;
+	}
+
+	return bestValue;
+}
+
+// TeddyScanner returns positions where a value could start, with the buckets which might match there, in order.
+// It classifies 32 positions at a time by looking up the low and high nibble of each prefix byte in the bucket masks.
+class TeddyScanner
+{
+private:
+	String8SetData* _set;
+	unsigned __int8* _text;
+	int _lastPosition;
+	int _nextPosition;
+
+	int _blockStart;
+	unsigned int _candidates;
+	unsigned __int8 _buckets[32];
+
+	__m256i _lowMasks[TeddyMaxPrefixLength];
+	__m256i _highMasks[TeddyMaxPrefixLength];
+
+	void NextBlock()
+	{
+		int position = _nextPosition;
+		int end = _lastPosition + _set->minLength;
+		_blockStart = position;
+
+		if (position + 31 + _set->prefixLength <= end)
+		{
+			// Look up the buckets for 32 positions at once
+			__m256i nibbleMask = _mm256_set1_epi8(0x0F);
+			__m256i result = _mm256_set1_epi8(-1);
+			for (int k = 0; k < _set->prefixLength; ++k)
+			{
+				__m256i block = _mm256_loadu_si256((__m256i*)(&_text[position + k]));
+				__m256i low = _mm256_and_si256(block, nibbleMask);
+				__m256i high = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibbleMask);
+				result = _mm256_and_si256(result, _mm256_and_si256(_mm256_shuffle_epi8(_lowMasks[k], low), _mm256_shuffle_epi8(_highMasks[k], high)));
+			}
+
+			_mm256_storeu_si256((__m256i*)_buckets, result);
+			_candidates = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(result, _mm256_setzero_si256()));
+
+			// Exclude positions where no value would fit
+			if (position + 31 > _lastPosition) _candidates &= ((1U << (_lastPosition - position + 1)) - 1);
+		}
+		else
+		{
+			// Look up the buckets for the remaining positions individually
+			_candidates = 0;
+			for (int offset = 0; offset < 32 && position + offset <= _lastPosition; ++offset)
+			{
+				unsigned __int8 buckets = 0xFF;
+				for (int k = 0; k < _set->prefixLength; ++k)
+				{
+					unsigned __int8 c = _text[position + offset + k];
+					buckets &= _set->lowMasks[k][c & 15] & _set->highMasks[k][c >> 4];
+				}
+
+				_buckets[offset] = buckets;
+				if (buckets != 0) _candidates |= (1U << offset);
+			}
+		}
+
+		_nextPosition = position + 32;
+	}
+
+public:
+	TeddyScanner(String8SetData* set, unsigned __int8* text, int index, int end)
+	{
+		_set = set;
+		_text = text;
+		_lastPosition = end - set->minLength;
+		_nextPosition = index;
+		_blockStart = index;
+		_candidates = 0;
+
+		for (int k = 0; k < set->prefixLength; ++k)
+		{
+			_lowMasks[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)set->lowMasks[k]));
+			_highMasks[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)set->highMasks[k]));
+		}
+	}
+
+	// Return the next position where a value could start and the buckets which could match there, or -1 when done
+	int Next(unsigned int* buckets)
+	{
+		while (_candidates == 0)
+		{
+			if (_set->minLength == 0 || _nextPosition > _lastPosition) return -1;
+			NextBlock();
+		}
+
+		int offset = (int)_tzcnt_u32(_candidates);
+		_candidates &= _candidates - 1;
+
+		*buckets = _buckets[offset];
+		return _blockStart + offset;
+	}
+
+	// Skip any candidates before position
+	void SkipTo(int position)
+	{
+		int offset = position - _blockStart;
+		if (offset >= 32)
+		{
+			_candidates = 0;
+			if (position > _nextPosition) _nextPosition = position;
+		}
+		else if (offset > 0)
+		{
+			_candidates &= (~0U << offset);
+		}
+	}
+};
+
+template<bool ignoreCase>
+static void WhereContainsAnyTeddyN(String8SetData* set, unsigned __int8* text, int textIndex, int* rowEnds, int rowCount, int rowEndOffset, unsigned __int64* matchVector)
+{
+	if (rowCount == 0) return;
+
+	TeddyScanner scanner(set, text, textIndex, rowEnds[rowCount - 1] - rowEndOffset);
+
+	int row = 0;
+	unsigned int buckets;
+	int position;
+	while ((position = scanner.Next(&buckets)) != -1)
+	{
+		// Find the row containing this candidate
+		while (row < rowCount && rowEnds[row] - rowEndOffset <= position) ++row;
+		if (row == rowCount) break;
+
+		// If a value matches entirely within the row, the row matches; skip to the next row
+		int rowEnd = rowEnds[row] - rowEndOffset;
+		if (MatchInBucketsN<ignoreCase>(set, text, position, rowEnd, buckets) != -1)
+		{
+			matchVector[row >> 6] |= (0x1ULL << (row & 63));
+			scanner.SkipTo(rowEnd);
+			++row;
+		}
+	}
+}
+
+static void WhereContainsAnyAhoCorasickN(String8SetData* set, unsigned __int8* text, int textIndex, int* rowEnds, int rowCount, int rowEndOffset, unsigned __int64* matchVector)
+{
+	int* transitions = set->transitions;
+	int* outputValue = set->outputValue;
+	int classCount = set->classCount;
+
+	int rowStart = textIndex;
+	for (int row = 0; row < rowCount; ++row)
+	{
+		int rowEnd = rowEnds[row] - rowEndOffset;
+
+		// Run the DFA across the row, stopping at the first value found
+		int state = 0;
+		for (int i = rowStart; i < rowEnd; ++i)
+		{
+			state = transitions[state * classCount + set->byteClass[text[i]]];
+			if (outputValue[state] != -1)
+			{
+				matchVector[row >> 6] |= (0x1ULL << (row & 63));
+				break;
+			}
+		}
+
+		rowStart = rowEnd;
+	}
+}
+
+template<bool ignoreCase>
+static int IndexOfAnyTeddyN(String8SetData* set, unsigned __int8* text, int index, int end, int* result, int* valueIndices, int resultLimit)
+{
+	int resultCount = 0;
+	TeddyScanner scanner(set, text, index, end);
+
+	unsigned int buckets;
+	int position;
+	while ((position = scanner.Next(&buckets)) != -1)
+	{
+		int valueIndex = MatchInBucketsN<ignoreCase>(set, text, position, end, buckets);
+		if (valueIndex != -1)
+		{
+			result[resultCount] = position;
+			valueIndices[resultCount] = valueIndex;
+			if (++resultCount == resultLimit) break;
+		}
+	}
+
+	return resultCount;
+}
+
+static int IndexOfAnyAhoCorasickN(String8SetData* set, unsigned __int8* text, int index, int end, int* result, int* valueIndices, int resultLimit)
+{
+	int resultCount = 0;
+	int* transitions = set->transitions;
+	int* exactValue = set->exactValue;
+	int* dictionaryLink = set->dictionaryLink;
+	int* depth = set->depth;
+	int classCount = set->classCount;
+	int maxLength = set->maxLength;
+
+	// The lowest value starting at each of the last maxLength positions; a position is final once no value starting there can still end
+	int* lowestAt = new int[maxLength];
+	for (int i = 0; i < maxLength; ++i) lowestAt[i] = -1;
+
+	// Run the DFA across the text once
+	int state = 0;
+	for (int i = index; i < end && resultCount < resultLimit; ++i)
+	{
+		state = transitions[state * classCount + set->byteClass[text[i]]];
+
+		// Record every value ending here at the position it starts
+		for (int match = (exactValue[state] != -1 ? state : dictionaryLink[state]); match != -1; match = dictionaryLink[match])
+		{
+			int* lowest = &lowestAt[(i - depth[match] + 1) % maxLength];
+			*lowest = LowestValueN(*lowest, exactValue[match]);
+		}
+
+		// No more values can end for the position maxLength - 1 back, so report it
+		int position = i - maxLength + 1;
+		if (position >= index)
+		{
+			int* lowest = &lowestAt[position % maxLength];
+			if (*lowest != -1)
+			{
+				result[resultCount] = position;
+				valueIndices[resultCount] = *lowest;
+				resultCount++;
+				*lowest = -1;
+			}
+		}
+	}
+
+	// Report the positions in the last maxLength bytes
+	int position = end - maxLength + 1;
+	if (position < index) position = index;
+	for (; position < end && resultCount < resultLimit; ++position)
+	{
+		int lowest = lowestAt[position % maxLength];
+		if (lowest != -1)
+		{
+			result[resultCount] = position;
+			valueIndices[resultCount] = lowest;
+			resultCount++;
+		}
+	}
+
+	delete[] lowestAt;
+	return resultCount;
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		IntPtr String8SetN::Build(array<Byte>^ values, array<Int32>^ valueEnds, Int32 valueCount, Boolean ignoreCase)
+		{
+			if (valueCount < 0 || valueCount > valueEnds->Length) throw gcnew IndexOutOfRangeException();
+			if (valueCount > 0 && (valueEnds[valueCount - 1] > values->Length)) throw gcnew IndexOutOfRangeException();
+			for (int i = 1; i < valueCount; ++i)
+			{
+				if (valueEnds[i] < valueEnds[i - 1]) throw gcnew ArgumentException("valueEnds must be ascending.");
+			}
+
+			pin_ptr<Byte> pValues = nullptr;
+			pin_ptr<Int32> pValueEnds = nullptr;
+			if (values->Length > 0) pValues = &values[0];
+			if (valueEnds->Length > 0) pValueEnds = &valueEnds[0];
+			return IntPtr(BuildN(pValues, pValueEnds, valueCount, ignoreCase));
+		}
+
+		void String8SetN::Free(IntPtr set)
+		{
+			if (set == IntPtr::Zero) return;
+			FreeN((String8SetData*)set.ToPointer());
+		}
+
+		void String8SetN::WhereContainsAny(IntPtr set, array<Byte>^ text, Int32 textIndex, array<Int32>^ rowEnds, Int32 rowEndsIndex, Int32 rowCount, Int32 rowEndOffset, array<UInt64>^ vector)
+		{
+			if (set == IntPtr::Zero) throw gcnew ArgumentNullException("set");
+			if (rowCount <= 0) return;
+			if (textIndex < 0 || rowEndsIndex < 0) throw gcnew IndexOutOfRangeException();
+			if (rowEndsIndex + rowCount > rowEnds->Length) throw gcnew IndexOutOfRangeException();
+			if (rowEnds[rowEndsIndex + rowCount - 1] - rowEndOffset > text->Length) throw gcnew IndexOutOfRangeException();
+			if (rowCount > (vector->Length * 64)) throw gcnew IndexOutOfRangeException();
+
+			String8SetData* pSet = (String8SetData*)set.ToPointer();
+			pin_ptr<Byte> pText = nullptr;
+			if (text->Length > 0) pText = &text[0];
+			pin_ptr<Int32> pRowEnds = &rowEnds[rowEndsIndex];
+			pin_ptr<UInt64> pVector = &vector[0];
+			KernelScopeN scope(KernelN::WhereString, rowCount, rowEnds[rowEndsIndex + rowCount - 1] - rowEndOffset - textIndex, pVector, rowCount);
+
+			if (!pSet->useTeddy)
+			{
+				WhereContainsAnyAhoCorasickN(pSet, pText, textIndex, pRowEnds, rowCount, rowEndOffset, pVector);
+			}
+			else if (pSet->ignoreCase)
+			{
+				WhereContainsAnyTeddyN<true>(pSet, pText, textIndex, pRowEnds, rowCount, rowEndOffset, pVector);
+			}
+			else
+			{
+				WhereContainsAnyTeddyN<false>(pSet, pText, textIndex, pRowEnds, rowCount, rowEndOffset, pVector);
+			}
+		}
+
+		Int32 String8SetN::IndexOfAny(IntPtr set, array<Byte>^ text, Int32 index, Int32 length, array<Int32>^ matchArray, array<Int32>^ valueIndexArray)
+		{
+			if (set == IntPtr::Zero) throw gcnew ArgumentNullException("set");
+			if (index < 0 || length < 0 || index + length > text->Length) throw gcnew IndexOutOfRangeException();
+			if (valueIndexArray->Length < matchArray->Length) throw gcnew ArgumentOutOfRangeException("valueIndexArray");
+			if (length == 0 || matchArray->Length == 0) return 0;
+
+			String8SetData* pSet = (String8SetData*)set.ToPointer();
+			pin_ptr<Byte> pText = &text[0];
+			pin_ptr<Int32> pMatchArray = &matchArray[0];
+			pin_ptr<Int32> pValueIndexArray = &valueIndexArray[0];
+
+			if (!pSet->useTeddy)
+			{
+				return IndexOfAnyAhoCorasickN(pSet, pText, index, index + length, pMatchArray, pValueIndexArray, matchArray->Length);
+			}
+			else if (pSet->ignoreCase)
+			{
+				return IndexOfAnyTeddyN<true>(pSet, pText, index, index + length, pMatchArray, pValueIndexArray, matchArray->Length);
+			}
+			else
+			{
+				return IndexOfAnyTeddyN<false>(pSet, pText, index, index + length, pMatchArray, pValueIndexArray, matchArray->Length);
+			}
+		}
+	}
+}
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+using namespace System;
+
+namespace XForm
+{
+	namespace Native
+	{
+		public ref class String8SetN
+		{
+		public:
+			// Build a matcher for a set of values (value i ends at valueEnds[i] in values). Must be released with Free.
+			static IntPtr Build(array<Byte>^ values, array<Int32>^ valueEnds, Int32 valueCount, Boolean ignoreCase);
+			static void Free(IntPtr set);
+
+			// Set the bit for each row containing any value. The first row starts at textIndex and row i ends at (rowEnds[rowEndsIndex + i] - rowEndOffset).
+			static void WhereContainsAny(IntPtr set, array<Byte>^ text, Int32 textIndex, array<Int32>^ rowEnds, Int32 rowEndsIndex, Int32 rowCount, Int32 rowEndOffset, array<UInt64>^ vector);
+
+			// Find each index where any value starts (and the lowest value index matching there), in order, until matchArray is full.
+			static Int32 IndexOfAny(IntPtr set, array<Byte>^ text, Int32 index, Int32 length, array<Int32>^ matchArray, array<Int32>^ valueIndexArray);
+		};
+	}
+}
@@ -0,0 +1,243 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "stdafx.h"
+#include <intrin.h>
+#include <string.h>
+#include "String8N.h"
+#include "KernelCountersN.h"
+
+#pragma unmanaged
+
+// Cell formats, matching PageTabularWriter.Format. TSV removes tabs and newlines; CSV quotes every value and doubles quotes.
+enum class CellFormatN : unsigned __int8
+{
+	Tsv = 0,
+	Csv = 1
+};
+
+template<CellFormatN format>
+static __inline bool IsEscapedN(unsigned __int8 c)
+{
+	if (format == CellFormatN::Tsv) return (c == '\t' || c == '\n');
+	return (c == '"');
+}
+
+// Build a bit for each of 32 bytes which must be escaped
+template<CellFormatN format>
+static __inline unsigned int EscapeMaskN(__m256i block)
+{
+	if (format == CellFormatN::Tsv)
+	{
+		__m256i tabs = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t'));
+		__m256i lines = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n'));
+		return (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(tabs, lines));
+	}
+
+	return (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('"')));
+}
+
+// Return the escaped length of one value (without the delimiter after it)
+template<CellFormatN format>
+static int MeasureCellN(unsigned __int8* value, int length)
+{
+	int escapeCount = 0;
+
+	// Count escaped bytes 32 at a time
+	int i = 0;
+	for (; i + 32 <= length; i += 32)
+	{
+		__m256i block = _mm256_loadu_si256((__m256i*)(&value[i]));
+		escapeCount += (int)__popcnt(EscapeMaskN<format>(block));
+	}
+
+	// Count the remainder individually
+	for (; i < length; ++i)
+	{
+		if (IsEscapedN<format>(value[i])) escapeCount++;
+	}
+
+	if (format == CellFormatN::Tsv) return length - escapeCount;
+	return length + escapeCount + 2;
+}
+
+// Write the bytes [from, to) of value, handling the escaped byte at 'to' if there is one
+template<CellFormatN format>
+static __inline unsigned __int8* CopyUntilEscapeN(unsigned __int8* value, int from, int to, bool escapedAtEnd, unsigned __int8* output)
+{
+	memcpy(output, &value[from], to - from);
+	output += (to - from);
+
+	// TSV drops tabs and newlines; CSV writes quotes twice
+	if (format == CellFormatN::Csv && escapedAtEnd)
+	{
+		*output++ = '"';
+		*output++ = '"';
+	}
+
+	return output;
+}
+
+// Write one escaped value to output; returns the end of the written bytes
+template<CellFormatN format>
+static unsigned __int8* WriteCellN(unsigned __int8* value, int length, unsigned __int8* output)
+{
+	if (format == CellFormatN::Csv) *output++ = '"';
+
+	int i = 0;
+	for (; i + 32 <= length; i += 32)
+	{
+		__m256i block = _mm256_loadu_si256((__m256i*)(&value[i]));
+		unsigned int escapes = EscapeMaskN<format>(block);
+
+		// Most blocks need no escaping; copy them as-is
+		if (escapes == 0)
+		{
+			_mm256_storeu_si256((__m256i*)output, block);
+			output += 32;
+			continue;
+		}
+
+		// Otherwise, copy the runs between escaped bytes
+		int from = i;
+		while (escapes != 0)
+		{
+			int at = i + (int)_tzcnt_u32(escapes);
+			output = CopyUntilEscapeN<format>(value, from, at, true, output);
+			from = at + 1;
+			escapes &= escapes - 1;
+		}
+
+		output = CopyUntilEscapeN<format>(value, from, i + 32, false, output);
+	}
+
+	// Copy the remainder individually
+	int from = i;
+	for (; i < length; ++i)
+	{
+		if (IsEscapedN<format>(value[i]))
+		{
+			output = CopyUntilEscapeN<format>(value, from, i, true, output);
+			from = i + 1;
+		}
+	}
+
+	output = CopyUntilEscapeN<format>(value, from, length, false, output);
+
+	if (format == CellFormatN::Csv) *output++ = '"';
+	return output;
+}
+
+template<CellFormatN format>
+static __int64 MeasureCellsN(unsigned __int8* text, int* starts, int* lengths, int count, int* cellLengths)
+{
+	__int64 totalLength = 0;
+
+	for (int i = 0; i < count; ++i)
+	{
+		cellLengths[i] = MeasureCellN<format>(&text[starts[i]], lengths[i]);
+		totalLength += cellLengths[i];
+	}
+
+	return totalLength;
+}
+
+// Write each escaped value at positions[i] in buffer, followed by the cell delimiter or (for the last column) the row separator.
+// Returns the index of the first value which didn't fit in the buffer, or count if all were written.
+template<CellFormatN format>
+static int WriteCellsN(unsigned __int8* text, int* starts, int* lengths, int count, bool lastColumn, int* positions, unsigned __int8* buffer, int bufferLength)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		unsigned __int8* value = &text[starts[i]];
+		int length = lengths[i];
+
+		// Escaping removes bytes from TSV values and at most doubles CSV values; measure exactly only when the bound doesn't fit
+		__int64 maximumLength = (format == CellFormatN::Tsv ? (__int64)length : 2 * (__int64)length + 2) + 2;
+		if (positions[i] < 0) return i;
+		if (positions[i] + maximumLength > bufferLength)
+		{
+			if ((__int64)positions[i] + MeasureCellN<format>(value, length) + (lastColumn ? 2 : 1) > bufferLength) return i;
+		}
+
+		unsigned __int8* output = WriteCellN<format>(value, length, &buffer[positions[i]]);
+
+		if (lastColumn)
+		{
+			output[0] = '\r';
+			output[1] = '\n';
+		}
+		else
+		{
+			output[0] = (format == CellFormatN::Tsv ? '\t' : ',');
+		}
+	}
+
+	return count;
+}
+
+#pragma managed
+
+namespace XForm
+{
+	namespace Native
+	{
+		// Validate the arguments and return the total length of the values
+		static Int64 ValidateCellArguments(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, Byte format, Array^ perCell)
+		{
+			if (format > (Byte)CellFormatN::Csv) throw gcnew ArgumentException("format");
+			if (count < 0 || count > starts->Length || count > lengths->Length || count > perCell->Length) throw gcnew IndexOutOfRangeException();
+
+			Int64 totalLength = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				if (starts[i] < 0 || lengths[i] < 0 || starts[i] + lengths[i] > text->Length) throw gcnew IndexOutOfRangeException();
+				totalLength += lengths[i];
+			}
+
+			return totalLength;
+		}
+
+		Int64 String8N::MeasureCells(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, Byte format, array<Int32>^ cellLengths)
+		{
+			ValidateCellArguments(text, starts, lengths, count, format, cellLengths);
+			if (count == 0) return 0;
+
+			pin_ptr<Byte> pText = nullptr;
+			if (text->Length > 0) pText = &text[0];
+			pin_ptr<Int32> pStarts = &starts[0];
+			pin_ptr<Int32> pLengths = &lengths[0];
+			pin_ptr<Int32> pCellLengths = &cellLengths[0];
+
+			if ((CellFormatN)format == CellFormatN::Tsv) return MeasureCellsN<CellFormatN::Tsv>(pText, pStarts, pLengths, count, pCellLengths);
+			return MeasureCellsN<CellFormatN::Csv>(pText, pStarts, pLengths, count, pCellLengths);
+		}
+
+		void String8N::WriteCells(array<Byte>^ text, array<Int32>^ starts, array<Int32>^ lengths, Int32 count, Byte format, Boolean lastColumn, array<Int32>^ positions, array<Byte>^ buffer)
+		{
+			Int64 totalLength = ValidateCellArguments(text, starts, lengths, count, format, positions);
+			if (count == 0) return;
+			if (buffer->Length == 0) throw gcnew IndexOutOfRangeException();
+
+			pin_ptr<Byte> pText = nullptr;
+			if (text->Length > 0) pText = &text[0];
+			pin_ptr<Int32> pStarts = &starts[0];
+			pin_ptr<Int32> pLengths = &lengths[0];
+			pin_ptr<Int32> pPositions = &positions[0];
+			pin_ptr<Byte> pBuffer = &buffer[0];
+			KernelScopeN scope(KernelN::WriteCells, count, totalLength);
+
+			int written;
+			if ((CellFormatN)format == CellFormatN::Tsv)
+			{
+				written = WriteCellsN<CellFormatN::Tsv>(pText, pStarts, pLengths, count, lastColumn, pPositions, pBuffer, buffer->Length);
+			}
+			else
+			{
+				written = WriteCellsN<CellFormatN::Csv>(pText, pStarts, pLengths, count, lastColumn, pPositions, pBuffer, buffer->Length);
+			}
+
+			if (written < count) throw gcnew IndexOutOfRangeException();
+		}
+	}
+}
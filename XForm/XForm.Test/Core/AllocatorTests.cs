@@ -56,5 +56,70 @@ namespace XForm.Test.Core
             Assert.AreEqual(typeof(List<int>), list.GetType());
             Assert.AreEqual(1000, ((List<int>)list).Capacity);
         }
+
+        [TestMethod]
+        public void Allocator_RentToSize()
+        {
+            // Use a type no other test pools, so the pool starts empty
+            decimal[] buffer = null;
+
+            // Verify rented buffers are rounded up to a size class
+            Allocator.RentToSize(ref buffer, 3000);
+            Assert.AreEqual(4096, buffer.Length);
+
+            // Verify no re-rent if size already fine
+            decimal[] previous = buffer;
+            Allocator.RentToSize(ref buffer, 4096);
+            Assert.IsTrue(ReferenceEquals(buffer, previous));
+
+            // Verify growing returns the smaller buffer, which is reused by the next rent of its size
+            Allocator.RentToSize(ref buffer, 5000);
+            Assert.AreEqual(8192, buffer.Length);
+
+            decimal[] other = null;
+            Allocator.RentToSize(ref other, 4000);
+            Assert.IsTrue(ReferenceEquals(other, previous));
+
+            // Verify Return clears the reference and the buffer is reused
+            previous = buffer;
+            Allocator.Return(ref buffer);
+            Assert.IsNull(buffer);
+            Assert.IsTrue(ReferenceEquals(previous, BufferPool<decimal>.Rent(8000)));
+
+            // Verify arrays not from the pool aren't pooled
+            BufferPool<decimal>.Return(new decimal[5000]);
+            Assert.AreEqual(8192, BufferPool<decimal>.Rent(5000).Length);
+        }
+
+        [TestMethod]
+        public void Allocator_RentBitVector()
+        {
+            // Verify rented vectors are cleared, even if returned with bits set
+            BitVector vector = null;
+            Allocator.RentToSize(ref vector, 100000);
+            vector.All(100000);
+            Allocator.Return(ref vector);
+            Assert.IsNull(vector);
+
+            Allocator.RentToSize(ref vector, 100000);
+            Assert.AreEqual(100000, vector.Capacity);
+            Assert.AreEqual(0, vector.Count);
+
+            // Verify shrinking clears bits past the new Capacity, so None only needs to clear the used words
+            vector.All(100000);
+            vector.Capacity = 1000;
+            Assert.AreEqual(1000, vector.Count);
+            vector.None();
+            Assert.AreEqual(0, vector.Count);
+
+            // Verify pooled vectors combine with unpooled ones of the same Capacity
+            BitVector other = new BitVector(1000).All(1000);
+            vector.Or(other);
+            Assert.AreEqual(1000, vector.Count);
+            other.And(vector);
+            Assert.AreEqual(1000, other.Count);
+
+            Allocator.Return(ref vector);
+        }
     }
 }
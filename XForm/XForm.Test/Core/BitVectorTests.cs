@@ -1,6 +1,8 @@
 ﻿// Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
+using System;
+using System.Collections.Generic;
 using System.Text;
 
 using Microsoft.VisualStudio.TestTools.UnitTesting;
@@ -87,6 +89,49 @@ namespace XForm.Test.Core
             Assert.AreEqual("30, 33, 36, 39, 42", Join(page, count));
         }
 
+        [TestMethod]
+        public void BitVector_PageDenseNative()
+        {
+            // Build sparse, dense, and full blocks, so native paging uses both the bit-by-bit and whole block paths
+            Random r = new Random(7);
+            BitVector set = new BitVector(64 * 40);
+            for (int i = 0; i < set.Capacity; ++i)
+            {
+                int block = i / 64;
+                set[i] = (block % 4 == 0 ? r.Next(16) == 0 : (block % 4 == 3 ? true : r.Next(4) != 0));
+            }
+
+            List<int> matches = new List<int>();
+            for (int i = 0; i < set.Capacity; ++i)
+            {
+                if (set[i]) matches.Add(i);
+            }
+
+            string expected = string.Join(", ", matches);
+
+            // Page with limits smaller than, near, and larger than one block
+            NativeAccelerator.Enable();
+            foreach (int limit in new int[] { 10, 63, 64, 65, 200 })
+            {
+                Assert.AreEqual(expected, PageToString(set, new int[limit]), $"Page limit {limit}");
+            }
+        }
+
+        private static string PageToString(BitVector set, int[] page)
+        {
+            StringBuilder result = new StringBuilder();
+
+            int index = 0;
+            while (index != -1)
+            {
+                int count = set.Page(page, ref index);
+                if (result.Length > 0 && count > 0) result.Append(", ");
+                result.Append(Join(page, count));
+            }
+
+            return result.ToString();
+        }
+
         private static void AssertOnly(BitVector set, int limit, int expected)
         {
             Assert.IsTrue(set[expected]);
@@ -0,0 +1,134 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using XForm.Data;
+
+namespace XForm.Test.Core
+{
+    [TestClass]
+    public class GathererTests
+    {
+        [TestMethod]
+        public void Gatherer_ToContiguousNative()
+        {
+            Random r = new Random(5);
+            long[] values = new long[1000];
+            byte[] bytes = new byte[1000];
+            bool[] nulls = new bool[1000];
+            for (int i = 0; i < values.Length; ++i)
+            {
+                values[i] = r.Next();
+                bytes[i] = (byte)r.Next();
+                nulls[i] = (r.Next(10) == 0);
+            }
+
+            // Build an indirected selector, sliced so the indices don't start at zero
+            int[] indices = new int[1000];
+            for (int i = 0; i < indices.Length; ++i)
+            {
+                indices[i] = r.Next(values.Length);
+            }
+
+            ArraySelector selector = ArraySelector.Map(indices, indices.Length).Slice(3, 998);
+
+            XArray expectedValues = Copy<long>(XArray.All(values, values.Length, nulls).Reselect(selector));
+            XArray expectedBytes = Copy<byte>(XArray.All(bytes).Reselect(selector));
+
+            NativeAccelerator.Enable();
+
+            XArray actualValues = Copy<long>(XArray.All(values, values.Length, nulls).Reselect(selector));
+            XArray actualBytes = Copy<byte>(XArray.All(bytes).Reselect(selector));
+
+            AssertSame<long>(expectedValues, actualValues);
+            AssertSame<byte>(expectedBytes, actualBytes);
+
+            // Verify selector composition (which gathers indices) matches indexing through both selectors
+            int[] remapArray = null;
+            ArraySelector inner = ArraySelector.Map(new int[] { 0, 5, 994, 17, 17 }, 5);
+            ArraySelector combined = selector.Select(inner, ref remapArray);
+            for (int i = 0; i < inner.Count; ++i)
+            {
+                Assert.AreEqual(selector.Index(inner.Index(i)), combined.Index(i));
+            }
+        }
+
+        [TestMethod]
+        public void Gatherer_OutOfRangeNative()
+        {
+            Action<int[], int, int[], int, int, int[]> gather = NativeAccelerator.GetMethod<Action<int[], int, int[], int, int, int[]>>("XForm.Native.GatherN", "Gather");
+
+            int[] source = new int[] { 10, 11, 12, 13 };
+            int[] target = new int[20];
+            gather(source, 1, new int[] { 2, 0, 1 }, 0, 3, target);
+            Assert.AreEqual(13, target[0]);
+            Assert.AreEqual(11, target[1]);
+            Assert.AreEqual(12, target[2]);
+
+            Assert.ThrowsException<IndexOutOfRangeException>(() => gather(source, 1, new int[] { 0, 3 }, 0, 2, target));
+            Assert.ThrowsException<IndexOutOfRangeException>(() => gather(source, 0, new int[] { 0, -1 }, 0, 2, target));
+            Assert.ThrowsException<IndexOutOfRangeException>(() => gather(source, 0, new int[] { 0, 1 }, 1, 2, target));
+        }
+
+        [TestMethod]
+        public void Gatherer_RangesNative()
+        {
+            Action<int[], int[], int, int, int[], int[]> gatherRanges = NativeAccelerator.GetMethod<Action<int[], int[], int, int, int[], int[]>>("XForm.Native.GatherN", "GatherRanges");
+
+            // Row ends for strings of lengths 3, 0, 2, 5, ...; indices include row zero (which starts at zero) and repeats
+            Random r = new Random(6);
+            int[] ends = new int[100];
+            int position = 0;
+            for (int i = 0; i < ends.Length; ++i)
+            {
+                position += r.Next(6);
+                ends[i] = position;
+            }
+
+            int[] indices = new int[50];
+            for (int i = 0; i < indices.Length; ++i)
+            {
+                indices[i] = (i % 7 == 0 ? 0 : r.Next(ends.Length));
+            }
+
+            int[] starts = new int[48];
+            int[] lengths = new int[48];
+            gatherRanges(ends, indices, 2, 48, starts, lengths);
+
+            for (int i = 0; i < 48; ++i)
+            {
+                int row = indices[i + 2];
+                int expectedStart = (row == 0 ? 0 : ends[row - 1]);
+                Assert.AreEqual(expectedStart, starts[i], $"Start {i}");
+                Assert.AreEqual(ends[row] - expectedStart, lengths[i], $"Length {i}");
+            }
+
+            Assert.ThrowsException<IndexOutOfRangeException>(() => gatherRanges(ends, new int[] { 0, 100 }, 0, 2, starts, lengths));
+            Assert.ThrowsException<IndexOutOfRangeException>(() => gatherRanges(ends, new int[] { 0, -1 }, 0, 2, starts, lengths));
+        }
+
+        private static XArray Copy<T>(XArray xarray)
+        {
+            T[] array = null;
+            bool[] nulls = null;
+            return xarray.ToContiguous<T>(ref array, ref nulls);
+        }
+
+        private static void AssertSame<T>(XArray expected, XArray actual)
+        {
+            Assert.AreEqual(expected.Count, actual.Count);
+            Assert.AreEqual(expected.HasNulls, actual.HasNulls);
+
+            T[] expectedArray = (T[])expected.Array;
+            T[] actualArray = (T[])actual.Array;
+            for (int i = 0; i < expected.Count; ++i)
+            {
+                Assert.AreEqual(expectedArray[expected.Index(i)], actualArray[actual.Index(i)], $"Row {i}");
+                if (expected.HasNulls) Assert.AreEqual(expected.NullRows[expected.Index(i)], actual.NullRows[actual.Index(i)], $"Null {i}");
+            }
+        }
+    }
+}
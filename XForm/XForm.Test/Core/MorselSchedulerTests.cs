@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Threading;
+
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using XForm.Core;
+
+namespace XForm.Test.Core
+{
+    [TestClass]
+    public class MorselSchedulerTests
+    {
+        [TestMethod]
+        public void MorselScheduler_Basics()
+        {
+            using (MorselScheduler scheduler = new MorselScheduler(3))
+            {
+                // Every row must be run exactly once, in 64-aligned morsels, for ranges smaller and larger than one morsel per thread
+                foreach (int rowCount in new int[] { 0, 1, 63, 64, 65, 1000, 64 * 100 + 7 })
+                {
+                    int[] runCount = new int[rowCount];
+                    scheduler.Run(0, rowCount, (start, end) =>
+                    {
+                        Assert.AreEqual(0, start & 63);
+                        for (int i = start; i < end; ++i) Interlocked.Increment(ref runCount[i]);
+                    }, new MorselOptions() { MorselLength = 64 });
+
+                    for (int i = 0; i < rowCount; ++i) Assert.AreEqual(1, runCount[i], $"Row {i} of {rowCount} was run {runCount[i]} times.");
+                }
+
+                // Thread-local sums merged once
+                long sum = scheduler.Run<long>(10, 100010, () => 0, (start, end, local) =>
+                {
+                    for (int i = start; i < end; ++i) local += i;
+                    return local;
+                }, (left, right) => left + right, new MorselOptions() { MorselLength = 1024 });
+
+                Assert.AreEqual((10L + 100009L) * 100000L / 2, sum);
+
+                // Skewed cost: the first morsels are slow, so other threads must steal them from the first deque
+                int threadsUsed = scheduler.Run<int>(0, 64 * 64, () => 0, (start, end, local) =>
+                {
+                    if (start < 64 * 16) Thread.Sleep(5);
+                    return 1;
+                }, (left, right) => left + right, new MorselOptions() { MorselLength = 64 });
+
+                Assert.IsTrue(threadsUsed > 1, "Work wasn't shared across threads.");
+            }
+        }
+
+        [TestMethod]
+        public void MorselScheduler_Nested()
+        {
+            using (MorselScheduler scheduler = new MorselScheduler(2))
+            {
+                // Nested calls from workers run to completion, since the calling thread always participates
+                long total = scheduler.Run<long>(0, 8, () => 0, (start, end, local) =>
+                {
+                    for (int i = start; i < end; ++i)
+                    {
+                        local += scheduler.Run<long>(0, 640, () => 0, (s, e, l) => l + (e - s), (left, right) => left + right, new MorselOptions() { MorselLength = 64 });
+                    }
+
+                    return local;
+                }, (left, right) => left + right, new MorselOptions() { MorselLength = 1 });
+
+                Assert.AreEqual(8 * 640, total);
+            }
+        }
+
+        [TestMethod]
+        public void MorselScheduler_ErrorsAndCancellation()
+        {
+            using (MorselScheduler scheduler = new MorselScheduler(3))
+            {
+                // Exceptions are rethrown on the calling thread
+                Assert.ThrowsException<InvalidOperationException>(() => scheduler.Run(0, 6400, (start, end) =>
+                {
+                    if (start == 640) throw new InvalidOperationException();
+                }, new MorselOptions() { MorselLength = 64 }));
+
+                // Cancellation skips the remaining morsels
+                using (CancellationTokenSource cts = new CancellationTokenSource())
+                {
+                    int morselsRun = 0;
+                    Assert.ThrowsException<OperationCanceledException>(() => scheduler.Run(0, 64 * 1000, (start, end) =>
+                    {
+                        if (Interlocked.Increment(ref morselsRun) == 10) cts.Cancel();
+                    }, new MorselOptions() { MorselLength = 64, CancellationToken = cts.Token }));
+
+                    Assert.IsTrue(morselsRun < 1000);
+                }
+
+                // The scheduler is still usable afterward
+                Assert.AreEqual(100, scheduler.Run<int>(0, 100, () => 0, (start, end, local) => local + (end - start), (left, right) => left + right, new MorselOptions() { MorselLength = 1 }));
+            }
+        }
+
+        [TestMethod]
+        public void ParallelRunner_SingleThread()
+        {
+            // With one thread, the method must be run once for the whole range (and not again in parallel)
+            int previousCount = ParallelRunner.ParallelCount;
+            try
+            {
+                ParallelRunner.ParallelCount = 1;
+
+                int callCount = 0;
+                ParallelRunner.Run(0, 100000, (start, end) =>
+                {
+                    callCount++;
+                    Assert.AreEqual(0, start);
+                    Assert.AreEqual(100000, end);
+                });
+
+                Assert.AreEqual(1, callCount);
+            }
+            finally
+            {
+                ParallelRunner.ParallelCount = previousCount;
+            }
+        }
+    }
+}
@@ -0,0 +1,630 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.InteropServices;
+
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using XForm.Query;
+using XForm.Types;
+
+namespace XForm.Test.Core
+{
+    /// <summary>
+    ///  NativeKernelTests compare the XForm.Native kernels to simple scalar implementations on randomized inputs,
+    ///  covering lengths around the 32 and 64 value block sizes, unaligned offsets, every operator, edge values, and resuming mid-block.
+    /// </summary>
+    [TestClass]
+    public class NativeKernelTests
+    {
+        private const int Iterations = 2000;
+
+        private delegate int PageSignature(ulong[] vector, int[] indicesFound, ref int nextIndex, int countLimit);
+
+        [TestMethod]
+        public void NativeKernel_WhereToConstant()
+        {
+            Random r = new Random(5);
+
+            WhereToConstant(r, new byte[] { 0, 1, 2, 126, 127, 128, 129, 254, 255 });
+            WhereToConstant(r, new sbyte[] { sbyte.MinValue, -127, -1, 0, 1, 126, sbyte.MaxValue });
+            WhereToConstant(r, new ushort[] { 0, 1, 255, 256, 32767, 32768, 65534, 65535 });
+            WhereToConstant(r, new short[] { short.MinValue, -32767, -256, -1, 0, 1, 255, short.MaxValue });
+
+            WhereToConstantNullable(r, new int[] { int.MinValue, -1, 0, 1, 65536, int.MaxValue });
+            WhereToConstantNullable(r, new uint[] { 0, 1, 0x7FFFFFFF, 0x80000000, uint.MaxValue });
+            WhereToConstantNullable(r, new long[] { long.MinValue, int.MinValue, -1, 0, 1, uint.MaxValue, long.MaxValue });
+            WhereToConstantNullable(r, new ulong[] { 0, 1, uint.MaxValue, 0x7FFFFFFFFFFFFFFF, 0x8000000000000000, ulong.MaxValue });
+            WhereToConstantNullable(r, new float[] { float.NegativeInfinity, float.MinValue, -1.5f, -0.0f, 0.0f, float.Epsilon, 1.5f, float.MaxValue, float.PositiveInfinity });
+            WhereToConstantNullable(r, new double[] { double.NegativeInfinity, double.MinValue, -1.5, -0.0, 0.0, double.Epsilon, 1.5, double.MaxValue, double.PositiveInfinity });
+        }
+
+        [TestMethod]
+        public void NativeKernel_WhereToArray()
+        {
+            Random r = new Random(5);
+
+            WhereToArray(r, new byte[] { 0, 1, 2, 126, 127, 128, 129, 254, 255 });
+            WhereToArray(r, new sbyte[] { sbyte.MinValue, -127, -1, 0, 1, 126, sbyte.MaxValue });
+            WhereToArray(r, new ushort[] { 0, 1, 255, 256, 32767, 32768, 65534, 65535 });
+            WhereToArray(r, new short[] { short.MinValue, -32767, -256, -1, 0, 1, 255, short.MaxValue });
+        }
+
+        private delegate void WhereInSignature(byte[] left, int index, int length, ulong[] valueSet, byte bOp, ulong[] vector, int vectorIndex);
+
+        [TestMethod]
+        public void NativeKernel_WhereIn()
+        {
+            WhereInSignature whereIn = NativeAccelerator.GetMethod<WhereInSignature>("XForm.Native.Comparer", "WhereIn");
+            Random r = new Random(7);
+
+            for (int iteration = 0; iteration < Iterations; ++iteration)
+            {
+                // Sets of random, sparse, top-bit-only, and edge values
+                bool[] inSet = new bool[256];
+                int mode = r.Next(4);
+                for (int value = 0; value < 256; ++value)
+                {
+                    if (mode == 0) inSet[value] = (r.Next(2) == 0);
+                    else if (mode == 1) inSet[value] = (r.Next(50) == 0);
+                    else if (mode == 2) inSet[value] = (value >= 128);
+                    else inSet[value] = (value == 0 || value == 127 || value == 128 || value == 255);
+                }
+
+                ulong[] valueSet = new ulong[4];
+                for (int value = 0; value < 256; ++value)
+                {
+                    if (inSet[value]) valueSet[value >> 6] |= (1UL << (value & 63));
+                }
+
+                int index = r.Next(70);
+                int length = r.Next(300);
+                byte[] left = RandomValues(r, new byte[] { 0, 1, 2, 127, 128, 254, 255 }, index + length);
+                for (int i = 0; i < left.Length; ++i)
+                {
+                    if (r.Next(2) == 0) left[i] = (byte)r.Next(256);
+                }
+
+                // Each boolean operator must merge only the matches into the existing vector
+                foreach (BooleanOperator bOp in new BooleanOperator[] { BooleanOperator.And, BooleanOperator.Or })
+                {
+                    ulong[] vector = new ulong[(length + 63) >> 6];
+                    for (int i = 0; i < vector.Length; ++i) vector[i] = (ulong)r.Next() << 32 | (uint)r.Next();
+                    ulong[] expected = (ulong[])vector.Clone();
+
+                    for (int i = 0; i < length; ++i)
+                    {
+                        bool match = inSet[left[index + i]];
+                        if (bOp == BooleanOperator.And && !match) expected[i >> 6] &= ~(1UL << (i & 63));
+                        if (bOp == BooleanOperator.Or && match) expected[i >> 6] |= (1UL << (i & 63));
+                    }
+
+                    // Bits past the end of the rows are cleared by And
+                    if (bOp == BooleanOperator.And && (length & 63) != 0) expected[expected.Length - 1] &= (1UL << (length & 63)) - 1;
+
+                    whereIn(left, index, length, valueSet, (byte)bOp, vector, 0);
+                    CollectionAssert.AreEqual(expected, vector, $"WhereIn {bOp} length {length}");
+                }
+            }
+        }
+
+        [TestMethod]
+        public void NativeKernel_CountAndPage()
+        {
+            Func<ulong[], int> count = NativeAccelerator.GetMethod<Func<ulong[], int>>("XForm.Native.BitVectorN", "Count");
+            PageSignature page = NativeAccelerator.GetMethod<PageSignature>("XForm.Native.BitVectorN", "Page");
+            Random r = new Random(5);
+
+            for (int iteration = 0; iteration < Iterations; ++iteration)
+            {
+                // Build vectors from empty to full, with runs of set bits crossing block boundaries
+                ulong[] vector = new ulong[1 + r.Next(20)];
+                double density = r.NextDouble();
+                List<int> expected = new List<int>();
+                for (int i = 0; i < vector.Length * 64; ++i)
+                {
+                    if (r.NextDouble() < density)
+                    {
+                        vector[i >> 6] |= (1UL << (i & 63));
+                        expected.Add(i);
+                    }
+                }
+
+                Assert.AreEqual(expected.Count, count(vector), "Count");
+
+                // Page from a random start, in pages of a random size, and verify every set bit after the start is found in order
+                int fromIndex = r.Next(vector.Length * 64);
+                int[] indicesFound = new int[1 + r.Next(100)];
+                List<int> actual = new List<int>();
+                int nextIndex = fromIndex;
+                while (nextIndex != -1)
+                {
+                    int pageCount = page(vector, indicesFound, ref nextIndex, indicesFound.Length);
+                    Assert.IsTrue(pageCount <= indicesFound.Length, "Page returned more than countLimit");
+                    actual.AddRange(indicesFound.Take(pageCount));
+                }
+
+                CollectionAssert.AreEqual(expected.Where((i) => i >= fromIndex).ToArray(), actual.ToArray(), $"Page from {fromIndex} with {indicesFound.Length} per page");
+            }
+        }
+
+        [TestMethod]
+        public void NativeKernel_SplitTsv()
+        {
+            Func<byte[], int, int, ulong[], ulong[], int> splitTsv = NativeAccelerator.GetMethod<Func<byte[], int, int, ulong[], ulong[], int>>("XForm.Native.String8N", "SplitTsv");
+            Random r = new Random(5);
+            byte[] alphabet = new byte[] { (byte)'a', (byte)'\t', (byte)'\n', (byte)'\r', (byte)' ' };
+
+            for (int iteration = 0; iteration < Iterations; ++iteration)
+            {
+                // Content ending exactly at the array end, so any read past it fails
+                int index = r.Next(100);
+                int length = r.Next(300);
+                byte[] content = new byte[index + length];
+                for (int i = 0; i < content.Length; ++i)
+                {
+                    content[i] = alphabet[r.Next(alphabet.Length)];
+                }
+
+                ulong[] cells = new ulong[(length + 63) >> 6];
+                ulong[] rows = new ulong[(length + 63) >> 6];
+                int rowCount = splitTsv(content, index, length, cells, rows);
+
+                int expectedRowCount = 0;
+                for (int i = 0; i < length; ++i)
+                {
+                    bool isRow = (content[index + i] == (byte)'\n');
+                    bool isCell = isRow || (content[index + i] == (byte)'\t');
+                    if (isRow) expectedRowCount++;
+
+                    Assert.AreEqual(isRow, (rows[i >> 6] & (1UL << (i & 63))) != 0, $"Row bit {i} of {length} from {index}");
+                    Assert.AreEqual(isCell, (cells[i >> 6] & (1UL << (i & 63))) != 0, $"Cell bit {i} of {length} from {index}");
+                }
+
+                Assert.AreEqual(expectedRowCount, rowCount);
+            }
+        }
+
+        [TestMethod]
+        public void NativeKernel_IndexOfAll()
+        {
+            Func<byte[], int, int, byte[], int, int, bool, int[], int> indexOfAll = NativeAccelerator.GetMethod<Func<byte[], int, int, byte[], int, int, bool, int[], int>>("XForm.Native.String8N", "IndexOfAll");
+            Random r = new Random(5);
+            byte[] alphabet = new byte[] { (byte)'a', (byte)'A', (byte)'b', (byte)'B', (byte)'@', (byte)'`' };
+
+            for (int iteration = 0; iteration < Iterations; ++iteration)
+            {
+                byte[] text = Enumerable.Range(0, r.Next(200)).Select((i) => alphabet[r.Next(alphabet.Length)]).ToArray();
+                byte[] value = Enumerable.Range(0, 1 + r.Next(6)).Select((i) => alphabet[r.Next(alphabet.Length)]).ToArray();
+                bool ignoreCase = (r.Next(2) == 0);
+                int index = (text.Length == 0 ? 0 : r.Next(text.Length));
+                int length = text.Length - index;
+                int[] matches = new int[1 + r.Next(50)];
+
+                int matchCount = indexOfAll(text, index, length, value, 0, value.Length, ignoreCase, matches);
+
+                int[] expected = Enumerable.Range(index, Math.Max(0, length - value.Length + 1))
+                    .Where((i) => Enumerable.Range(0, value.Length).All((j) => ignoreCase ? ToLower(text[i + j]) == ToLower(value[j]) : text[i + j] == value[j]))
+                    .Take(matches.Length)
+                    .ToArray();
+
+                CollectionAssert.AreEqual(expected, matches.Take(matchCount).ToArray());
+            }
+        }
+
+        [TestMethod]
+        public void NativeKernel_Counters()
+        {
+            NativeAccelerator.Enable();
+            Func<ulong[], int> count = NativeAccelerator.GetMethod<Func<ulong[], int>>("XForm.Native.BitVectorN", "Count");
+            int countIndex = Array.IndexOf(KernelCounters.KernelNames, "Count");
+            ulong[] vector = new ulong[] { ulong.MaxValue, 0x1UL, 0UL };
+
+            // Nothing is counted when counters are off
+            KernelCounterSnapshot before = KernelCounters.Read();
+            Assert.AreEqual(65, count(vector));
+            Assert.AreEqual(0, KernelCounters.Read().Subtract(before).Calls(countIndex));
+
+            try
+            {
+                Assert.IsTrue(KernelCounters.Enable(true));
+                KernelCounters.Reset();
+
+                Assert.AreEqual(65, count(vector));
+                Assert.AreEqual(65, count(vector));
+
+                KernelCounterSnapshot counters = KernelCounters.Read();
+                Assert.AreEqual(2, counters.Calls(countIndex));
+                Assert.AreEqual(2 * 192, counters.Elements(countIndex));
+                Assert.AreEqual(2 * 24, counters.Bytes(countIndex));
+                Assert.AreEqual(2 * 65, counters.Matched(countIndex));
+                Assert.IsTrue(counters.Cycles(countIndex) > 0);
+                Assert.IsTrue(counters.ToString().StartsWith("Count: 2 calls"));
+            }
+            finally
+            {
+                KernelCounters.Enable(false);
+            }
+        }
+
+        private delegate long PredicateSignature(IntPtr[] columns, byte[] types, byte[] compareOperators, long[] constants, byte[] booleanOperators, long startRow, long endRow, ulong[] vector);
+
+        [TestMethod]
+        public void NativeKernel_Predicate()
+        {
+            PredicateSignature evaluate = NativeAccelerator.GetMethod<PredicateSignature>("XForm.Native.PredicateN", "Evaluate");
+            Random r = new Random(5);
+
+            // Columns of each width, with ColumnTypeN codes (Unsigned8, Signed16, Signed32, Float32, Signed64, Float64)
+            int rowCount = 10000;
+            Array[] columns = new Array[]
+            {
+                RandomValues(r, new byte[] { 0, 1, 127, 128, 255 }, rowCount),
+                RandomValues(r, new short[] { short.MinValue, -1, 0, 1, short.MaxValue }, rowCount),
+                RandomValues(r, new int[] { int.MinValue, -1, 0, 1, int.MaxValue }, rowCount),
+                RandomValues(r, new float[] { float.NegativeInfinity, -1.5f, 0.0f, 1.5f, float.MaxValue }, rowCount),
+                RandomValues(r, new long[] { long.MinValue, -1, 0, 1, long.MaxValue }, rowCount),
+                RandomValues(r, new double[] { double.NegativeInfinity, -1.5, 0.0, 1.5, double.MaxValue }, rowCount)
+            };
+            byte[] columnTypes = new byte[] { 0, 3, 5, 8, 7, 9 };
+
+            GCHandle[] handles = columns.Select((column) => GCHandle.Alloc(column, GCHandleType.Pinned)).ToArray();
+            try
+            {
+                for (int iteration = 0; iteration < Iterations / 10; ++iteration)
+                {
+                    // Build random terms, all ANDed or all ORed, over a random 64-aligned range
+                    int termCount = 1 + r.Next(4);
+                    int[] columnIndices = new int[termCount];
+                    byte[] compareOperators = new byte[termCount];
+                    object[] values = new object[termCount];
+                    long[] constants = new long[termCount];
+                    BooleanOperator bOp = (BooleanOperator)r.Next(2);
+
+                    for (int t = 0; t < termCount; ++t)
+                    {
+                        columnIndices[t] = r.Next(columns.Length);
+                        compareOperators[t] = (byte)r.Next((int)CompareOperator.GreaterThanOrEqual + 1);
+                        values[t] = columns[columnIndices[t]].GetValue(r.Next(rowCount));
+                        constants[t] = ToBits(values[t]);
+                    }
+
+                    int startRow = 64 * r.Next(rowCount / 64);
+                    int endRow = startRow + r.Next(rowCount - startRow + 1);
+                    ulong[] vector = (r.Next(2) == 0 ? RandomVector(r, rowCount) : null);
+                    ulong[] before = (vector == null ? null : (ulong[])vector.Clone());
+
+                    long count = evaluate(
+                        columnIndices.Select((i) => handles[i].AddrOfPinnedObject()).ToArray(),
+                        columnIndices.Select((i) => columnTypes[i]).ToArray(),
+                        compareOperators,
+                        constants,
+                        Enumerable.Repeat((byte)bOp, termCount).ToArray(),
+                        startRow,
+                        endRow,
+                        vector);
+
+                    long expectedCount = 0;
+                    for (int row = startRow; row < endRow; ++row)
+                    {
+                        bool matches = (bOp == BooleanOperator.And);
+                        for (int t = 0; t < termCount; ++t)
+                        {
+                            bool termMatches = MatchesBoxed((CompareOperator)compareOperators[t], (IComparable)columns[columnIndices[t]].GetValue(row), values[t]);
+                            matches = (bOp == BooleanOperator.And ? matches && termMatches : matches || termMatches);
+                        }
+
+                        if (matches) expectedCount++;
+                        if (vector != null && ((vector[row >> 6] & (1UL << (row & 63))) != 0) != matches) Assert.Fail($"Row {row} wrong for {termCount} terms {bOp}");
+                    }
+
+                    Assert.AreEqual(expectedCount, count);
+
+                    // Rows outside the range are left alone
+                    if (vector != null)
+                    {
+                        for (int row = 0; row < startRow; ++row) Assert.AreEqual(before[row >> 6] & (1UL << (row & 63)), vector[row >> 6] & (1UL << (row & 63)));
+                    }
+                }
+            }
+            finally
+            {
+                foreach (GCHandle handle in handles) handle.Free();
+            }
+        }
+
+        private delegate void HyperLogLogAddSignature(ulong[] hashes, int index, int length, byte[] registers);
+        private delegate void CountMinAddSignature(ulong[] hashes, int index, int length, uint[] counters, int depth, uint[] estimates);
+        private static readonly ulong[] CountMinRowMultipliers = new ulong[] { 0x9E3779B97F4A7C15, 0xC2B2AE3D27D4EB4F, 0x165667B19E3779F9, 0xD6E8FEB86659FD93, 0xFF51AFD7ED558CCD, 0xC4CEB9FE1A85EC53, 0x87C37B91114253D5, 0x4CF5AD432745937F };
+
+        [TestMethod]
+        public void NativeKernel_Sketch()
+        {
+            HyperLogLogAddSignature hllAdd = NativeAccelerator.GetMethod<HyperLogLogAddSignature>("XForm.Native.HyperLogLogN", "Add");
+            Action<byte[], byte[]> hllMerge = NativeAccelerator.GetMethod<Action<byte[], byte[]>>("XForm.Native.HyperLogLogN", "Merge");
+            CountMinAddSignature cmAdd = NativeAccelerator.GetMethod<CountMinAddSignature>("XForm.Native.CountMinN", "Add");
+            Action<uint[], uint[]> cmMerge = NativeAccelerator.GetMethod<Action<uint[], uint[]>>("XForm.Native.CountMinN", "Merge");
+            Random r = new Random(5);
+
+            for (int iteration = 0; iteration < Iterations / 10; ++iteration)
+            {
+                // Hashes with many repeats and some all-zero and all-one values, over a random unaligned range
+                int length = r.Next(300);
+                int index = r.Next(10);
+                ulong[] hashes = new ulong[index + length];
+                for (int i = 0; i < hashes.Length; ++i) hashes[i] = Hashing.Hash(r.Next(50), 0);
+                if (hashes.Length > 0) hashes[r.Next(hashes.Length)] = (r.Next(2) == 0 ? 0UL : ulong.MaxValue);
+
+                // HyperLogLog: each register holds the maximum rank of the hashes routed to it
+                int precision = 4 + r.Next(13);
+                byte[] registers = new byte[1 << precision];
+                byte[] expectedRegisters = new byte[registers.Length];
+                hllAdd(hashes, index, length, registers);
+                for (int i = index; i < index + length; ++i)
+                {
+                    int register = (int)(hashes[i] >> (64 - precision));
+                    int rank = 1;
+                    while (rank <= 64 - precision && (hashes[i] & (1UL << (63 - precision - rank + 1))) == 0) rank++;
+                    expectedRegisters[register] = (byte)Math.Max(expectedRegisters[register], rank);
+                }
+
+                CollectionAssert.AreEqual(expectedRegisters, registers, $"HyperLogLog precision {precision}");
+
+                byte[] other = RandomValues(r, new byte[] { 0, 1, 30, 61 }, registers.Length);
+                byte[] expectedMerge = registers.Zip(other, (left, right) => Math.Max(left, right)).ToArray();
+                hllMerge(registers, other);
+                CollectionAssert.AreEqual(expectedMerge, registers, "HyperLogLog Merge");
+
+                // CountMin: the estimate after each add is the minimum counter across rows
+                int depth = 1 + r.Next(8);
+                int widthBits = 4 + r.Next(9);
+                int width = 1 << widthBits;
+                uint[] counters = new uint[width * depth];
+                uint[] expectedCounters = new uint[counters.Length];
+                uint[] estimates = (r.Next(2) == 0 ? new uint[length] : null);
+                cmAdd(hashes, index, length, counters, depth, estimates);
+                for (int i = 0; i < length; ++i)
+                {
+                    ulong hash = hashes[index + i];
+                    uint minimum = uint.MaxValue;
+                    for (int row = 0; row < depth; ++row)
+                    {
+                        int counter = row * width + (int)((hash * CountMinRowMultipliers[row]) >> (64 - widthBits));
+                        minimum = Math.Min(minimum, ++expectedCounters[counter]);
+                    }
+
+                    if (estimates != null) Assert.AreEqual(minimum, estimates[i], $"CountMin estimate {i}");
+                }
+
+                CollectionAssert.AreEqual(expectedCounters, counters, $"CountMin width {width} depth {depth}");
+
+                // Merge adds, saturating at uint.MaxValue
+                uint[] otherCounters = RandomValues(r, new uint[] { 0, 1, 1000, uint.MaxValue - 1, uint.MaxValue }, counters.Length);
+                uint[] expectedSum = counters.Zip(otherCounters, (left, right) => (uint)Math.Min(uint.MaxValue, (ulong)left + right)).ToArray();
+                cmMerge(counters, otherCounters);
+                CollectionAssert.AreEqual(expectedSum, counters, "CountMin Merge");
+            }
+        }
+
+        private delegate void BloomFilterAddSignature(ulong[] hashes, int index, int length, uint[] blocks);
+        private delegate int BloomFilterContainsSignature(ulong[] hashes, int index, int length, uint[] blocks, ulong[] vector);
+        private static readonly uint[] BloomFilterSalts = new uint[] { 0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d, 0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31 };
+
+        [TestMethod]
+        public void NativeKernel_BloomFilter()
+        {
+            BloomFilterAddSignature add = NativeAccelerator.GetMethod<BloomFilterAddSignature>("XForm.Native.BloomFilterN", "Add");
+            BloomFilterContainsSignature contains = NativeAccelerator.GetMethod<BloomFilterContainsSignature>("XForm.Native.BloomFilterN", "Contains");
+            Random r = new Random(6);
+
+            for (int iteration = 0; iteration < Iterations / 10; ++iteration)
+            {
+                // Add hashes over a random unaligned range to a filter with a non-power-of-two block count
+                int blockCount = 1 + r.Next(40);
+                int length = r.Next(300);
+                int index = r.Next(10);
+                ulong[] hashes = new ulong[index + length];
+                for (int i = 0; i < hashes.Length; ++i) hashes[i] = Hashing.Hash(r.Next(1000), 0);
+                if (hashes.Length > 0) hashes[r.Next(hashes.Length)] = (r.Next(2) == 0 ? 0UL : ulong.MaxValue);
+
+                // Each hash sets one bit in each word of one block
+                uint[] blocks = new uint[8 * blockCount];
+                uint[] expectedBlocks = new uint[blocks.Length];
+                add(hashes, index, length, blocks);
+                for (int i = index; i < index + length; ++i)
+                {
+                    int block = 8 * (int)(((hashes[i] >> 32) * (ulong)blockCount) >> 32);
+                    for (int word = 0; word < 8; ++word) expectedBlocks[block + word] |= 1U << (int)(((uint)hashes[i] * BloomFilterSalts[word]) >> 27);
+                }
+
+                CollectionAssert.AreEqual(expectedBlocks, blocks, $"BloomFilter Add {blockCount} blocks");
+
+                // Probe a different set of hashes; a row matches if all eight bits of its block are set
+                for (int i = 0; i < hashes.Length; ++i) hashes[i] = Hashing.Hash(r.Next(2000), 0);
+
+                ulong[] vector = new ulong[(length + 63) >> 6];
+                int count = contains(hashes, index, length, blocks, vector);
+                int expectedCount = 0;
+                for (int i = 0; i < length; ++i)
+                {
+                    ulong hash = hashes[index + i];
+                    int block = 8 * (int)(((hash >> 32) * (ulong)blockCount) >> 32);
+                    bool expected = true;
+                    for (int word = 0; word < 8; ++word) expected &= (blocks[block + word] & (1U << (int)(((uint)hash * BloomFilterSalts[word]) >> 27))) != 0;
+
+                    Assert.AreEqual(expected, (vector[i >> 6] & (1UL << (i & 63))) != 0, $"BloomFilter Contains row {i}");
+                    if (expected) expectedCount++;
+                }
+
+                Assert.AreEqual(expectedCount, count, "BloomFilter Contains count");
+            }
+        }
+
+        private static long ToBits(object value)
+        {
+            if (value is float) return (long)(uint)BitConverter.ToInt32(BitConverter.GetBytes((float)value), 0);
+            if (value is double) return BitConverter.DoubleToInt64Bits((double)value);
+            return Convert.ToInt64(value);
+        }
+
+        private static bool MatchesBoxed(CompareOperator cOp, IComparable left, object right)
+        {
+            int cmp = left.CompareTo(right);
+            switch (cOp)
+            {
+                case CompareOperator.Equal:
+                    return cmp == 0;
+                case CompareOperator.NotEqual:
+                    return cmp != 0;
+                case CompareOperator.LessThan:
+                    return cmp < 0;
+                case CompareOperator.LessThanOrEqual:
+                    return cmp <= 0;
+                case CompareOperator.GreaterThan:
+                    return cmp > 0;
+                default:
+                    return cmp >= 0;
+            }
+        }
+
+        private static byte ToLower(byte c)
+        {
+            return (byte)(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+        }
+
+        private static void WhereToConstant<T>(Random r, T[] edgeValues) where T : IComparable<T>
+        {
+            ComparerExtensions.WhereSingle<T> where = NativeAccelerator.GetMethod<ComparerExtensions.WhereSingle<T>>("XForm.Native.Comparer", "Where");
+            WhereToConstant(r, edgeValues, false, (left, index, length, cOp, right, nulls, bOp, vector, vectorIndex) => where(left, index, length, cOp, right, bOp, vector, vectorIndex));
+        }
+
+        private static void WhereToConstantNullable<T>(Random r, T[] edgeValues) where T : IComparable<T>
+        {
+            ComparerExtensions.WhereSingleNullable<T> where = NativeAccelerator.GetMethod<ComparerExtensions.WhereSingleNullable<T>>("XForm.Native.Comparer", "Where");
+            WhereToConstant(r, edgeValues, true, (left, index, length, cOp, right, nulls, bOp, vector, vectorIndex) => where(left, index, length, cOp, right, nulls, index, bOp, vector, vectorIndex));
+        }
+
+        private delegate void WhereSignature<T>(T[] left, int index, int length, byte cOp, T right, bool[] nulls, byte bOp, ulong[] vector, int vectorIndex);
+
+        private static void WhereToConstant<T>(Random r, T[] edgeValues, bool withNulls, WhereSignature<T> where) where T : IComparable<T>
+        {
+            for (int iteration = 0; iteration < Iterations; ++iteration)
+            {
+                int index = r.Next(70);
+                int length = r.Next(300);
+                T[] left = RandomValues(r, edgeValues, index + length);
+                T right = edgeValues[r.Next(edgeValues.Length)];
+                bool[] nulls = (withNulls && r.Next(2) == 0 ? Enumerable.Range(0, left.Length).Select((i) => r.Next(4) == 0).ToArray() : null);
+
+                CompareOperator cOp = (CompareOperator)r.Next((int)CompareOperator.GreaterThanOrEqual + 1);
+                BooleanOperator bOp = (BooleanOperator)r.Next(2);
+                int vectorIndex = 64 * r.Next(2);
+                ulong[] vector = RandomVector(r, vectorIndex + length);
+                ulong[] expected = (ulong[])vector.Clone();
+
+                for (int i = 0; i < length; ++i)
+                {
+                    bool matches = Matches(cOp, left[index + i], right) && (nulls == null || !nulls[index + i]);
+                    Merge(expected, vectorIndex + i, matches, bOp);
+                }
+
+                where(left, index, length, (byte)cOp, right, nulls, (byte)bOp, vector, vectorIndex);
+                VerifyBits(expected, vector, vectorIndex, length, $"{typeof(T).Name} {cOp} {right} {bOp}, {length} from {index}");
+            }
+        }
+
+        private static void WhereToArray<T>(Random r, T[] edgeValues) where T : IComparable<T>
+        {
+            ComparerExtensions.Where<T> where = NativeAccelerator.GetMethod<ComparerExtensions.Where<T>>("XForm.Native.Comparer", "Where");
+
+            for (int iteration = 0; iteration < Iterations; ++iteration)
+            {
+                int leftIndex = r.Next(70);
+                int rightIndex = r.Next(70);
+                int length = r.Next(300);
+                T[] left = RandomValues(r, edgeValues, leftIndex + length);
+                T[] right = RandomValues(r, edgeValues, rightIndex + length);
+
+                CompareOperator cOp = (CompareOperator)r.Next((int)CompareOperator.GreaterThanOrEqual + 1);
+                BooleanOperator bOp = (BooleanOperator)r.Next(2);
+                int vectorIndex = 64 * r.Next(2);
+                ulong[] vector = RandomVector(r, vectorIndex + length);
+                ulong[] expected = (ulong[])vector.Clone();
+
+                for (int i = 0; i < length; ++i)
+                {
+                    Merge(expected, vectorIndex + i, Matches(cOp, left[leftIndex + i], right[rightIndex + i]), bOp);
+                }
+
+                where(left, leftIndex, (byte)cOp, right, rightIndex, length, (byte)bOp, vector, vectorIndex);
+                VerifyBits(expected, vector, vectorIndex, length, $"{typeof(T).Name}[] {cOp} {bOp}, {length} from {leftIndex} and {rightIndex}");
+            }
+        }
+
+        private static T[] RandomValues<T>(Random r, T[] edgeValues, int length)
+        {
+            // Use only the edge values, so equal values and sign boundaries are common
+            T[] values = new T[length];
+            for (int i = 0; i < length; ++i)
+            {
+                values[i] = edgeValues[r.Next(edgeValues.Length)];
+            }
+
+            return values;
+        }
+
+        private static ulong[] RandomVector(Random r, int bitCount)
+        {
+            ulong[] vector = new ulong[(bitCount + 63) >> 6];
+            for (int i = 0; i < vector.Length; ++i)
+            {
+                vector[i] = ((ulong)(uint)r.Next() << 33) ^ ((ulong)(uint)r.Next() << 11) ^ (ulong)(uint)r.Next();
+            }
+
+            return vector;
+        }
+
+        private static bool Matches<T>(CompareOperator cOp, T left, T right) where T : IComparable<T>
+        {
+            // Inputs have no NaNs, so CompareTo agrees with the IEEE operators (including -0.0 == 0.0)
+            int cmp = left.CompareTo(right);
+            switch (cOp)
+            {
+                case CompareOperator.Equal:
+                    return cmp == 0;
+                case CompareOperator.NotEqual:
+                    return cmp != 0;
+                case CompareOperator.LessThan:
+                    return cmp < 0;
+                case CompareOperator.LessThanOrEqual:
+                    return cmp <= 0;
+                case CompareOperator.GreaterThan:
+                    return cmp > 0;
+                case CompareOperator.GreaterThanOrEqual:
+                    return cmp >= 0;
+                default:
+                    throw new NotImplementedException(cOp.ToString());
+            }
+        }
+
+        private static void Merge(ulong[] vector, int index, bool matches, BooleanOperator bOp)
+        {
+            ulong bit = (1UL << (index & 63));
+            if (bOp == BooleanOperator.And && !matches) vector[index >> 6] &= ~bit;
+            if (bOp == BooleanOperator.Or && matches) vector[index >> 6] |= bit;
+        }
+
+        private static void VerifyBits(ulong[] expected, ulong[] actual, int vectorIndex, int length, string message)
+        {
+            // Bits beyond the compared rows aren't defined after And, so only verify the compared rows
+            for (int i = vectorIndex; i < vectorIndex + length; ++i)
+            {
+                ulong bit = (1UL << (i & 63));
+                if ((expected[i >> 6] & bit) != (actual[i >> 6] & bit)) Assert.Fail($"Row {i - vectorIndex} wrong for {message}");
+            }
+        }
+    }
+}
@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using XForm.Core;
+
+namespace XForm.Test.Core
+{
+    [TestClass]
+    public class SketchTests
+    {
+        [TestMethod]
+        public void HyperLogLog_Basics()
+        {
+            // Estimates must be within 4% (five standard errors at the default precision)
+            foreach (int distinctCount in new int[] { 0, 1, 10, 1000, 50000, 500000 })
+            {
+                HyperLogLog sketch = new HyperLogLog();
+                ulong[] hashes = HashRange(0, distinctCount);
+
+                // Adding each value twice doesn't change the estimate
+                sketch.Add(hashes, 0, hashes.Length);
+                sketch.Add(hashes, 0, hashes.Length);
+
+                long estimate = sketch.Estimate();
+                Assert.IsTrue(Math.Abs(estimate - distinctCount) <= Math.Max(1, distinctCount * 0.04), $"Estimated {estimate:n0} for {distinctCount:n0} distinct values.");
+            }
+
+            // Merging overlapping sketches estimates the union
+            HyperLogLog left = new HyperLogLog();
+            HyperLogLog right = new HyperLogLog();
+            HyperLogLog all = new HyperLogLog();
+
+            ulong[] leftHashes = HashRange(0, 60000);
+            ulong[] rightHashes = HashRange(40000, 100000);
+            left.Add(leftHashes, 0, leftHashes.Length);
+            right.Add(rightHashes, 0, rightHashes.Length);
+            all.Add(leftHashes, 0, leftHashes.Length);
+            all.Add(rightHashes, 0, rightHashes.Length);
+
+            left.Merge(right);
+            Assert.AreEqual(all.Estimate(), left.Estimate());
+            Assert.IsTrue(Math.Abs(left.Estimate() - 100000) <= 4000);
+
+            // Only sketches with the same precision merge
+            Assert.ThrowsException<ArgumentException>(() => left.Merge(new HyperLogLog(10)));
+        }
+
+        [TestMethod]
+        public void CountMinSketch_Basics()
+        {
+            // Value i is added (i + 1) times for the first 100 values, then 10,000 values are added once
+            CountMinSketch sketch = new CountMinSketch();
+            for (int i = 0; i < 100; ++i)
+            {
+                ulong[] repeated = new ulong[i + 1];
+                for (int j = 0; j < repeated.Length; ++j) repeated[j] = Hashing.Hash(i, 0);
+
+                uint[] estimates = new uint[repeated.Length];
+                sketch.Add(repeated, 0, repeated.Length, estimates);
+
+                // The estimate after each add counts every add so far
+                for (int j = 0; j < repeated.Length; ++j) Assert.IsTrue(estimates[j] >= j + 1);
+            }
+
+            ulong[] singles = HashRange(1000, 11000);
+            sketch.Add(singles, 0, singles.Length);
+            Assert.AreEqual(5050 + 10000, sketch.TotalCount);
+
+            // Estimates never undercount and overcount by much less than 0.5% of the total
+            for (int i = 0; i < 100; ++i)
+            {
+                uint estimate = sketch.Estimate(Hashing.Hash(i, 0));
+                Assert.IsTrue(estimate >= i + 1 && estimate <= i + 1 + 15, $"Estimated {estimate} for {i + 1}.");
+            }
+
+            // Merged sketches estimate the combined counts
+            CountMinSketch other = new CountMinSketch();
+            other.Add(singles, 0, singles.Length);
+            other.Merge(sketch);
+            Assert.AreEqual(5050 + 20000, other.TotalCount);
+            Assert.IsTrue(other.Estimate(singles[0]) >= 2);
+            Assert.IsTrue(other.Estimate(Hashing.Hash(99, 0)) >= 100);
+
+            Assert.ThrowsException<ArgumentException>(() => other.Merge(new CountMinSketch(1024)));
+        }
+
+        [TestMethod]
+        public void BloomFilter_Basics()
+        {
+            // Every added value must be found (no false negatives)
+            BloomFilter filter = new BloomFilter(10000);
+            ulong[] added = HashRange(0, 10000);
+            filter.Add(added, 0, added.Length);
+
+            BitVector vector = new BitVector(added.Length);
+            Assert.AreEqual(added.Length, filter.Contains(added, 0, added.Length, vector));
+            for (int i = 0; i < added.Length; ++i) Assert.IsTrue(filter.Contains(added[i]));
+
+            // About 1% of other values are false positives at ten bits per value
+            ulong[] other = HashRange(10000, 110000);
+            vector = new BitVector(other.Length);
+            int falsePositives = filter.Contains(other, 0, other.Length, vector);
+            Assert.IsTrue(falsePositives < other.Length * 0.03, $"{falsePositives:n0} false positives for {other.Length:n0} values.");
+
+            // The vector must agree with the single value lookup, over an unaligned range
+            vector = new BitVector(1000);
+            int count = filter.Contains(other, 37, 1000, vector);
+            int expectedCount = 0;
+            for (int i = 0; i < 1000; ++i)
+            {
+                Assert.AreEqual(filter.Contains(other[37 + i]), vector[i]);
+                if (vector[i]) expectedCount++;
+            }
+
+            Assert.AreEqual(expectedCount, count);
+
+            // An empty filter has no matches
+            Assert.AreEqual(0, new BloomFilter(0).Contains(other, 0, other.Length, new BitVector(other.Length)));
+        }
+
+        private static ulong[] HashRange(int startInclusive, int endExclusive)
+        {
+            ulong[] hashes = new ulong[endExclusive - startInclusive];
+            for (int i = 0; i < hashes.Length; ++i)
+            {
+                hashes[i] = Hashing.Hash(startInclusive + i, 0);
+            }
+
+            return hashes;
+        }
+    }
+}
@@ -110,6 +110,59 @@ namespace XForm.Test.Query
             RunQueryAndVerify(values, "When", expected, "Result", "set [Result] DateAdd([When], \"-2d\")");
         }
 
+        [TestMethod]
+        public void Function_DatePart()
+        {
+            DateTime[] values = new DateTime[]
+            {
+                DateTime.MinValue,
+                new DateTime(2000, 2, 29, 23, 59, 59, 999, DateTimeKind.Utc),
+                new DateTime(2017, 12, 31, 12, 30, 15, 250, DateTimeKind.Utc),
+                new DateTime(2018, 1, 1, 0, 0, 0, DateTimeKind.Local),
+                new DateTime(1900, 3, 1, 1, 2, 3, 4),
+                DateTime.MaxValue
+            };
+
+            Function_DatePartAllParts(values);
+            NativeAccelerator.Enable();
+            Function_DatePartAllParts(values);
+        }
+
+        private static void Function_DatePartAllParts(DateTime[] values)
+        {
+            RunQueryAndVerify(values, "When", values.Select((when) => (ushort)when.Year).ToArray(), "Result", "set [Result] DatePart([When], Year)");
+            RunQueryAndVerify(values, "When", values.Select((when) => (ushort)when.Month).ToArray(), "Result", "set [Result] DatePart([When], Month)");
+            RunQueryAndVerify(values, "When", values.Select((when) => (ushort)when.Day).ToArray(), "Result", "set [Result] DatePart([When], DayOfMonth)");
+            RunQueryAndVerify(values, "When", values.Select((when) => (ushort)when.Hour).ToArray(), "Result", "set [Result] DatePart([When], Hour)");
+            RunQueryAndVerify(values, "When", values.Select((when) => (ushort)when.Minute).ToArray(), "Result", "set [Result] DatePart([When], Minute)");
+            RunQueryAndVerify(values, "When", values.Select((when) => (ushort)when.Second).ToArray(), "Result", "set [Result] DatePart([When], Second)");
+            RunQueryAndVerify(values, "When", values.Select((when) => (ushort)when.Millisecond).ToArray(), "Result", "set [Result] DatePart([When], Millisecond)");
+        }
+
+        [TestMethod]
+        public void Function_DateTruncate()
+        {
+            DateTime[] values = new DateTime[]
+            {
+                new DateTime(2017, 12, 01, 0, 0, 0, DateTimeKind.Utc),
+                new DateTime(2017, 12, 02, 8, 59, 59, 999, DateTimeKind.Utc),
+                new DateTime(2017, 12, 03, 9, 0, 0, DateTimeKind.Utc),
+                new DateTime(2017, 12, 04, 23, 45, 10, DateTimeKind.Utc),
+                DateTime.MaxValue
+            };
+
+            Function_DateTruncateUnits(values);
+            NativeAccelerator.Enable();
+            Function_DateTruncateUnits(values);
+        }
+
+        private static void Function_DateTruncateUnits(DateTime[] values)
+        {
+            RunQueryAndVerify(values, "When", values.Select((when) => new DateTime(when.Year, when.Month, when.Day, when.Hour, when.Minute, 0, when.Kind)).ToArray(), "Result", "set [Result] DateTruncate([When], \"1m\")");
+            RunQueryAndVerify(values, "When", values.Select((when) => new DateTime(when.Year, when.Month, when.Day, when.Hour, 0, 0, when.Kind)).ToArray(), "Result", "set [Result] DateTruncate([When], \"1h\")");
+            RunQueryAndVerify(values, "When", values.Select((when) => new DateTime(when.Year, when.Month, when.Day, 0, 0, 0, when.Kind)).ToArray(), "Result", "set [Result] DateTruncate([When], \"1d\")");
+        }
+
         [TestMethod]
         public void Function_Cast_Basics()
         {
@@ -49,6 +49,48 @@ namespace XForm.Test.Functions
             RunQueryAndVerify(left, right, expected, "set [Result] Divide([Left], [Right])");
         }
 
+        [TestMethod]
+        public void Function_OverflowAndDivideByZeroAreNull()
+        {
+            Function_OverflowAndDivideByZeroAreNullAllPaths();
+            NativeAccelerator.Enable();
+            Function_OverflowAndDivideByZeroAreNullAllPaths();
+        }
+
+        private static void Function_OverflowAndDivideByZeroAreNullAllPaths()
+        {
+            long[] left = new long[]  { long.MaxValue, 10, long.MinValue, 20, 5, long.MinValue };
+            long[] right = new long[] {             1,  0,            -1,  2, 0,             2 };
+
+            RunAndCompareWithPadding(left, right, new long[] { 0, 10, 0, 22, 5, long.MinValue + 2 }, new bool[] { true, false, true, false, false, false }, "set [Result] Add([Left], [Right])");
+            RunAndCompareWithPadding(left, right, new long[] { long.MaxValue - 1, 10, long.MinValue + 1, 18, 5, 0 }, new bool[] { false, false, false, false, false, true }, "set [Result] Subtract([Left], [Right])");
+            RunAndCompareWithPadding(left, right, new long[] { long.MaxValue, 0, 0, 40, 0, 0 }, new bool[] { false, false, true, false, false, true }, "set [Result] Multiply([Left], [Right])");
+            RunAndCompareWithPadding(left, right, new long[] { long.MaxValue, 0, 0, 10, 0, long.MinValue / 2 }, new bool[] { false, true, true, false, true, false }, "set [Result] Divide([Left], [Right])");
+        }
+
+        private static void RunAndCompareWithPadding(long[] left, long[] right, long[] expected, bool[] expectedNulls, string queryText)
+        {
+            XArray leftXArray = XArray.All(left, left.Length);
+            XArray rightXArray = XArray.All(right, right.Length);
+            XArray expectedXArray = XArray.All(expected, expected.Length, expectedNulls);
+
+            RunAndCompare(leftXArray, rightXArray, expectedXArray, queryText);
+            RunAndCompare(TableTestHarness.Pad(leftXArray), TableTestHarness.Pad(rightXArray), expectedXArray, queryText);
+
+            // Verify null inputs and invalid results are both null with alternating null inputs
+            XArray expectedWithNulls = TableTestHarness.Nulls(expectedXArray);
+            for (int i = 0; i < expectedWithNulls.Count; ++i)
+            {
+                expectedWithNulls.NullRows[i] |= expectedNulls[i / 2];
+            }
+
+            RunAndCompare(TableTestHarness.Nulls(leftXArray), TableTestHarness.Nulls(rightXArray), expectedWithNulls, queryText);
+
+            // Verify a single invalid or valid value
+            XArray expectedFirst = (expectedNulls[0] ? XArray.Null(new long[1], expected.Length) : TableTestHarness.First(expectedXArray));
+            RunAndCompare(TableTestHarness.First(leftXArray), TableTestHarness.First(rightXArray), expectedFirst, queryText);
+        }
+
         public static void RunQueryAndVerify(Array left, Array right, Array expected, string queryText)
         {
             XArray leftXArray = XArray.All(left, left.Length);
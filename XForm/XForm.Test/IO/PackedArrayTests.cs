@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.IO;
+using System.Linq;
+
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using XForm.Data;
+using XForm.IO;
+using XForm.IO.StreamProvider;
+
+namespace XForm.Test.IO
+{
+    [TestClass]
+    public class PackedArrayTests
+    {
+        [TestMethod]
+        public void PackedArray_RoundTrip()
+        {
+            NativeAccelerator.Enable();
+            Random r = new Random(5);
+            int count = 3 * PackedArray.BlockRowCount + 1234;
+
+            // Small range (BitPacked)
+            RoundTrip("Small", Enumerable.Range(0, count).Select((i) => 1000 + r.Next(50)).ToArray());
+
+            // Full range (BitPacked at 32 or 64 bits)
+            RoundTrip("Full", Enumerable.Range(0, count).Select((i) => r.Next(int.MinValue, int.MaxValue)).ToArray());
+            RoundTrip("FullLong", Enumerable.Range(0, count).Select((i) => (i % 3 == 0 ? long.MinValue : (i % 3 == 1 ? long.MaxValue : (long)r.Next() << 20))).ToArray());
+
+            // Ascending (Delta)
+            RoundTrip("Ascending", Enumerable.Range(0, count).Select((i) => 5 * i + r.Next(3)).ToArray());
+            RoundTrip("AscendingLong", Enumerable.Range(0, count).Select((i) => DateTime.UtcNow.Ticks + 10000L * i).ToArray());
+
+            // Repeated (RunLength)
+            RoundTrip("Runs", Enumerable.Range(0, count).Select((i) => (i / 5000) * 1000000).ToArray());
+
+            // Constant (zero bits)
+            RoundTrip("Constant", Enumerable.Range(0, count).Select((i) => -7).ToArray());
+
+            // Empty
+            RoundTrip("Empty", new int[0]);
+        }
+
+        private static void RoundTrip<T>(string columnName, T[] array)
+        {
+            LocalFileStreamProvider provider = new LocalFileStreamProvider(".");
+            string filePath = PackedArray.PackedFilePath(Path.Combine("PackedArrayTests", columnName, $"V.{typeof(T).Name}.bin"));
+
+            using (PackedArrayWriter<T> writer = new PackedArrayWriter<T>(provider.OpenWrite(filePath)))
+            {
+                // Write in uneven pages which straddle blocks
+                ArraySelector page = ArraySelector.All(0).NextPage(array.Length, 30000);
+                while (page.Count > 0)
+                {
+                    writer.Append(XArray.All(array).Reselect(page));
+                    page = page.NextPage(array.Length, 30000);
+                }
+            }
+
+            int bytesPerItem = (typeof(T) == typeof(int) ? 4 : 8);
+            Assert.IsTrue(provider.Attributes(filePath).Length < bytesPerItem * array.Length + 1024, "Packed column should not be much larger than the values.");
+
+            using (PackedArrayReader<T> reader = new PackedArrayReader<T>(provider.OpenRead(filePath)))
+            {
+                Assert.AreEqual(array.Length, reader.Count);
+
+                // Read in pages, then all at once, then a page out of order
+                ArraySelector page = ArraySelector.All(0).NextPage(array.Length, 20480);
+                while (page.Count > 0)
+                {
+                    TableTestHarness.AssertAreEqual(XArray.All(array).Reselect(page), reader.Read(page), page.Count);
+                    page = page.NextPage(array.Length, 20480);
+                }
+
+                TableTestHarness.AssertAreEqual(XArray.All(array), reader.Read(ArraySelector.All(array.Length)), array.Length);
+
+                if (array.Length > 100)
+                {
+                    ArraySelector middle = ArraySelector.All(array.Length).Slice(50, 100);
+                    TableTestHarness.AssertAreEqual(XArray.All(array).Reselect(middle), reader.Read(middle), middle.Count);
+
+                    // Read rows by index, out of order and across blocks
+                    Random r = new Random(array.Length);
+                    int[] indices = Enumerable.Range(0, 5000).Select((i) => r.Next(array.Length)).ToArray();
+                    ArraySelector mapped = ArraySelector.Map(indices, indices.Length).Slice(10, 4990);
+                    TableTestHarness.AssertAreEqual(XArray.All(array).Reselect(mapped), reader.Read(mapped), mapped.Count);
+                }
+            }
+
+            provider.Delete(Path.Combine("PackedArrayTests", columnName));
+        }
+    }
+}
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.IO;
+using System.Linq;
+
+using Microsoft.CodeAnalysis.Elfie.Model.Strings;
+using Microsoft.CodeAnalysis.Elfie.Serialization;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using XForm.Data;
+using XForm.IO;
+
+namespace XForm.Test.IO
+{
+    [TestClass]
+    public class PageTabularWriterTests
+    {
+        [TestMethod]
+        public void PageTabularWriter_MatchesElfieWriters()
+        {
+            // Values needing escaping in each format, in short and long (over 32 byte) values
+            string[] names = new string[] { "Name", "Quoted \"Name\"", "Tab\tName" };
+            Random r = new Random(5);
+            string alphabet = "abcdefghij\t\n\"\r ,";
+            string[][] values = names.Select((name) => Enumerable.Range(0, 500).Select((i) => new string(Enumerable.Range(0, r.Next(80)).Select((j) => alphabet[r.Next(alphabet.Length)]).ToArray())).ToArray()).ToArray();
+            values[0][10] = "";
+
+            VerifyMatches(names, values);
+
+            NativeAccelerator.Enable();
+            VerifyMatches(names, values);
+        }
+
+        private static void VerifyMatches(string[] names, string[][] values)
+        {
+            MemoryStream tsvStream = new MemoryStream();
+            Assert.AreEqual(ElfieOutput(new TsvWriter(tsvStream), tsvStream, names, values), PageOutput(PageTabularWriter.Format.Tsv, names, values));
+
+            MemoryStream csvStream = new MemoryStream();
+            Assert.AreEqual(ElfieOutput(new CsvWriter(csvStream), csvStream, names, values), PageOutput(PageTabularWriter.Format.Csv, names, values));
+        }
+
+        private static string ElfieOutput(ITabularWriter writer, MemoryStream stream, string[] names, string[][] values)
+        {
+            String8Block block = new String8Block();
+
+            using (writer)
+            {
+                writer.SetColumns(names);
+                for (int row = 0; row < values[0].Length; ++row)
+                {
+                    for (int column = 0; column < names.Length; ++column)
+                    {
+                        writer.Write(block.GetCopy(values[column][row]));
+                    }
+
+                    writer.NextRow();
+                }
+            }
+
+            return System.Text.Encoding.UTF8.GetString(stream.ToArray());
+        }
+
+        private static string PageOutput(PageTabularWriter.Format format, string[] names, string[][] values)
+        {
+            MemoryStream stream = new MemoryStream();
+            String8Block block = new String8Block();
+
+            using (PageTabularWriter writer = new PageTabularWriter(stream, format))
+            {
+                writer.SetColumns(names);
+
+                // Write in uneven pages, with values in one shared array and in separate arrays
+                int pageSize = 97;
+                for (int start = 0; start < values[0].Length; start += pageSize)
+                {
+                    int count = Math.Min(pageSize, values[0].Length - start);
+                    XArray[] columns = new XArray[names.Length];
+                    for (int column = 0; column < names.Length; ++column)
+                    {
+                        String8[] page = values[column].Skip(start).Take(count).Select((value) => (column == 1 ? String8.Convert(value, new byte[String8.GetLength(value)]) : block.GetCopy(value))).ToArray();
+                        columns[column] = XArray.All(page, count);
+                    }
+
+                    writer.Write(columns, count);
+                }
+
+                Assert.AreEqual(values[0].Length, writer.RowCountWritten);
+            }
+
+            return System.Text.Encoding.UTF8.GetString(stream.ToArray());
+        }
+    }
+}
@@ -2,11 +2,17 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 using System;
+using System.IO;
+using System.Linq;
+using System.Threading;
 
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 
+using XForm.Data;
 using XForm.IO;
+using XForm.IO.StreamProvider;
 using XForm.Test.Query;
+using XForm.Types;
 
 namespace XForm.Test.IO
 {
@@ -22,5 +28,198 @@ namespace XForm.Test.IO
         //    LocalFileStreamProvider provider = new LocalFileStreamProvider(".");
         //    Assert.AreEqual("", String.Join("\r\n", provider.Enumerate(".", true)));
         //}
+
+        [TestMethod]
+        public void LocalFileStreamProvider_MemoryMapped()
+        {
+            NativeAccelerator.Enable();
+
+            LocalFileStreamProvider provider = new LocalFileStreamProvider(".");
+            string filePath = Path.Combine("StreamProviderTests", "V.i64.bin");
+            long[] values = Enumerable.Range(0, 100000).Select((i) => (long)i * 7919).ToArray();
+
+            using (PrimitiveArrayWriter<long> writer = new PrimitiveArrayWriter<long>(provider.OpenWrite(filePath)))
+            {
+                writer.Append(XArray.All(values));
+            }
+
+            try
+            {
+                LocalFileStreamProvider.IsMemoryMappingEnabled = true;
+
+                using (Stream stream = provider.OpenRead(filePath))
+                {
+                    Assert.IsInstanceOfType(stream, typeof(MappedFileStream));
+
+                    using (PrimitiveArrayReader<long> reader = new PrimitiveArrayReader<long>(stream))
+                    {
+                        Assert.AreEqual(values.Length, reader.Count);
+
+                        // Read sequential pages, then one out of order
+                        ArraySelector page = ArraySelector.All(0).NextPage(values.Length, 10240);
+                        while (page.Count > 0)
+                        {
+                            TableTestHarness.AssertAreEqual(XArray.All(values).Reselect(page), reader.Read(page), page.Count);
+                            page = page.NextPage(values.Length, 10240);
+                        }
+
+                        page = ArraySelector.All(values.Length).Slice(500, 600);
+                        TableTestHarness.AssertAreEqual(XArray.All(values).Reselect(page), reader.Read(page), page.Count);
+                    }
+                }
+
+                // Verify the mapped stream works as a regular Stream
+                using (Stream stream = provider.OpenRead(filePath))
+                {
+                    byte[] expected = File.ReadAllBytes(filePath);
+                    byte[] actual = new byte[expected.Length + 10];
+
+                    stream.Seek(1000, SeekOrigin.Begin);
+                    Assert.AreEqual(expected.Length - 1000, stream.Read(actual, 0, actual.Length));
+                    Assert.AreEqual(0, stream.Read(actual, 0, actual.Length));
+                    Assert.IsTrue(expected.Skip(1000).SequenceEqual(actual.Take(expected.Length - 1000)));
+                }
+            }
+            finally
+            {
+                LocalFileStreamProvider.IsMemoryMappingEnabled = false;
+                provider.Delete("StreamProviderTests");
+            }
+        }
+
+        [TestMethod]
+        public void ReadAheadStreamProvider_Basics()
+        {
+            IStreamProvider provider = new ReadAheadStreamProvider(new LocalFileStreamProvider("."));
+            string filePath = Path.Combine("StreamProviderTests", "ReadAhead", "V.i32.bin");
+            int[] values = Enumerable.Range(0, 100000).Select((i) => i * 31).ToArray();
+
+            using (PrimitiveArrayWriter<int> writer = new PrimitiveArrayWriter<int>(provider.OpenWrite(filePath)))
+            {
+                writer.Append(XArray.All(values));
+            }
+
+            try
+            {
+                // Read column pages through the read ahead stream, then one out of order
+                using (Stream stream = provider.OpenRead(filePath))
+                {
+                    Assert.IsInstanceOfType(stream, typeof(ReadAheadStream));
+
+                    using (PrimitiveArrayReader<int> reader = new PrimitiveArrayReader<int>(stream))
+                    {
+                        ArraySelector page = ArraySelector.All(0).NextPage(values.Length, 10240);
+                        while (page.Count > 0)
+                        {
+                            TableTestHarness.AssertAreEqual(XArray.All(values).Reselect(page), reader.Read(page), page.Count);
+                            page = page.NextPage(values.Length, 10240);
+                        }
+
+                        page = ArraySelector.All(values.Length).Slice(500, 600);
+                        TableTestHarness.AssertAreEqual(XArray.All(values).Reselect(page), reader.Read(page), page.Count);
+                    }
+                }
+
+                // Read with small chunks, seeking within a chunk, back, and past the end
+                byte[] expected = File.ReadAllBytes(filePath);
+                using (ReadAheadStream stream = new ReadAheadStream(new FileStream(filePath, FileMode.Open, FileAccess.Read), default(CancellationToken), 1000, 3))
+                {
+                    byte[] actual = new byte[expected.Length + 10];
+
+                    Assert.AreEqual(2500, stream.Read(actual, 0, 2500));
+                    Assert.IsTrue(expected.Take(2500).SequenceEqual(actual.Take(2500)));
+
+                    stream.Seek(2700, SeekOrigin.Begin);
+                    Assert.AreEqual(100, stream.Read(actual, 0, 100));
+                    Assert.IsTrue(expected.Skip(2700).Take(100).SequenceEqual(actual.Take(100)));
+
+                    stream.Seek(10, SeekOrigin.Begin);
+                    Assert.AreEqual(expected.Length - 10, stream.Read(actual, 0, actual.Length));
+                    Assert.IsTrue(expected.Skip(10).SequenceEqual(actual.Take(expected.Length - 10)));
+                    Assert.AreEqual(0, stream.Read(actual, 0, actual.Length));
+
+                    stream.Seek(-4, SeekOrigin.End);
+                    Assert.AreEqual(4, stream.Read(actual, 0, actual.Length));
+                    Assert.IsTrue(expected.Skip(expected.Length - 4).SequenceEqual(actual.Take(4)));
+                }
+
+                // Verify reading stops when the query is cancelled
+                using (CancellationTokenSource source = new CancellationTokenSource())
+                using (ReadAheadStream stream = new ReadAheadStream(new FileStream(filePath, FileMode.Open, FileAccess.Read), source.Token, 1000, 3))
+                {
+                    byte[] actual = new byte[1000];
+                    Assert.AreEqual(1000, stream.Read(actual, 0, 1000));
+
+                    source.Cancel();
+                    try
+                    {
+                        while (stream.Read(actual, 0, 1000) > 0) { }
+                        Assert.Fail("ReadAheadStream should throw when cancelled.");
+                    }
+                    catch (OperationCanceledException)
+                    { }
+                }
+
+                // Verify reading stops when the token set on a reader's provider is cancelled
+                ReadAheadStreamProvider readerProvider = ((ReadAheadStreamProvider)provider).ForReader();
+                using (CancellationTokenSource source = new CancellationTokenSource())
+                using (Stream stream = readerProvider.OpenRead(filePath))
+                {
+                    byte[] actual = new byte[1000];
+                    Assert.AreEqual(1000, stream.Read(actual, 0, 1000));
+
+                    readerProvider.CancellationToken = source.Token;
+                    source.Cancel();
+                    Assert.ThrowsException<OperationCanceledException>(() => { while (stream.Read(actual, 0, actual.Length) > 0) { } });
+                }
+
+                // Verify an inner stream failure is thrown by every later read, not reported as the end of the stream
+                using (ReadAheadStream stream = new ReadAheadStream(new FailingStream(new FileStream(filePath, FileMode.Open, FileAccess.Read), 2500), default(CancellationToken), 1000, 3))
+                {
+                    byte[] actual = new byte[1000];
+                    Assert.ThrowsException<IOException>(() => { while (stream.Read(actual, 0, actual.Length) > 0) { } });
+                    Assert.ThrowsException<IOException>(() => stream.Read(actual, 0, actual.Length));
+                }
+            }
+            finally
+            {
+                provider.Delete("StreamProviderTests");
+            }
+        }
+
+        private class FailingStream : Stream
+        {
+            private Stream _inner;
+            private long _failAfter;
+
+            public FailingStream(Stream inner, long failAfter)
+            {
+                _inner = inner;
+                _failAfter = failAfter;
+            }
+
+            public override bool CanRead => true;
+            public override bool CanSeek => _inner.CanSeek;
+            public override bool CanWrite => false;
+            public override long Length => _inner.Length;
+            public override long Position { get => _inner.Position; set => _inner.Position = value; }
+
+            public override int Read(byte[] buffer, int offset, int count)
+            {
+                if (_inner.Position >= _failAfter) throw new IOException("Simulated read failure.");
+                return _inner.Read(buffer, offset, (int)Math.Min(count, _failAfter - _inner.Position));
+            }
+
+            public override long Seek(long offset, SeekOrigin origin) => _inner.Seek(offset, origin);
+            public override void Flush() { }
+            public override void SetLength(long value) => throw new NotSupportedException();
+            public override void Write(byte[] buffer, int offset, int count) => throw new NotSupportedException();
+
+            protected override void Dispose(bool disposing)
+            {
+                _inner.Dispose();
+                base.Dispose(disposing);
+            }
+        }
     }
 }
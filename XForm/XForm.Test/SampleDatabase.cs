@@ -411,5 +411,38 @@ namespace XForm.Test
                 BinaryTableWriter.ColumnFileSizeLimit = currentFileLimit;
             }
         }
+
+        [TestMethod]
+        public void Database_PartitionRowLimit()
+        {
+            long currentRowLimit = BinaryTableWriter.PartitionRowLimit;
+            try
+            {
+                string tablePath = @"Table\RowLimitPartition\Full\2018.06.06 00.00.00Z";
+                int length = 100000;
+
+                // Set a row limit which doesn't divide the pages evenly
+                BinaryTableWriter.PartitionRowLimit = 30000;
+
+                // Build a table with 100,000 longs, well under the file size limit
+                SampleDatabase.XDatabaseContext.FromArrays(length)
+                    .WithColumn("ID", Enumerable.Range(0, length).Select((i) => (long)i).ToArray())
+                    .Query($@"write ""{tablePath}""", SampleDatabase.XDatabaseContext)
+                    .RunAndDispose();
+
+                // Verify the rows were split by the row limit (30,000 x 3 + 10,000)
+                Assert.IsTrue(SampleDatabase.XDatabaseContext.StreamProvider.Exists($@"{tablePath}\\3\\Schema.csv"));
+                Assert.IsFalse(SampleDatabase.XDatabaseContext.StreamProvider.Exists($@"{tablePath}\\4\\Schema.csv"));
+
+                // Verify every row is read back once, in order
+                Assert.AreEqual(length, SampleDatabase.XDatabaseContext.Query("read RowLimitPartition").RunAndDispose().RowCount);
+                Assert.AreEqual(10000, SampleDatabase.XDatabaseContext.Query("read RowLimitPartition\r\nwhere [ID] >= 90000").RunAndDispose().RowCount);
+                Assert.AreEqual((long)length * (length - 1) / 2, SampleDatabase.XDatabaseContext.Query("read RowLimitPartition").ToList<long>("ID").Sum((page) => page.Sum()));
+            }
+            finally
+            {
+                BinaryTableWriter.PartitionRowLimit = currentRowLimit;
+            }
+        }
     }
 }
@@ -3,6 +3,9 @@
 
 using System;
 using System.Linq;
+using System.Text;
+
+using Microsoft.CodeAnalysis.Elfie.Model.Strings;
 
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 
@@ -24,6 +27,51 @@ namespace XForm.Test.Query
             Comparer_AllTypes();
         }
 
+        [TestMethod]
+        public void Comparer_IndexOfAllNative()
+        {
+            Func<byte[], int, int, byte[], int, int, bool, int[], int> indexOfAllNative = NativeAccelerator.GetMethod<Func<byte[], int, int, byte[], int, int, bool, int[], int>>("XForm.Native.String8N", "IndexOfAll");
+
+            // Build text with many near-matches (same first or last byte), mixed case, and matches spanning 32-byte block boundaries
+            StringBuilder builder = new StringBuilder();
+            Random r = new Random(5);
+            string alphabet = "tTiImMeEoOuU@`[{ ";
+            for (int i = 0; i < 2000; ++i)
+            {
+                builder.Append(alphabet[r.Next(alphabet.Length)]);
+                if (r.Next(20) == 0) builder.Append((r.Next(2) == 0 ? "timeout" : "TimeOut"));
+            }
+
+            byte[] text = Encoding.UTF8.GetBytes(builder.ToString());
+            String8 text8 = new String8(text, 0, text.Length);
+
+            foreach (string value in new string[] { "t", "Ti", "tie", "timeout", "TIMEOUT", "@`", "[t{", "timeout timeout timeout timeout timeout" })
+            {
+                byte[] valueBytes = Encoding.UTF8.GetBytes(value);
+                String8 value8 = new String8(valueBytes, 0, valueBytes.Length);
+
+                // Try from several start indices (to cover the scalar suffix) with several result page sizes
+                foreach (int startIndex in new int[] { 0, 1, 31, text.Length - 40, text.Length - value.Length })
+                {
+                    foreach (int resultLength in new int[] { 1, 7, 1024 })
+                    {
+                        int[] expected = new int[resultLength];
+                        int[] actual = new int[resultLength];
+
+                        int expectedCount = text8.IndexOfAll(value8, startIndex, false, expected);
+                        int actualCount = indexOfAllNative(text, startIndex, text.Length - startIndex, valueBytes, 0, valueBytes.Length, false, actual);
+                        Assert.AreEqual(expectedCount, actualCount, $"Exact \"{value}\" from {startIndex}");
+                        Assert.AreEqual(string.Join(", ", expected.Take(expectedCount)), string.Join(", ", actual.Take(actualCount)));
+
+                        expectedCount = text8.IndexOfAll(value8, startIndex, true, expected);
+                        actualCount = indexOfAllNative(text, startIndex, text.Length - startIndex, valueBytes, 0, valueBytes.Length, true, actual);
+                        Assert.AreEqual(expectedCount, actualCount, $"IgnoreCase \"{value}\" from {startIndex}");
+                        Assert.AreEqual(string.Join(", ", expected.Take(expectedCount)), string.Join(", ", actual.Take(actualCount)));
+                    }
+                }
+            }
+        }
+
         private static void Comparer_AllTypes()
         {
             int[] ascending = Enumerable.Range(0, 120).ToArray();
@@ -70,6 +118,18 @@ namespace XForm.Test.Query
             Comparer_VerifyWhere<T>(XArray.All(left, left.Length), XArray.All(right, right.Length), CompareOperator.GreaterThanOrEqual);
             Comparer_VerifyWhere<T>(XArray.All(left, left.Length), XArray.All(right, right.Length), CompareOperator.LessThan);
             Comparer_VerifyWhere<T>(XArray.All(left, left.Length), XArray.All(right, right.Length), CompareOperator.LessThanOrEqual);
+
+            // Try operations between array with nulls and single value (nulls never match)
+            bool[] nulls = new bool[left.Length];
+            for (int i = 0; i < nulls.Length; ++i)
+            {
+                nulls[i] = (i % 3 == 1);
+            }
+
+            Comparer_VerifyWhere<T>(XArray.All(left, left.Length, nulls), XArray.Single(new T[1] { value }, left.Length), CompareOperator.Equal);
+            Comparer_VerifyWhere<T>(XArray.All(left, left.Length, nulls), XArray.Single(new T[1] { value }, left.Length), CompareOperator.NotEqual);
+            Comparer_VerifyWhere<T>(XArray.All(left, left.Length, nulls), XArray.Single(new T[1] { value }, left.Length), CompareOperator.GreaterThan);
+            Comparer_VerifyWhere<T>(XArray.All(left, left.Length, nulls), XArray.Single(new T[1] { value }, left.Length), CompareOperator.LessThanOrEqual);
         }
 
         private static void Comparer_VerifyWhere<T>(XArray left, XArray right, CompareOperator cOp) where T : IComparable<T>
@@ -90,7 +150,8 @@ namespace XForm.Test.Query
             T[] rightArray = (T[])right.Array;
             for (int i = 0; i < left.Selector.Count; ++i)
             {
-                bool shouldBeIncluded = CompareSingle(leftArray[left.Index(i)], rightArray[right.Index(i)], cOp);
+                bool isNull = (left.HasNulls && left.NullRows[left.Index(i)]) || (right.HasNulls && right.NullRows[right.Index(i)]);
+                bool shouldBeIncluded = !isNull && CompareSingle(leftArray[left.Index(i)], rightArray[right.Index(i)], cOp);
                 if (shouldBeIncluded) expectedCount++;
                 Assert.AreEqual(shouldBeIncluded, set[i]);
             }
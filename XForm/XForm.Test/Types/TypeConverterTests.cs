@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Text;
+
+using Microsoft.CodeAnalysis.Elfie.Model.Strings;
+
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using XForm.Data;
+using XForm.Types;
+
+namespace XForm.Test.Types
+{
+    [TestClass]
+    public class TypeConverterTests
+    {
+        private static string[] s_values = new string[]
+        {
+            "", "0", "-0", "-", "1", "-1", "00000000000000000001", "12345678", "1234567890123456", "12345678901234567", "1a", " 1", "1.", ".5", "-.5", "1.2.3",
+            "2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296",
+            "9223372036854775807", "9223372036854775808", "-9223372036854775808", "-9223372036854775809",
+            "18446744073709551615", "18446744073709551616", "3.14159", "-2.5", "12345.678901234567890"
+        };
+
+        [TestMethod]
+        public void TypeConverter_String8ToNumberNative()
+        {
+            String8[] values = ToString8Page(s_values);
+
+            XArray expectedInt, expectedUInt, expectedLong, expectedDouble;
+            Convert(values, out expectedInt, out expectedUInt, out expectedLong, out expectedDouble);
+
+            NativeAccelerator.Enable();
+            XArray actualInt, actualUInt, actualLong, actualDouble;
+            Convert(values, out actualInt, out actualUInt, out actualLong, out actualDouble);
+
+            AssertSame<int>(expectedInt, actualInt, s_values);
+            AssertSame<uint>(expectedUInt, actualUInt, s_values);
+            AssertSame<long>(expectedLong, actualLong, s_values);
+            AssertSame<double>(expectedDouble, actualDouble, s_values);
+        }
+
+        [TestMethod]
+        public void TypeConverter_DateTimeNative()
+        {
+            string[] dateTimes = new string[] { "2017-12-01", "2017-12-01T13:45:59Z", "2017-12-01 13:45:59", "2017-12-01T13:45:59.", "2016-02-29", "2017-02-29", "2017-13-01", "2017-12-01T24:00:00Z",
+                "2017-12-01T13:45:59.1234567", "12/01/2017", "12/01/2017 13:45:59", "2017-12-0a", "", "9999-12-31T23:59:59Z", "0001-01-01" };
+            string[] timeSpans = new string[] { "00:00:00", "23:59:59", "12:34:56.7", "12:34:56.1234567", "12:34:56.12345678", "24:00:00", "1.02:03:04", "-01:00:00", "12:60:00", "5m", "7d", "" };
+
+            String8[] dateTimes8 = ToString8Page(dateTimes);
+            String8[] timeSpans8 = ToString8Page(timeSpans);
+
+            XArray expectedDateTimes = Copy<DateTime>(TypeConverterFactory.GetConverter(typeof(String8), typeof(DateTime))(XArray.All(dateTimes8)));
+            XArray expectedTimeSpans = Copy<TimeSpan>(TypeConverterFactory.GetConverter(typeof(String8), typeof(TimeSpan))(XArray.All(timeSpans8)));
+            XArray expectedStrings = Copy<String8>(TypeConverterFactory.GetConverter(typeof(DateTime), typeof(String8))(expectedDateTimes));
+
+            NativeAccelerator.Enable();
+            XArray actualDateTimes = Copy<DateTime>(TypeConverterFactory.GetConverter(typeof(String8), typeof(DateTime))(XArray.All(dateTimes8)));
+            XArray actualTimeSpans = Copy<TimeSpan>(TypeConverterFactory.GetConverter(typeof(String8), typeof(TimeSpan))(XArray.All(timeSpans8)));
+            XArray actualStrings = Copy<String8>(TypeConverterFactory.GetConverter(typeof(DateTime), typeof(String8))(expectedDateTimes));
+
+            AssertSame<DateTime>(expectedDateTimes, actualDateTimes, dateTimes);
+            AssertSame<TimeSpan>(expectedTimeSpans, actualTimeSpans, timeSpans);
+            AssertSame<String8>(expectedStrings, actualStrings, dateTimes);
+        }
+
+        private static String8[] ToString8Page(string[] values)
+        {
+            // Put all values in one byte[], as when read from a file, with separators so values don't start at the beginning
+            byte[] text = Encoding.UTF8.GetBytes(string.Join("\t", values));
+            String8[] result = new String8[values.Length];
+            int index = 0;
+            for (int i = 0; i < values.Length; ++i)
+            {
+                int length = Encoding.UTF8.GetByteCount(values[i]);
+                result[i] = new String8(text, index, length);
+                index += length + 1;
+            }
+
+            return result;
+        }
+
+        private static void Convert(String8[] values, out XArray asInt, out XArray asUInt, out XArray asLong, out XArray asDouble)
+        {
+            XArray source = XArray.All(values, values.Length);
+            asInt = Copy<int>(TypeConverterFactory.GetConverter(typeof(String8), typeof(int), ValueKinds.None)(source));
+            asUInt = Copy<uint>(TypeConverterFactory.GetConverter(typeof(String8), typeof(uint), ValueKinds.None)(source));
+            asLong = Copy<long>(TypeConverterFactory.GetConverter(typeof(String8), typeof(long), ValueKinds.None)(source));
+            asDouble = Copy<double>(TypeConverterFactory.GetConverter(typeof(String8), typeof(double), ValueKinds.None)(source));
+        }
+
+        private static XArray Copy<T>(XArray xarray)
+        {
+            T[] values = new T[xarray.Count];
+            bool[] nulls = new bool[xarray.Count];
+            for (int i = 0; i < xarray.Count; ++i)
+            {
+                values[i] = ((T[])xarray.Array)[xarray.Index(i)];
+                nulls[i] = (xarray.HasNulls && xarray.NullRows[xarray.Index(i)]);
+            }
+
+            return XArray.All(values, xarray.Count, nulls);
+        }
+
+        private static void AssertSame<T>(XArray expected, XArray actual, string[] values)
+        {
+            Assert.AreEqual(expected.Count, actual.Count);
+            for (int i = 0; i < expected.Count; ++i)
+            {
+                Assert.AreEqual(expected.NullRows[i], actual.NullRows[i], $"Null mismatch for \"{values[i]}\" as {typeof(T).Name}");
+                Assert.AreEqual(((T[])expected.Array)[i], ((T[])actual.Array)[i], $"Value mismatch for \"{values[i]}\" as {typeof(T).Name}");
+            }
+        }
+    }
+}
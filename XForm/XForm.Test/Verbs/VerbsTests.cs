@@ -40,6 +40,34 @@ namespace XForm.Test.Query
                 expected.Select((i) => block.GetCopy(i.ToString())).ToArray());
         }
 
+        [TestMethod]
+        public void Verb_JoinSelective()
+        {
+            // Join many batches to a small table, so most batches are rejected by the Bloom filter and some rows are false positives
+            int[] joinTo = Enumerable.Range(0, 500).Select((i) => i * 997).ToArray();
+            int[] joinFrom = Enumerable.Range(0, 200000).Select((i) => (int)((i * 7919L) % 600000)).ToArray();
+            int[] expected = joinFrom.Where((i) => i % 997 == 0 && i / 997 < 500).ToArray();
+
+            RunJoinAndVerify(joinTo, joinFrom, expected);
+
+            // Run as long, with values differing only in the upper 32 bits
+            RunJoinAndVerify(
+                joinTo.Select((i) => (long)i << 32).ToArray(),
+                joinFrom.Select((i) => (long)i << 32).ToArray(),
+                expected.Select((i) => (long)i << 32).ToArray());
+        }
+
+        [TestMethod]
+        public void Verb_JoinMostlyMatching()
+        {
+            // Join many rows which nearly all match, so the Bloom filter is dropped after the trial rows
+            int[] joinTo = Enumerable.Range(0, 500).Select((i) => i * 997).ToArray();
+            int[] joinFrom = Enumerable.Range(0, 200000).Select((i) => (i % 100 == 0 ? -1 : (i % 500) * 997)).ToArray();
+            int[] expected = joinFrom.Where((i) => i != -1).ToArray();
+
+            RunJoinAndVerify(joinTo, joinFrom, expected);
+        }
+
         private static void RunJoinAndVerify(Array joinTo, Array joinFrom, Array expected)
         {
             Type t = joinTo.GetType().GetElementType();
@@ -167,6 +195,31 @@ namespace XForm.Test.Query
             TableTestHarness.AssertAreEqual(expected, actual, 2);
         }
 
+        [TestMethod]
+        public void Verb_PeekApproximate()
+        {
+            int[] values = BuildPeekSample();
+
+            // The count-min sketch is far wider than the distinct values, so the counts are exact here
+            IXTable expected = TableTestHarness.DatabaseContext.FromArrays(3)
+                .WithColumn("Value", new int[] { 0, 1, 2 })
+                .WithColumn("Count", new int[] { 500, 250, 150 })
+                .WithColumn("Percentage", TableTestHarness.ToString8(new string[]
+                {
+                    PercentageAggregator.TwoSigFigs(500, 1000),
+                    PercentageAggregator.TwoSigFigs(250, 1000),
+                    PercentageAggregator.TwoSigFigs(150, 1000)
+                }));
+
+            IXTable actual = TableTestHarness.DatabaseContext.FromArrays(values.Length)
+                .WithColumn("Value", values)
+                .Query("peek [Value] Approximate", TableTestHarness.DatabaseContext);
+
+            TableTestHarness.AssertAreEqual(expected, actual, 2);
+            // 28 distinct values; the HyperLogLog estimate may be off by one when two share a register
+            Assert.IsTrue(Math.Abs(((Peek)actual).DistinctCountEstimate - 28) <= 1);
+        }
+
         [TestMethod]
         public void Verb_GroupBy()
         {
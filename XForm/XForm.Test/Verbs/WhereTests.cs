@@ -1,10 +1,14 @@
 ﻿using System;
+using System.IO;
+using System.Linq;
 
 using Elfie.Test;
 
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 
+using XForm.Data;
 using XForm.Extensions;
+using XForm.IO;
 using XForm.Query;
 
 namespace XForm.Test.Verbs
@@ -86,6 +90,68 @@ namespace XForm.Test.Verbs
             Assert.AreEqual((long)50, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [EventTime] : \"00:\"\r\nwhere [EventTime] : \"00\"\r\nlimit 50").Count());
         }
 
+        [TestMethod]
+        public void Where_ContainsAny()
+        {
+            NativeAccelerator.Enable();
+
+            // Contains ORed on one column is evaluated in one pass; verify against the complement (NOT A AND NOT B)
+            Assert.AreEqual(1000 - SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere not [ID] : \"99\" AND not [ID] : \"88\"").Count(), SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] : \"99\" OR [ID] : \"88\"").Count());
+            Assert.AreEqual(19, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] : \"99\" OR [ID] : \"999\"").Count());
+            Assert.AreEqual(19, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] : \"99\" OR [ID] : \"\"").Count());
+            Assert.AreEqual(0, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] : \"9999\" OR [ID] : \"a\"").Count());
+
+            // Many values (Aho-Corasick); every ID except the ten single digit ones contains a two digit value
+            string allDigits = string.Join(" OR ", Enumerable.Range(0, 100).Select((i) => $"[ID] : \"{i:D2}\""));
+            string allSingleDigits = string.Join(" OR ", Enumerable.Range(0, 10).Select((i) => $"[ID] : \"{i}\""));
+            Assert.AreEqual(1000, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere " + allSingleDigits).Count());
+            Assert.AreEqual(990, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere " + allDigits).Count());
+        }
+
+        [TestMethod]
+        public void Where_EnumSet()
+        {
+            NativeAccelerator.Enable();
+
+            // Terms on one Enum column are combined into one match on the indices; verify ORs against the complement (NOT A AND NOT B)
+            Assert.AreEqual(1000 - Count("not [ServerName] : \"-1\" AND not [ServerName] : \"-2\""), Count("[ServerName] : \"-1\" OR [ServerName] : \"-2\""));
+            Assert.AreEqual(1000, Count("[ServerName] != \"ws-front-4\" OR [ServerName] != \"ws-front-5\""));
+
+            // Other terms are still evaluated separately
+            Assert.AreEqual(1000 - Count("not [ServerName] : \"-1\" AND not [ID] = \"1\" AND not [ServerName] : \"-2\""), Count("[ServerName] : \"-1\" OR [ID] = \"1\" OR [ServerName] : \"-2\""));
+
+            // ANDed terms intersect: |A AND B| = |A| + |B| - |A OR B|
+            long either = Count("[ServerName] : \"-1\" OR [ServerName] : \"2\"");
+            Assert.AreEqual(Count("[ServerName] : \"-1\"") + Count("[ServerName] : \"2\"") - either, Count("[ServerName] : \"-1\" AND [ServerName] : \"2\""));
+            Assert.AreEqual(0, Count("[ServerName] = \"ws-front-4\" AND [ServerName] = \"ws-front-5\""));
+        }
+
+        private static long Count(string where)
+        {
+            return SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere " + where).Count();
+        }
+
+        [TestMethod]
+        public void Where_String8Native()
+        {
+            NativeAccelerator.Enable();
+
+            // String8 to constant comparisons run natively on the raw column; IDs are "0" to "999"
+            Assert.AreEqual(1, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] = \"9\"").Count());
+            Assert.AreEqual(999, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] != \"9\"").Count());
+            Assert.AreEqual(0, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] = \"\"").Count());
+            Assert.AreEqual(445, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] < \"5\"").Count());
+            Assert.AreEqual(446, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] <= \"5\"").Count());
+            Assert.AreEqual(554, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] > \"5\"").Count());
+            Assert.AreEqual(555, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] >= \"5\"").Count());
+            Assert.AreEqual(1000, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] > \"\"").Count());
+            Assert.AreEqual(111, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] |> \"1\"").Count());
+            Assert.AreEqual(99, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] >| \"9\"").Count());
+
+            // Later clauses see filtered rows and must not use the raw column
+            Assert.AreEqual(110, SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere [ID] > \"5\"\r\nwhere [ID] < \"6\"").Count());
+        }
+
         [TestMethod]
         public void Where_Cascading()
         {
@@ -189,6 +255,39 @@ namespace XForm.Test.Verbs
             Verify.Exception<UsageException>(() => SampleDatabase.XDatabaseContext.Query("read WebRequest\r\nwhere Cast([IsPremiumUser], Boolean) != \"invalid\"").Count());
         }
 
+        [TestMethod]
+        public void Where_ZoneMap()
+        {
+            string tablePath = @"Table\ZoneMap\Full\2018.06.06 00.00.00Z";
+            int length = 200000;
+
+            // Build a table with ascending values, so most blocks can be skipped or matched entirely
+            SampleDatabase.XDatabaseContext.FromArrays(length)
+                .WithColumn("ID", Enumerable.Range(0, length).ToArray())
+                .WithColumn("Hour", Enumerable.Range(0, length).Select((i) => i / 1000).ToArray())
+                .Query($@"write ""{tablePath}""", SampleDatabase.XDatabaseContext)
+                .RunAndDispose();
+
+            // Verify the zone map was written and classifies pages correctly
+            ZoneMap zoneMap = ZoneMap.TryRead(SampleDatabase.XDatabaseContext.StreamProvider, typeof(int), Path.Combine(tablePath, "ID"), length);
+            Assert.IsNotNull(zoneMap);
+            Assert.AreEqual(ZoneMatch.None, zoneMap.Match(ArraySelector.All(length).Slice(0, 10240), CompareOperator.GreaterThan, 150000));
+            Assert.AreEqual(ZoneMatch.All, zoneMap.Match(ArraySelector.All(length).Slice(196608, 200000), CompareOperator.GreaterThan, 150000));
+            Assert.AreEqual(ZoneMatch.Some, zoneMap.Match(ArraySelector.All(length).Slice(65536, 70000), CompareOperator.Equal, 70000));
+            Assert.AreEqual(ZoneMatch.None, zoneMap.Match(ArraySelector.All(length).Slice(0, 10240), CompareOperator.Equal, 70000));
+
+            // Verify results are the same whether pages are skipped, matched entirely, or compared
+            Assert.AreEqual(50000, SampleDatabase.XDatabaseContext.Query("read ZoneMap\r\nwhere [ID] >= 150000").Count());
+            Assert.AreEqual(65536, SampleDatabase.XDatabaseContext.Query("read ZoneMap\r\nwhere [ID] < 65536").Count());
+            Assert.AreEqual(131072, SampleDatabase.XDatabaseContext.Query("read ZoneMap\r\nwhere [ID] <= 131071").Count());
+            Assert.AreEqual(0, SampleDatabase.XDatabaseContext.Query("read ZoneMap\r\nwhere [ID] > 199999").Count());
+            Assert.AreEqual(1, SampleDatabase.XDatabaseContext.Query("read ZoneMap\r\nwhere [ID] = 70000").Count());
+            Assert.AreEqual(199999, SampleDatabase.XDatabaseContext.Query("read ZoneMap\r\nwhere [ID] != 70000").Count());
+            Assert.AreEqual(1000, SampleDatabase.XDatabaseContext.Query("read ZoneMap\r\nwhere [Hour] = 150").Count());
+            Assert.AreEqual(5000, SampleDatabase.XDatabaseContext.Query("read ZoneMap\r\nwhere [Hour] >= 150 AND [ID] < 155000").Count());
+            Assert.AreEqual(150000, SampleDatabase.XDatabaseContext.Query("read ZoneMap\r\nwhere not [ID] >= 150000").Count());
+        }
+
         [TestMethod]
         public void Where_Parallel()
         {
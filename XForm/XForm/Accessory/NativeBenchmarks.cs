@@ -0,0 +1,343 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Security;
+using System.Text;
+
+using XForm.Data;
+using XForm.Extensions;
+using XForm.Query;
+
+namespace XForm
+{
+    /// <summary>
+    ///  NativeBenchmarks measures the XForm.Native and Arriba.Native kernels directly (without the managed query layer)
+    ///  across input sizes from L1 cache to DRAM, selectivities, operators, and element types.
+    ///
+    ///  Results are written to a TSV in the BenchmarkLogger layout (Name, Output, X1) with ns/element and GB/s columns added.
+    ///  When given a baseline TSV from a previous run, results more than RegressionTolerance slower per element are reported.
+    ///
+    ///  Usage: xform perfnative [OutputTsvPath?] [BaselineTsvPath?]
+    /// </summary>
+    internal class NativeBenchmarks
+    {
+        public const string DefaultOutputPath = "XForm.NativeBenchmarks.tsv";
+        public const double RegressionTolerance = 0.10;
+
+        // Input sizes to sweep, in bytes: within L1, L2, L3, and well beyond cache
+        private static readonly KeyValuePair<string, int>[] s_sizes = new KeyValuePair<string, int>[]
+        {
+            new KeyValuePair<string, int>("L1", 16 * 1024),
+            new KeyValuePair<string, int>("L2", 256 * 1024),
+            new KeyValuePair<string, int>("L3", 8 * 1024 * 1024),
+            new KeyValuePair<string, int>("DRAM", 256 * 1024 * 1024)
+        };
+
+        // Target fractions of rows matching (LessThan) or set (bit vectors). Results are labeled with the measured fraction,
+        // since Equal and GreaterThanOrEqual against the same value match different fractions than LessThan.
+        private static readonly double[] s_selectivities = new double[] { 0.01, 0.50, 0.99 };
+
+        private static readonly CompareOperator[] s_operators = new CompareOperator[] { CompareOperator.Equal, CompareOperator.LessThan, CompareOperator.GreaterThanOrEqual };
+
+        private delegate void WhereSignature<T>(T[] left, int index, int length, byte cOp, T right, byte bOp, ulong[] vector, int vectorIndex);
+        private delegate void WhereNullableSignature<T>(T[] left, int index, int length, byte cOp, T right, bool[] nulls, int nullsIndex, byte bOp, ulong[] vector, int vectorIndex);
+        private delegate int IndexOfAllSignature(byte[] content, int index, int length, byte[] value, int valueIndex, int valueLength, bool ignoreCase, int[] matchArray);
+
+        private int _measureForMilliseconds;
+        private string _outputPath;
+        private Dictionary<string, double> _baseline;
+        private StreamWriter _writer;
+        private Random _random;
+        private Func<ulong[], int> _count;
+        private int _regressionCount;
+
+        public NativeBenchmarks(string outputPath = DefaultOutputPath, string baselinePath = null, int measureForMilliseconds = 200)
+        {
+            _outputPath = outputPath;
+            _measureForMilliseconds = measureForMilliseconds;
+            _baseline = (baselinePath == null ? new Dictionary<string, double>() : ReadBaseline(baselinePath));
+            _random = new Random(5);
+        }
+
+        /// <summary>
+        ///  Run every benchmark and return the number of regressions against the baseline.
+        /// </summary>
+        public int Run()
+        {
+            string nativeBinaryPath = Path.Combine(AppDomain.CurrentDomain.BaseDirectory, "XForm.Native.dll");
+            if (!File.Exists(nativeBinaryPath) || !Environment.Is64BitProcess) throw new InvalidOperationException("NativeBenchmarks requires XForm.Native.dll and a 64-bit process.");
+
+            _count = NativeAccelerator.GetMethod<Func<ulong[], int>>("XForm.Native.BitVectorN", "Count");
+            _regressionCount = 0;
+
+            using (_writer = File.AppendText(_outputPath))
+            {
+                if (_writer.BaseStream.Length == 0) _writer.WriteLine("Name\tOutput\tX1\tNsPerElement\tGBPerSecond");
+                WriteLine("");
+                WriteLine($"{DateTime.UtcNow:u}\t{Environment.MachineName}\tNative Kernels");
+
+                Where<byte>(false, 100);
+                Where<sbyte>(true, 100);
+                Where<ushort>(false, 1000);
+                Where<short>(true, 1000);
+                WhereNullable<int>(true, 1000);
+                WhereNullable<uint>(false, 1000);
+                WhereNullable<long>(true, 1000);
+                WhereNullable<ulong>(false, 1000);
+                WhereNullable<float>(true, 1000);
+                WhereNullable<double>(true, 1000);
+
+                CountAndPage();
+                SplitTsv();
+                IndexOfAll();
+                ArribaSets();
+            }
+
+            if (_regressionCount > 0) Console.WriteLine($"{_regressionCount:n0} kernel(s) regressed more than {RegressionTolerance:p0} from the baseline.");
+            return _regressionCount;
+        }
+
+        private void Where<T>(bool isSigned, int range)
+        {
+            WhereSignature<T> where = NativeAccelerator.GetMethod<WhereSignature<T>>("XForm.Native.Comparer", "Where");
+            SweepWhere<T>(isSigned, range, (values, length, cOp, right, vector) => where(values, 0, length, cOp, right, (byte)BooleanOperator.Or, vector, 0));
+        }
+
+        private void WhereNullable<T>(bool isSigned, int range)
+        {
+            WhereNullableSignature<T> where = NativeAccelerator.GetMethod<WhereNullableSignature<T>>("XForm.Native.Comparer", "Where");
+            SweepWhere<T>(isSigned, range, (values, length, cOp, right, vector) => where(values, 0, length, cOp, right, null, 0, (byte)BooleanOperator.Or, vector, 0));
+        }
+
+        private void SweepWhere<T>(bool isSigned, int range, Action<T[], int, byte, T, ulong[]> where)
+        {
+            int elementSize = Marshal.SizeOf(typeof(T));
+            int minimum = (isSigned ? -range / 2 : 0);
+
+            // Build values uniformly distributed in [minimum, minimum + range) for the largest size
+            T[] values = new T[s_sizes[s_sizes.Length - 1].Value / elementSize];
+            for (int i = 0; i < values.Length; ++i)
+            {
+                values[i] = (T)Convert.ChangeType(minimum + _random.Next(range), typeof(T));
+            }
+
+            foreach (KeyValuePair<string, int> size in s_sizes)
+            {
+                int length = size.Value / elementSize;
+                ulong[] vector = new ulong[(length + 63) >> 6];
+
+                foreach (CompareOperator cOp in s_operators)
+                {
+                    foreach (double selectivity in s_selectivities)
+                    {
+                        T right = (T)Convert.ChangeType(minimum + (int)(selectivity * range), typeof(T));
+
+                        // Run once to measure the fraction of rows matching for the label
+                        Array.Clear(vector, 0, vector.Length);
+                        where(values, length, (byte)cOp, right, vector);
+                        string name = $"Where {typeof(T).Name} {cOp} {MatchLabel(_count(vector), length)} {size.Key}";
+
+                        Array.Clear(vector, 0, vector.Length);
+                        Measure(name, length, size.Value, () => { where(values, length, (byte)cOp, right, vector); return null; }, () => _count(vector));
+                    }
+                }
+            }
+        }
+
+        private void CountAndPage()
+        {
+            BitVector.PageSignature page = NativeAccelerator.GetMethod<BitVector.PageSignature>("XForm.Native.BitVectorN", "Page");
+            int[] indices = new int[XTableExtensions.DefaultBatchSize];
+
+            foreach (KeyValuePair<string, int> size in s_sizes)
+            {
+                ulong[] vector = new ulong[size.Value / 8];
+                int bitCount = vector.Length * 64;
+
+                foreach (double selectivity in s_selectivities)
+                {
+                    Array.Clear(vector, 0, vector.Length);
+                    for (int i = 0; i < bitCount; ++i)
+                    {
+                        if (_random.NextDouble() < selectivity) vector[i >> 6] |= (1UL << (i & 63));
+                    }
+
+                    string label = MatchLabel(_count(vector), bitCount);
+                    Measure($"Count {label} {size.Key}", bitCount, size.Value, () => _count(vector), null);
+
+                    // Page through every set bit, a batch at a time
+                    Measure($"Page {label} {size.Key}", bitCount, size.Value, () =>
+                    {
+                        int total = 0;
+                        int nextIndex = 0;
+                        while (nextIndex != -1)
+                        {
+                            total += page(vector, indices, ref nextIndex, indices.Length);
+                        }
+
+                        return total;
+                    }, null);
+                }
+            }
+        }
+
+        private static string MatchLabel(int matchCount, int elementCount)
+        {
+            // Label with the percentage of elements matching, to one decimal place so that rare matches don't round to zero
+            return "p" + ((100.0 * matchCount) / elementCount).ToString("0.0", CultureInfo.InvariantCulture);
+        }
+
+        private byte[] BuildTsv(int length, int cellLength)
+        {
+            // Build TSV content with cells of about cellLength bytes and ten cells per row
+            byte[] content = new byte[length + 64];
+            for (int i = 0; i < length; ++i)
+            {
+                content[i] = (byte)('a' + _random.Next(26));
+                if (_random.Next(cellLength) == 0) content[i] = (byte)(_random.Next(10) == 0 ? '\n' : '\t');
+            }
+
+            return content;
+        }
+
+        private void SplitTsv()
+        {
+            Func<byte[], int, int, ulong[], ulong[], int> splitTsv = NativeAccelerator.GetMethod<Func<byte[], int, int, ulong[], ulong[], int>>("XForm.Native.String8N", "SplitTsv");
+
+            foreach (KeyValuePair<string, int> size in s_sizes)
+            {
+                foreach (int cellLength in new int[] { 4, 32 })
+                {
+                    byte[] content = BuildTsv(size.Value, cellLength);
+                    ulong[] cells = new ulong[(content.Length + 63) >> 6];
+                    ulong[] rows = new ulong[(content.Length + 63) >> 6];
+
+                    // SplitTsv scans whole 64 byte blocks and the tail individually; the vectors are relative to the index passed
+                    Measure($"SplitTsv Cell{cellLength} {size.Key}", size.Value, size.Value, () => splitTsv(content, 0, size.Value, cells, rows), null);
+                }
+            }
+        }
+
+        private void IndexOfAll()
+        {
+            IndexOfAllSignature indexOfAll = NativeAccelerator.GetMethod<IndexOfAllSignature>("XForm.Native.String8N", "IndexOfAll");
+            byte[] value = Encoding.UTF8.GetBytes("Needle");
+            int[] matches = new int[XTableExtensions.DefaultBatchSize];
+
+            foreach (KeyValuePair<string, int> size in s_sizes)
+            {
+                // Lowercase text with 'n' as common as other letters, so the first byte often matches
+                byte[] content = BuildTsv(size.Value, 32);
+                for (int i = 0; i + value.Length < size.Value; i += 1000 + _random.Next(1000))
+                {
+                    Buffer.BlockCopy(value, 0, content, i, value.Length);
+                }
+
+                foreach (bool ignoreCase in new bool[] { false, true })
+                {
+                    string name = $"IndexOfAll {(ignoreCase ? "IgnoreCase" : "Exact")} {size.Key}";
+                    Measure(name, size.Value, size.Value, () =>
+                    {
+                        // Continue from the last match until the whole content is searched
+                        int total = 0;
+                        int index = 0;
+                        while (index < size.Value)
+                        {
+                            int count = indexOfAll(content, index, size.Value - index, value, 0, value.Length, ignoreCase, matches);
+                            total += count;
+                            if (count < matches.Length) break;
+                            index = matches[count - 1] + 1;
+                        }
+
+                        return total;
+                    }, null);
+                }
+            }
+        }
+
+        private void ArribaSets()
+        {
+            try
+            {
+                NativeMethods.CallOverheadTest();
+            }
+            catch (DllNotFoundException)
+            {
+                WriteLine(" - Arriba.Native.dll not found; skipping AndSets and PopulationCount.");
+                return;
+            }
+
+            foreach (KeyValuePair<string, int> size in s_sizes)
+            {
+                ulong[] left = new ulong[size.Value / 8];
+                ulong[] right = new ulong[size.Value / 8];
+                ulong[] result = new ulong[size.Value / 8];
+                for (int i = 0; i < left.Length; ++i)
+                {
+                    left[i] = ((ulong)_random.Next() << 32) | (uint)_random.Next();
+                    right[i] = ((ulong)_random.Next() << 32) | (uint)_random.Next();
+                }
+
+                Measure($"AndSets {size.Key}", left.Length * 64, 3 * size.Value, () => { NativeMethods.AndSets(result, left, right, left.Length); return null; }, () => _count(result));
+                Measure($"PopulationCount {size.Key}", left.Length * 64, size.Value, () => NativeMethods.PopulationCount(left, left.Length), null);
+            }
+        }
+
+        private void Measure(string name, int elementCount, long byteCount, Func<object> method, Func<object> getOutput)
+        {
+            BenchmarkResult result = BenchmarkResult.Measure(name, elementCount, method, _measureForMilliseconds);
+            if (getOutput != null) result.Output = getOutput();
+
+            double nsPerElement = (result.Elapsed.TotalMilliseconds * 1000 * 1000) / ((double)elementCount * result.Iterations);
+            double gbPerSecond = ((double)byteCount * result.Iterations) / result.Elapsed.TotalSeconds / (1000 * 1000 * 1000);
+
+            WriteLine($"{name}\t{result.Output ?? "<null>"}\t{result.ToResultCount()}\t{nsPerElement.ToString("0.0000", CultureInfo.InvariantCulture)}\t{gbPerSecond.ToString("0.00", CultureInfo.InvariantCulture)}");
+
+            // Report regressions from the baseline
+            double baselineNsPerElement;
+            if (_baseline.TryGetValue(name, out baselineNsPerElement) && nsPerElement > baselineNsPerElement * (1 + RegressionTolerance))
+            {
+                _regressionCount++;
+                Console.WriteLine($" - REGRESSION: {name} {nsPerElement:n4} ns/element; baseline {baselineNsPerElement:n4} ns/element [{nsPerElement / baselineNsPerElement:n2}x]");
+            }
+        }
+
+        private void WriteLine(string message)
+        {
+            _writer.WriteLine(message);
+            Console.WriteLine(message);
+        }
+
+        private static Dictionary<string, double> ReadBaseline(string baselinePath)
+        {
+            // Use the last result for each benchmark name in the baseline file
+            Dictionary<string, double> baseline = new Dictionary<string, double>(StringComparer.OrdinalIgnoreCase);
+            foreach (string line in File.ReadLines(baselinePath))
+            {
+                string[] cells = line.Split('\t');
+                double nsPerElement;
+                if (cells.Length < 5 || !double.TryParse(cells[3], NumberStyles.Float, CultureInfo.InvariantCulture, out nsPerElement)) continue;
+                baseline[cells[0]] = nsPerElement;
+            }
+
+            return baseline;
+        }
+
+        private class NativeMethods
+        {
+            [DllImport("Arriba.Native.dll", PreserveSig = true, CallingConvention = CallingConvention.Cdecl), SuppressUnmanagedCodeSecurity]
+            public static extern int CallOverheadTest();
+
+            [DllImport("Arriba.Native.dll", PreserveSig = true, CallingConvention = CallingConvention.Cdecl), SuppressUnmanagedCodeSecurity]
+            public static extern int PopulationCount(ulong[] values, int length);
+
+            [DllImport("Arriba.Native.dll", PreserveSig = true, CallingConvention = CallingConvention.Cdecl), SuppressUnmanagedCodeSecurity]
+            public static extern void AndSets(ulong[] result, ulong[] left, ulong[] right, int length);
+        }
+    }
+}
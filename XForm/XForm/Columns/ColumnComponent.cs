@@ -6,5 +6,7 @@
     public static class ColumnComponent
     {
         public const string String8Raw = "String8Raw";
+        public const string ZoneMap = "ZoneMap";
+        public const string ColumnMemory = "ColumnMemory";
     }
 }
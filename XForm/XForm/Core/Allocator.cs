@@ -27,6 +27,34 @@ namespace XForm
             if (array == null || array.Length < minimumSize) array = new T[minimumSize];
         }
 
+        /// <summary>
+        ///  AllocateToSize for scratch buffers which never leave their owner. If the array is too small,
+        ///  return it to the BufferPool and rent a big enough one. Owners must call Return when disposed.
+        /// </summary>
+        /// <typeparam name="T">Type of array elements</typeparam>
+        /// <param name="array">Array reference to ensure is the minimum size</param>
+        /// <param name="minimumSize">Minimum size Array will be after the call. It may be larger.</param>
+        public static void RentToSize<T>(ref T[] array, int minimumSize)
+        {
+            if (array != null && array.Length >= minimumSize) return;
+
+            if (array != null) BufferPool<T>.Return(array);
+            array = BufferPool<T>.Rent(minimumSize);
+        }
+
+        /// <summary>
+        ///  Return a buffer from RentToSize to the BufferPool and clear the reference to it.
+        /// </summary>
+        /// <typeparam name="T">Type of array elements</typeparam>
+        /// <param name="array">Array reference to return</param>
+        public static void Return<T>(ref T[] array)
+        {
+            if (array == null) return;
+
+            BufferPool<T>.Return(array);
+            array = null;
+        }
+
         /// <summary>
         ///  AllocateToSize for BitVector. Ensure the vector is allocated and at least the required
         ///  size.
@@ -39,6 +67,39 @@ namespace XForm
             vector.Capacity = size;
         }
 
+        /// <summary>
+        ///  RentToSize for BitVector. If the vector is too small, return its array to the BufferPool and
+        ///  wrap a big enough one. Newly rented vectors are cleared. Owners must call Return when disposed.
+        /// </summary>
+        /// <param name="vector">BitVector instance to allocate</param>
+        /// <param name="size">Minimum required size for vector</param>
+        public static void RentToSize(ref BitVector vector, int size)
+        {
+            int wordCount = (size + 63) >> 6;
+            if (vector == null || vector.Array.Length < wordCount)
+            {
+                if (vector != null) BufferPool<ulong>.Return(vector.Array);
+
+                ulong[] array = BufferPool<ulong>.Rent(wordCount);
+                System.Array.Clear(array, 0, array.Length);
+                vector = new BitVector(array);
+            }
+
+            vector.Capacity = size;
+        }
+
+        /// <summary>
+        ///  Return a BitVector from RentToSize to the BufferPool and clear the reference to it.
+        /// </summary>
+        /// <param name="vector">BitVector reference to return</param>
+        public static void Return(ref BitVector vector)
+        {
+            if (vector == null) return;
+
+            BufferPool<ulong>.Return(vector.Array);
+            vector = null;
+        }
+
         /// <summary>
         ///  Ensure a given array is at least the required size, dynamically creating it of the right type.
         /// </summary>
@@ -72,7 +133,7 @@ namespace XForm
             if (array.Length >= minimumSize) return;
 
             int newSize = Math.Max(minimumSize, array.Length * 2);
-            T[] newArray = new T[minimumSize];
+            T[] newArray = new T[newSize];
             Array.Copy(array, newArray, array.Length);
             array = newArray;
         }
@@ -204,7 +204,7 @@ namespace XForm
                 elapsed += w.Elapsed;
             }
 
-            return new BenchmarkResult() { Name = name, Output = output, ItemCount = itemCount, Iterations = iterations, Elapsed = w.Elapsed };
+            return new BenchmarkResult() { Name = name, Output = output, ItemCount = itemCount, Iterations = iterations, Elapsed = elapsed };
         }
 
         public static BenchmarkResult MeasureParallel(string name, int itemCount, Func<int, int, object> method, int parallelCount, int forMilliseconds)
@@ -46,6 +46,9 @@ namespace XForm
             get { return _length; }
             set
             {
+                // Bits past Capacity are kept clear, so None only clears the used words of (pooled) arrays
+                if (value < _length && value >= 0) ClearAbove(value, _length);
+
                 _length = value;
                 int vectorLength = ((_length + 63) >> 6);
                 if (_bitVector.Length < vectorLength) _bitVector = new ulong[vectorLength];
@@ -166,6 +169,23 @@ namespace XForm
             return this;
         }
 
+        private void ClearAbove(int length, int previousLength)
+        {
+            int lastIndex = length >> 6;
+
+            if ((length & 63) != 0)
+            {
+                _bitVector[lastIndex] &= ulong.MaxValue >> (64 - (length & 63));
+                lastIndex++;
+            }
+
+            int previousEnd = Math.Min(_bitVector.Length, (previousLength + 63) >> 6);
+            if (lastIndex < previousEnd)
+            {
+                System.Array.Clear(_bitVector, lastIndex, previousEnd - lastIndex);
+            }
+        }
+
         /// <summary>
         ///  Return the single matching index from this BitVector, or -1 if there
         ///  wasn't exactly one match.
@@ -182,7 +202,7 @@ namespace XForm
 
         public BitVector None()
         {
-            System.Array.Clear(_bitVector, 0, _bitVector.Length);
+            System.Array.Clear(_bitVector, 0, Math.Min(_bitVector.Length, (_length + 63) >> 6));
             return this;
         }
 
@@ -223,7 +243,9 @@ namespace XForm
         {
             if (this.Capacity != other.Capacity) throw new InvalidOperationException();
 
-            for (int i = 0; i < _bitVector.Length; ++i)
+            // Arrays may be longer than Capacity (if pooled), so only combine the used words
+            int end = (this.Capacity + 63) >> 6;
+            for (int i = 0; i < end; ++i)
             {
                 _bitVector[i] = other._bitVector[i];
             }
@@ -235,7 +257,8 @@ namespace XForm
         {
             if (this.Capacity != other.Capacity) throw new InvalidOperationException();
 
-            for (int i = 0; i < _bitVector.Length; ++i)
+            int end = (this.Capacity + 63) >> 6;
+            for (int i = 0; i < end; ++i)
             {
                 _bitVector[i] &= other._bitVector[i];
             }
@@ -247,7 +270,8 @@ namespace XForm
         {
             if (this.Capacity != other.Capacity) throw new InvalidOperationException();
 
-            for (int i = 0; i < _bitVector.Length; ++i)
+            int end = (this.Capacity + 63) >> 6;
+            for (int i = 0; i < end; ++i)
             {
                 _bitVector[i] |= other._bitVector[i];
             }
@@ -259,7 +283,8 @@ namespace XForm
         {
             if (this.Capacity != other.Capacity) throw new InvalidOperationException();
 
-            for (int i = 0; i < _bitVector.Length; ++i)
+            int end = (this.Capacity + 63) >> 6;
+            for (int i = 0; i < end; ++i)
             {
                 _bitVector[i] &= ~other._bitVector[i];
             }
@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+namespace XForm.Core
+{
+    /// <summary>
+    ///  BloomFilter is a split block Bloom filter over 64-bit hashes. It answers "might this value be in the set?"
+    ///  with no false negatives and about 1% false positives at ten bits per value.
+    ///
+    ///  Each value sets one bit in each of the eight 32-bit words of one 256-bit block, so a probe reads one block
+    ///  and the native kernel checks all eight bits with one AVX2 test. It's used to reject most non-matching rows
+    ///  before the exact lookup in a join dictionary.
+    /// </summary>
+    public class BloomFilter
+    {
+        public delegate void AddSignature(ulong[] hashes, int index, int length, uint[] blocks);
+        public delegate int ContainsSignature(ulong[] hashes, int index, int length, uint[] blocks, ulong[] vector);
+        internal static AddSignature s_AddNative = null;
+        internal static ContainsSignature s_ContainsNative = null;
+
+        private const int BitsPerValue = 10;
+        private const int BitsPerBlock = 256;
+
+        // WARNING: Must stay in sync with BLOOM_SALTS_N in XForm.Native
+        private static readonly uint[] Salts = new uint[] { 0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d, 0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31 };
+
+        private uint[] _blocks;
+        private uint _blockCount;
+
+        public BloomFilter(int expectedCount)
+        {
+            if (expectedCount < 0) throw new ArgumentOutOfRangeException("expectedCount");
+            _blockCount = (uint)Math.Max(1, ((long)expectedCount * BitsPerValue + BitsPerBlock - 1) / BitsPerBlock);
+            _blocks = new uint[8 * _blockCount];
+        }
+
+        public void Add(ulong[] hashes, int index, int length)
+        {
+            if (index < 0 || length < 0 || index + length > hashes.Length) throw new IndexOutOfRangeException();
+
+            if (s_AddNative != null)
+            {
+                s_AddNative(hashes, index, length, _blocks);
+                return;
+            }
+
+            int end = index + length;
+            for (int i = index; i < end; ++i)
+            {
+                int block = Block(hashes[i]);
+                for (int word = 0; word < 8; ++word)
+                {
+                    _blocks[block + word] |= Bit(hashes[i], word);
+                }
+            }
+        }
+
+        /// <summary>
+        ///  Set bit i in vector if hashes[index + i] may be in the filter, clearing it otherwise, and return the count set.
+        /// </summary>
+        public int Contains(ulong[] hashes, int index, int length, BitVector vector)
+        {
+            if (index < 0 || length < 0 || index + length > hashes.Length) throw new IndexOutOfRangeException();
+            if (vector.Array.Length < ((length + 63) >> 6)) throw new ArgumentOutOfRangeException("vector");
+
+            if (s_ContainsNative != null) return s_ContainsNative(hashes, index, length, _blocks, vector.Array);
+
+            int count = 0;
+            for (int i = 0; i < length; ++i)
+            {
+                if (Contains(hashes[index + i]))
+                {
+                    vector.Set(i);
+                    count++;
+                }
+                else
+                {
+                    vector.Clear(i);
+                }
+            }
+
+            return count;
+        }
+
+        public bool Contains(ulong hash)
+        {
+            int block = Block(hash);
+            for (int word = 0; word < 8; ++word)
+            {
+                uint bit = Bit(hash, word);
+                if ((_blocks[block + word] & bit) == 0) return false;
+            }
+
+            return true;
+        }
+
+        private int Block(ulong hash)
+        {
+            // The top hash half picks the block (by multiply-shift, so any block count works)
+            return 8 * (int)(((hash >> 32) * _blockCount) >> 32);
+        }
+
+        private static uint Bit(ulong hash, int word)
+        {
+            // The bottom hash half picks the bit in each word
+            return 1U << (int)(((uint)hash * Salts[word]) >> 27);
+        }
+    }
+}
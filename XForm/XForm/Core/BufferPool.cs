@@ -0,0 +1,80 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System.Collections.Concurrent;
+
+namespace XForm
+{
+    /// <summary>
+    ///  BufferPool keeps returned scratch arrays in power-of-two size classes so that readers, writers,
+    ///  and streams built for each query reuse the buffers of previous queries instead of allocating new ones.
+    ///  Buffers of 85KB and more are allocated on the Large Object Heap, so reusing them avoids the full
+    ///  collections which allocating them causes.
+    ///
+    ///  Only buffers which never escape their owner may be returned. Reader pages and BitVectors are pooled;
+    ///  ColumnCache copies the pages it keeps, and byte pages aren't pooled because String8 values returned
+    ///  to callers point into them.
+    /// </summary>
+    /// <typeparam name="T">Type of array elements</typeparam>
+    public static class BufferPool<T>
+    {
+        private const int MinimumSizeClass = 10;
+        private const int MaximumSizeClass = 26;
+        private const int MaximumPooledPerSizeClass = 32;
+
+        private static ConcurrentBag<T[]>[] s_pool = BuildPool();
+
+        private static ConcurrentBag<T[]>[] BuildPool()
+        {
+            ConcurrentBag<T[]>[] pool = new ConcurrentBag<T[]>[MaximumSizeClass + 1];
+            for (int i = MinimumSizeClass; i <= MaximumSizeClass; ++i)
+            {
+                pool[i] = new ConcurrentBag<T[]>();
+            }
+
+            return pool;
+        }
+
+        private static int SizeClass(int length)
+        {
+            int sizeClass = MinimumSizeClass;
+            while (sizeClass <= MaximumSizeClass && (1 << sizeClass) < length)
+            {
+                sizeClass++;
+            }
+
+            return sizeClass;
+        }
+
+        /// <summary>
+        ///  Get an array of at least minimumSize elements, reusing a returned one if available.
+        ///  The array contents are not cleared.
+        /// </summary>
+        /// <param name="minimumSize">Minimum length of array to return</param>
+        /// <returns>Array with Length >= minimumSize</returns>
+        public static T[] Rent(int minimumSize)
+        {
+            int sizeClass = SizeClass(minimumSize);
+            if (sizeClass > MaximumSizeClass) return new T[minimumSize];
+
+            T[] array;
+            if (s_pool[sizeClass].TryTake(out array)) return array;
+
+            return new T[1 << sizeClass];
+        }
+
+        /// <summary>
+        ///  Return an array from Rent to the pool. The caller must not use the array afterward.
+        /// </summary>
+        /// <param name="array">Array to return</param>
+        public static void Return(T[] array)
+        {
+            // Only pool arrays which are exactly a size class (arrays from Rent)
+            int sizeClass = SizeClass(array.Length);
+            if (sizeClass > MaximumSizeClass || (1 << sizeClass) != array.Length) return;
+
+            ConcurrentBag<T[]> bag = s_pool[sizeClass];
+            if (bag.Count < MaximumPooledPerSizeClass) bag.Add(array);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+namespace XForm.Core
+{
+    /// <summary>
+    ///  CountMinSketch estimates how many times each value was added in fixed memory (width * depth counters).
+    ///  Estimates never undercount; they overcount by at most e/width of the total count with probability 1 - e^-depth.
+    ///  With the defaults, that's within 0.07% of all rows with 98% confidence, well under the 0.5% Peek reports.
+    ///
+    ///  Values are added as 64-bit hashes. Each row of counters picks a bucket from the top bits of the hash times a different
+    ///  odd multiplier, and the estimate is the minimum counter across rows. Sketches of the same shape merge by adding counters.
+    /// </summary>
+    public class CountMinSketch
+    {
+        public delegate void AddSignature(ulong[] hashes, int index, int length, uint[] counters, int depth, uint[] estimates);
+        internal static AddSignature s_AddNative = null;
+        internal static Action<uint[], uint[]> s_MergeNative = null;
+
+        public const int DefaultWidth = 4096;
+        public const int DefaultDepth = 4;
+
+        // WARNING: Must stay in sync with CountMinRowMultipliersN in XForm.Native
+        private static readonly ulong[] RowMultipliers = new ulong[] { 0x9E3779B97F4A7C15, 0xC2B2AE3D27D4EB4F, 0x165667B19E3779F9, 0xD6E8FEB86659FD93, 0xFF51AFD7ED558CCD, 0xC4CEB9FE1A85EC53, 0x87C37B91114253D5, 0x4CF5AD432745937F };
+
+        private uint[] _counters;
+        private int _width;
+        private int _widthShift;
+        private int _depth;
+
+        public long TotalCount { get; private set; }
+
+        public CountMinSketch(int width = DefaultWidth, int depth = DefaultDepth)
+        {
+            if (width < 16 || (width & (width - 1)) != 0) throw new ArgumentOutOfRangeException("width");
+            if (depth <= 0 || depth > RowMultipliers.Length) throw new ArgumentOutOfRangeException("depth");
+
+            _width = width;
+            _widthShift = 64;
+            for (int i = width; i > 1; i >>= 1) _widthShift--;
+            _depth = depth;
+            _counters = new uint[width * depth];
+        }
+
+        /// <summary>
+        ///  Add hashes[index, index + length). If estimates isn't null, estimates[i] is set to the estimated
+        ///  count of hashes[index + i] right after it was added, so callers can track heavy hitters as they go.
+        /// </summary>
+        public void Add(ulong[] hashes, int index, int length, uint[] estimates = null)
+        {
+            if (index < 0 || length < 0 || index + length > hashes.Length) throw new IndexOutOfRangeException();
+            if (estimates != null && estimates.Length < length) throw new IndexOutOfRangeException();
+            TotalCount += length;
+
+            if (s_AddNative != null)
+            {
+                s_AddNative(hashes, index, length, _counters, _depth, estimates);
+                return;
+            }
+
+            for (int i = 0; i < length; ++i)
+            {
+                uint minimum = uint.MaxValue;
+                ulong hash = hashes[index + i];
+
+                for (int row = 0; row < _depth; ++row)
+                {
+                    int counterIndex = CounterIndex(hash, row);
+                    if (_counters[counterIndex] != uint.MaxValue) _counters[counterIndex]++;
+                    if (_counters[counterIndex] < minimum) minimum = _counters[counterIndex];
+                }
+
+                if (estimates != null) estimates[i] = minimum;
+            }
+        }
+
+        public uint Estimate(ulong hash)
+        {
+            uint minimum = uint.MaxValue;
+            for (int row = 0; row < _depth; ++row)
+            {
+                minimum = Math.Min(minimum, _counters[CounterIndex(hash, row)]);
+            }
+
+            return minimum;
+        }
+
+        public void Merge(CountMinSketch other)
+        {
+            if (other._width != _width || other._depth != _depth) throw new ArgumentException("Only CountMinSketches with the same width and depth can be merged.", "other");
+            TotalCount += other.TotalCount;
+
+            if (s_MergeNative != null)
+            {
+                s_MergeNative(_counters, other._counters);
+                return;
+            }
+
+            for (int i = 0; i < _counters.Length; ++i)
+            {
+                // Saturate rather than wrap, so merged estimates never drop
+                _counters[i] = (uint)Math.Min(uint.MaxValue, (ulong)_counters[i] + other._counters[i]);
+            }
+        }
+
+        private int CounterIndex(ulong hash, int row)
+        {
+            return row * _width + (int)((hash * RowMultipliers[row]) >> _widthShift);
+        }
+    }
+}
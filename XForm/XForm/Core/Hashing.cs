@@ -5,6 +5,8 @@ using System;
 
 using Microsoft.CodeAnalysis.Elfie.Model.Strings;
 
+using XForm.Data;
+
 namespace XForm
 {
     /// <summary>
@@ -85,6 +87,48 @@ namespace XForm
             }
         }
 
+        /// <summary>
+        ///  Hash each value in an XArray into hashes[0, values.Count), for sketches which need a 64-bit hash per row.
+        ///  Null rows hash as the default value of the column type.
+        /// </summary>
+        public static void Hash(XArray values, ulong[] hashes, uint seed)
+        {
+            if (hashes.Length < values.Count) throw new ArgumentOutOfRangeException("hashes");
+
+            Array array = values.Array;
+            if (array is byte[]) Hash((byte[])array, values, hashes, seed, Hash);
+            else if (array is sbyte[]) Hash((sbyte[])array, values, hashes, seed, Hash);
+            else if (array is short[]) Hash((short[])array, values, hashes, seed, Hash);
+            else if (array is ushort[]) Hash((ushort[])array, values, hashes, seed, Hash);
+            else if (array is int[]) Hash((int[])array, values, hashes, seed, Hash);
+            else if (array is uint[]) Hash((uint[])array, values, hashes, seed, Hash);
+            else if (array is long[]) Hash((long[])array, values, hashes, seed, Hash);
+            else if (array is ulong[]) Hash((ulong[])array, values, hashes, seed, Hash);
+            else if (array is float[]) Hash((float[])array, values, hashes, seed, Hash);
+            else if (array is double[]) Hash((double[])array, values, hashes, seed, Hash);
+            else if (array is Guid[]) Hash((Guid[])array, values, hashes, seed, Hash);
+            else if (array is DateTime[]) Hash((DateTime[])array, values, hashes, seed, Hash);
+            else if (array is TimeSpan[]) Hash((TimeSpan[])array, values, hashes, seed, Hash);
+            else if (array is String8[]) Hash((String8[])array, values, hashes, seed, Hash);
+            else if (array is bool[]) Hash((bool[])array, values, hashes, seed, (value, s) => Hash((byte)(value ? 1 : 0), s));
+            else
+            {
+                for (int i = 0; i < values.Count; ++i)
+                {
+                    object value = array.GetValue(values.Index(i));
+                    hashes[i] = Hash((value == null ? 0 : value.GetHashCode()), seed);
+                }
+            }
+        }
+
+        private static void Hash<T>(T[] array, XArray values, ulong[] hashes, uint seed, Func<T, uint, ulong> hasher)
+        {
+            for (int i = 0; i < values.Count; ++i)
+            {
+                hashes[i] = hasher(array[values.Index(i)], seed);
+            }
+        }
+
         public static uint Murmur3(uint value, uint seed)
         {
             uint h = seed;
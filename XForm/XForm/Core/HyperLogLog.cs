@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+namespace XForm.Core
+{
+    /// <summary>
+    ///  HyperLogLog estimates the number of distinct values added in fixed memory (2^precision bytes).
+    ///  The standard error is about 1.04 / sqrt(2^precision); 0.8% at the default precision of 14.
+    ///
+    ///  Values are added as 64-bit hashes. The top 'precision' bits choose a register, and each register keeps the
+    ///  longest run of leading zeros seen in the remaining bits. Sketches of the same precision merge by taking the
+    ///  maximum of each register, so partitions can be sketched independently and combined cheaply.
+    /// </summary>
+    public class HyperLogLog
+    {
+        public delegate void AddSignature(ulong[] hashes, int index, int length, byte[] registers);
+        internal static AddSignature s_AddNative = null;
+        internal static Action<byte[], byte[]> s_MergeNative = null;
+
+        public const int DefaultPrecision = 14;
+
+        private byte[] _registers;
+        private int _precision;
+
+        public HyperLogLog(int precision = DefaultPrecision)
+        {
+            if (precision < 4 || precision > 16) throw new ArgumentOutOfRangeException("precision");
+            _precision = precision;
+            _registers = new byte[1 << precision];
+        }
+
+        public int Precision => _precision;
+
+        public void Add(ulong hash)
+        {
+            int index = (int)(hash >> (64 - _precision));
+            byte rank = Rank(hash, _precision);
+            if (rank > _registers[index]) _registers[index] = rank;
+        }
+
+        public void Add(ulong[] hashes, int index, int length)
+        {
+            if (index < 0 || length < 0 || index + length > hashes.Length) throw new IndexOutOfRangeException();
+
+            if (s_AddNative != null)
+            {
+                s_AddNative(hashes, index, length, _registers);
+                return;
+            }
+
+            int end = index + length;
+            for (int i = index; i < end; ++i)
+            {
+                Add(hashes[i]);
+            }
+        }
+
+        public void Merge(HyperLogLog other)
+        {
+            if (other._precision != _precision) throw new ArgumentException("Only HyperLogLogs with the same precision can be merged.", "other");
+
+            if (s_MergeNative != null)
+            {
+                s_MergeNative(_registers, other._registers);
+                return;
+            }
+
+            for (int i = 0; i < _registers.Length; ++i)
+            {
+                if (other._registers[i] > _registers[i]) _registers[i] = other._registers[i];
+            }
+        }
+
+        public long Estimate()
+        {
+            int m = _registers.Length;
+
+            double sum = 0;
+            int zeroCount = 0;
+            for (int i = 0; i < m; ++i)
+            {
+                sum += 1.0 / (1UL << _registers[i]);
+                if (_registers[i] == 0) zeroCount++;
+            }
+
+            double estimate = Alpha(m) * m * m / sum;
+
+            // Use linear counting for small cardinalities, where it's more accurate. 64-bit hashes don't need a large range correction.
+            if (estimate <= 2.5 * m && zeroCount > 0) estimate = m * Math.Log((double)m / zeroCount);
+
+            return (long)Math.Round(estimate);
+        }
+
+        private static double Alpha(int m)
+        {
+            if (m == 16) return 0.673;
+            if (m == 32) return 0.697;
+            if (m == 64) return 0.709;
+            return 0.7213 / (1.0 + 1.079 / m);
+        }
+
+        private static byte Rank(ulong hash, int precision)
+        {
+            // One more than the leading zeros after the register bits; the guard bit caps the rank at (64 - precision + 1)
+            ulong remaining = (hash << precision) | (1UL << (precision - 1));
+
+            byte rank = 1;
+            while ((remaining & 0x8000000000000000UL) == 0)
+            {
+                rank++;
+                remaining <<= 1;
+            }
+
+            return rank;
+        }
+    }
+}
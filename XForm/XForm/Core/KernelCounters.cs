@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Diagnostics.Tracing;
+using System.Text;
+
+namespace XForm
+{
+    /// <summary>
+    ///  KernelCounters reports, for each XForm.Native kernel, the calls, values processed, bytes read, rows matched, and CPU cycles (TSC) spent.
+    ///  Counting is off by default and costs one flag check per kernel call when off. Counters are process-wide, so concurrent queries are counted together.
+    ///  Counters are only available when NativeAccelerator is enabled.
+    /// </summary>
+    public static class KernelCounters
+    {
+        // WARNING: Values must stay in sync with KernelN in XForm.Native
+        public static readonly string[] KernelNames = new string[] { "Where", "WhereString", "IndexOfAll", "SplitTsv", "Count", "Page", "Gather", "Parse", "Compute", "Read", "WriteCells", "Sketch", "BloomFilter" };
+        public const int FieldCount = 5;
+
+        internal static Action<bool> s_EnableNative = null;
+        internal static Action s_ResetNative = null;
+        internal static Action<long[]> s_ReadNative = null;
+
+        public static bool IsAvailable => s_ReadNative != null;
+        public static bool IsEnabled { get; private set; }
+
+        /// <summary>
+        ///  Turn kernel counters on or off. Returns false if counters aren't available (NativeAccelerator isn't enabled).
+        /// </summary>
+        public static bool Enable(bool enabled)
+        {
+            if (s_EnableNative == null) return false;
+
+            s_EnableNative(enabled);
+            IsEnabled = enabled;
+            return true;
+        }
+
+        public static void Reset()
+        {
+            if (s_ResetNative != null) s_ResetNative();
+        }
+
+        /// <summary>
+        ///  Return the current totals. Subtract an earlier snapshot to get the counts for one query.
+        /// </summary>
+        public static KernelCounterSnapshot Read()
+        {
+            long[] values = new long[KernelNames.Length * FieldCount];
+            if (s_ReadNative != null) s_ReadNative(values);
+            return new KernelCounterSnapshot(values);
+        }
+
+        /// <summary>
+        ///  Write a marker event (provider "XForm-Kernels") so profiler traces can be lined up with query stages.
+        /// </summary>
+        public static void Mark(string label)
+        {
+            KernelEventSource.Log.Marker(label);
+        }
+    }
+
+    public class KernelCounterSnapshot
+    {
+        private long[] _values;
+
+        internal KernelCounterSnapshot(long[] values)
+        {
+            _values = values;
+        }
+
+        public long Calls(int kernel) => _values[kernel * KernelCounters.FieldCount];
+        public long Elements(int kernel) => _values[kernel * KernelCounters.FieldCount + 1];
+        public long Bytes(int kernel) => _values[kernel * KernelCounters.FieldCount + 2];
+        public long Matched(int kernel) => _values[kernel * KernelCounters.FieldCount + 3];
+        public long Cycles(int kernel) => _values[kernel * KernelCounters.FieldCount + 4];
+
+        public KernelCounterSnapshot Subtract(KernelCounterSnapshot earlier)
+        {
+            long[] difference = new long[_values.Length];
+            for (int i = 0; i < difference.Length; ++i)
+            {
+                difference[i] = _values[i] - earlier._values[i];
+            }
+
+            return new KernelCounterSnapshot(difference);
+        }
+
+        /// <summary>
+        ///  Return one line for each kernel which ran, like "Where: 120 calls, 7,864,320 values, 31,457,280 bytes, 312,004 matched, 0.41 cycles/value".
+        /// </summary>
+        public override string ToString()
+        {
+            StringBuilder result = new StringBuilder();
+
+            for (int kernel = 0; kernel < KernelCounters.KernelNames.Length; ++kernel)
+            {
+                if (Calls(kernel) == 0) continue;
+
+                if (result.Length > 0) result.AppendLine();
+                result.Append($"{KernelCounters.KernelNames[kernel]}: {Calls(kernel):n0} calls, {Elements(kernel):n0} values, {Bytes(kernel):n0} bytes, {Matched(kernel):n0} matched, {(double)Cycles(kernel) / Math.Max(1, Elements(kernel)):n2} cycles/value");
+            }
+
+            return result.ToString();
+        }
+    }
+
+    [EventSource(Name = "XForm-Kernels")]
+    internal sealed class KernelEventSource : EventSource
+    {
+        public static KernelEventSource Log = new KernelEventSource();
+
+        [Event(1, Level = EventLevel.Informational)]
+        public void Marker(string label)
+        {
+            WriteEvent(1, label);
+        }
+    }
+}
@@ -0,0 +1,398 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.ExceptionServices;
+using System.Threading;
+
+namespace XForm.Core
+{
+    public enum MorselPriority
+    {
+        Low = 0,
+        Normal = 1,
+        High = 2
+    }
+
+    public class MorselOptions
+    {
+        /// <summary>
+        ///  Rows per morsel. Use a multiple of 64 so that morsels never share a BitVector block.
+        /// </summary>
+        public int MorselLength { get; set; } = MorselScheduler.DefaultMorselLength;
+
+        /// <summary>
+        ///  Maximum threads (including the calling thread) to run the morsels of one call.
+        /// </summary>
+        public int MaxParallelism { get; set; } = int.MaxValue;
+
+        /// <summary>
+        ///  Workers move to higher priority calls between morsels, so a High query isn't stuck behind a long Low one.
+        /// </summary>
+        public MorselPriority Priority { get; set; } = MorselPriority.Normal;
+
+        /// <summary>
+        ///  When cancelled, remaining morsels are skipped and Run throws OperationCanceledException.
+        /// </summary>
+        public CancellationToken CancellationToken { get; set; }
+    }
+
+    /// <summary>
+    ///  MorselScheduler runs a range of rows in parallel as fixed-size morsels on a shared set of worker threads.
+    ///
+    ///  Each call gives every participating thread a contiguous block of morsels in its own deque. Threads take
+    ///  morsels from the front of their own deque and, when it's empty, steal half of the remaining morsels from the
+    ///  back of another thread's deque, so ranges with skewed cost still keep every core busy until the end.
+    ///  The calling thread always participates, so calls make progress even when every worker is busy, and nested calls can't deadlock.
+    ///
+    ///  Each thread accumulates into its own local value, and the locals are merged once on the calling thread when all morsels are done.
+    /// </summary>
+    public sealed class MorselScheduler : IDisposable
+    {
+        public const int DefaultMorselLength = 64 * 1024;
+
+        private static readonly Lazy<MorselScheduler> s_default = new Lazy<MorselScheduler>(() => new MorselScheduler(Environment.ProcessorCount - 1));
+
+        public static MorselScheduler Default => s_default.Value;
+
+        private Thread[] _workers;
+
+        // Calls with morsels left for workers to join, highest priority first, then oldest first
+        private List<MorselJob> _jobs;
+        private volatile int _highestPriority;
+        private bool _isDisposed;
+
+        public MorselScheduler(int workerCount)
+        {
+            if (workerCount < 0) throw new ArgumentOutOfRangeException("workerCount");
+
+            _jobs = new List<MorselJob>();
+            _highestPriority = -1;
+
+            _workers = new Thread[workerCount];
+            for (int i = 0; i < workerCount; ++i)
+            {
+                _workers[i] = new Thread(WorkerLoop) { IsBackground = true, Name = $"XForm Morsel Worker {i}" };
+                _workers[i].Start();
+            }
+        }
+
+        public int WorkerCount => _workers.Length;
+
+        /// <summary>
+        ///  Run method on [startIndexInclusive, endIndexExclusive) in morsels of options.MorselLength rows,
+        ///  returning once every morsel is done. Exceptions from method are rethrown on the calling thread.
+        /// </summary>
+        public void Run(int startIndexInclusive, int endIndexExclusive, Action<int, int> method, MorselOptions options = null)
+        {
+            Run<object>(startIndexInclusive, endIndexExclusive, () => null, (start, end, local) => { method(start, end); return local; }, (left, right) => null, options);
+        }
+
+        /// <summary>
+        ///  Run body on [startIndexInclusive, endIndexExclusive) in morsels, with a local value per thread.
+        ///  localInit creates each thread's local, body returns the local updated for one morsel, and
+        ///  merge combines two locals. The merged result of all threads is returned; threads take morsels in no
+        ///  particular order, so merge must not depend on the order of locals.
+        /// </summary>
+        public TLocal Run<TLocal>(int startIndexInclusive, int endIndexExclusive, Func<TLocal> localInit, Func<int, int, TLocal, TLocal> body, Func<TLocal, TLocal, TLocal> merge, MorselOptions options = null)
+        {
+            if (endIndexExclusive < startIndexInclusive) throw new ArgumentOutOfRangeException("endIndexExclusive");
+            if (localInit == null) throw new ArgumentNullException("localInit");
+            if (body == null) throw new ArgumentNullException("body");
+            if (merge == null) throw new ArgumentNullException("merge");
+            if (options == null) options = new MorselOptions();
+            if (options.MorselLength <= 0) throw new ArgumentOutOfRangeException("options.MorselLength");
+
+            long rowCount = (long)endIndexExclusive - startIndexInclusive;
+            int morselCount = (int)((rowCount + options.MorselLength - 1) / options.MorselLength);
+            int slotCount = Math.Min(Math.Min(options.MaxParallelism, _workers.Length + 1), morselCount);
+
+            // If there's only one morsel or thread, run on this thread without scheduling
+            if (slotCount <= 1)
+            {
+                TLocal local = localInit();
+                for (long start = startIndexInclusive; start < endIndexExclusive; start += options.MorselLength)
+                {
+                    options.CancellationToken.ThrowIfCancellationRequested();
+                    local = body((int)start, (int)Math.Min(endIndexExclusive, start + options.MorselLength), local);
+                }
+
+                return local;
+            }
+
+            MorselJob<TLocal> job = new MorselJob<TLocal>(startIndexInclusive, endIndexExclusive, morselCount, slotCount, localInit, body, options);
+
+            // Offer the job to workers; the calling thread takes the last slot
+            Add(job);
+            job.Work(slotCount - 1, null);
+            job.WaitForCompletion();
+            Remove(job);
+
+            if (job.Exception != null) ExceptionDispatchInfo.Capture(job.Exception).Throw();
+            options.CancellationToken.ThrowIfCancellationRequested();
+
+            return job.MergeLocals(merge);
+        }
+
+        internal int HighestPriority => _highestPriority;
+
+        private void Add(MorselJob job)
+        {
+            lock (_jobs)
+            {
+                int index = 0;
+                while (index < _jobs.Count && _jobs[index].Priority >= job.Priority) index++;
+                _jobs.Insert(index, job);
+
+                _highestPriority = (int)_jobs[0].Priority;
+                Monitor.PulseAll(_jobs);
+            }
+        }
+
+        private void Remove(MorselJob job)
+        {
+            lock (_jobs)
+            {
+                _jobs.Remove(job);
+                _highestPriority = (_jobs.Count == 0 ? -1 : (int)_jobs[0].Priority);
+            }
+        }
+
+        private void WorkerLoop()
+        {
+            while (true)
+            {
+                MorselJob job;
+
+                lock (_jobs)
+                {
+                    while (_jobs.Count == 0 && !_isDisposed) Monitor.Wait(_jobs);
+                    if (_isDisposed) return;
+                    job = _jobs[0];
+                }
+
+                // If every slot is taken, the threads already in the job will finish it
+                int slot = job.TryJoin();
+                if (slot == -1)
+                {
+                    Remove(job);
+                    continue;
+                }
+
+                // Work returns early if a higher priority job arrives; otherwise there's nothing left to claim
+                if (job.Work(slot, this)) Remove(job);
+            }
+        }
+
+        public void Dispose()
+        {
+            lock (_jobs)
+            {
+                _isDisposed = true;
+                Monitor.PulseAll(_jobs);
+            }
+        }
+    }
+
+    internal abstract class MorselJob
+    {
+        public MorselPriority Priority { get; private set; }
+        public Exception Exception => _exception;
+
+        protected int _startIndex;
+        protected int _endIndex;
+        protected int _morselLength;
+        protected int _slotCount;
+        protected CancellationToken _cancellationToken;
+
+        // Each slot's deque holds the morsel indices [head, tail) packed as (head << 32 | tail), updated by CompareExchange.
+        // Owners take from the head and thieves take from the tail.
+        private long[] _deques;
+        private int _joinedCount;
+        private int _remainingCount;
+        private ManualResetEventSlim _completed;
+        private Exception _exception;
+
+        protected MorselJob(int startIndex, int endIndex, int morselCount, int slotCount, MorselOptions options)
+        {
+            _startIndex = startIndex;
+            _endIndex = endIndex;
+            _morselLength = options.MorselLength;
+            _slotCount = slotCount;
+            _cancellationToken = options.CancellationToken;
+            Priority = options.Priority;
+
+            // Give each slot an equal contiguous block of morsels
+            _deques = new long[slotCount];
+            for (int slot = 0; slot < slotCount; ++slot)
+            {
+                _deques[slot] = Pack((int)((long)morselCount * slot / slotCount), (int)((long)morselCount * (slot + 1) / slotCount));
+            }
+
+            _remainingCount = morselCount;
+            _completed = new ManualResetEventSlim(false);
+        }
+
+        /// <summary>
+        ///  Claim a slot for a worker thread, or return -1 if all worker slots are taken (the last slot is the calling thread's).
+        /// </summary>
+        public int TryJoin()
+        {
+            int slot = Interlocked.Increment(ref _joinedCount) - 1;
+            return (slot < _slotCount - 1 ? slot : -1);
+        }
+
+        /// <summary>
+        ///  Run morsels from this slot's deque, stealing when it's empty. Returns true when no morsels are left to claim,
+        ///  or false if the thread left early for a higher priority job (other threads will steal the rest).
+        /// </summary>
+        public bool Work(int slot, MorselScheduler scheduler)
+        {
+            while (true)
+            {
+                int morsel = TakeOrSteal(slot);
+                if (morsel == -1) return true;
+
+                int start = _startIndex + morsel * _morselLength;
+                int end = (int)Math.Min(_endIndex, (long)start + _morselLength);
+
+                if (_exception == null && !_cancellationToken.IsCancellationRequested)
+                {
+                    try
+                    {
+                        RunMorsel(slot, start, end);
+                    }
+                    catch (Exception ex)
+                    {
+                        Interlocked.CompareExchange(ref _exception, ex, null);
+                    }
+                }
+
+                if (Interlocked.Decrement(ref _remainingCount) == 0) _completed.Set();
+
+                if (scheduler != null && scheduler.HighestPriority > (int)Priority) return false;
+            }
+        }
+
+        public void WaitForCompletion()
+        {
+            _completed.Wait();
+        }
+
+        protected abstract void RunMorsel(int slot, int startIndexInclusive, int endIndexExclusive);
+
+        private int TakeOrSteal(int slot)
+        {
+            while (true)
+            {
+                int morsel = Take(slot);
+                if (morsel != -1) return morsel;
+
+                if (!Steal(slot)) return -1;
+            }
+        }
+
+        private int Take(int slot)
+        {
+            while (true)
+            {
+                long range = Volatile.Read(ref _deques[slot]);
+                int head = Head(range);
+                int tail = Tail(range);
+                if (head >= tail) return -1;
+
+                if (Interlocked.CompareExchange(ref _deques[slot], Pack(head + 1, tail), range) == range) return head;
+            }
+        }
+
+        private bool Steal(int slot)
+        {
+            // Look for work in each other deque, starting with the next one so thieves spread out
+            for (int i = 1; i < _slotCount; ++i)
+            {
+                int victim = (slot + i) % _slotCount;
+
+                while (true)
+                {
+                    long range = Volatile.Read(ref _deques[victim]);
+                    int head = Head(range);
+                    int tail = Tail(range);
+                    if (head >= tail) break;
+
+                    // Take the back half (rounded up) of the victim's remaining morsels
+                    int stealCount = (tail - head + 1) / 2;
+                    if (Interlocked.CompareExchange(ref _deques[victim], Pack(head, tail - stealCount), range) == range)
+                    {
+                        // This deque is empty, so no thief can change it; publish the stolen morsels in it
+                        Interlocked.Exchange(ref _deques[slot], Pack(tail - stealCount, tail));
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        private static long Pack(int head, int tail)
+        {
+            return ((long)head << 32) | (uint)tail;
+        }
+
+        private static int Head(long range)
+        {
+            return (int)(range >> 32);
+        }
+
+        private static int Tail(long range)
+        {
+            return (int)range;
+        }
+    }
+
+    internal class MorselJob<TLocal> : MorselJob
+    {
+        private Func<TLocal> _localInit;
+        private Func<int, int, TLocal, TLocal> _body;
+
+        // Each slot is only used by one thread, so locals are updated without locking
+        private TLocal[] _locals;
+        private bool[] _hasLocal;
+
+        public MorselJob(int startIndex, int endIndex, int morselCount, int slotCount, Func<TLocal> localInit, Func<int, int, TLocal, TLocal> body, MorselOptions options)
+            : base(startIndex, endIndex, morselCount, slotCount, options)
+        {
+            _localInit = localInit;
+            _body = body;
+            _locals = new TLocal[slotCount];
+            _hasLocal = new bool[slotCount];
+        }
+
+        protected override void RunMorsel(int slot, int startIndexInclusive, int endIndexExclusive)
+        {
+            if (!_hasLocal[slot])
+            {
+                _locals[slot] = _localInit();
+                _hasLocal[slot] = true;
+            }
+
+            _locals[slot] = _body(startIndexInclusive, endIndexExclusive, _locals[slot]);
+        }
+
+        public TLocal MergeLocals(Func<TLocal, TLocal, TLocal> merge)
+        {
+            TLocal result = default(TLocal);
+            bool hasResult = false;
+
+            for (int slot = 0; slot < _slotCount; ++slot)
+            {
+                if (!_hasLocal[slot]) continue;
+
+                result = (hasResult ? merge(result, _locals[slot]) : _locals[slot]);
+                hasResult = true;
+            }
+
+            return (hasResult ? result : _localInit());
+        }
+    }
+}
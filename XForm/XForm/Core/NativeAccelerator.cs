@@ -8,9 +8,14 @@ using System.IO;
 using System.Linq;
 using System.Reflection;
 
+using XForm.Core;
 using XForm.Data;
+using XForm.Functions.Date;
+using XForm.IO;
+using XForm.Query.Expression;
 using XForm.Types;
 using XForm.Types.Comparers;
+using XForm.Types.Computers;
 
 namespace XForm
 {
@@ -49,18 +54,87 @@ namespace XForm
             BitVector.s_nativeCount = GetMethod<Func<ulong[], int>>("XForm.Native.BitVectorN", "Count");
             BitVector.s_nativePage = GetMethod<BitVector.PageSignature>("XForm.Native.BitVectorN", "Page");
 
+            KernelCounters.s_EnableNative = GetMethod<Action<bool>>("XForm.Native.KernelCountersN", "Enable");
+            KernelCounters.s_ResetNative = GetMethod<Action>("XForm.Native.KernelCountersN", "Reset");
+            KernelCounters.s_ReadNative = GetMethod<Action<long[]>>("XForm.Native.KernelCountersN", "Read");
+
+            MappedFileStream.s_OpenNative = GetMethod<MappedFileStream.OpenSignature>("XForm.Native.MappedFileN", "Open");
+            MappedFileStream.s_ReadNative = GetMethod<MappedFileStream.ReadSignature>("XForm.Native.MappedFileN", "Read");
+            MappedFileStream.s_FreeNative = GetMethod<Action<IntPtr>>("XForm.Native.MappedFileN", "Free");
+            MappedFileStream.s_AddressNative = GetMethod<Func<IntPtr, IntPtr>>("XForm.Native.MappedFileN", "Address");
+
+            ColumnPredicate.s_EvaluateNative = GetMethod<ColumnPredicate.EvaluateSignature>("XForm.Native.PredicateN", "Evaluate");
+
+            HyperLogLog.s_AddNative = GetMethod<HyperLogLog.AddSignature>("XForm.Native.HyperLogLogN", "Add");
+            HyperLogLog.s_MergeNative = GetMethod<Action<byte[], byte[]>>("XForm.Native.HyperLogLogN", "Merge");
+            CountMinSketch.s_AddNative = GetMethod<CountMinSketch.AddSignature>("XForm.Native.CountMinN", "Add");
+            CountMinSketch.s_MergeNative = GetMethod<Action<uint[], uint[]>>("XForm.Native.CountMinN", "Merge");
+            BloomFilter.s_AddNative = GetMethod<BloomFilter.AddSignature>("XForm.Native.BloomFilterN", "Add");
+            BloomFilter.s_ContainsNative = GetMethod<BloomFilter.ContainsSignature>("XForm.Native.BloomFilterN", "Contains");
+
+            PackedArray.s_UnpackInt32Native = GetMethod<PackedArray.UnpackSignature<int>>("XForm.Native.PackedN", "Unpack");
+            PackedArray.s_UnpackInt64Native = GetMethod<PackedArray.UnpackSignature<long>>("XForm.Native.PackedN", "Unpack");
+            PackedArray.s_UnpackDeltaInt32Native = GetMethod<PackedArray.UnpackDeltaSignature<int>>("XForm.Native.PackedN", "UnpackDelta");
+            PackedArray.s_UnpackDeltaInt64Native = GetMethod<PackedArray.UnpackDeltaSignature<long>>("XForm.Native.PackedN", "UnpackDelta");
+
+            Gatherer<byte>.s_GatherNative = GetMethod<Gatherer<byte>.GatherSignature>("XForm.Native.GatherN", "Gather");
+            Gatherer<sbyte>.s_GatherNative = GetMethod<Gatherer<sbyte>.GatherSignature>("XForm.Native.GatherN", "Gather");
+            Gatherer<bool>.s_GatherNative = GetMethod<Gatherer<bool>.GatherSignature>("XForm.Native.GatherN", "Gather");
+            Gatherer<short>.s_GatherNative = GetMethod<Gatherer<short>.GatherSignature>("XForm.Native.GatherN", "Gather");
+            Gatherer<ushort>.s_GatherNative = GetMethod<Gatherer<ushort>.GatherSignature>("XForm.Native.GatherN", "Gather");
+            Gatherer<int>.s_GatherNative = GetMethod<Gatherer<int>.GatherSignature>("XForm.Native.GatherN", "Gather");
+            Gatherer<uint>.s_GatherNative = GetMethod<Gatherer<uint>.GatherSignature>("XForm.Native.GatherN", "Gather");
+            Gatherer<float>.s_GatherNative = GetMethod<Gatherer<float>.GatherSignature>("XForm.Native.GatherN", "Gather");
+            Gatherer<long>.s_GatherNative = GetMethod<Gatherer<long>.GatherSignature>("XForm.Native.GatherN", "Gather");
+            Gatherer<ulong>.s_GatherNative = GetMethod<Gatherer<ulong>.GatherSignature>("XForm.Native.GatherN", "Gather");
+            Gatherer<double>.s_GatherNative = GetMethod<Gatherer<double>.GatherSignature>("XForm.Native.GatherN", "Gather");
+            String8ColumnReader.s_GatherRangesNative = GetMethod<String8ColumnReader.GatherRangesSignature>("XForm.Native.GatherN", "GatherRanges");
+
             String8Comparer.s_IndexOfAllNative = GetMethod<String8Comparer.IndexOfAll>("XForm.Native.String8N", "IndexOfAll");
+            String8Comparer.s_WhereRawNative = GetMethod<String8Comparer.WhereRaw>("XForm.Native.String8N", "Where");
+
+            FromString8Converter<int>.s_ParseBatchNative = GetMethod<FromString8Converter<int>.ParseBatch>("XForm.Native.String8N", "Parse");
+            FromString8Converter<uint>.s_ParseBatchNative = GetMethod<FromString8Converter<uint>.ParseBatch>("XForm.Native.String8N", "Parse");
+            FromString8Converter<long>.s_ParseBatchNative = GetMethod<FromString8Converter<long>.ParseBatch>("XForm.Native.String8N", "Parse");
+            FromString8Converter<double>.s_ParseBatchNative = GetMethod<FromString8Converter<double>.ParseBatch>("XForm.Native.String8N", "Parse");
+            FromString8Converter<DateTime>.s_ParseTicksBatchNative = GetMethod<FromString8Converter<DateTime>.ParseTicksBatch>("XForm.Native.String8N", "ParseDateTime");
+            FromString8Converter<TimeSpan>.s_ParseTicksBatchNative = GetMethod<FromString8Converter<TimeSpan>.ParseTicksBatch>("XForm.Native.String8N", "ParseTimeSpan");
+            ToString8Converter<DateTime>.s_FormatTicksBatchNative = GetMethod<ToString8Converter<DateTime>.FormatTicksBatch>("XForm.Native.String8N", "FormatDateTime");
+            PageTabularWriter.s_MeasureCellsNative = GetMethod<PageTabularWriter.MeasureCells>("XForm.Native.String8N", "MeasureCells");
+            PageTabularWriter.s_WriteCellsNative = GetMethod<PageTabularWriter.WriteCells>("XForm.Native.String8N", "WriteCells");
+
+            String8SetComparer.s_BuildNative = GetMethod<String8SetComparer.Build>("XForm.Native.String8SetN", "Build");
+            String8SetComparer.s_FreeNative = GetMethod<Action<IntPtr>>("XForm.Native.String8SetN", "Free");
+            String8SetComparer.s_WhereContainsAnyNative = GetMethod<String8SetComparer.WhereContainsAnySignature>("XForm.Native.String8SetN", "WhereContainsAny");
+
+            NativeComputer<long>.s_AddNative = GetMethod<NativeComputer<long>.ComputeSignature>("XForm.Native.ComputerN", "Add");
+            NativeComputer<long>.s_SubtractNative = GetMethod<NativeComputer<long>.ComputeSignature>("XForm.Native.ComputerN", "Subtract");
+            NativeComputer<long>.s_MultiplyNative = GetMethod<NativeComputer<long>.ComputeSignature>("XForm.Native.ComputerN", "Multiply");
+            NativeComputer<long>.s_DivideNative = GetMethod<NativeComputer<long>.ComputeSignature>("XForm.Native.ComputerN", "Divide");
+
+            DatePartBuilder.s_DatePartNative = GetMethod<DatePartBuilder.DatePartSignature>("XForm.Native.DateTimeN", "DatePart");
+            DateTruncateBuilder.s_TruncateNative = GetMethod<DateTruncateBuilder.TruncateSignature>("XForm.Native.DateTimeN", "Truncate");
+            DateAddBuilder.s_AddNative = GetMethod<DateAddBuilder.AddSignature>("XForm.Native.DateTimeN", "Add");
+            DateSubtractBuilder.s_SubtractNative = GetMethod<DateSubtractBuilder.SubtractSignature>("XForm.Native.DateTimeN", "Subtract");
 
             UshortComparer.s_WhereNative = GetMethod<ComparerExtensions.Where<ushort>>("XForm.Native.Comparer", "Where");
             ShortComparer.s_WhereNative = GetMethod<ComparerExtensions.Where<short>>("XForm.Native.Comparer", "Where");
-            //ByteComparer.s_WhereNative = GetMethod<ComparerExtensions.Where<byte>>("XForm.Native.Comparer", "Where");
-            //SbyteComparer.s_WhereNative = GetMethod<ComparerExtensions.Where<sbyte>>("XForm.Native.Comparer", "Where");
+            ByteComparer.s_WhereNative = GetMethod<ComparerExtensions.Where<byte>>("XForm.Native.Comparer", "Where");
+            SbyteComparer.s_WhereNative = GetMethod<ComparerExtensions.Where<sbyte>>("XForm.Native.Comparer", "Where");
 
             UshortComparer.s_WhereSingleNative = GetMethod<ComparerExtensions.WhereSingle<ushort>>("XForm.Native.Comparer", "Where");
             ShortComparer.s_WhereSingleNative = GetMethod<ComparerExtensions.WhereSingle<short>>("XForm.Native.Comparer", "Where");
             ByteComparer.s_WhereSingleNative = GetMethod<ComparerExtensions.WhereSingle<byte>>("XForm.Native.Comparer", "Where");
             SbyteComparer.s_WhereSingleNative = GetMethod<ComparerExtensions.WhereSingle<sbyte>>("XForm.Native.Comparer", "Where");
             BoolComparer.s_WhereSingleNative = GetMethod<ComparerExtensions.WhereSingle<bool>>("XForm.Native.Comparer", "Where");
+            SetComparer.s_WhereInNative = GetMethod<SetComparer.WhereInSignature>("XForm.Native.Comparer", "WhereIn");
+
+            IntComparer.s_WhereSingleNullableNative = GetMethod<ComparerExtensions.WhereSingleNullable<int>>("XForm.Native.Comparer", "Where");
+            UintComparer.s_WhereSingleNullableNative = GetMethod<ComparerExtensions.WhereSingleNullable<uint>>("XForm.Native.Comparer", "Where");
+            LongComparer.s_WhereSingleNullableNative = GetMethod<ComparerExtensions.WhereSingleNullable<long>>("XForm.Native.Comparer", "Where");
+            UlongComparer.s_WhereSingleNullableNative = GetMethod<ComparerExtensions.WhereSingleNullable<ulong>>("XForm.Native.Comparer", "Where");
+            FloatComparer.s_WhereSingleNullableNative = GetMethod<ComparerExtensions.WhereSingleNullable<float>>("XForm.Native.Comparer", "Where");
+            DoubleComparer.s_WhereSingleNullableNative = GetMethod<ComparerExtensions.WhereSingleNullable<double>>("XForm.Native.Comparer", "Where");
         }
     }
 }
@@ -2,7 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 using System;
-using System.Threading.Tasks;
+using System.Threading;
 
 namespace XForm.Core
 {
@@ -10,22 +10,24 @@ namespace XForm.Core
     {
         public static int ParallelCount = Environment.ProcessorCount;
 
+        /// <summary>
+        ///  Run method on [startIndexInclusive, endIndexExclusive) in 64-aligned morsels on the shared MorselScheduler,
+        ///  using up to ParallelCount threads.
+        /// </summary>
         public static void Run(int startIndexInclusive, int endIndexExclusive, Action<int, int> method)
+        {
+            Run(startIndexInclusive, endIndexExclusive, method, CancellationToken.None);
+        }
+
+        public static void Run(int startIndexInclusive, int endIndexExclusive, Action<int, int> method, CancellationToken cancellationToken)
         {
             if (ParallelCount == 1)
             {
                 method(startIndexInclusive, endIndexExclusive);
+                return;
             }
 
-            int segmentLength = ParallelLengthPart(endIndexExclusive - startIndexInclusive, ParallelCount);
-
-            Parallel.For(0, ParallelCount, (i) =>
-            {
-                int threadStartIndex = startIndexInclusive + i * segmentLength;
-                int threadEndIndex = (i == ParallelCount - 1 ? endIndexExclusive : threadStartIndex + segmentLength);
-
-                method(threadStartIndex, threadEndIndex);
-            });
+            MorselScheduler.Default.Run(startIndexInclusive, endIndexExclusive, method, new MorselOptions() { MaxParallelism = ParallelCount, CancellationToken = cancellationToken });
         }
 
         public static int ParallelLengthPart(int totalCount, int parallelCount)
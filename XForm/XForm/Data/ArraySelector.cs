@@ -121,6 +121,12 @@ namespace XForm.Data
 
             // Otherwise, we need to remap the indices in the inner array to ones in the real array
             Allocator.AllocateToSize(ref remapArray, inner.Count);
+            if (this.Indices != null)
+            {
+                Gatherer<int>.Gather(this.Indices, this.StartIndexInclusive, inner.Indices, inner.StartIndexInclusive, inner.Count, remapArray);
+                return new ArraySelector() { StartIndexInclusive = 0, EndIndexExclusive = inner.Count, Indices = remapArray };
+            }
+
             for (int i = 0; i < inner.Count; ++i)
             {
                 remapArray[i] = Index(inner.Index(i));
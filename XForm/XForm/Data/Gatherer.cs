@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+namespace XForm.Data
+{
+    /// <summary>
+    ///  Gatherer copies values out of an array by index, for places which must physically
+    ///  materialize an indirected XArray (ToContiguous, null remapping, selector composition).
+    /// </summary>
+    /// <typeparam name="T">Type of values to gather</typeparam>
+    internal static class Gatherer<T>
+    {
+        internal delegate void GatherSignature(T[] source, int sourceIndex, int[] indices, int indicesIndex, int count, T[] target);
+        internal static GatherSignature s_GatherNative;
+
+        /// <summary>
+        ///  Set target[i] = source[sourceIndex + indices[indicesIndex + i]] for i in [0, count).
+        /// </summary>
+        public static void Gather(T[] source, int sourceIndex, int[] indices, int indicesIndex, int count, T[] target)
+        {
+            if (s_GatherNative != null)
+            {
+                s_GatherNative(source, sourceIndex, indices, indicesIndex, count, target);
+                return;
+            }
+
+            for (int i = 0; i < count; ++i)
+            {
+                target[i] = source[sourceIndex + indices[indicesIndex + i]];
+            }
+        }
+    }
+}
@@ -254,9 +254,17 @@ namespace XForm.Data
             Allocator.AllocateToSize(ref remapArray, array.Count);
 
             bool areAnyNulls = false;
-            for (int i = 0; i < array.Count; ++i)
+            if (array.Selector.Indices != null)
             {
-                areAnyNulls |= (remapArray[i] = array.NullRows[array.Index(i)]);
+                Gatherer<bool>.Gather(array.NullRows, 0, array.Selector.Indices, array.Selector.StartIndexInclusive, array.Count, remapArray);
+                areAnyNulls = (System.Array.IndexOf(remapArray, true, 0, array.Count) != -1);
+            }
+            else
+            {
+                for (int i = 0; i < array.Count; ++i)
+                {
+                    areAnyNulls |= (remapArray[i] = array.NullRows[array.Index(i)]);
+                }
             }
 
             return (areAnyNulls ? remapArray : null);
@@ -277,6 +285,17 @@ namespace XForm.Data
             T[] thisArray = (T[])this.Array;
             Allocator.AllocateToSize(ref array, this.Count);
 
+            if (this.Selector.Indices != null)
+            {
+                // Gather values (and nulls) by index in bulk
+                Gatherer<T>.Gather(thisArray, 0, this.Selector.Indices, this.Selector.StartIndexInclusive, this.Count, array);
+                if (!this.HasNulls) return XArray.All(array, this.Count);
+
+                Allocator.AllocateToSize(ref nulls, this.Count);
+                Gatherer<bool>.Gather(this.NullRows, 0, this.Selector.Indices, this.Selector.StartIndexInclusive, this.Count, nulls);
+                return XArray.All(array, this.Count, nulls);
+            }
+
             if (!this.HasNulls)
             {
                 for (int i = 0; i < this.Count; ++i)
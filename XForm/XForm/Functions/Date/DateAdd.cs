@@ -9,6 +9,9 @@ namespace XForm.Functions.Date
 {
     internal class DateAddBuilder : IFunctionBuilder
     {
+        internal delegate int AddSignature(DateTime[] values, int index, int count, long offsetTicks, DateTime[] result);
+        internal static AddSignature s_AddNative = null;
+
         public string Name => "DateAdd";
         public string Usage => "DateAdd({DateTime}, {TimeSpanToAdd})";
         public Type ReturnType => typeof(DateTime);
@@ -22,7 +25,13 @@ namespace XForm.Functions.Date
                 Name,
                 source,
                 baseDateTime,
-                (dateTime) => dateTime.Add(offsetSpan)
+                (dateTime) => dateTime.Add(offsetSpan),
+                batchFunction: (values, index, count, result) =>
+                {
+                    // If any result is out of range, convert one at a time so that non-null rows throw as DateTime.Add does
+                    if (s_AddNative == null) return false;
+                    return (s_AddNative(values, index, count, offsetSpan.Ticks, result) == 0);
+                }
             );
         }
     }
@@ -20,6 +20,9 @@ namespace XForm.Functions.Date
 
     internal class DatePartBuilder : IFunctionBuilder
     {
+        internal delegate void DatePartSignature(DateTime[] values, int index, int count, byte part, ushort[] result);
+        internal static DatePartSignature s_DatePartNative = null;
+
         public string Name => "DatePart";
         public string Usage => "DatePart({DateTime}, {Part})";
         public Type ReturnType => typeof(ushort);
@@ -34,7 +37,13 @@ namespace XForm.Functions.Date
                 Name,
                 source,
                 baseDateTime,
-                (dateTime) => extractMethod(dateTime));
+                (dateTime) => extractMethod(dateTime),
+                batchFunction: (values, index, count, result) =>
+                {
+                    if (s_DatePartNative == null) return false;
+                    s_DatePartNative(values, index, count, (byte)part, result);
+                    return true;
+                });
         }
 
         private static Func<DateTime, ushort> DatePartMethod(DatePart part)
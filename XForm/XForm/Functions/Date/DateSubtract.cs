@@ -9,6 +9,9 @@ namespace XForm.Functions.Date
 {
     internal class DateSubtractBuilder : IFunctionBuilder
     {
+        internal delegate void SubtractSignature(DateTime[] end, int endIndex, bool endIsSingle, DateTime[] start, int startIndex, bool startIsSingle, int count, TimeSpan[] result);
+        internal static SubtractSignature s_SubtractNative = null;
+
         public string Name => "DateSubtract";
         public string Usage => "DateSubtract({DateTimeEnd}, {DateTimeStart})";
         public Type ReturnType => typeof(DateTime);
@@ -23,7 +26,13 @@ namespace XForm.Functions.Date
                 source,
                 endColumn,
                 startColumn,
-                (end, start) => end - start
+                (end, start) => end - start,
+                batchFunction: (end, endIndex, endIsSingle, start, startIndex, startIsSingle, count, result) =>
+                {
+                    if (s_SubtractNative == null) return false;
+                    s_SubtractNative(end, endIndex, endIsSingle, start, startIndex, startIsSingle, count, result);
+                    return true;
+                }
             );
         }
     }
@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+using XForm.Data;
+
+namespace XForm.Functions.Date
+{
+    internal class DateTruncateBuilder : IFunctionBuilder
+    {
+        internal delegate void TruncateSignature(DateTime[] values, int index, int count, long unitTicks, DateTime[] result);
+        internal static TruncateSignature s_TruncateNative = null;
+
+        public string Name => "DateTruncate";
+        public string Usage => "DateTruncate({DateTime}, {TimeSpanUnit})";
+        public Type ReturnType => typeof(DateTime);
+
+        public IXColumn Build(IXTable source, XDatabaseContext context)
+        {
+            IXColumn baseDateTime = context.Parser.NextColumn(source, context, typeof(DateTime));
+            TimeSpan unit = context.Parser.NextTimeSpan();
+            if (unit.Ticks <= 0) throw new ArgumentException($"DateTruncate unit must be positive; it was {unit}.");
+
+            long unitTicks = unit.Ticks;
+
+            return SimpleTransformFunction<DateTime, DateTime>.Build(
+                Name,
+                source,
+                baseDateTime,
+                (dateTime) => new DateTime(dateTime.Ticks - dateTime.Ticks % unitTicks, dateTime.Kind),
+                batchFunction: (values, index, count, result) =>
+                {
+                    if (s_TruncateNative == null) return false;
+                    s_TruncateNative(values, index, count, unitTicks, result);
+                    return true;
+                }
+            );
+        }
+    }
+}
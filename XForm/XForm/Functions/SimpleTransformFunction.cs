@@ -15,35 +15,46 @@ namespace XForm.Functions
     ///  If your function requires an addition buffer for transformation (like a String8Block
     ///  to hold changed copies of strings), you can declare it in a scope the Func can see
     ///  and clear it in the 'beforexarray' action. See XForm.Functions.String.ToUpper.
+    ///
+    ///  If your function has a faster form converting many values at once (like a native kernel), pass it
+    ///  as the 'batchFunction'. It gets contiguous values (including values for null rows, which are ignored)
+    ///  and returns false to have the values converted one at a time instead. See XForm.Functions.Date.DatePart.
     /// </summary>
     /// <typeparam name="T">Type of the source column</typeparam>
     /// <typeparam name="U">Type output by the function</typeparam>
     public class SimpleTransformFunction<T, U> : IXColumn
     {
+        public delegate bool BatchFunction(T[] values, int index, int count, U[] result);
+
         private string _name;
         private IXColumn _column;
         private Func<T, U> _function;
         private Action _beforeBatch;
+        private BatchFunction _batchFunction;
         private U[] _buffer;
         private bool[] _isNull;
 
+        private T[] _contiguousValues;
+        private bool[] _contiguousNulls;
+
         private XArray _convertedValues;
 
         public ColumnDetails ColumnDetails { get; private set; }
 
-        private SimpleTransformFunction(string name, IXColumn column, Func<T, U> function, Action beforeBatch = null)
+        private SimpleTransformFunction(string name, IXColumn column, Func<T, U> function, Action beforeBatch = null, BatchFunction batchFunction = null)
         {
             _name = name;
             _column = column;
             _function = function;
             _beforeBatch = beforeBatch;
+            _batchFunction = batchFunction;
             this.ColumnDetails = column.ColumnDetails.ChangeType(typeof(U));
         }
 
-        public static IXColumn Build(string name, IXTable source, IXColumn column, Func<T, U> function, Action beforeBatch = null)
+        public static IXColumn Build(string name, IXTable source, IXColumn column, Func<T, U> function, Action beforeBatch = null, BatchFunction batchFunction = null)
         {
             if (column.ColumnDetails.Type != typeof(T)) throw new ArgumentException($"Function required argument of type {typeof(T).Name}, but argument was {column.ColumnDetails.Type.Name} instead.");
-            return new SimpleTransformFunction<T, U>(name, column, function, beforeBatch);
+            return new SimpleTransformFunction<T, U>(name, column, function, beforeBatch, batchFunction);
         }
 
         public Func<XArray> CurrentGetter()
@@ -128,6 +139,16 @@ namespace XForm.Functions
             // Allocate for results
             Allocator.AllocateToSize(ref _buffer, xarray.Count);
 
+            // Convert all values at once, if there's a batch function
+            if (_batchFunction != null)
+            {
+                XArray contiguous = (xarray.Selector.Indices != null ? xarray.ToContiguous(ref _contiguousValues, ref _contiguousNulls) : xarray);
+                if (_batchFunction((T[])contiguous.Array, contiguous.Selector.StartIndexInclusive, contiguous.Count, _buffer))
+                {
+                    return XArray.All(_buffer, xarray.Count, XArray.RemapNulls(xarray, ref _isNull));
+                }
+            }
+
             // Convert each non-null value
             T[] array = (T[])xarray.Array;
             for (int i = 0; i < xarray.Count; ++i)
@@ -15,37 +15,50 @@ namespace XForm.Functions
     ///  If your function requires an addition buffer for transformation (like a String8Block
     ///  to hold changed copies of strings), you can declare it in a scope the Func can see
     ///  and clear it in the 'beforexarray' action. See XForm.Functions.String.ToUpper.
+    ///
+    ///  If your function has a faster form converting many values at once (like a native kernel), pass it
+    ///  as the 'batchFunction'. It gets contiguous or single values (including values for null rows, which are ignored)
+    ///  and returns false to have the values converted one at a time instead. See XForm.Functions.Date.DateSubtract.
     /// </summary>
     /// <typeparam name="T">Type of the first source column</typeparam>
     /// <typeparam name="U">Type of the second source column</typeparam>
     /// <typeparam name="V">Type output by the function</typeparam>
     public class SimpleTwoArgumentFunction<T, U, V> : IXColumn
     {
+        public delegate bool BatchFunction(T[] values1, int index1, bool isSingle1, U[] values2, int index2, bool isSingle2, int count, V[] result);
+
         private string _name;
         private IXColumn _column1;
         private IXColumn _column2;
         private Func<T, U, V> _function;
         private Action _beforeBatch;
+        private BatchFunction _batchFunction;
         private V[] _buffer;
         private bool[] _isNull;
 
+        private T[] _contiguousValues1;
+        private bool[] _contiguousNulls1;
+        private U[] _contiguousValues2;
+        private bool[] _contiguousNulls2;
+
         public ColumnDetails ColumnDetails { get; private set; }
 
-        private SimpleTwoArgumentFunction(string name, IXColumn column1, IXColumn column2, Func<T, U, V> function, Action beforeBatch = null)
+        private SimpleTwoArgumentFunction(string name, IXColumn column1, IXColumn column2, Func<T, U, V> function, Action beforeBatch = null, BatchFunction batchFunction = null)
         {
             _name = name;
             _column1 = column1;
             _column2 = column2;
             _function = function;
             _beforeBatch = beforeBatch;
+            _batchFunction = batchFunction;
             this.ColumnDetails = new ColumnDetails(name, typeof(V));
         }
 
-        public static IXColumn Build(string name, IXTable source, IXColumn column1, IXColumn column2, Func<T, U, V> function, Action beforeBatch = null)
+        public static IXColumn Build(string name, IXTable source, IXColumn column1, IXColumn column2, Func<T, U, V> function, Action beforeBatch = null, BatchFunction batchFunction = null)
         {
             if (column1.ColumnDetails.Type != typeof(T)) throw new ArgumentException($"Function required first argument of type {typeof(T).Name}, but argument was {column1.ColumnDetails.Type.Name} instead.");
             if (column2.ColumnDetails.Type != typeof(U)) throw new ArgumentException($"Function required second argument of type {typeof(U).Name}, but argument was {column2.ColumnDetails.Type.Name} instead.");
-            return new SimpleTwoArgumentFunction<T, U, V>(name, column1, column2, function, beforeBatch);
+            return new SimpleTwoArgumentFunction<T, U, V>(name, column1, column2, function, beforeBatch, batchFunction);
         }
 
         public Func<XArray> CurrentGetter()
@@ -107,6 +120,12 @@ namespace XForm.Functions
             Allocator.AllocateToSize(ref _buffer, count);
             Allocator.AllocateToSize(ref _isNull, count);
 
+            // Convert all values at once, if there's a batch function
+            if (_batchFunction != null && TryConvertBatch(xarray1, xarray2, count))
+            {
+                return XArray.All(_buffer, count, MergeNulls(xarray1, xarray2, count));
+            }
+
             // Convert each non-null value
             bool areAnyNull = false;
             T[] array1 = (T[])xarray1.Array;
@@ -126,6 +145,32 @@ namespace XForm.Functions
             return XArray.All(_buffer, count, (areAnyNull ? _isNull : null));
         }
 
+        private bool TryConvertBatch(XArray xarray1, XArray xarray2, int count)
+        {
+            if (xarray1.Selector.Indices != null) xarray1 = xarray1.ToContiguous(ref _contiguousValues1, ref _contiguousNulls1);
+            if (xarray2.Selector.Indices != null) xarray2 = xarray2.ToContiguous(ref _contiguousValues2, ref _contiguousNulls2);
+
+            return _batchFunction(
+                (T[])xarray1.Array, xarray1.Selector.StartIndexInclusive, xarray1.Selector.IsSingleValue,
+                (U[])xarray2.Array, xarray2.Selector.StartIndexInclusive, xarray2.Selector.IsSingleValue,
+                count, _buffer);
+        }
+
+        private bool[] MergeNulls(XArray xarray1, XArray xarray2, int count)
+        {
+            if (!xarray1.HasNulls && !xarray2.HasNulls) return null;
+
+            bool areAnyNull = false;
+            for (int i = 0; i < count; ++i)
+            {
+                bool rowIsNull = (xarray1.HasNulls && xarray1.NullRows[xarray1.Index(i)]) || (xarray2.HasNulls && xarray2.NullRows[xarray2.Index(i)]);
+                areAnyNull |= rowIsNull;
+                _isNull[i] = rowIsNull;
+            }
+
+            return (areAnyNull ? _isNull : null);
+        }
+
         public override string ToString()
         {
             return $"{_name}({_column1}, {_column2})";
@@ -35,6 +35,7 @@ namespace XForm
             _server.AddResponder("download", Download);
             _server.AddResponder("count", CountWithinTimeout);
             _server.AddResponder("save", Save);
+            _server.AddResponder("counters", Counters);
             _server.AddResponder("test", Test);
         }
 
@@ -130,6 +131,36 @@ namespace XForm
             }
         }
 
+        private void Counters(IHttpRequest request, IHttpResponse response)
+        {
+            try
+            {
+                // Turn kernel counters on or off if requested ("counters?on=1"), then return the totals so far
+                string on = request.QueryString["on"];
+                if (!String.IsNullOrEmpty(on)) KernelCounters.Enable(on == "1" || on.Equals("true", StringComparison.OrdinalIgnoreCase));
+
+                KernelCounterSnapshot counters = KernelCounters.Read();
+                using (ITabularWriter writer = WriterForFormat("json", response))
+                {
+                    writer.SetColumns(new string[] { "Kernel", "Calls", "Elements", "Bytes", "Matched", "Cycles" });
+                    for (int kernel = 0; kernel < KernelCounters.KernelNames.Length; ++kernel)
+                    {
+                        writer.Write(String8.Convert(KernelCounters.KernelNames[kernel], new byte[KernelCounters.KernelNames[kernel].Length]));
+                        writer.Write(counters.Calls(kernel));
+                        writer.Write(counters.Elements(kernel));
+                        writer.Write(counters.Bytes(kernel));
+                        writer.Write(counters.Matched(kernel));
+                        writer.Write(counters.Cycles(kernel));
+                        writer.NextRow();
+                    }
+                }
+            }
+            catch (Exception ex)
+            {
+                ReportError(request, response, ex);
+            }
+        }
+
         private void CountWithinTimeout(IHttpRequest request, IHttpResponse response)
         {
             try
@@ -168,14 +199,29 @@ namespace XForm
 
                 // Try to get the count up to the timeout
                 if (Debugger.IsAttached) timeout = TimeSpan.MaxValue;
+                KernelCounterSnapshot countersBefore = (KernelCounters.IsEnabled ? KernelCounters.Read() : null);
                 RunResult result = pipeline.RunUntilTimeout(timeout);
 
                 using (ITabularWriter writer = WriterForFormat("json", response))
                 {
-                    writer.SetColumns(new string[] { "Count", "IsComplete", "RuntimeMs" });
-                    writer.Write(result.RowCount);
-                    writer.Write(result.IsComplete);
-                    writer.Write((int)result.Elapsed.TotalMilliseconds);
+                    // Include the time in each native kernel, if counting (includes other queries running at the same time)
+                    if (countersBefore != null)
+                    {
+                        string kernels = KernelCounters.Read().Subtract(countersBefore).ToString().Replace(Environment.NewLine, "; ");
+                        writer.SetColumns(new string[] { "Count", "IsComplete", "RuntimeMs", "Kernels" });
+                        writer.Write(result.RowCount);
+                        writer.Write(result.IsComplete);
+                        writer.Write((int)result.Elapsed.TotalMilliseconds);
+                        writer.Write(String8.Convert(kernels, new byte[String8.GetLength(kernels)]));
+                    }
+                    else
+                    {
+                        writer.SetColumns(new string[] { "Count", "IsComplete", "RuntimeMs" });
+                        writer.Write(result.RowCount);
+                        writer.Write(result.IsComplete);
+                        writer.Write((int)result.Elapsed.TotalMilliseconds);
+                    }
+
                     writer.NextRow();
                 }
             }
@@ -29,6 +29,9 @@ namespace XForm.IO
         private Type _indicesType;
         private bool _loadedIndicesType;
 
+        private ZoneMap _zoneMap;
+        private bool _loadedZoneMap;
+
         public ColumnDetails ColumnDetails { get; private set; }
 
         public BinaryReaderColumn(BinaryTableReader table, ColumnDetails details, IStreamProvider streamProvider)
@@ -69,6 +72,30 @@ namespace XForm.IO
 
                 return () => reader.ReadRaw(_table.CurrentSelector);
             }
+            else if (componentName.Equals(ColumnComponent.ZoneMap))
+            {
+                // Load the zone map, if this column has one, without opening the column values
+                if (!_loadedZoneMap)
+                {
+                    _zoneMap = ZoneMap.TryRead(_streamProvider, ColumnDetails.Type, Path.Combine(_table.TablePath, ColumnDetails.Name), _table.Count);
+                    _loadedZoneMap = true;
+                }
+
+                if (_zoneMap == null) return null;
+                return () => new ZoneMapPage(_zoneMap, _table.CurrentSelector);
+            }
+            else if (componentName.Equals(ColumnComponent.ColumnMemory))
+            {
+                // Return the whole column, if it's mapped or cached as one array of values (not enum, packed, or nullable)
+                if (IndicesType != null) return null;
+
+                GetReader();
+                IColumnMemoryReader reader = _columnReader as IColumnMemoryReader;
+                ColumnMemory memory = (reader == null ? null : reader.TryGetMemory());
+                if (memory == null || memory.Type != ColumnDetails.Type || memory.Count < _table.Count) return null;
+
+                return () => memory;
+            }
 
             return null;
         }
@@ -135,6 +162,7 @@ namespace XForm.IO
     {
         private TableMetadata _metadata;
         private BinaryReaderColumn[] _columns;
+        private ReadAheadStreamProvider _readAheadProvider;
 
         private ArraySelector _currentSelector;
         private ArraySelector _currentEnumerateSelector;
@@ -143,6 +171,15 @@ namespace XForm.IO
         {
             TablePath = tableRootPath;
             _metadata = TableMetadataSerializer.Read(streamProvider, tableRootPath);
+            if (_metadata.RowCount > int.MaxValue) throw new IOException($"Table partition \"{tableRootPath}\" has {_metadata.RowCount:n0} rows, but partitions may have at most {int.MaxValue:n0}. Rewrite the table to split it into partitions.");
+
+            // Read ahead column streams with this reader's own CancellationToken, set from each Next call
+            _readAheadProvider = streamProvider as ReadAheadStreamProvider;
+            if (_readAheadProvider != null)
+            {
+                _readAheadProvider = _readAheadProvider.ForReader();
+                streamProvider = _readAheadProvider;
+            }
 
             // Construct columns (files aren't opened until columns are subscribed to)
             _columns = new BinaryReaderColumn[_metadata.Schema.Count];
@@ -176,10 +213,13 @@ namespace XForm.IO
         public string TablePath { get; private set; }
         public string Query => _metadata.Query;
         public int Count => (int)_metadata.RowCount;
+        public long RowCount => _metadata.RowCount;
         public int CurrentRowCount { get; private set; }
 
         public int Next(int desiredCount, CancellationToken cancellationToken)
         {
+            if (_readAheadProvider != null) _readAheadProvider.CancellationToken = cancellationToken;
+
             _currentEnumerateSelector = _currentEnumerateSelector.NextPage(Count, desiredCount);
             _currentSelector = _currentEnumerateSelector;
             CurrentRowCount = _currentEnumerateSelector.Count;
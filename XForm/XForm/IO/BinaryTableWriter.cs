@@ -146,15 +146,22 @@ namespace XForm.IO
     {
         /// <summary>
         ///  File Size limit for each individual column file.
-        ///  2GB because XForm uses integers for row indices and to seek in streams, and so XForm can allocate arrays to hold cached files whole.
+        ///  2GB so XForm can allocate arrays to hold cached files whole and String8 positions fit in integers.
         ///  This may be lowered later to accomodate ideal sizes for cloud storage.
         /// </summary>
         public static long ColumnFileSizeLimit = (long)int.MaxValue;
 
+        /// <summary>
+        ///  Row limit for each partition. Pages and row indices within a partition are integers, so larger tables
+        ///  are split into partitions automatically; the table row count and positions across partitions are 64-bit.
+        /// </summary>
+        public static long PartitionRowLimit = (long)int.MaxValue;
+
         public TableMetadata Metadata { get; private set; }
         private XDatabaseContext _xDatabaseContext;
         private string _tableRootPath;
         private IColumnWriter[] _writers;
+        private IZoneMapWriter[] _zoneMapWriters;
 
         private Func<XArray>[] _getters;
         private XArray[] _currentArrays;
@@ -197,6 +204,7 @@ namespace XForm.IO
 
             int columnCount = _source.Columns.Count;
             _writers = new IColumnWriter[columnCount];
+            _zoneMapWriters = new IZoneMapWriter[columnCount];
 
             for (int i = 0; i < columnCount; ++i)
             {
@@ -207,6 +215,9 @@ namespace XForm.IO
                 _writers[i] = TypeProviderFactory.TryGetColumnWriter(_xDatabaseContext.StreamProvider, column.Type, columnPath);
                 if (_writers[i] == null) throw new ArgumentException($"No writer or String8 converter for {column.Type.Name} was available. Could not build column writer.");
 
+                // Track per-block minimum, maximum, and null count for ordered types, so queries can skip blocks
+                _zoneMapWriters[i] = ZoneMap.TryGetWriter(_xDatabaseContext.StreamProvider, column.Type, columnPath);
+
                 // If the column was converted to String8, write String8 in the schema
                 if (column.Type != typeof(String8) && _writers[i].WritingAsType == typeof(String8))
                 {
@@ -247,6 +258,10 @@ namespace XForm.IO
         {
             if (_writers == null) BuildWriters();
 
+            // Write only the rows which fit under the partition row limit
+            long rowsLeft = PartitionRowLimit - Metadata.RowCount;
+            if (arrays[0].Count > rowsLeft) arrays = arrays.Select((array) => array.Slice(0, (int)rowsLeft)).ToArray();
+
             int countWritten = arrays[0].Count;
 
             // Try to write all rows
@@ -278,6 +293,7 @@ namespace XForm.IO
                 for (int i = 0; i < _writers.Length; ++i)
                 {
                     _writers[i].Append(arrays[i]);
+                    if (_zoneMapWriters[i] != null) _zoneMapWriters[i].Append(arrays[i]);
                 }
             }
             else
@@ -285,6 +301,7 @@ namespace XForm.IO
                 Parallel.For(0, _writers.Length, (i) =>
                 {
                     _writers[i].Append(arrays[i]);
+                    if (_zoneMapWriters[i] != null) _zoneMapWriters[i].Append(arrays[i]);
                 });
             }
 
@@ -326,6 +343,13 @@ namespace XForm.IO
 
                 _writers = null;
 
+                foreach (IZoneMapWriter writer in _zoneMapWriters)
+                {
+                    if (writer != null) writer.Dispose();
+                }
+
+                _zoneMapWriters = null;
+
                 // Write the schema and query only if the table was valid
                 if (Metadata.RowCount > 0)
                 {
@@ -55,7 +55,7 @@ namespace XForm.IO
     /// <summary>
     ///  CachedColumnReader implements IColumnReader for a column already retrieved into a single complete array.
     /// </summary>
-    public class CachedColumnReader : IColumnReader
+    public class CachedColumnReader : IColumnReader, IColumnMemoryReader
     {
         private XArray _column;
         private int[] _remapArray;
@@ -69,12 +69,33 @@ namespace XForm.IO
         {
             using (inner)
             {
-                _column = inner.Read(ArraySelector.All(inner.Count));
+                // Readers return their pages to the BufferPool when disposed, so keep copies of them
+                XArray column = inner.Read(ArraySelector.All(inner.Count));
+                _column = column.ReplaceValues(CopyOf(column.Array, column.Selector), (bool[])CopyOf(column.NullRows, column.Selector));
             }
         }
 
+        private static Array CopyOf(Array array, ArraySelector selector)
+        {
+            if (array == null) return null;
+
+            // Contiguous selectors only need the values up to the end of the selector
+            int length = (selector.Indices != null ? array.Length : Math.Min(array.Length, selector.EndIndexExclusive));
+            Array copy = Array.CreateInstance(array.GetType().GetElementType(), length);
+            Array.Copy(array, copy, length);
+            return copy;
+        }
+
         public int Count => _column.Count;
 
+        public ColumnMemory TryGetMemory()
+        {
+            // The cached array can be read in place if it's the values from the start, without nulls
+            if (_column.HasNulls || _column.Selector.Indices != null || _column.Selector.IsSingleValue || _column.Selector.StartIndexInclusive != 0) return null;
+            if (_column.Array == null || !_column.Array.GetType().GetElementType().IsPrimitive) return null;
+            return new ColumnMemory(_column.Array, _column.Count);
+        }
+
         public XArray Read(ArraySelector selector)
         {
             return _column.Select(selector, ref _remapArray);
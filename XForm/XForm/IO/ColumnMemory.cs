@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+namespace XForm.IO
+{
+    /// <summary>
+    ///  ColumnMemory is a whole column of primitive values without nulls which is already in memory, either as a
+    ///  memory-mapped values file (Address) or a cached array (Array). Whole-column kernels read it in place
+    ///  rather than paging copies of it through the pipeline. It's valid while the column reader which returned it is open.
+    /// </summary>
+    public class ColumnMemory
+    {
+        public Type Type { get; private set; }
+        public int Count { get; private set; }
+        public IntPtr Address { get; private set; }
+        public Array Array { get; private set; }
+
+        public ColumnMemory(Type type, int count, IntPtr address)
+        {
+            Type = type;
+            Count = count;
+            Address = address;
+        }
+
+        public ColumnMemory(Array array, int count)
+        {
+            Type = array.GetType().GetElementType();
+            Count = count;
+            Array = array;
+        }
+    }
+
+    /// <summary>
+    ///  IColumnMemoryReader is implemented by column readers which may be able to return the whole column in memory.
+    /// </summary>
+    public interface IColumnMemoryReader
+    {
+        /// <summary>
+        ///  Return the whole column in memory, or null if it isn't available in one piece.
+        /// </summary>
+        ColumnMemory TryGetMemory();
+    }
+}
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.IO;
+
+namespace XForm.IO
+{
+    /// <summary>
+    ///  MappedFileStream is a read-only Stream over a memory-mapped file.
+    ///  Readers which know about it (PrimitiveArrayReader) copy column pages from the
+    ///  mapping straight into their typed arrays, skipping the FileStream buffer and the
+    ///  intermediate byte[] page. Sequential reads prefetch ahead, so repeated scans are
+    ///  served from the OS page cache.
+    /// </summary>
+    public class MappedFileStream : Stream
+    {
+        public delegate IntPtr OpenSignature(string filePath, ref long length);
+        public delegate void ReadSignature(IntPtr file, long byteOffset, Array target, int targetByteIndex, int byteCount);
+
+        internal static OpenSignature s_OpenNative;
+        internal static ReadSignature s_ReadNative;
+        internal static Action<IntPtr> s_FreeNative;
+        internal static Func<IntPtr, IntPtr> s_AddressNative;
+
+        private IntPtr _file;
+        private long _length;
+        private long _position;
+
+        /// <summary>
+        ///  Return whether files can be mapped (the native accelerator is enabled).
+        /// </summary>
+        public static bool IsAvailable => (s_OpenNative != null);
+
+        public MappedFileStream(string filePath)
+        {
+            if (!IsAvailable) throw new InvalidOperationException("MappedFileStream requires the NativeAccelerator to be enabled.");
+            _file = s_OpenNative(filePath, ref _length);
+        }
+
+        /// <summary>
+        ///  Address of the start of the mapping, for kernels which read the whole file in place. Valid until the stream is disposed.
+        /// </summary>
+        public IntPtr Address
+        {
+            get
+            {
+                if (_file == IntPtr.Zero) return IntPtr.Zero;
+                return s_AddressNative(_file);
+            }
+        }
+
+        public override bool CanRead => true;
+        public override bool CanSeek => true;
+        public override bool CanWrite => false;
+        public override long Length => _length;
+
+        public override long Position
+        {
+            get { return _position; }
+            set { Seek(value, SeekOrigin.Begin); }
+        }
+
+        /// <summary>
+        ///  Copy byteCount bytes at byteOffset in the file directly into any primitive array.
+        /// </summary>
+        public void Read(long byteOffset, Array target, int targetByteIndex, int byteCount)
+        {
+            if (byteCount == 0) return;
+            if (_file == IntPtr.Zero) throw new ObjectDisposedException(nameof(MappedFileStream));
+            s_ReadNative(_file, byteOffset, target, targetByteIndex, byteCount);
+        }
+
+        public override int Read(byte[] buffer, int offset, int count)
+        {
+            int countToRead = (int)Math.Max(0, Math.Min(count, _length - _position));
+            Read(_position, buffer, offset, countToRead);
+            _position += countToRead;
+            return countToRead;
+        }
+
+        public override long Seek(long offset, SeekOrigin origin)
+        {
+            long position = offset;
+            if (origin == SeekOrigin.Current) position += _position;
+            if (origin == SeekOrigin.End) position += _length;
+            if (position < 0) throw new IOException("Seek before the beginning of the file.");
+
+            _position = position;
+            return _position;
+        }
+
+        public override void Flush()
+        { }
+
+        public override void SetLength(long value)
+        {
+            throw new NotSupportedException();
+        }
+
+        public override void Write(byte[] buffer, int offset, int count)
+        {
+            throw new NotSupportedException();
+        }
+
+        protected override void Dispose(bool disposing)
+        {
+            if (_file != IntPtr.Zero)
+            {
+                s_FreeNative(_file);
+                _file = IntPtr.Zero;
+            }
+
+            base.Dispose(disposing);
+        }
+
+        ~MappedFileStream()
+        {
+            Dispose(false);
+        }
+    }
+}
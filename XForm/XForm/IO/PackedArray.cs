@@ -0,0 +1,597 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+
+using XForm.Data;
+using XForm.Types;
+
+namespace XForm.IO
+{
+    internal enum PackedEncoding : byte
+    {
+        BitPacked = 0,
+        Delta = 1,
+        RunLength = 2
+    }
+
+    /// <summary>
+    ///  PackedArray stores int and long columns in blocks of BlockRowCount rows, each encoded in whichever
+    ///  of three lightweight encodings is smallest for the block:
+    ///   - BitPacked: Frame of Reference; each value minus the block minimum, packed in the fewest bits.
+    ///   - Delta: For non-decreasing blocks; the first value, then each difference minus the smallest difference, bit-packed.
+    ///   - RunLength: The value of each run, bit-packed, then the (exclusive) end row of each run, bit-packed.
+    ///
+    ///  Packed columns are written to "V.i32.pk.bin" or "V.i64.pk.bin" instead of "V.i32.bin" or "V.i64.bin".
+    ///  Block Format: [32 byte header] [WordCount ulongs of packed values]
+    ///  File Format: [Blocks] [long offset of each block] [int RowCount] [int BlockCount]
+    /// </summary>
+    public static class PackedArray
+    {
+        public const int BlockRowCount = 65536;
+        internal const int BlockHeaderBytes = 32;
+
+        // Set to write int and long columns packed. Packed columns are read whether or not this is set.
+        public static bool IsEnabled = false;
+
+        internal delegate void UnpackSignature<T>(ulong[] words, int wordIndex, int bitWidth, long baseValue, int count, T[] target, int targetIndex);
+        internal delegate void UnpackDeltaSignature<T>(ulong[] words, int wordIndex, int bitWidth, long firstValue, long deltaBase, int count, T[] target, int targetIndex);
+
+        internal static UnpackSignature<int> s_UnpackInt32Native;
+        internal static UnpackSignature<long> s_UnpackInt64Native;
+        internal static UnpackDeltaSignature<int> s_UnpackDeltaInt32Native;
+        internal static UnpackDeltaSignature<long> s_UnpackDeltaInt64Native;
+
+        public static bool IsSupported(Type type)
+        {
+            return type == typeof(int) || type == typeof(long);
+        }
+
+        public static string PackedFilePath(string valuesFilePath)
+        {
+            // V.i32.bin -> V.i32.pk.bin
+            return Path.ChangeExtension(valuesFilePath, ".pk.bin");
+        }
+
+        internal static int BitsRequired(ulong range)
+        {
+            int bits = 0;
+            while (range != 0)
+            {
+                bits++;
+                range >>= 1;
+            }
+
+            return bits;
+        }
+
+        internal static int WordsRequired(int count, int bitWidth)
+        {
+            return (int)(((long)count * bitWidth + 63) / 64);
+        }
+
+        /// <summary>
+        ///  Pack value (which must fit in bitWidth bits) as the index'th value in words after wordIndex.
+        ///  The words must be zeroed before packing.
+        /// </summary>
+        internal static void Pack(ulong value, int bitWidth, int index, ulong[] words, int wordIndex)
+        {
+            if (bitWidth == 0) return;
+
+            long bit = (long)index * bitWidth;
+            int word = wordIndex + (int)(bit >> 6);
+            int shift = (int)(bit & 63);
+
+            words[word] |= value << shift;
+            if (shift + bitWidth > 64) words[word + 1] |= value >> (64 - shift);
+        }
+
+        private static ulong UnpackOne(ulong[] words, int wordIndex, int bitWidth, ulong mask, int index)
+        {
+            long bit = (long)index * bitWidth;
+            int word = wordIndex + (int)(bit >> 6);
+            int shift = (int)(bit & 63);
+
+            ulong value = words[word] >> shift;
+            if (shift + bitWidth > 64) value |= words[word + 1] << (64 - shift);
+            return value & mask;
+        }
+
+        private static ulong Mask(int bitWidth)
+        {
+            return (bitWidth == 64 ? ulong.MaxValue : (1UL << bitWidth) - 1);
+        }
+
+        /// <summary>
+        ///  Set target[targetIndex + i] = baseValue + [i'th bitWidth-bit value in words after wordIndex] for i in [0, count).
+        /// </summary>
+        internal static void Unpack<T>(ulong[] words, int wordIndex, int bitWidth, long baseValue, int count, T[] target, int targetIndex)
+        {
+            int[] intTarget = (object)target as int[];
+            if (intTarget != null)
+            {
+                if (s_UnpackInt32Native != null)
+                {
+                    s_UnpackInt32Native(words, wordIndex, bitWidth, baseValue, count, intTarget, targetIndex);
+                    return;
+                }
+
+                ulong mask = Mask(bitWidth);
+                for (int i = 0; i < count; ++i)
+                {
+                    intTarget[targetIndex + i] = (int)(baseValue + (long)(bitWidth == 0 ? 0 : UnpackOne(words, wordIndex, bitWidth, mask, i)));
+                }
+            }
+            else
+            {
+                long[] longTarget = (long[])(object)target;
+                if (s_UnpackInt64Native != null)
+                {
+                    s_UnpackInt64Native(words, wordIndex, bitWidth, baseValue, count, longTarget, targetIndex);
+                    return;
+                }
+
+                ulong mask = Mask(bitWidth);
+                for (int i = 0; i < count; ++i)
+                {
+                    longTarget[targetIndex + i] = baseValue + (long)(bitWidth == 0 ? 0 : UnpackOne(words, wordIndex, bitWidth, mask, i));
+                }
+            }
+        }
+
+        /// <summary>
+        ///  Decode count delta-encoded values into target at targetIndex. The first value is firstValue, and each
+        ///  next value is the previous plus deltaBase plus the next bitWidth-bit value in words after wordIndex.
+        /// </summary>
+        internal static void UnpackDelta<T>(ulong[] words, int wordIndex, int bitWidth, long firstValue, long deltaBase, int count, T[] target, int targetIndex)
+        {
+            int[] intTarget = (object)target as int[];
+            if (intTarget != null && s_UnpackDeltaInt32Native != null)
+            {
+                s_UnpackDeltaInt32Native(words, wordIndex, bitWidth, firstValue, deltaBase, count, intTarget, targetIndex);
+                return;
+            }
+
+            long[] longTarget = (object)target as long[];
+            if (longTarget != null && s_UnpackDeltaInt64Native != null)
+            {
+                s_UnpackDeltaInt64Native(words, wordIndex, bitWidth, firstValue, deltaBase, count, longTarget, targetIndex);
+                return;
+            }
+
+            ulong mask = Mask(bitWidth);
+            long current = firstValue;
+            for (int i = 0; i < count; ++i)
+            {
+                if (i > 0) current += deltaBase + (long)(bitWidth == 0 ? 0 : UnpackOne(words, wordIndex, bitWidth, mask, i - 1));
+
+                if (intTarget != null)
+                {
+                    intTarget[targetIndex + i] = (int)current;
+                }
+                else
+                {
+                    longTarget[targetIndex + i] = current;
+                }
+            }
+        }
+    }
+
+    public class PackedArrayReader<T> : IColumnReader
+    {
+        private Stream _stream;
+        private BinaryReader _reader;
+        private MappedFileStream _mappedStream;
+
+        private int _count;
+        private long[] _blockOffsets;
+
+        private byte[] _bytesBuffer;
+        private ulong[] _words;
+        private T[] _runValues;
+        private int[] _runEnds;
+
+        private T[] _block;
+        private int _blockIndex;
+        private int _blockCount;
+
+        private bool[] _blocksNeeded;
+
+        private T[] _array;
+        private XArray _currentArray;
+        private ArraySelector _currentSelector;
+
+        public PackedArrayReader(Stream stream)
+        {
+            if (!PackedArray.IsSupported(typeof(T))) throw new ArgumentException($"PackedArrayReader does not support type {typeof(T).Name}.");
+
+            _stream = stream;
+            _reader = new BinaryReader(stream);
+            _mappedStream = stream as MappedFileStream;
+
+            // Read the row count, block count, and block offsets from the end of the file
+            _stream.Seek(-8, SeekOrigin.End);
+            _count = _reader.ReadInt32();
+            int blockCount = _reader.ReadInt32();
+
+            _blockOffsets = new long[blockCount];
+            _stream.Seek(-8 - 8L * blockCount, SeekOrigin.End);
+            for (int i = 0; i < blockCount; ++i)
+            {
+                _blockOffsets[i] = _reader.ReadInt64();
+            }
+
+            _blockIndex = -1;
+        }
+
+        public int Count => _count;
+
+        public XArray Read(ArraySelector selector)
+        {
+            if (selector.Indices != null) return ReadIndices(selector);
+            if (selector.EndIndexExclusive > _count) throw new ArgumentOutOfRangeException("selector");
+
+            // Return the previous xarray if re-requested
+            if (selector.Equals(_currentSelector)) return _currentArray;
+
+            Allocator.RentToSize(ref _array, selector.Count);
+
+            // Decode each block the rows are in and copy the rows out
+            int row = selector.StartIndexInclusive;
+            while (row < selector.EndIndexExclusive)
+            {
+                int blockIndex = row / PackedArray.BlockRowCount;
+                int blockStart = blockIndex * PackedArray.BlockRowCount;
+                DecodeBlock(blockIndex);
+
+                int end = Math.Min(selector.EndIndexExclusive, blockStart + _blockCount);
+                if (end <= row) throw new IOException($"Packed block {blockIndex} is missing rows.");
+
+                Array.Copy(_block, row - blockStart, _array, row - selector.StartIndexInclusive, end - row);
+                row = end;
+            }
+
+            // Cache and return the current xarray
+            _currentArray = XArray.All(_array, selector.Count);
+            _currentSelector = selector;
+            return _currentArray;
+        }
+
+        private XArray ReadIndices(ArraySelector selector)
+        {
+            Allocator.RentToSize(ref _array, selector.Count);
+            Allocator.AllocateToSize(ref _blocksNeeded, _blockOffsets.Length);
+            Array.Clear(_blocksNeeded, 0, _blockOffsets.Length);
+
+            // Find the blocks covering the rows
+            int[] indices = selector.Indices;
+            int indicesEnd = selector.EndIndexExclusive;
+            for (int i = selector.StartIndexInclusive; i < indicesEnd; ++i)
+            {
+                int row = indices[i];
+                if (row < 0 || row >= _count) throw new ArgumentOutOfRangeException("selector");
+                _blocksNeeded[row / PackedArray.BlockRowCount] = true;
+            }
+
+            // Decode each covering block once (the currently decoded one first) and gather the rows in it
+            if (_blockIndex != -1 && _blocksNeeded[_blockIndex]) GatherFromBlock(selector);
+
+            for (int blockIndex = 0; blockIndex < _blockOffsets.Length; ++blockIndex)
+            {
+                if (!_blocksNeeded[blockIndex]) continue;
+
+                DecodeBlock(blockIndex);
+                GatherFromBlock(selector);
+            }
+
+            // Cache and return the current xarray
+            _currentArray = XArray.All(_array, selector.Count);
+            _currentSelector = selector;
+            return _currentArray;
+        }
+
+        private void GatherFromBlock(ArraySelector selector)
+        {
+            int[] indices = selector.Indices;
+            int indicesStart = selector.StartIndexInclusive;
+            int blockStart = _blockIndex * PackedArray.BlockRowCount;
+
+            for (int i = 0; i < selector.Count; ++i)
+            {
+                int rowInBlock = indices[indicesStart + i] - blockStart;
+                if ((uint)rowInBlock < (uint)PackedArray.BlockRowCount)
+                {
+                    if (rowInBlock >= _blockCount) throw new IOException($"Packed block {_blockIndex} is missing rows.");
+                    _array[i] = _block[rowInBlock];
+                }
+            }
+
+            _blocksNeeded[_blockIndex] = false;
+        }
+
+        private void DecodeBlock(int blockIndex)
+        {
+            if (blockIndex == _blockIndex) return;
+
+            long offset = _blockOffsets[blockIndex];
+            _stream.Seek(offset, SeekOrigin.Begin);
+
+            PackedEncoding encoding = (PackedEncoding)_reader.ReadByte();
+            int bitWidth = _reader.ReadByte();
+            int endWidth = _reader.ReadByte();
+            _reader.ReadByte();
+            int rowCount = _reader.ReadInt32();
+            int runCount = _reader.ReadInt32();
+            int wordCount = _reader.ReadInt32();
+            long baseValue = _reader.ReadInt64();
+            long deltaBase = _reader.ReadInt64();
+
+            ReadWords(offset + PackedArray.BlockHeaderBytes, wordCount);
+            Allocator.RentToSize(ref _block, rowCount);
+
+            switch (encoding)
+            {
+                case PackedEncoding.BitPacked:
+                    PackedArray.Unpack(_words, 0, bitWidth, baseValue, rowCount, _block, 0);
+                    break;
+                case PackedEncoding.Delta:
+                    PackedArray.UnpackDelta(_words, 0, bitWidth, baseValue, deltaBase, rowCount, _block, 0);
+                    break;
+                case PackedEncoding.RunLength:
+                    Allocator.RentToSize(ref _runValues, runCount);
+                    Allocator.RentToSize(ref _runEnds, runCount);
+                    PackedArray.Unpack(_words, 0, bitWidth, baseValue, runCount, _runValues, 0);
+                    PackedArray.Unpack(_words, PackedArray.WordsRequired(runCount, bitWidth), endWidth, 0, runCount, _runEnds, 0);
+
+                    int start = 0;
+                    for (int run = 0; run < runCount; ++run)
+                    {
+                        T value = _runValues[run];
+                        for (int i = start; i < _runEnds[run]; ++i)
+                        {
+                            _block[i] = value;
+                        }
+
+                        start = _runEnds[run];
+                    }
+                    break;
+                default:
+                    throw new IOException($"Packed block {blockIndex} has unknown encoding {encoding}.");
+            }
+
+            _blockIndex = blockIndex;
+            _blockCount = rowCount;
+        }
+
+        private void ReadWords(long byteOffset, int wordCount)
+        {
+            Allocator.RentToSize(ref _words, wordCount);
+            int byteCount = 8 * wordCount;
+
+            if (_mappedStream != null)
+            {
+                // If the file is memory-mapped, copy the words directly from the mapping
+                _mappedStream.Read(byteOffset, _words, 0, byteCount);
+                return;
+            }
+
+            Allocator.RentToSize(ref _bytesBuffer, byteCount);
+
+            int bytesRead = 0;
+            while (bytesRead < byteCount)
+            {
+                int lengthRead = _stream.Read(_bytesBuffer, bytesRead, byteCount - bytesRead);
+                if (lengthRead == 0) throw new IOException("Packed block ended unexpectedly.");
+                bytesRead += lengthRead;
+            }
+
+            Buffer.BlockCopy(_bytesBuffer, 0, _words, 0, byteCount);
+        }
+
+        public void Dispose()
+        {
+            if (_reader != null)
+            {
+                _reader.Dispose();
+                _reader = null;
+                _stream = null;
+            }
+
+            Allocator.Return(ref _bytesBuffer);
+            Allocator.Return(ref _words);
+            Allocator.Return(ref _runValues);
+            Allocator.Return(ref _runEnds);
+            Allocator.Return(ref _block);
+            Allocator.Return(ref _array);
+        }
+    }
+
+    public class PackedArrayWriter<T> : IColumnWriter
+    {
+        private int _bytesPerItem;
+        private BinaryWriter _writer;
+        private long _bytesWritten;
+        private int _rowCount;
+        private List<long> _blockOffsets;
+
+        private long[] _block;
+        private int _blockCount;
+
+        private ulong[] _words;
+        private byte[] _bytesBuffer;
+
+        public PackedArrayWriter(Stream stream)
+        {
+            if (!PackedArray.IsSupported(typeof(T))) throw new ArgumentException($"PackedArrayWriter does not support type {typeof(T).Name}.");
+
+            _writer = new BinaryWriter(stream);
+            _bytesPerItem = (typeof(T) == typeof(int) ? 4 : 8);
+            _blockOffsets = new List<long>();
+            Allocator.RentToSize(ref _block, PackedArray.BlockRowCount);
+        }
+
+        public Type WritingAsType => typeof(T);
+
+        public bool CanAppend(XArray xarray)
+        {
+            // Limit by the unpacked size, so that packed and unpacked tables split into the same files
+            return (_bytesPerItem * ((long)_rowCount + xarray.Count)) <= BinaryTableWriter.ColumnFileSizeLimit;
+        }
+
+        public void Append(XArray xarray)
+        {
+            int[] intArray = xarray.Array as int[];
+            long[] longArray = xarray.Array as long[];
+
+            for (int i = 0; i < xarray.Count; ++i)
+            {
+                int index = xarray.Index(i);
+                _block[_blockCount++] = (intArray != null ? intArray[index] : longArray[index]);
+                if (_blockCount == PackedArray.BlockRowCount) WriteBlock();
+            }
+
+            _rowCount += xarray.Count;
+        }
+
+        private void WriteBlock()
+        {
+            int count = _blockCount;
+
+            // Find the range, whether the values are non-decreasing, and how many runs there are
+            long min = _block[0];
+            long max = _block[0];
+            bool isNonDecreasing = true;
+            int runCount = 1;
+            for (int i = 1; i < count; ++i)
+            {
+                long value = _block[i];
+                if (value < min) min = value;
+                if (value > max) max = value;
+                if (value < _block[i - 1]) isNonDecreasing = false;
+                if (value != _block[i - 1]) runCount++;
+            }
+
+            // Bit-Packing from the minimum
+            PackedEncoding encoding = PackedEncoding.BitPacked;
+            int bitWidth = PackedArray.BitsRequired(unchecked((ulong)max - (ulong)min));
+            int wordCount = PackedArray.WordsRequired(count, bitWidth);
+
+            // Delta, if the values never decrease
+            ulong minDelta = 0;
+            if (isNonDecreasing && count > 1)
+            {
+                minDelta = ulong.MaxValue;
+                ulong maxDelta = 0;
+                for (int i = 1; i < count; ++i)
+                {
+                    ulong delta = unchecked((ulong)_block[i] - (ulong)_block[i - 1]);
+                    if (delta < minDelta) minDelta = delta;
+                    if (delta > maxDelta) maxDelta = delta;
+                }
+
+                int deltaWidth = PackedArray.BitsRequired(maxDelta - minDelta);
+                int deltaWordCount = PackedArray.WordsRequired(count - 1, deltaWidth);
+                if (deltaWordCount < wordCount)
+                {
+                    encoding = PackedEncoding.Delta;
+                    bitWidth = deltaWidth;
+                    wordCount = deltaWordCount;
+                }
+            }
+
+            // Run-Length, if there are few enough runs
+            int valueWidth = PackedArray.BitsRequired(unchecked((ulong)max - (ulong)min));
+            int endWidth = PackedArray.BitsRequired((ulong)count);
+            int runLengthWordCount = PackedArray.WordsRequired(runCount, valueWidth) + PackedArray.WordsRequired(runCount, endWidth);
+            if (runLengthWordCount < wordCount)
+            {
+                encoding = PackedEncoding.RunLength;
+                bitWidth = valueWidth;
+                wordCount = runLengthWordCount;
+            }
+
+            // Pack the values
+            Allocator.RentToSize(ref _words, wordCount);
+            Array.Clear(_words, 0, wordCount);
+
+            long baseValue = min;
+            long deltaBase = 0;
+            switch (encoding)
+            {
+                case PackedEncoding.BitPacked:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        PackedArray.Pack(unchecked((ulong)_block[i] - (ulong)min), bitWidth, i, _words, 0);
+                    }
+                    break;
+                case PackedEncoding.Delta:
+                    baseValue = _block[0];
+                    deltaBase = unchecked((long)minDelta);
+                    for (int i = 1; i < count; ++i)
+                    {
+                        PackedArray.Pack(unchecked((ulong)_block[i] - (ulong)_block[i - 1] - minDelta), bitWidth, i - 1, _words, 0);
+                    }
+                    break;
+                case PackedEncoding.RunLength:
+                    int endsWordIndex = PackedArray.WordsRequired(runCount, bitWidth);
+                    int run = 0;
+                    for (int i = 1; i <= count; ++i)
+                    {
+                        if (i == count || _block[i] != _block[i - 1])
+                        {
+                            PackedArray.Pack(unchecked((ulong)_block[i - 1] - (ulong)min), bitWidth, run, _words, 0);
+                            PackedArray.Pack((ulong)i, endWidth, run, _words, endsWordIndex);
+                            run++;
+                        }
+                    }
+                    break;
+            }
+
+            // Write the header and packed words
+            _blockOffsets.Add(_bytesWritten);
+            _writer.Write((byte)encoding);
+            _writer.Write((byte)bitWidth);
+            _writer.Write((byte)(encoding == PackedEncoding.RunLength ? endWidth : 0));
+            _writer.Write((byte)0);
+            _writer.Write(count);
+            _writer.Write(encoding == PackedEncoding.RunLength ? runCount : 0);
+            _writer.Write(wordCount);
+            _writer.Write(baseValue);
+            _writer.Write(deltaBase);
+
+            int byteCount = 8 * wordCount;
+            Allocator.RentToSize(ref _bytesBuffer, byteCount);
+            Buffer.BlockCopy(_words, 0, _bytesBuffer, 0, byteCount);
+            _writer.Write(_bytesBuffer, 0, byteCount);
+
+            _bytesWritten += PackedArray.BlockHeaderBytes + byteCount;
+            _blockCount = 0;
+        }
+
+        public void Dispose()
+        {
+            if (_writer != null)
+            {
+                if (_blockCount > 0) WriteBlock();
+
+                // Write the block offsets, row count, and block count
+                foreach (long offset in _blockOffsets)
+                {
+                    _writer.Write(offset);
+                }
+
+                _writer.Write(_rowCount);
+                _writer.Write(_blockOffsets.Count);
+
+                _writer.Dispose();
+                _writer = null;
+            }
+
+            Allocator.Return(ref _block);
+            Allocator.Return(ref _words);
+            Allocator.Return(ref _bytesBuffer);
+        }
+    }
+}
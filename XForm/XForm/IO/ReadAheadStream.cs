@@ -0,0 +1,257 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Concurrent;
+using System.IO;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace XForm.IO
+{
+    /// <summary>
+    ///  ReadAheadStream reads (and decompresses, if the inner stream does) the next chunks of a stream on a
+    ///  background thread while the query thread works on the current ones.
+    ///
+    ///  At most ChunkCount chunks are read ahead. The chunk buffers are reused for the life of the stream and then returned to the BufferPool.
+    ///  Sequential reads (including Seeks to the current position, as column readers do for every page) are served
+    ///  from the chunks. Other Seeks stop the background read, then restart it at the new position.
+    ///
+    ///  Reads waiting for a chunk are cancelled by the token from the cancellation token getter, which is checked on each wait,
+    ///  so that one stream can serve successive queries. If the inner stream fails, that read and every later one throw.
+    /// </summary>
+    public class ReadAheadStream : Stream
+    {
+        public const int DefaultChunkSize = 1024 * 1024;
+        public const int DefaultChunkCount = 4;
+
+        private class Chunk
+        {
+            public byte[] Buffer;
+            public int Count;
+            public Exception Error;
+        }
+
+        private Stream _inner;
+        private Func<CancellationToken> _cancellationTokenGetter;
+        private Exception _readError;
+
+        private BlockingCollection<byte[]> _freeBuffers;
+        private BlockingCollection<Chunk> _readChunks;
+        private CancellationTokenSource _readCancellation;
+        private Task _readTask;
+
+        private Chunk _current;
+        private int _currentIndex;
+        private long _position;
+
+        public ReadAheadStream(Stream inner, CancellationToken cancellationToken = default(CancellationToken), int chunkSize = DefaultChunkSize, int chunkCount = DefaultChunkCount)
+            : this(inner, () => cancellationToken, chunkSize, chunkCount)
+        { }
+
+        public ReadAheadStream(Stream inner, Func<CancellationToken> cancellationTokenGetter, int chunkSize = DefaultChunkSize, int chunkCount = DefaultChunkCount)
+        {
+            if (!inner.CanRead) throw new ArgumentException("ReadAheadStream requires a readable stream.");
+
+            _inner = inner;
+            _cancellationTokenGetter = cancellationTokenGetter;
+
+            // Don't allocate chunks larger than the whole stream
+            if (inner.CanSeek) chunkSize = (int)Math.Max(1, Math.Min(chunkSize, inner.Length));
+
+            _freeBuffers = new BlockingCollection<byte[]>();
+            for (int i = 0; i < chunkCount; ++i)
+            {
+                _freeBuffers.Add(BufferPool<byte>.Rent(chunkSize));
+            }
+
+            _readChunks = new BlockingCollection<Chunk>();
+
+            _position = (inner.CanSeek ? inner.Position : 0);
+            StartReadAhead();
+        }
+
+        public override bool CanRead => true;
+        public override bool CanSeek => _inner.CanSeek;
+        public override bool CanWrite => false;
+        public override long Length => _inner.Length;
+
+        public override long Position
+        {
+            get { return _position; }
+            set { Seek(value, SeekOrigin.Begin); }
+        }
+
+        public override int Read(byte[] buffer, int offset, int count)
+        {
+            if (_inner == null) throw new ObjectDisposedException(nameof(ReadAheadStream));
+            if (_readError != null) throw new IOException("ReadAheadStream inner stream read failed.", _readError);
+
+            int totalRead = 0;
+            while (count > 0)
+            {
+                if (_current == null || _currentIndex == _current.Count)
+                {
+                    // Stop at the end of the stream
+                    if (_current != null && _current.Count == 0) break;
+
+                    // Return the used buffer and wait for the next chunk
+                    if (_current != null) _freeBuffers.Add(_current.Buffer);
+                    _current = _readChunks.Take(_cancellationTokenGetter());
+                    _currentIndex = 0;
+
+                    if (_current.Error != null)
+                    {
+                        // Keep the error, so later reads don't see the failure as the end of the stream
+                        _readError = _current.Error;
+                        throw new IOException("ReadAheadStream inner stream read failed.", _readError);
+                    }
+
+                    if (_current.Count == 0) break;
+                }
+
+                int lengthToCopy = Math.Min(count, _current.Count - _currentIndex);
+                Buffer.BlockCopy(_current.Buffer, _currentIndex, buffer, offset, lengthToCopy);
+
+                _currentIndex += lengthToCopy;
+                _position += lengthToCopy;
+                offset += lengthToCopy;
+                count -= lengthToCopy;
+                totalRead += lengthToCopy;
+            }
+
+            return totalRead;
+        }
+
+        public override long Seek(long offset, SeekOrigin origin)
+        {
+            if (_inner == null) throw new ObjectDisposedException(nameof(ReadAheadStream));
+            if (_readError != null) throw new IOException("ReadAheadStream inner stream read failed.", _readError);
+
+            long position = offset;
+            if (origin == SeekOrigin.Current) position += _position;
+            if (origin == SeekOrigin.End) position += _inner.Length;
+            if (position < 0) throw new IOException("Seek before the beginning of the stream.");
+
+            // Sequential reads seek to the current position; keep reading ahead
+            if (position == _position) return _position;
+
+            // If the position is in the current chunk, move within it
+            if (_current != null && _current.Count > 0 && position > _position && position - _position <= _current.Count - _currentIndex)
+            {
+                _currentIndex += (int)(position - _position);
+                _position = position;
+                return _position;
+            }
+
+            if (!_inner.CanSeek) throw new NotSupportedException("ReadAheadStream can only seek within the current chunk when the inner stream can't seek.");
+
+            // Otherwise, stop reading ahead, discard the chunks read, and restart at the new position
+            StopReadAhead();
+            _inner.Seek(position, SeekOrigin.Begin);
+            _position = position;
+            StartReadAhead();
+
+            return _position;
+        }
+
+        private void StartReadAhead()
+        {
+            // The background read stops only for Seek and Dispose; it reads at most ChunkCount chunks ahead if a query is cancelled
+            _readCancellation = new CancellationTokenSource();
+            CancellationToken readCancellationToken = _readCancellation.Token;
+            _readTask = Task.Factory.StartNew(() => ReadAhead(readCancellationToken), CancellationToken.None, TaskCreationOptions.LongRunning, TaskScheduler.Default);
+        }
+
+        private void StopReadAhead()
+        {
+            _readCancellation.Cancel();
+            _readTask.Wait();
+            _readCancellation.Dispose();
+
+            // Return every buffer read ahead to the free list
+            if (_current != null && _current.Buffer != null) _freeBuffers.Add(_current.Buffer);
+            _current = null;
+            _currentIndex = 0;
+
+            Chunk chunk;
+            while (_readChunks.TryTake(out chunk))
+            {
+                if (chunk.Buffer != null) _freeBuffers.Add(chunk.Buffer);
+            }
+        }
+
+        private void ReadAhead(CancellationToken cancellationToken)
+        {
+            try
+            {
+                while (true)
+                {
+                    // Wait for a free buffer; this bounds how far ahead the stream reads
+                    byte[] buffer = _freeBuffers.Take(cancellationToken);
+
+                    Chunk chunk = new Chunk() { Buffer = buffer };
+                    try
+                    {
+                        while (chunk.Count < buffer.Length)
+                        {
+                            int lengthRead = _inner.Read(buffer, chunk.Count, buffer.Length - chunk.Count);
+                            if (lengthRead == 0) break;
+                            chunk.Count += lengthRead;
+                        }
+                    }
+                    catch (Exception ex)
+                    {
+                        chunk.Count = 0;
+                        chunk.Error = ex;
+                    }
+
+                    _readChunks.Add(chunk);
+
+                    // Stop after the end of the stream or an error
+                    if (chunk.Count == 0) return;
+                }
+            }
+            catch (OperationCanceledException)
+            {
+                // Seek or Dispose stopped the read ahead
+            }
+        }
+
+        public override void Flush()
+        { }
+
+        public override void SetLength(long value)
+        {
+            throw new NotSupportedException();
+        }
+
+        public override void Write(byte[] buffer, int offset, int count)
+        {
+            throw new NotSupportedException();
+        }
+
+        protected override void Dispose(bool disposing)
+        {
+            if (_inner != null)
+            {
+                StopReadAhead();
+
+                _inner.Dispose();
+                _inner = null;
+
+                // Return the chunk buffers for other streams to reuse
+                byte[] buffer;
+                while (_freeBuffers.TryTake(out buffer))
+                {
+                    BufferPool<byte>.Return(buffer);
+                }
+
+                _freeBuffers.Dispose();
+                _readChunks.Dispose();
+            }
+
+            base.Dispose(disposing);
+        }
+    }
+}
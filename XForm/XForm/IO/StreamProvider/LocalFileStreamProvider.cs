@@ -17,6 +17,12 @@ namespace XForm.IO.StreamProvider
     /// </summary>
     public class LocalFileStreamProvider : IStreamProvider
     {
+        /// <summary>
+        ///  If IsMemoryMappingEnabled = true (and the NativeAccelerator is enabled), binary column files
+        ///  are read through memory mappings instead of FileStreams.
+        /// </summary>
+        public static bool IsMemoryMappingEnabled = false;
+
         private string RootPath { get; set; }
 
         public LocalFileStreamProvider(string rootPath)
@@ -74,6 +80,11 @@ namespace XForm.IO.StreamProvider
 
         public Stream OpenRead(string logicalPath)
         {
+            if (IsMemoryMappingEnabled && MappedFileStream.IsAvailable && logicalPath.EndsWith(".bin", StringComparison.OrdinalIgnoreCase))
+            {
+                return new MappedFileStream(PathCombineSandbox(logicalPath));
+            }
+
             return new FileStream(PathCombineSandbox(logicalPath), FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete);
         }
 
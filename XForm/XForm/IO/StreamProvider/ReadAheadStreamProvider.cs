@@ -0,0 +1,83 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Threading;
+
+namespace XForm.IO.StreamProvider
+{
+    /// <summary>
+    ///  ReadAheadStreamProvider wraps binary column files from an inner provider in a ReadAheadStream,
+    ///  so that reading (and decompressing) the next pages overlaps with query work on the current ones.
+    ///  Memory-mapped files are returned unwrapped; they're read directly from the mapping.
+    ///
+    ///  Reads from the streams wait with this provider's CancellationToken. Table readers get their own provider
+    ///  from ForReader and set the token passed to each Next call, so that cancelling a query stops its reads.
+    /// </summary>
+    public class ReadAheadStreamProvider : IStreamProvider
+    {
+        private IStreamProvider _inner;
+
+        public ReadAheadStreamProvider(IStreamProvider inner)
+        {
+            _inner = inner;
+        }
+
+        public CancellationToken CancellationToken { get; set; }
+
+        /// <summary>
+        ///  Return a ReadAheadStreamProvider over the same inner provider with a separate CancellationToken,
+        ///  for one table reader to set from the query reading it.
+        /// </summary>
+        public ReadAheadStreamProvider ForReader()
+        {
+            return new ReadAheadStreamProvider(_inner);
+        }
+
+        public string Description => _inner.Description;
+
+        public StreamAttributes Attributes(string logicalPath)
+        {
+            return _inner.Attributes(logicalPath);
+        }
+
+        public void Delete(string logicalPath)
+        {
+            _inner.Delete(logicalPath);
+        }
+
+        public IEnumerable<StreamAttributes> Enumerate(string underLogicalPath, EnumerateTypes types, bool recursive)
+        {
+            return _inner.Enumerate(underLogicalPath, types, recursive);
+        }
+
+        public ItemVersions ItemVersions(LocationType location, string itemName)
+        {
+            return _inner.ItemVersions(location, itemName);
+        }
+
+        public Stream OpenAppend(string logicalPath)
+        {
+            return _inner.OpenAppend(logicalPath);
+        }
+
+        public Stream OpenRead(string logicalPath)
+        {
+            Stream stream = _inner.OpenRead(logicalPath);
+            if (!logicalPath.EndsWith(".bin", StringComparison.OrdinalIgnoreCase) || stream is MappedFileStream) return stream;
+            return new ReadAheadStream(stream, () => this.CancellationToken);
+        }
+
+        public Stream OpenWrite(string logicalPath)
+        {
+            return _inner.OpenWrite(logicalPath);
+        }
+
+        public void Publish(string logicalTablePath)
+        {
+            _inner.Publish(logicalTablePath);
+        }
+    }
+}
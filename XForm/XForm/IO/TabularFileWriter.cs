@@ -21,6 +21,7 @@ namespace XForm.IO
         private IStreamProvider _streamProvider;
         private string _outputFilePath;
         private ITabularWriter _writer;
+        private PageTabularWriter _pageWriter;
 
         private Func<XArray>[] _stringColumnGetters;
 
@@ -68,10 +69,9 @@ namespace XForm.IO
             _source.Reset();
 
             // If this is a reset, ensure the old writer is Disposed (and flushes output)
-            if (_writer != null)
+            if (_writer != null || _pageWriter != null)
             {
-                _writer.Dispose();
-                _writer = null;
+                DisposeWriters();
 
                 // On Dispose, tell the StreamProvider to publish the table
                 _streamProvider.Publish(_outputFilePath);
@@ -81,19 +81,26 @@ namespace XForm.IO
         public int Next(int desiredCount, CancellationToken cancellationToken)
         {
             // Build the writer only when we start getting rows
-            if (_writer == null)
+            if (_writer == null && _pageWriter == null)
             {
+                PageTabularWriter.Format format;
                 if (_outputFilePath == null) throw new InvalidOperationException("TabularFileWriter can't reset when passed an ITabularWriter instance");
                 if (_outputFilePath.Equals("cout", StringComparison.OrdinalIgnoreCase))
                 {
                     _writer = new ConsoleTabularWriter();
+                    _writer.SetColumns(_source.Columns.Select((col) => col.ColumnDetails.Name));
+                }
+                else if (PageTabularWriter.TryGetFormat(_outputFilePath, out format))
+                {
+                    // Write TSVs and CSVs a page at a time
+                    _pageWriter = new PageTabularWriter(_streamProvider.OpenWrite(_outputFilePath), format);
+                    _pageWriter.SetColumns(_source.Columns.Select((col) => col.ColumnDetails.Name));
                 }
                 else
                 {
                     _writer = TabularFactory.BuildWriter(_streamProvider.OpenWrite(_outputFilePath), _outputFilePath);
+                    _writer.SetColumns(_source.Columns.Select((col) => col.ColumnDetails.Name));
                 }
-
-                _writer.SetColumns(_source.Columns.Select((col) => col.ColumnDetails.Name));
             }
 
             // Or smaller batch?
@@ -106,6 +113,12 @@ namespace XForm.IO
                 arrays[i] = _stringColumnGetters[i]();
             }
 
+            if (_pageWriter != null)
+            {
+                _pageWriter.Write(arrays, rowCount);
+                return rowCount;
+            }
+
             for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex)
             {
                 for (int colIndex = 0; colIndex < _stringColumnGetters.Length; ++colIndex)
@@ -128,11 +141,11 @@ namespace XForm.IO
                 _source = null;
             }
 
-            if (_writer != null)
+            if (_writer != null || _pageWriter != null)
             {
                 try
                 {
-                    _writer.Dispose();
+                    DisposeWriters();
 
                     // On Dispose, tell the StreamProvider to publish the table
                     if (_streamProvider != null) _streamProvider.Publish(_outputFilePath);
@@ -140,8 +153,24 @@ namespace XForm.IO
                 finally
                 {
                     _writer = null;
+                    _pageWriter = null;
                 }
             }
         }
+
+        private void DisposeWriters()
+        {
+            if (_writer != null)
+            {
+                _writer.Dispose();
+                _writer = null;
+            }
+
+            if (_pageWriter != null)
+            {
+                _pageWriter.Dispose();
+                _pageWriter = null;
+            }
+        }
     }
 }
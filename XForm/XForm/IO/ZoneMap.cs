@@ -0,0 +1,325 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.IO;
+
+using XForm.Data;
+using XForm.Extensions;
+using XForm.IO.StreamProvider;
+using XForm.Query;
+using XForm.Types;
+
+namespace XForm.IO
+{
+    /// <summary>
+    ///  ZoneMatch describes whether the rows in a range can match a comparison.
+    /// </summary>
+    public enum ZoneMatch
+    {
+        None,
+        Some,
+        All
+    }
+
+    /// <summary>
+    ///  ZoneMap holds the minimum, maximum, and null count of each block of BlockRowCount rows in a binary table column.
+    ///  Where uses it to skip evaluating pages which can't match a comparison, or to match them entirely without reading them.
+    ///
+    ///  Zone maps are written beside the column values, as [Column]\ZoneMin, [Column]\ZoneMax, and [Column]\ZoneNulls.
+    /// </summary>
+    public class ZoneMap
+    {
+        public const int BlockRowCount = 65536;
+
+        private const string MinPart = "ZoneMin";
+        private const string MaxPart = "ZoneMax";
+        private const string NullCountPart = "ZoneNulls";
+
+        // Zone maps are only kept for types with a total order (no NaN) which are compared by value
+        private static HashSet<Type> s_supportedTypes = new HashSet<Type>()
+        {
+            typeof(sbyte), typeof(byte), typeof(short), typeof(ushort), typeof(int), typeof(uint), typeof(long), typeof(ulong),
+            typeof(DateTime), typeof(TimeSpan)
+        };
+
+        private Array _mins;
+        private Array _maxs;
+        private int[] _nullCounts;
+        private int _rowCount;
+
+        public Type Type { get; private set; }
+
+        private ZoneMap(Type type, Array mins, Array maxs, int[] nullCounts, int rowCount)
+        {
+            Type = type;
+            _mins = mins;
+            _maxs = maxs;
+            _nullCounts = nullCounts;
+            _rowCount = rowCount;
+        }
+
+        public static bool IsSupported(Type type)
+        {
+            return s_supportedTypes.Contains(type);
+        }
+
+        /// <summary>
+        ///  Build a writer to compute and write the zone map for a column, if the column type supports zone maps.
+        /// </summary>
+        /// <param name="streamProvider">IStreamProvider to write to</param>
+        /// <param name="type">Column Type</param>
+        /// <param name="columnPath">Path of the column folder</param>
+        /// <returns>IZoneMapWriter for column, or null if the type isn't supported</returns>
+        public static IZoneMapWriter TryGetWriter(IStreamProvider streamProvider, Type type, string columnPath)
+        {
+            if (!IsSupported(type)) return null;
+            return (IZoneMapWriter)Allocator.ConstructGenericOf<IStreamProvider, string>(typeof(ZoneMapWriter<>), type, streamProvider, columnPath);
+        }
+
+        /// <summary>
+        ///  Read the zone map for a column, if one was written.
+        /// </summary>
+        /// <param name="streamProvider">IStreamProvider to read from</param>
+        /// <param name="type">Column Type</param>
+        /// <param name="columnPath">Path of the column folder</param>
+        /// <param name="rowCount">Row Count of the table</param>
+        /// <returns>ZoneMap for column, or null if none was written</returns>
+        public static ZoneMap TryRead(IStreamProvider streamProvider, Type type, string columnPath, int rowCount)
+        {
+            if (!IsSupported(type)) return null;
+
+            // The null counts are written last, so only use the zone map if they're there
+            string nullCountsPath = NullCountPath(columnPath);
+            if (!PrimitiveTypeProvider<int>.ValuesExist(streamProvider, nullCountsPath)) return null;
+
+            int[] nullCounts = (int[])ReadAll(streamProvider, typeof(int), nullCountsPath);
+            Array mins = ReadAll(streamProvider, type, MinPath(columnPath));
+            Array maxs = ReadAll(streamProvider, type, MaxPath(columnPath));
+
+            int blockCount = (rowCount + BlockRowCount - 1) / BlockRowCount;
+            if (nullCounts.Length < blockCount || mins.Length < blockCount || maxs.Length < blockCount) return null;
+
+            return new ZoneMap(type, mins, maxs, nullCounts, rowCount);
+        }
+
+        private static Array ReadAll(IStreamProvider streamProvider, Type type, string path)
+        {
+            using (IColumnReader reader = TypeProviderFactory.Get(type).BinaryReader(streamProvider, path, CachingOption.Never))
+            {
+                XArray values = reader.Read(ArraySelector.All(reader.Count));
+
+                Array result = null;
+                Allocator.AllocateToSize(ref result, values.Count, type);
+                Array.Copy(values.Array, values.Selector.StartIndexInclusive, result, 0, values.Count);
+                return result;
+            }
+        }
+
+        /// <summary>
+        ///  Determine whether rows in a range of the table can match a comparison to a constant.
+        ///  Null rows never match, so ranges containing nulls never match entirely.
+        /// </summary>
+        /// <param name="rows">ArraySelector for the rows being compared</param>
+        /// <param name="op">CompareOperator to the constant</param>
+        /// <param name="value">Constant value, of the column type</param>
+        /// <returns>None if no rows can match, All if every row matches, Some otherwise</returns>
+        public ZoneMatch Match(ArraySelector rows, CompareOperator op, object value)
+        {
+            if (rows.Indices != null || rows.IsSingleValue || rows.Count == 0 || value == null) return ZoneMatch.Some;
+            if (rows.EndIndexExclusive > _rowCount) return ZoneMatch.Some;
+
+            int firstBlock = rows.StartIndexInclusive / BlockRowCount;
+            int lastBlock = (rows.EndIndexExclusive - 1) / BlockRowCount;
+
+            // Find the minimum and maximum of the blocks containing the rows
+            object min = null;
+            object max = null;
+            bool anyNulls = false;
+            for (int block = firstBlock; block <= lastBlock; ++block)
+            {
+                int blockRows = Math.Min(BlockRowCount, _rowCount - block * BlockRowCount);
+                if (_nullCounts[block] > 0) anyNulls = true;
+                if (_nullCounts[block] >= blockRows) continue;
+
+                object blockMin = _mins.GetValue(block);
+                object blockMax = _maxs.GetValue(block);
+                if (min == null || Comparer.Default.Compare(blockMin, min) < 0) min = blockMin;
+                if (max == null || Comparer.Default.Compare(blockMax, max) > 0) max = blockMax;
+            }
+
+            // If every row is null, none can match
+            if (min == null) return ZoneMatch.None;
+
+            int minToValue = Comparer.Default.Compare(min, value);
+            int maxToValue = Comparer.Default.Compare(max, value);
+
+            bool none, all;
+            switch (op)
+            {
+                case CompareOperator.Equal:
+                    none = (minToValue > 0 || maxToValue < 0);
+                    all = (minToValue == 0 && maxToValue == 0);
+                    break;
+                case CompareOperator.NotEqual:
+                    none = (minToValue == 0 && maxToValue == 0);
+                    all = (minToValue > 0 || maxToValue < 0);
+                    break;
+                case CompareOperator.LessThan:
+                    none = (minToValue >= 0);
+                    all = (maxToValue < 0);
+                    break;
+                case CompareOperator.LessThanOrEqual:
+                    none = (minToValue > 0);
+                    all = (maxToValue <= 0);
+                    break;
+                case CompareOperator.GreaterThan:
+                    none = (maxToValue <= 0);
+                    all = (minToValue > 0);
+                    break;
+                case CompareOperator.GreaterThanOrEqual:
+                    none = (maxToValue < 0);
+                    all = (minToValue >= 0);
+                    break;
+                default:
+                    return ZoneMatch.Some;
+            }
+
+            if (none) return ZoneMatch.None;
+            if (all && !anyNulls) return ZoneMatch.All;
+            return ZoneMatch.Some;
+        }
+
+        internal static string MinPath(string columnPath) => Path.Combine(columnPath, MinPart);
+        internal static string MaxPath(string columnPath) => Path.Combine(columnPath, MaxPart);
+        internal static string NullCountPath(string columnPath) => Path.Combine(columnPath, NullCountPart);
+    }
+
+    /// <summary>
+    ///  ZoneMapPage is the ZoneMap column component: the zone map with the rows currently being read.
+    /// </summary>
+    public struct ZoneMapPage
+    {
+        public ZoneMap ZoneMap;
+        public ArraySelector Rows;
+
+        public ZoneMapPage(ZoneMap zoneMap, ArraySelector rows)
+        {
+            ZoneMap = zoneMap;
+            Rows = rows;
+        }
+
+        public ZoneMatch Match(CompareOperator op, object value)
+        {
+            return ZoneMap.Match(Rows, op, value);
+        }
+    }
+
+    public interface IZoneMapWriter : IDisposable
+    {
+        void Append(XArray xarray);
+    }
+
+    /// <summary>
+    ///  ZoneMapWriter computes the minimum, maximum, and null count of each block of rows written to a column
+    ///  and writes them when disposed.
+    /// </summary>
+    /// <typeparam name="T">Column Type</typeparam>
+    public class ZoneMapWriter<T> : IZoneMapWriter where T : IComparable<T>
+    {
+        private IStreamProvider _streamProvider;
+        private string _columnPath;
+
+        private List<T> _mins;
+        private List<T> _maxs;
+        private List<int> _nullCounts;
+
+        private T _currentMin;
+        private T _currentMax;
+        private int _currentRowCount;
+        private int _currentNullCount;
+
+        public ZoneMapWriter(IStreamProvider streamProvider, string columnPath)
+        {
+            _streamProvider = streamProvider;
+            _columnPath = columnPath;
+
+            _mins = new List<T>();
+            _maxs = new List<T>();
+            _nullCounts = new List<int>();
+        }
+
+        public void Append(XArray xarray)
+        {
+            T[] array = (T[])xarray.Array;
+
+            for (int i = 0; i < xarray.Count; ++i)
+            {
+                int index = xarray.Index(i);
+
+                if (xarray.HasNulls && xarray.NullRows[index])
+                {
+                    _currentNullCount++;
+                }
+                else
+                {
+                    T value = array[index];
+                    if (_currentNullCount == _currentRowCount)
+                    {
+                        // First non-null value in the block
+                        _currentMin = value;
+                        _currentMax = value;
+                    }
+                    else
+                    {
+                        if (value.CompareTo(_currentMin) < 0) _currentMin = value;
+                        if (value.CompareTo(_currentMax) > 0) _currentMax = value;
+                    }
+                }
+
+                _currentRowCount++;
+                if (_currentRowCount == ZoneMap.BlockRowCount) NextBlock();
+            }
+        }
+
+        private void NextBlock()
+        {
+            _mins.Add(_currentMin);
+            _maxs.Add(_currentMax);
+            _nullCounts.Add(_currentNullCount);
+
+            _currentMin = default(T);
+            _currentMax = default(T);
+            _currentRowCount = 0;
+            _currentNullCount = 0;
+        }
+
+        private void Write(Type type, string path, Array values)
+        {
+            using (IColumnWriter writer = TypeProviderFactory.Get(type).BinaryWriter(_streamProvider, path))
+            {
+                writer.Append(XArray.All(values, values.Length));
+            }
+        }
+
+        public void Dispose()
+        {
+            if (_streamProvider == null) return;
+
+            if (_currentRowCount > 0) NextBlock();
+
+            if (_nullCounts.Count > 0)
+            {
+                Write(typeof(T), ZoneMap.MinPath(_columnPath), _mins.ToArray());
+                Write(typeof(T), ZoneMap.MaxPath(_columnPath), _maxs.ToArray());
+
+                // Write null counts last; readers only use zone maps which have them
+                Write(typeof(int), ZoneMap.NullCountPath(_columnPath), _nullCounts.ToArray());
+            }
+
+            _streamProvider = null;
+        }
+    }
+}
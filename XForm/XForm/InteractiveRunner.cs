@@ -61,6 +61,13 @@ namespace XForm
                     string nextLine = Console.ReadLine();
 
                     Stopwatch w = Stopwatch.StartNew();
+                    KernelCounterSnapshot countersBefore = null;
+                    if (KernelCounters.IsEnabled)
+                    {
+                        KernelCounters.Mark(nextLine);
+                        countersBefore = KernelCounters.Read();
+                    }
+
                     try
                     {
                         if (String.IsNullOrEmpty(nextLine)) return lastCount;
@@ -106,6 +113,11 @@ namespace XForm
                             case "rerun":
                                 LoadScript(s_commandCachePath);
                                 break;
+                            case "counters":
+                                // Turn native kernel counters on or off ("counters on", "counters off")
+                                bool enable = (parts.Length < 2 || parts[1].ToLowerInvariant() != "off");
+                                Console.WriteLine(KernelCounters.Enable(enable) ? $"Kernel counters {(enable ? "on" : "off")}." : "Kernel counters require XForm.Native.");
+                                continue;
                             default:
                                 try
                                 {
@@ -140,6 +152,13 @@ namespace XForm
 
                     Console.WriteLine();
                     Console.WriteLine($"{lastCount:n0} rows in {w.Elapsed.ToFriendlyString()}. {(result.IsComplete ? "" : "[incomplete]")}");
+
+                    // Show the time in each native kernel, if counting
+                    if (countersBefore != null && KernelCounters.IsEnabled)
+                    {
+                        Console.WriteLine(KernelCounters.Read().Subtract(countersBefore));
+                    }
+
                     Console.WriteLine();
                 }
             }
@@ -28,6 +28,9 @@ namespace XForm
             foreach (string arg in args)
             {
                 if (arg.Equals("+cache", StringComparison.OrdinalIgnoreCase)) ColumnCache.IsEnabled = true;
+                if (arg.Equals("+mmap", StringComparison.OrdinalIgnoreCase)) LocalFileStreamProvider.IsMemoryMappingEnabled = true;
+                if (arg.Equals("+pack", StringComparison.OrdinalIgnoreCase)) PackedArray.IsEnabled = true;
+                if (arg.Equals("+readahead", StringComparison.OrdinalIgnoreCase)) context.StreamProvider = new ReadAheadStreamProvider(context.StreamProvider);
                 if (arg.Equals("-parallel", StringComparison.OrdinalIgnoreCase)) context.ForceSingleThreaded = true;
             }
 
@@ -88,6 +91,10 @@ namespace XForm
                     case "perf":
                         new PerformanceComparisons(context).Run();
                         return 0;
+                    case "perfnative":
+                        return new NativeBenchmarks(
+                            (args.Length > 1 ? args[1] : NativeBenchmarks.DefaultOutputPath),
+                            (args.Length > 2 ? args[2] : null)).Run();
                     case "generatehuge":
                         HugeSampleGenerator.Generate(ParseLongOrDefault(args, 1, (long)5 * 1000 * 1000 * 1000), context);
                         return 0;
@@ -1,28 +1,36 @@
 ﻿// Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
+using System;
+using System.Collections.Generic;
 using System.Text;
 
 using XForm.Data;
 
 namespace XForm.Query.Expression
 {
-    internal class AndExpression : IExpression
+    internal class AndExpression : IExpression, IDisposable
     {
         private IExpression[] _terms;
+        private IExpression[] _evaluateTerms;
         private BitVector _termVector;
 
         public AndExpression(IExpression[] terms)
         {
             _terms = terms;
+
+            // Terms on the same Enum column are evaluated together in one pass over the indices
+            _evaluateTerms = EnumSetExpression.Combine(terms, BooleanOperator.And);
         }
 
+        internal IReadOnlyList<IExpression> Terms => _terms;
+
         public void Evaluate(BitVector vector)
         {
-            Allocator.AllocateToSize(ref _termVector, vector.Capacity);
+            Allocator.RentToSize(ref _termVector, vector.Capacity);
             vector.All(vector.Capacity);
 
-            foreach (IExpression term in _terms)
+            foreach (IExpression term in _evaluateTerms)
             {
                 _termVector.None();
                 term.Evaluate(_termVector);
@@ -53,5 +61,15 @@ namespace XForm.Query.Expression
 
             return result.ToString();
         }
+
+        public void Dispose()
+        {
+            foreach (IExpression term in _terms)
+            {
+                (term as IDisposable)?.Dispose();
+            }
+
+            Allocator.Return(ref _termVector);
+        }
     }
 }
@@ -0,0 +1,168 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+using XForm.Columns;
+using XForm.Core;
+using XForm.Data;
+using XForm.IO;
+
+namespace XForm.Query.Expression
+{
+    /// <summary>
+    ///  ColumnPredicate is a where expression compiled to run natively over whole columns already in memory
+    ///  (memory-mapped or cached). It supports one term, or terms all ANDed or all ORed, where each term compares
+    ///  a column to a constant.
+    ///
+    ///  Rows are split into 64-aligned morsels run on the MorselScheduler, and each morsel evaluates every term
+    ///  in cache-sized chunks. No pages are built and no values are copied, so filtered counts run at memory bandwidth.
+    /// </summary>
+    internal class ColumnPredicate
+    {
+        public delegate long EvaluateSignature(IntPtr[] columns, byte[] types, byte[] compareOperators, long[] constants, byte[] booleanOperators, long startRow, long endRow, ulong[] vector);
+        internal static EvaluateSignature s_EvaluateNative = null;
+
+        // WARNING: Order must stay in sync with ColumnTypeN in XForm.Native
+        private static readonly Type[] s_columnTypes = new Type[] { typeof(byte), typeof(sbyte), typeof(ushort), typeof(short), typeof(uint), typeof(int), typeof(ulong), typeof(long), typeof(float), typeof(double) };
+
+        private ColumnMemory[] _columns;
+        private byte[] _types;
+        private byte[] _compareOperators;
+        private long[] _constants;
+        private byte[] _booleanOperators;
+
+        public int RowCount { get; private set; }
+
+        private ColumnPredicate(int termCount, int rowCount)
+        {
+            _columns = new ColumnMemory[termCount];
+            _types = new byte[termCount];
+            _compareOperators = new byte[termCount];
+            _constants = new long[termCount];
+            _booleanOperators = new byte[termCount];
+            RowCount = rowCount;
+        }
+
+        /// <summary>
+        ///  Compile an expression over rowCount rows of a binary table, or return null if the expression or
+        ///  its columns can't be evaluated over whole columns.
+        /// </summary>
+        public static ColumnPredicate TryBuild(IExpression expression, int rowCount)
+        {
+            if (s_EvaluateNative == null) return null;
+
+            IReadOnlyList<IExpression> terms;
+            BooleanOperator bOp;
+
+            if (expression is AndExpression)
+            {
+                terms = ((AndExpression)expression).Terms;
+                bOp = BooleanOperator.And;
+            }
+            else if (expression is OrExpression)
+            {
+                terms = ((OrExpression)expression).Terms;
+                bOp = BooleanOperator.Or;
+            }
+            else
+            {
+                terms = new IExpression[] { expression };
+                bOp = BooleanOperator.And;
+            }
+
+            ColumnPredicate predicate = new ColumnPredicate(terms.Count, rowCount);
+            for (int i = 0; i < terms.Count; ++i)
+            {
+                // Nested And and Or, Not, and String8 terms aren't compiled
+                TermExpression term = terms[i] as TermExpression;
+                if (term == null) return null;
+
+                IXColumn column;
+                CompareOperator cOp;
+                object value;
+                if (!term.TryGetColumnConstant(out column, out cOp, out value)) return null;
+
+                Func<object> memoryGetter = column.ComponentGetter(ColumnComponent.ColumnMemory);
+                if (memoryGetter == null) return null;
+
+                ColumnMemory memory = (ColumnMemory)memoryGetter();
+                int typeIndex = Array.IndexOf(s_columnTypes, memory.Type);
+                if (typeIndex == -1 || memory.Type != column.ColumnDetails.Type || memory.Count < rowCount) return null;
+
+                predicate._columns[i] = memory;
+                predicate._types[i] = (byte)typeIndex;
+                predicate._compareOperators[i] = (byte)cOp;
+                predicate._constants[i] = ToBits(value, memory.Type);
+                predicate._booleanOperators[i] = (byte)bOp;
+            }
+
+            return predicate;
+        }
+
+        /// <summary>
+        ///  Count the rows matching the predicate.
+        /// </summary>
+        public long Count(CancellationToken cancellationToken)
+        {
+            return Evaluate(null, 0, RowCount, cancellationToken);
+        }
+
+        /// <summary>
+        ///  Set the bits in vector for matching rows in [startRowInclusive, endRowExclusive), clearing the bits
+        ///  for non-matching rows in the range, and return the match count. startRowInclusive must be a multiple of 64.
+        /// </summary>
+        public long Evaluate(ulong[] vector, int startRowInclusive, int endRowExclusive, CancellationToken cancellationToken)
+        {
+            if ((startRowInclusive & 63) != 0) throw new ArgumentException("startRowInclusive");
+            if (startRowInclusive < 0 || endRowExclusive > RowCount || endRowExclusive < startRowInclusive) throw new ArgumentOutOfRangeException("endRowExclusive");
+
+            IntPtr[] addresses = new IntPtr[_columns.Length];
+            GCHandle[] handles = new GCHandle[_columns.Length];
+
+            try
+            {
+                // Pin cached arrays for the whole evaluation; mapped files are already at fixed addresses
+                for (int i = 0; i < _columns.Length; ++i)
+                {
+                    if (_columns[i].Array != null)
+                    {
+                        handles[i] = GCHandle.Alloc(_columns[i].Array, GCHandleType.Pinned);
+                        addresses[i] = handles[i].AddrOfPinnedObject();
+                    }
+                    else
+                    {
+                        addresses[i] = _columns[i].Address;
+                    }
+                }
+
+                return MorselScheduler.Default.Run<long>(
+                    startRowInclusive,
+                    endRowExclusive,
+                    () => 0,
+                    (start, end, count) => count + s_EvaluateNative(addresses, _types, _compareOperators, _constants, _booleanOperators, start, end, vector),
+                    (left, right) => left + right,
+                    new MorselOptions() { MaxParallelism = ParallelRunner.ParallelCount, CancellationToken = cancellationToken });
+            }
+            finally
+            {
+                for (int i = 0; i < handles.Length; ++i)
+                {
+                    if (handles[i].IsAllocated) handles[i].Free();
+                }
+            }
+        }
+
+        private static long ToBits(object value, Type type)
+        {
+            // Constants are passed as the bits of the value in the column type
+            if (type == typeof(float)) return (long)(uint)BitConverter.ToInt32(BitConverter.GetBytes((float)value), 0);
+            if (type == typeof(double)) return BitConverter.DoubleToInt64Bits((double)value);
+            if (type == typeof(ulong)) return unchecked((long)(ulong)value);
+            return Convert.ToInt64(value);
+        }
+    }
+}
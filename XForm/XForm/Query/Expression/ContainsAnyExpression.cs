@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+using System.Text;
+
+using Microsoft.CodeAnalysis.Elfie.Model.Strings;
+
+using XForm.Data;
+using XForm.Types;
+using XForm.Types.Comparers;
+
+namespace XForm.Query.Expression
+{
+    /// <summary>
+    ///  ContainsAnyExpression evaluates ([Column] : "A" OR [Column] : "B" OR ...) on a String8 column
+    ///  with one scan of the raw bytes, rather than one scan per value.
+    /// </summary>
+    internal class ContainsAnyExpression : IExpression, IDisposable
+    {
+        private IExpression[] _terms;
+        private Func<object> _rawGetter;
+        private String8SetComparer _comparer;
+
+        private ContainsAnyExpression(IExpression[] terms, Func<object> rawGetter, String8[] values)
+        {
+            _terms = terms;
+            _rawGetter = rawGetter;
+            _comparer = new String8SetComparer(values);
+        }
+
+        /// <summary>
+        ///  Build a ContainsAnyExpression if every term is a raw String8 Contains on the same column
+        ///  and the native multi-value matcher is available.
+        /// </summary>
+        /// <param name="terms">Terms being ORed together</param>
+        /// <returns>ContainsAnyExpression for the terms, or null if they can't be combined</returns>
+        public static IExpression TryBuild(IList<IExpression> terms)
+        {
+            if (String8SetComparer.s_BuildNative == null || terms.Count < 2) return null;
+
+            IXColumn column = null;
+            Func<object> rawGetter = null;
+            String8[] values = new String8[terms.Count];
+
+            for (int i = 0; i < terms.Count; ++i)
+            {
+                TermExpression term = terms[i] as TermExpression;
+                if (term == null) return null;
+
+                IXColumn termColumn;
+                Func<object> termRawGetter;
+                if (!term.TryGetRawContains(out termColumn, out termRawGetter, out values[i])) return null;
+
+                if (column == null)
+                {
+                    column = termColumn;
+                    rawGetter = termRawGetter;
+                }
+                else if (!object.ReferenceEquals(column, termColumn))
+                {
+                    return null;
+                }
+            }
+
+            IExpression[] termArray = new IExpression[terms.Count];
+            terms.CopyTo(termArray, 0);
+            return new ContainsAnyExpression(termArray, rawGetter, values);
+        }
+
+        public void Evaluate(BitVector vector)
+        {
+            String8Raw raw = (String8Raw)_rawGetter();
+            _comparer.WhereContainsAny(raw, vector);
+        }
+
+        public override string ToString()
+        {
+            StringBuilder result = new StringBuilder();
+            foreach (IExpression term in _terms)
+            {
+                if (result.Length > 0) result.Append(" OR ");
+                result.Append(term);
+            }
+
+            return result.ToString();
+        }
+
+        public void Dispose()
+        {
+            if (_comparer != null)
+            {
+                _comparer.Dispose();
+                _comparer = null;
+            }
+        }
+    }
+}
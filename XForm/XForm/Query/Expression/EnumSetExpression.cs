@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+using System.Text;
+
+using XForm.Data;
+using XForm.Types.Comparers;
+
+namespace XForm.Query.Expression
+{
+    /// <summary>
+    ///  EnumSetExpression evaluates several terms comparing the same Enum column to constants, ANDed or ORed,
+    ///  as one match against the Enum indices. ([Status] = "Active" OR [Status] |> "Pend") becomes
+    ///  ([Status.Indices] IN (1, 4, 5)), so the column is scanned once at byte compare speed.
+    /// </summary>
+    internal class EnumSetExpression : IExpression
+    {
+        private IExpression[] _terms;
+        private BooleanOperator _bOp;
+        private Func<XArray> _indicesGetter;
+        private SetComparer _comparer;
+
+        private EnumSetExpression(IExpression[] terms, BooleanOperator bOp, IXColumn column, BitVector valueSet)
+        {
+            _terms = terms;
+            _bOp = bOp;
+            _indicesGetter = column.IndicesCurrentGetter();
+            _comparer = new SetComparer(valueSet);
+        }
+
+        /// <summary>
+        ///  Combine the terms comparing the same Enum column into one EnumSetExpression per column.
+        /// </summary>
+        /// <param name="terms">Terms being ANDed or ORed together</param>
+        /// <param name="bOp">Operator combining the terms</param>
+        /// <returns>Terms to evaluate, with Enum terms combined, or the original terms if none could be combined</returns>
+        public static IExpression[] Combine(IExpression[] terms, BooleanOperator bOp)
+        {
+            List<IExpression> result = new List<IExpression>();
+            bool[] combined = new bool[terms.Length];
+            bool anyCombined = false;
+
+            for (int i = 0; i < terms.Length; ++i)
+            {
+                if (combined[i]) continue;
+
+                IXColumn column;
+                BitVector valueSet;
+                TermExpression term = terms[i] as TermExpression;
+                if (term != null && term.TryGetEnumValueSet(out column, out valueSet))
+                {
+                    // Merge the value sets of the later terms on the same column
+                    List<IExpression> columnTerms = new List<IExpression>() { term };
+                    BitVector mergedSet = new BitVector(valueSet.Capacity).Set(valueSet);
+
+                    for (int j = i + 1; j < terms.Length; ++j)
+                    {
+                        IXColumn otherColumn;
+                        BitVector otherValueSet;
+                        TermExpression other = terms[j] as TermExpression;
+                        if (other == null || !other.TryGetEnumValueSet(out otherColumn, out otherValueSet) || !object.ReferenceEquals(column, otherColumn)) continue;
+
+                        if (bOp == BooleanOperator.And)
+                        {
+                            mergedSet.And(otherValueSet);
+                        }
+                        else
+                        {
+                            mergedSet.Or(otherValueSet);
+                        }
+
+                        columnTerms.Add(other);
+                        combined[j] = true;
+                    }
+
+                    if (columnTerms.Count > 1)
+                    {
+                        result.Add(new EnumSetExpression(columnTerms.ToArray(), bOp, column, mergedSet));
+                        anyCombined = true;
+                        continue;
+                    }
+                }
+
+                result.Add(terms[i]);
+            }
+
+            return (anyCombined ? result.ToArray() : terms);
+        }
+
+        public void Evaluate(BitVector vector)
+        {
+            _comparer.Evaluate(_indicesGetter(), default(XArray), vector);
+        }
+
+        public override string ToString()
+        {
+            StringBuilder result = new StringBuilder();
+            foreach (IExpression term in _terms)
+            {
+                if (result.Length > 0) result.Append(_bOp == BooleanOperator.And ? " AND " : " OR ");
+                result.Append(term);
+            }
+
+            return result.ToString();
+        }
+    }
+}
@@ -1,11 +1,13 @@
 ﻿// Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
+using System;
+
 using XForm.Data;
 
 namespace XForm.Query.Expression
 {
-    internal class NotExpression : IExpression
+    internal class NotExpression : IExpression, IDisposable
     {
         private IExpression _inner;
 
@@ -24,5 +26,10 @@ namespace XForm.Query.Expression
         {
             return $"NOT({_inner})";
         }
+
+        public void Dispose()
+        {
+            (_inner as IDisposable)?.Dispose();
+        }
     }
 }
@@ -20,11 +20,23 @@ namespace XForm.Query.Expression
         private CompareOperator _cOp;
         private IXColumn _right;
 
+        // Operator after moving a constant to the right side (_cOp is kept as written for ToString)
+        private CompareOperator _evaluateOp;
+
         private Func<XArray> _leftGetter;
         private Func<XArray> _rightGetter;
         private ComparerExtensions.Comparer _comparer;
         private Action<BitVector> _evaluate;
 
+        private Func<object> _rawGetter;
+        private String8 _rawValue;
+
+        private BitVector _enumValueSet;
+
+        private Func<object> _zoneMapGetter;
+        private CompareOperator _zoneMapOperator;
+        private object _zoneMapValue;
+
         public TermExpression(IXTable source, IXColumn left, CompareOperator op, IXColumn right)
         {
             _evaluate = EvaluateNormal;
@@ -48,6 +60,8 @@ namespace XForm.Query.Expression
                 }
             }
 
+            _evaluateOp = op;
+
             // Disallow unquoted constants used as strings
             if (_right.IsConstantColumn() && _left.ColumnDetails.Type == typeof(String8) && _right.ColumnDetails.Type == typeof(String8))
             {
@@ -90,12 +104,24 @@ namespace XForm.Query.Expression
                 if (_comparer == null) throw new ArgumentException($"No comparer found for type {left.ColumnDetails.Type.Name}.");
             }
 
+            // Allow ordered comparisons to constants to skip pages using the column zone map, if it has one
+            if (op <= CompareOperator.GreaterThanOrEqual && _right.IsConstantColumn() && !_right.IsNullConstant())
+            {
+                Func<object> zoneMapGetter = _left.ComponentGetter(ColumnComponent.ZoneMap);
+                if (zoneMapGetter != null && ((ZoneMapPage)zoneMapGetter()).ZoneMap.Type == _left.ColumnDetails.Type)
+                {
+                    _zoneMapGetter = zoneMapGetter;
+                    _zoneMapOperator = op;
+                    _zoneMapValue = _right.ValuesGetter()().Array.GetValue(0);
+                }
+            }
+
             // Optimize Enum to Constant comparisons to use the underlying indices
             if (_left.IsEnumColumn() && _right.IsConstantColumn())
             {
                 // Get an optimized comparer against the indices rather than values
                 IXColumn replacedRight = _right;
-                _comparer = SetComparer.ConvertToEnumIndexComparer(_left, _comparer, ref replacedRight, source);
+                _comparer = SetComparer.ConvertToEnumIndexComparer(_left, _comparer, ref replacedRight, source, out _enumValueSet);
 
                 // Get the indices on the left side
                 _leftGetter = _left.IndicesCurrentGetter();
@@ -114,6 +140,9 @@ namespace XForm.Query.Expression
                     String8 rightValue = (String8)_right.ValuesGetter()().Array.GetValue(0);
                     String8Comparer string8Comparer = new String8Comparer();
 
+                    _rawGetter = rawGetter;
+                    _rawValue = rightValue;
+
                     _evaluate = (vector) =>
                     {
                         String8Raw raw = (String8Raw)rawGetter();
@@ -121,10 +150,91 @@ namespace XForm.Query.Expression
                     };
                 }
             }
+            else if (String8Comparer.CanWhereRaw(op) && _right.IsConstantColumn() && !_right.IsNullConstant() && _left.ColumnDetails.Type == typeof(String8) && !_left.IsEnumColumn())
+            {
+                // Allow other String8 to constant comparisons to run natively on the raw byte[] and int[]
+                Func<object> rawGetter = _left.ComponentGetter(ColumnComponent.String8Raw);
+
+                if (rawGetter != null)
+                {
+                    String8 rightValue = (String8)_right.ValuesGetter()().Array.GetValue(0);
+                    String8Comparer string8Comparer = new String8Comparer();
+
+                    _evaluate = (vector) =>
+                    {
+                        String8Raw raw = (String8Raw)rawGetter();
+                        string8Comparer.Where(raw, op, rightValue, vector);
+                    };
+                }
+            }
+        }
+
+        /// <summary>
+        ///  Return whether this term is a String8 column Contains a constant, compared on the raw byte[] and int[].
+        /// </summary>
+        /// <param name="column">Column being searched</param>
+        /// <param name="rawGetter">Getter for the String8Raw column component</param>
+        /// <param name="value">Constant value to find</param>
+        /// <returns>True if this term is a raw String8 Contains, False otherwise</returns>
+        internal bool TryGetRawContains(out IXColumn column, out Func<object> rawGetter, out String8 value)
+        {
+            column = _left;
+            rawGetter = _rawGetter;
+            value = _rawValue;
+            return (_rawGetter != null);
+        }
+
+        /// <summary>
+        ///  Return whether this term compares an Enum column to a constant, and the set of Enum value indices which match.
+        /// </summary>
+        /// <param name="column">Enum column being compared</param>
+        /// <param name="valueSet">Set of the indices of the matching Enum values</param>
+        /// <returns>True if this term is evaluated on the Enum indices, False otherwise</returns>
+        internal bool TryGetEnumValueSet(out IXColumn column, out BitVector valueSet)
+        {
+            column = _left;
+            valueSet = _enumValueSet;
+            return (_enumValueSet != null);
+        }
+
+        /// <summary>
+        ///  Return whether this term compares a column (not an enum) to a non-null constant of the same type with an
+        ///  ordered or equality operator, so that it can be compiled into a whole-column ColumnPredicate.
+        /// </summary>
+        /// <param name="column">Column being compared</param>
+        /// <param name="op">Operator comparing column values to the constant</param>
+        /// <param name="value">Constant value, converted to the column type</param>
+        /// <returns>True if this term is a column compared to a constant, False otherwise</returns>
+        internal bool TryGetColumnConstant(out IXColumn column, out CompareOperator op, out object value)
+        {
+            column = _left;
+            op = _evaluateOp;
+            value = null;
+
+            if (op > CompareOperator.GreaterThanOrEqual) return false;
+            if (_left.IsConstantColumn() || _left.IsEnumColumn() || !_right.IsConstantColumn() || _right.IsNullConstant()) return false;
+            if (_left.ColumnDetails.Type != _right.ColumnDetails.Type) return false;
+
+            XArray rightValue = _right.ValuesGetter()();
+            value = rightValue.Array.GetValue(rightValue.Index(0));
+            return true;
         }
 
         public void Evaluate(BitVector result)
         {
+            if (_zoneMapGetter != null)
+            {
+                // If the zone map shows no rows on this page can match, or all rows do, skip reading and comparing them
+                ZoneMatch match = ((ZoneMapPage)_zoneMapGetter()).Match(_zoneMapOperator, _zoneMapValue);
+                if (match == ZoneMatch.None) return;
+
+                if (match == ZoneMatch.All)
+                {
+                    result.All(result.Capacity);
+                    return;
+                }
+            }
+
             _evaluate(result);
         }
 
@@ -388,7 +388,7 @@ namespace XForm.Query
 
             // Return the full expression
             if (terms.Count == 1) return terms[0];
-            return new OrExpression(terms.ToArray());
+            return ContainsAnyExpression.TryBuild(terms) ?? new OrExpression(terms.ToArray());
         }
 
         private IExpression NextAndExpression(IXTable source, XDatabaseContext context)
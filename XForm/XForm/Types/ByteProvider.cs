@@ -73,13 +73,20 @@ namespace XForm.Types
         public XArray Read(ArraySelector selector)
         {
             if (selector.Indices != null) throw new NotImplementedException();
+            return Read(selector.StartIndexInclusive, selector.Count);
+        }
 
-            Allocator.AllocateToSize(ref _array, selector.Count);
+        /// <summary>
+        ///  Read byteCount bytes from a 64-bit byte offset, for readers of wider types whose files exceed 2GB.
+        /// </summary>
+        public XArray Read(long byteOffset, int byteCount)
+        {
+            Allocator.AllocateToSize(ref _array, byteCount);
 
-            _stream.Seek(selector.StartIndexInclusive, SeekOrigin.Begin);
-            _stream.Read(_array, 0, selector.Count);
+            _stream.Seek(byteOffset, SeekOrigin.Begin);
+            _stream.Read(_array, 0, byteCount);
 
-            return XArray.All(_array, selector.Count);
+            return XArray.All(_array, byteCount);
         }
 
         public void Dispose()
@@ -15,6 +15,7 @@ namespace XForm.Types.Comparers
     internal class DoubleComparer : IXArrayComparer, IXArrayComparer<double>
     {
         internal static ComparerExtensions.WhereSingle<double> s_WhereSingleNative = null;
+        internal static ComparerExtensions.WhereSingleNullable<double> s_WhereSingleNullableNative = null;
         internal static ComparerExtensions.Where<double> s_WhereNative = null;
 
         public void GetHashCodes(XArray xarray, int[] hashes)
@@ -74,7 +75,14 @@ namespace XForm.Types.Comparers
                 int zeroOffset = left.Selector.StartIndexInclusive;
                 double rightValue = rightArray[0];
 
-                if (s_WhereSingleNative != null)
+                if (s_WhereSingleNullableNative != null)
+                {
+                    // Compare and remove left nulls in the same pass
+                    s_WhereSingleNullableNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.Equal, rightValue, left.NullRows, left.Selector.StartIndexInclusive, (byte)BooleanOperator.Or, vector.Array, 0);
+                    BoolComparer.AndNotNull(right, vector);
+                    return;
+                }
+                else if (s_WhereSingleNative != null)
                 {
                     s_WhereSingleNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.Equal, rightValue, (byte)BooleanOperator.Or, vector.Array, 0);
                 }
@@ -142,7 +150,14 @@ namespace XForm.Types.Comparers
                 int zeroOffset = left.Selector.StartIndexInclusive;
                 double rightValue = rightArray[0];
 
-                if (s_WhereSingleNative != null)
+                if (s_WhereSingleNullableNative != null)
+                {
+                    // Compare and remove left nulls in the same pass
+                    s_WhereSingleNullableNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.NotEqual, rightValue, left.NullRows, left.Selector.StartIndexInclusive, (byte)BooleanOperator.Or, vector.Array, 0);
+                    BoolComparer.AndNotNull(right, vector);
+                    return;
+                }
+                else if (s_WhereSingleNative != null)
                 {
                     s_WhereSingleNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.NotEqual, rightValue, (byte)BooleanOperator.Or, vector.Array, 0);
                 }
@@ -210,7 +225,14 @@ namespace XForm.Types.Comparers
                 int zeroOffset = left.Selector.StartIndexInclusive;
                 double rightValue = rightArray[0];
 
-                if (s_WhereSingleNative != null)
+                if (s_WhereSingleNullableNative != null)
+                {
+                    // Compare and remove left nulls in the same pass
+                    s_WhereSingleNullableNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.LessThan, rightValue, left.NullRows, left.Selector.StartIndexInclusive, (byte)BooleanOperator.Or, vector.Array, 0);
+                    BoolComparer.AndNotNull(right, vector);
+                    return;
+                }
+                else if (s_WhereSingleNative != null)
                 {
                     s_WhereSingleNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.LessThan, rightValue, (byte)BooleanOperator.Or, vector.Array, 0);
                 }
@@ -278,7 +300,14 @@ namespace XForm.Types.Comparers
                 int zeroOffset = left.Selector.StartIndexInclusive;
                 double rightValue = rightArray[0];
 
-                if (s_WhereSingleNative != null)
+                if (s_WhereSingleNullableNative != null)
+                {
+                    // Compare and remove left nulls in the same pass
+                    s_WhereSingleNullableNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.LessThanOrEqual, rightValue, left.NullRows, left.Selector.StartIndexInclusive, (byte)BooleanOperator.Or, vector.Array, 0);
+                    BoolComparer.AndNotNull(right, vector);
+                    return;
+                }
+                else if (s_WhereSingleNative != null)
                 {
                     s_WhereSingleNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.LessThanOrEqual, rightValue, (byte)BooleanOperator.Or, vector.Array, 0);
                 }
@@ -346,7 +375,14 @@ namespace XForm.Types.Comparers
                 int zeroOffset = left.Selector.StartIndexInclusive;
                 double rightValue = rightArray[0];
 
-                if (s_WhereSingleNative != null)
+                if (s_WhereSingleNullableNative != null)
+                {
+                    // Compare and remove left nulls in the same pass
+                    s_WhereSingleNullableNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.GreaterThan, rightValue, left.NullRows, left.Selector.StartIndexInclusive, (byte)BooleanOperator.Or, vector.Array, 0);
+                    BoolComparer.AndNotNull(right, vector);
+                    return;
+                }
+                else if (s_WhereSingleNative != null)
                 {
                     s_WhereSingleNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.GreaterThan, rightValue, (byte)BooleanOperator.Or, vector.Array, 0);
                 }
@@ -414,7 +450,14 @@ namespace XForm.Types.Comparers
                 int zeroOffset = left.Selector.StartIndexInclusive;
                 double rightValue = rightArray[0];
 
-                if (s_WhereSingleNative != null)
+                if (s_WhereSingleNullableNative != null)
+                {
+                    // Compare and remove left nulls in the same pass
+                    s_WhereSingleNullableNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.GreaterThanOrEqual, rightValue, left.NullRows, left.Selector.StartIndexInclusive, (byte)BooleanOperator.Or, vector.Array, 0);
+                    BoolComparer.AndNotNull(right, vector);
+                    return;
+                }
+                else if (s_WhereSingleNative != null)
                 {
                     s_WhereSingleNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, (byte)CompareOperator.GreaterThanOrEqual, rightValue, (byte)BooleanOperator.Or, vector.Array, 0);
                 }
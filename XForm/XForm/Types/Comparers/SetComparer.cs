@@ -16,15 +16,23 @@ namespace XForm.Types.Comparers
     /// </summary>
     internal class SetComparer
     {
+        public delegate void WhereInSignature(byte[] left, int index, int length, ulong[] valueSet, byte booleanOperator, ulong[] vector, int vectorIndex);
+        internal static WhereInSignature s_WhereInNative = null;
+
         private BitVector _set;
         private bool[] _array;
+        private ulong[] _valueSet;
 
-        private SetComparer(BitVector set)
+        public SetComparer(BitVector set)
         {
             _set = set;
 
             _array = null;
             _set.ToArray(ref _array);
+
+            // The native matcher takes the set as a 256-bit vector
+            _valueSet = new ulong[4];
+            Array.Copy(_set.Array, _valueSet, Math.Min(_set.Array.Length, _valueSet.Length));
         }
 
         /// <summary>
@@ -35,8 +43,9 @@ namespace XForm.Types.Comparers
         /// <param name="currentComparer">Current Comparison function requested by TermExpression</param>
         /// <param name="rightColumn">Constant being compared against</param>
         /// <param name="source">IXTable containing comparison</param>
+        /// <param name="set">Set of the indices of the EnumColumn values which match</param>
         /// <returns>Comparer to compare the (updated) right Constant to the EnumColumn.Indices (rather than Values)</returns>
-        public static ComparerExtensions.Comparer ConvertToEnumIndexComparer(IXColumn leftColumn, ComparerExtensions.Comparer currentComparer, ref IXColumn rightColumn, IXTable source)
+        public static ComparerExtensions.Comparer ConvertToEnumIndexComparer(IXColumn leftColumn, ComparerExtensions.Comparer currentComparer, ref IXColumn rightColumn, IXTable source, out BitVector set)
         {
             Func<XArray> valuesGetter = leftColumn.ValuesGetter();
             if (valuesGetter == null) throw new ArgumentException("ConvertToEnumIndexComparer is only valid for columns implementing Values.");
@@ -44,12 +53,13 @@ namespace XForm.Types.Comparers
             // Get all distinct values from the left side
             XArray left = valuesGetter();
 
+            // Get right side and compare
+            XArray right = rightColumn.ValuesGetter()();
+            set = new BitVector(left.Count);
+
             // If there are no values, return none
             if (left.Count == 0) return None;
 
-            // Get right side and compare
-            XArray right = rightColumn.ValuesGetter()();
-            BitVector set = new BitVector(left.Count);
             currentComparer(left, right, set);
 
             // NOTE: When EnumColumn values are sorted, can convert comparisons to non-equality native accelerated compare.
@@ -73,10 +83,10 @@ namespace XForm.Types.Comparers
             }
             else if (set.Count == left.Count - 1)
             {
-                set.Not();
+                BitVector notSet = new BitVector(left.Count).Set(set).Not();
 
                 // Convert the constant to the one non-matching index and make the comparison for index doesn't equal that
-                rightColumn = new ConstantColumn(source, (byte)set.GetSingle(), typeof(byte));
+                rightColumn = new ConstantColumn(source, (byte)notSet.GetSingle(), typeof(byte));
 
                 return TypeProviderFactory.Get(typeof(byte)).TryGetComparer(CompareOperator.NotEqual);
             }
@@ -121,6 +131,12 @@ namespace XForm.Types.Comparers
             else if (!left.Selector.IsSingleValue)
             {
                 // Fastest Path: Contiguous Array to constant.
+                if (s_WhereInNative != null)
+                {
+                    s_WhereInNative(leftArray, left.Selector.StartIndexInclusive, left.Selector.Count, _valueSet, (byte)BooleanOperator.Or, vector.Array, 0);
+                    return;
+                }
+
                 int zeroOffset = left.Selector.StartIndexInclusive;
                 for (int i = left.Selector.StartIndexInclusive; i < left.Selector.EndIndexExclusive; ++i)
                 {
@@ -23,6 +23,9 @@ namespace XForm.Types.Comparers
         public delegate int IndexOfAll(byte[] text, int textIndex, int textLength, byte[] value, int valueIndex, int valueLength, bool ignoreCase, int[] resultArray);
         internal static IndexOfAll s_IndexOfAllNative = null;
 
+        public delegate void WhereRaw(byte[] text, int textIndex, int[] rowEnds, int rowEndsIndex, int rowCount, int rowEndOffset, byte compareOperator, byte[] value, int valueIndex, int valueLength, byte booleanOperator, ulong[] vector);
+        internal static WhereRaw s_WhereRawNative = null;
+
         internal int[] _indicesBuffer;
 
         public void GetHashCodes(XArray xarray, int[] hashes)
@@ -670,6 +673,52 @@ namespace XForm.Types.Comparers
             }
         }
 
+        /// <summary>
+        ///  Return whether a String8 to constant comparison can run on the raw byte[] and int[] natively.
+        /// </summary>
+        /// <param name="cOp">CompareOperator to run</param>
+        /// <returns>True if a native raw comparison is available, False otherwise</returns>
+        public static bool CanWhereRaw(CompareOperator cOp)
+        {
+            if (s_WhereRawNative == null) return false;
+
+            switch (cOp)
+            {
+                case CompareOperator.Equal:
+                case CompareOperator.NotEqual:
+                case CompareOperator.LessThan:
+                case CompareOperator.LessThanOrEqual:
+                case CompareOperator.GreaterThan:
+                case CompareOperator.GreaterThanOrEqual:
+                case CompareOperator.StartsWith:
+                case CompareOperator.EndsWith:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        /// <summary>
+        ///  Where overload to compare String8 rows to a constant as a single block, natively.
+        ///  This is only available when comparing to a constant and before any other row filtering operations.
+        /// </summary>
+        /// <param name="left">Raw String8 byte[] and int[] for current rows</param>
+        /// <param name="cOp">CompareOperator to run (see CanWhereRaw)</param>
+        /// <param name="rightValue">Constant Value to compare to</param>
+        /// <param name="vector">BitVector to record matches to</param>
+        public void Where(String8Raw left, CompareOperator cOp, String8 rightValue, BitVector vector)
+        {
+            if (left.Selector.Count == 0) return;
+
+            int[] positions = (int[])left.Positions.Array;
+            bool includesFirstString = (left.Selector.StartIndexInclusive == 0);
+            int firstStringStart = (includesFirstString ? 0 : positions[left.Positions.Index(0)]);
+            int positionOffset = left.Positions.Index((includesFirstString ? 0 : 1));
+            int textOffset = firstStringStart - left.Bytes.Selector.StartIndexInclusive;
+
+            s_WhereRawNative((byte[])left.Bytes.Array, left.Bytes.Selector.StartIndexInclusive, positions, positionOffset, left.Selector.Count, textOffset, (byte)cOp, rightValue.Array, rightValue.Index, rightValue.Length, (byte)BooleanOperator.Or, vector.Array);
+        }
+
         public bool WhereContains(String8 left, String8 right)
         {
             return left.IndexOf(right) != -1;
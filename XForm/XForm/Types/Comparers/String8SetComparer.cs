@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+using Microsoft.CodeAnalysis.Elfie.Model.Strings;
+
+namespace XForm.Types.Comparers
+{
+    /// <summary>
+    ///  String8SetComparer finds String8 rows containing any of a set of values (case-insensitive, like Contains).
+    ///  With XForm.Native, it scans each page once with a multi-value matcher (Teddy for small sets, Aho-Corasick for large ones).
+    ///  Otherwise, it runs one WhereContains pass per value.
+    /// </summary>
+    internal class String8SetComparer : IDisposable
+    {
+        public delegate IntPtr Build(byte[] values, int[] valueEnds, int valueCount, bool ignoreCase);
+        public delegate void WhereContainsAnySignature(IntPtr set, byte[] text, int textIndex, int[] rowEnds, int rowEndsIndex, int rowCount, int rowEndOffset, ulong[] vector);
+
+        internal static Build s_BuildNative = null;
+        internal static Action<IntPtr> s_FreeNative = null;
+        internal static WhereContainsAnySignature s_WhereContainsAnyNative = null;
+
+        private String8[] _values;
+        private IntPtr _set;
+
+        private String8Comparer _comparer;
+        private BitVector _valueVector;
+
+        public String8SetComparer(String8[] values)
+        {
+            _values = values;
+
+            if (s_BuildNative != null)
+            {
+                // Concatenate the values for the native matcher
+                int[] valueEnds = new int[values.Length];
+
+                int totalLength = 0;
+                for (int i = 0; i < values.Length; ++i)
+                {
+                    totalLength += values[i].Length;
+                    valueEnds[i] = totalLength;
+                }
+
+                byte[] valueBytes = new byte[totalLength];
+                for (int i = 0; i < values.Length; ++i)
+                {
+                    values[i].WriteTo(valueBytes, valueEnds[i] - values[i].Length);
+                }
+
+                _set = s_BuildNative(valueBytes, valueEnds, values.Length, true);
+            }
+            else
+            {
+                _comparer = new String8Comparer();
+            }
+        }
+
+        /// <summary>
+        ///  Find rows containing any of the values. Like WhereContains, this compares the raw String8 byte[] and int[]
+        ///  and is only available before any other row filtering operations.
+        /// </summary>
+        /// <param name="left">Raw String8 byte[] and int[] for current rows</param>
+        /// <param name="vector">BitVector to record matches to</param>
+        public void WhereContainsAny(String8Raw left, BitVector vector)
+        {
+            if (_set != IntPtr.Zero)
+            {
+                int[] positions = (int[])left.Positions.Array;
+                bool includesFirstString = (left.Selector.StartIndexInclusive == 0);
+                int firstStringStart = (includesFirstString ? 0 : positions[left.Positions.Index(0)]);
+                int positionOffset = left.Positions.Index((includesFirstString ? 0 : 1));
+                int textOffset = firstStringStart - left.Bytes.Selector.StartIndexInclusive;
+
+                s_WhereContainsAnyNative(_set, (byte[])left.Bytes.Array, left.Bytes.Selector.StartIndexInclusive, positions, positionOffset, left.Selector.Count, textOffset, vector.Array);
+            }
+            else
+            {
+                Allocator.RentToSize(ref _valueVector, vector.Capacity);
+
+                foreach (String8 value in _values)
+                {
+                    _valueVector.None();
+                    _comparer.WhereContains(left, value, _valueVector);
+                    vector.Or(_valueVector);
+                }
+            }
+        }
+
+        ~String8SetComparer()
+        {
+            Dispose();
+        }
+
+        public void Dispose()
+        {
+            Allocator.Return(ref _valueVector);
+
+            if (_set != IntPtr.Zero)
+            {
+                s_FreeNative(_set);
+                _set = IntPtr.Zero;
+                GC.SuppressFinalize(this);
+            }
+        }
+    }
+}
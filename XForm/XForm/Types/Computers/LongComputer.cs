@@ -7,9 +7,12 @@ namespace XForm.Types.Computers
     {
         private long[] _buffer;
         private bool[] _isNull;
+        private NativeComputer<long> _native = new NativeComputer<long>();
 
         public XArray Subtract(XArray left, XArray right)
         {
+            if (NativeComputer<long>.IsAvailable) return _native.Subtract(left, right);
+
             long[] leftArray = (long[])left.Array;
             long[] rightArray = (long[])right.Array;
 
@@ -31,17 +34,17 @@ namespace XForm.Types.Computers
                     int index2 = right.Index(i);
 
                     bool rowIsNull = (left.HasNulls && left.NullRows[index1]) || (right.HasNulls && right.NullRows[index2]);
-                    areAnyNull |= rowIsNull;
 
-                    _isNull[i] = rowIsNull;
-                    _buffer[i] = leftArray[index1] - rightArray[index2];
+                    SubtractSafe(leftArray[index1], rightArray[index2], out _buffer[i], out _isNull[i], ref areAnyNull);
+                    _isNull[i] |= rowIsNull;
+                    areAnyNull |= rowIsNull;
                 }
             }
             else if (left.Selector.Indices != null || right.Selector.Indices != null)
             {
                 for (int i = 0; i < left.Count; ++i)
                 {
-                    _buffer[i] = leftArray[left.Index(i)] - rightArray[right.Index(i)];
+                    SubtractSafe(leftArray[left.Index(i)], rightArray[right.Index(i)], out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else if (!right.Selector.IsSingleValue && !left.Selector.IsSingleValue)
@@ -50,7 +53,7 @@ namespace XForm.Types.Computers
                 int rightStart = right.Selector.StartIndexInclusive;
                 for (int i = 0; i < count; ++i)
                 {
-                    _buffer[i] = leftArray[i + leftStart] - rightArray[i + rightStart];
+                    SubtractSafe(leftArray[i + leftStart], rightArray[i + rightStart], out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else if (!left.Selector.IsSingleValue)
@@ -60,7 +63,7 @@ namespace XForm.Types.Computers
 
                 for (int i = 0; i < count; ++i)
                 {
-                    _buffer[i] = leftArray[i + leftStart] - rightValue;
+                    SubtractSafe(leftArray[i + leftStart], rightValue, out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else if (!right.Selector.IsSingleValue)
@@ -70,13 +73,13 @@ namespace XForm.Types.Computers
 
                 for (int i = 0; i < count; ++i)
                 {
-                    _buffer[i] = leftValue - rightArray[i + rightStart];
+                    SubtractSafe(leftValue, rightArray[i + rightStart], out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else
             {
-                _buffer[0] = leftArray[left.Selector.StartIndexInclusive] - rightArray[right.Selector.StartIndexInclusive];
-                return XArray.Single(_buffer, count);
+                SubtractSafe(leftArray[left.Selector.StartIndexInclusive], rightArray[right.Selector.StartIndexInclusive], out _buffer[0], out _isNull[0], ref areAnyNull);
+                return (areAnyNull ? XArray.Null(_buffer, count) : XArray.Single(_buffer, count));
             }
 
             return XArray.All(_buffer, count, (areAnyNull ? _isNull : null));
@@ -84,6 +87,8 @@ namespace XForm.Types.Computers
 
         public XArray Add(XArray left, XArray right)
         {
+            if (NativeComputer<long>.IsAvailable) return _native.Add(left, right);
+
             long[] leftArray = (long[])left.Array;
             long[] rightArray = (long[])right.Array;
 
@@ -105,17 +110,17 @@ namespace XForm.Types.Computers
                     int index2 = right.Index(i);
 
                     bool rowIsNull = (left.HasNulls && left.NullRows[index1]) || (right.HasNulls && right.NullRows[index2]);
-                    areAnyNull |= rowIsNull;
 
-                    _isNull[i] = rowIsNull;
-                    _buffer[i] = leftArray[index1] + rightArray[index2];
+                    AddSafe(leftArray[index1], rightArray[index2], out _buffer[i], out _isNull[i], ref areAnyNull);
+                    _isNull[i] |= rowIsNull;
+                    areAnyNull |= rowIsNull;
                 }
             }
             else if (left.Selector.Indices != null || right.Selector.Indices != null)
             {
                 for (int i = 0; i < left.Count; ++i)
                 {
-                    _buffer[i] = leftArray[left.Index(i)] + rightArray[right.Index(i)];
+                    AddSafe(leftArray[left.Index(i)], rightArray[right.Index(i)], out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else if (!right.Selector.IsSingleValue && !left.Selector.IsSingleValue)
@@ -124,7 +129,7 @@ namespace XForm.Types.Computers
                 int rightStart = right.Selector.StartIndexInclusive;
                 for (int i = 0; i < count; ++i)
                 {
-                    _buffer[i] = leftArray[i + leftStart] + rightArray[i + rightStart];
+                    AddSafe(leftArray[i + leftStart], rightArray[i + rightStart], out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else if (!left.Selector.IsSingleValue)
@@ -134,7 +139,7 @@ namespace XForm.Types.Computers
 
                 for (int i = 0; i < count; ++i)
                 {
-                    _buffer[i] = leftArray[i + leftStart] + rightValue;
+                    AddSafe(leftArray[i + leftStart], rightValue, out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else if (!right.Selector.IsSingleValue)
@@ -144,13 +149,13 @@ namespace XForm.Types.Computers
 
                 for (int i = 0; i < count; ++i)
                 {
-                    _buffer[i] = leftValue + rightArray[i + rightStart];
+                    AddSafe(leftValue, rightArray[i + rightStart], out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else
             {
-                _buffer[0] = leftArray[left.Selector.StartIndexInclusive] + rightArray[right.Selector.StartIndexInclusive];
-                return XArray.Single(_buffer, count);
+                AddSafe(leftArray[left.Selector.StartIndexInclusive], rightArray[right.Selector.StartIndexInclusive], out _buffer[0], out _isNull[0], ref areAnyNull);
+                return (areAnyNull ? XArray.Null(_buffer, count) : XArray.Single(_buffer, count));
             }
 
             return XArray.All(_buffer, count, (areAnyNull ? _isNull : null));
@@ -158,6 +163,8 @@ namespace XForm.Types.Computers
 
         public XArray Multiply(XArray left, XArray right)
         {
+            if (NativeComputer<long>.IsAvailable) return _native.Multiply(left, right);
+
             long[] leftArray = (long[])left.Array;
             long[] rightArray = (long[])right.Array;
 
@@ -179,17 +186,17 @@ namespace XForm.Types.Computers
                     int index2 = right.Index(i);
 
                     bool rowIsNull = (left.HasNulls && left.NullRows[index1]) || (right.HasNulls && right.NullRows[index2]);
-                    areAnyNull |= rowIsNull;
 
-                    _isNull[i] = rowIsNull;
-                    _buffer[i] = leftArray[index1] * rightArray[index2];
+                    MultiplySafe(leftArray[index1], rightArray[index2], out _buffer[i], out _isNull[i], ref areAnyNull);
+                    _isNull[i] |= rowIsNull;
+                    areAnyNull |= rowIsNull;
                 }
             }
             else if (left.Selector.Indices != null || right.Selector.Indices != null)
             {
                 for (int i = 0; i < left.Count; ++i)
                 {
-                    _buffer[i] = leftArray[left.Index(i)] * rightArray[right.Index(i)];
+                    MultiplySafe(leftArray[left.Index(i)], rightArray[right.Index(i)], out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else if (!right.Selector.IsSingleValue && !left.Selector.IsSingleValue)
@@ -198,7 +205,7 @@ namespace XForm.Types.Computers
                 int rightStart = right.Selector.StartIndexInclusive;
                 for (int i = 0; i < count; ++i)
                 {
-                    _buffer[i] = leftArray[i + leftStart] * rightArray[i + rightStart];
+                    MultiplySafe(leftArray[i + leftStart], rightArray[i + rightStart], out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else if (!left.Selector.IsSingleValue)
@@ -208,7 +215,7 @@ namespace XForm.Types.Computers
 
                 for (int i = 0; i < count; ++i)
                 {
-                    _buffer[i] = leftArray[i + leftStart] * rightValue;
+                    MultiplySafe(leftArray[i + leftStart], rightValue, out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else if (!right.Selector.IsSingleValue)
@@ -218,13 +225,13 @@ namespace XForm.Types.Computers
 
                 for (int i = 0; i < count; ++i)
                 {
-                    _buffer[i] = leftValue * rightArray[i + rightStart];
+                    MultiplySafe(leftValue, rightArray[i + rightStart], out _buffer[i], out _isNull[i], ref areAnyNull);
                 }
             }
             else
             {
-                _buffer[0] = leftArray[left.Selector.StartIndexInclusive] * rightArray[right.Selector.StartIndexInclusive];
-                return XArray.Single(_buffer, count);
+                MultiplySafe(leftArray[left.Selector.StartIndexInclusive], rightArray[right.Selector.StartIndexInclusive], out _buffer[0], out _isNull[0], ref areAnyNull);
+                return (areAnyNull ? XArray.Null(_buffer, count) : XArray.Single(_buffer, count));
             }
 
             return XArray.All(_buffer, count, (areAnyNull ? _isNull : null));
@@ -232,6 +239,8 @@ namespace XForm.Types.Computers
 
         public XArray Divide(XArray left, XArray right)
         {
+            if (NativeComputer<long>.IsAvailable) return _native.Divide(left, right);
+
             long[] leftArray = (long[])left.Array;
             long[] rightArray = (long[])right.Array;
 
@@ -304,9 +313,31 @@ namespace XForm.Types.Computers
             return XArray.All(_buffer, count, (areAnyNull ? _isNull : null));
         }
 
+        // Results which overflow are null, as are quotients with a zero divisor
+        private static void AddSafe(long left, long right, out long result, out bool isNull, ref bool areAnyNull)
+        {
+            result = unchecked(left + right);
+            isNull = ((left ^ result) & (right ^ result)) < 0;
+            areAnyNull |= isNull;
+        }
+
+        private static void SubtractSafe(long left, long right, out long result, out bool isNull, ref bool areAnyNull)
+        {
+            result = unchecked(left - right);
+            isNull = ((left ^ right) & (left ^ result)) < 0;
+            areAnyNull |= isNull;
+        }
+
+        private static void MultiplySafe(long left, long right, out long result, out bool isNull, ref bool areAnyNull)
+        {
+            result = unchecked(left * right);
+            isNull = (left == -1 && right == long.MinValue) || (left != 0 && result / left != right);
+            areAnyNull |= isNull;
+        }
+
         private static void DivideSafe(long numerator, long denominator, out long result, out bool isNull, ref bool areAnyNull)
         {
-            isNull = (denominator == 0);
+            isNull = (denominator == 0 || (denominator == -1 && numerator == long.MinValue));
             result = (isNull ? 0 : numerator / denominator);
             areAnyNull |= isNull;
         }
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+
+using XForm.Data;
+
+namespace XForm.Types.Computers
+{
+    /// <summary>
+    ///  NativeComputer runs IXArrayComputer operations with the native (AVX2) arithmetic kernels.
+    ///  Rows where either side is null, the result overflows, or the divisor is zero are null in the result.
+    ///
+    ///  The kernels handle contiguous and single value sides; sides with indices are gathered into contiguous buffers first.
+    ///  Only long is bound, since the arithmetic functions cast their arguments to long.
+    /// </summary>
+    /// <typeparam name="T">Type of values computed</typeparam>
+    internal class NativeComputer<T>
+    {
+        internal delegate int ComputeSignature(T[] left, int leftIndex, bool leftIsSingle, bool[] leftNulls, T[] right, int rightIndex, bool rightIsSingle, bool[] rightNulls, int count, T[] result, bool[] resultNulls);
+        internal static ComputeSignature s_AddNative;
+        internal static ComputeSignature s_SubtractNative;
+        internal static ComputeSignature s_MultiplyNative;
+        internal static ComputeSignature s_DivideNative;
+
+        private T[] _buffer;
+        private bool[] _isNull;
+
+        private T[] _leftValues;
+        private bool[] _leftNulls;
+        private T[] _rightValues;
+        private bool[] _rightNulls;
+
+        public static bool IsAvailable => (s_AddNative != null && s_SubtractNative != null && s_MultiplyNative != null && s_DivideNative != null);
+
+        public XArray Add(XArray left, XArray right)
+        {
+            return Compute(s_AddNative, left, right);
+        }
+
+        public XArray Subtract(XArray left, XArray right)
+        {
+            return Compute(s_SubtractNative, left, right);
+        }
+
+        public XArray Multiply(XArray left, XArray right)
+        {
+            return Compute(s_MultiplyNative, left, right);
+        }
+
+        public XArray Divide(XArray left, XArray right)
+        {
+            return Compute(s_DivideNative, left, right);
+        }
+
+        private XArray Compute(ComputeSignature kernel, XArray left, XArray right)
+        {
+            int count = left.Count;
+            if (right.Count != count) throw new InvalidOperationException("Computations must get the same number of rows from each argument.");
+
+            // Gather sides with indices into contiguous arrays
+            if (left.Selector.Indices != null) left = left.ToContiguous(ref _leftValues, ref _leftNulls);
+            if (right.Selector.Indices != null) right = right.ToContiguous(ref _rightValues, ref _rightNulls);
+
+            // Allocate for results
+            Allocator.AllocateToSize(ref _buffer, count);
+            Allocator.AllocateToSize(ref _isNull, count);
+
+            // If both sides are single values, compute the single result only
+            bool isSingle = (left.Selector.IsSingleValue && right.Selector.IsSingleValue);
+
+            int nullCount = kernel(
+                (T[])left.Array, left.Selector.StartIndexInclusive, left.Selector.IsSingleValue, left.NullRows,
+                (T[])right.Array, right.Selector.StartIndexInclusive, right.Selector.IsSingleValue, right.NullRows,
+                (isSingle ? Math.Min(1, count) : count), _buffer, _isNull);
+
+            if (isSingle) return (nullCount > 0 ? XArray.Null(_buffer, count) : XArray.Single(_buffer, count));
+            return XArray.All(_buffer, count, (nullCount > 0 ? _isNull : null));
+        }
+    }
+}
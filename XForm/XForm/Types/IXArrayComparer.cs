@@ -45,6 +45,7 @@ namespace XForm.Types
         public delegate void Comparer(XArray left, XArray right, BitVector vector);
 
         public delegate void WhereSingle<T>(T[] left, int index, int length, byte compareOperator, T right, byte booleanOperator, ulong[] vector, int vectorIndex);
+        public delegate void WhereSingleNullable<T>(T[] left, int index, int length, byte compareOperator, T right, bool[] nulls, int nullsIndex, byte booleanOperator, ulong[] vector, int vectorIndex);
         public delegate void Where<T>(T[] left, int leftIndex, byte compareOperator, T[] right, int rightIndex, int length, byte booleanOperator, ulong[] vector, int vectorIndex);
 
         public static Comparer TryBuild(this IXArrayComparer comparer, CompareOperator cOp)
@@ -28,6 +28,14 @@ namespace XForm.Types
             return ColumnCache.Instance.GetOrBuild(columnPath, option, () =>
             {
                 string filePath = ValuesFilePath(columnPath);
+
+                // Read the packed values, if the column was written packed
+                if (PackedArray.IsSupported(typeof(T)))
+                {
+                    string packedFilePath = PackedArray.PackedFilePath(filePath);
+                    if (streamProvider.UncachedExists(packedFilePath)) return new PackedArrayReader<T>(streamProvider.OpenRead(packedFilePath));
+                }
+
                 if (!streamProvider.UncachedExists(filePath)) return null;
                 return new PrimitiveArrayReader<T>(streamProvider.OpenRead(filePath));
             });
@@ -35,9 +43,21 @@ namespace XForm.Types
 
         public IColumnWriter BinaryWriter(IStreamProvider streamProvider, string columnPath)
         {
+            if (PackedArray.IsEnabled && PackedArray.IsSupported(typeof(T)))
+            {
+                return new PackedArrayWriter<T>(streamProvider.OpenWrite(PackedArray.PackedFilePath(ValuesFilePath(columnPath))));
+            }
+
             return new PrimitiveArrayWriter<T>(streamProvider.OpenWrite(ValuesFilePath(columnPath)));
         }
 
+        public static bool ValuesExist(IStreamProvider streamProvider, string columnPath)
+        {
+            string filePath = ValuesFilePath(columnPath);
+            if (PackedArray.IsSupported(typeof(T)) && streamProvider.UncachedExists(PackedArray.PackedFilePath(filePath))) return true;
+            return streamProvider.UncachedExists(filePath);
+        }
+
         public NegatedTryConvert TryGetNegatedTryConvert(Type sourceType, Type targetType, object defaultValue)
         {
             return PrimitiveConverterFactory.TryGetNegatedTryConvert(sourceType, targetType, defaultValue);
@@ -97,12 +117,16 @@ namespace XForm.Types
         }
     }
 
-    public class PrimitiveArrayReader<T> : IColumnReader
+    public class PrimitiveArrayReader<T> : IColumnReader, IColumnMemoryReader
     {
         private const int ReadPageSize = 64 * 1024;
 
+        // Pages are pooled, except byte pages, which String8 values returned to callers point into
+        private static readonly bool s_poolPages = (typeof(T) != typeof(byte));
+
         private int _bytesPerItem;
         private ByteReader _byteReader;
+        private MappedFileStream _mappedStream;
         private T[] _array;
 
         private XArray _currentArray;
@@ -111,10 +135,18 @@ namespace XForm.Types
         public PrimitiveArrayReader(Stream stream)
         {
             _byteReader = new ByteReader(stream);
+            _mappedStream = stream as MappedFileStream;
             _bytesPerItem = (typeof(T) == typeof(bool) ? 1 : Marshal.SizeOf<T>());
         }
 
-        public int Count => (int)(_byteReader.Count / _bytesPerItem);
+        public int Count => (int)(_byteReader.Length / _bytesPerItem);
+
+        public ColumnMemory TryGetMemory()
+        {
+            // Only memory-mapped files can be read in place
+            if (_mappedStream == null || _mappedStream.Address == IntPtr.Zero) return null;
+            return new ColumnMemory(typeof(T), Count, _mappedStream.Address);
+        }
 
         public XArray Read(ArraySelector selector)
         {
@@ -124,18 +156,33 @@ namespace XForm.Types
             if (selector.Equals(_currentSelector)) return _currentArray;
 
             // Allocate the result array
-            Allocator.AllocateToSize(ref _array, selector.Count);
+            if (s_poolPages)
+            {
+                Allocator.RentToSize(ref _array, selector.Count);
+            }
+            else
+            {
+                Allocator.AllocateToSize(ref _array, selector.Count);
+            }
 
-            // Read items in pages of 64k
-            int byteStart = _bytesPerItem * selector.StartIndexInclusive;
-            int byteEnd = _bytesPerItem * selector.EndIndexExclusive;
-            int bytesRead = 0;
-            for (int currentByteIndex = byteStart; currentByteIndex < byteEnd; currentByteIndex += ReadPageSize)
+            // Byte offsets are 64-bit, so columns of wider types may have up to int.MaxValue rows
+            long byteStart = (long)_bytesPerItem * selector.StartIndexInclusive;
+            int byteCount = _bytesPerItem * selector.Count;
+
+            if (_mappedStream != null)
+            {
+                // If the file is memory-mapped, copy the values directly from the mapping
+                _mappedStream.Read(byteStart, _array, 0, byteCount);
+            }
+            else
             {
-                int currentByteEnd = Math.Min(byteEnd, currentByteIndex + ReadPageSize);
-                XArray bytexarray = _byteReader.Read(ArraySelector.All(int.MaxValue).Slice(currentByteIndex, currentByteEnd));
-                Buffer.BlockCopy(bytexarray.Array, 0, _array, bytesRead, bytexarray.Count);
-                bytesRead += currentByteEnd - currentByteIndex;
+                // Read items in pages of 64k
+                for (int bytesRead = 0; bytesRead < byteCount; bytesRead += ReadPageSize)
+                {
+                    int pageByteCount = Math.Min(byteCount - bytesRead, ReadPageSize);
+                    XArray bytexarray = _byteReader.Read(byteStart + bytesRead, pageByteCount);
+                    Buffer.BlockCopy(bytexarray.Array, 0, _array, bytesRead, pageByteCount);
+                }
             }
 
             // Cache and return the current xarray
@@ -151,6 +198,8 @@ namespace XForm.Types
                 _byteReader.Dispose();
                 _byteReader = null;
             }
+
+            if (s_poolPages) Allocator.Return(ref _array);
         }
     }
 
@@ -159,6 +208,7 @@ namespace XForm.Types
         private int _bytesPerItem;
         private Stream _stream;
         private byte[] _bytesBuffer;
+        private T[] _gatherBuffer;
         private long _bytesWritten;
 
         public PrimitiveArrayWriter(Stream stream)
@@ -179,12 +229,19 @@ namespace XForm.Types
         public void Append(XArray array)
         {
             int bytesToWrite = _bytesPerItem * array.Count;
-            Allocator.AllocateToSize(ref _bytesBuffer, bytesToWrite);
+            Allocator.RentToSize(ref _bytesBuffer, bytesToWrite);
 
             if (array.Selector.Indices == null && array.Selector.IsSingleValue == false)
             {
                 Buffer.BlockCopy(array.Array, _bytesPerItem * array.Selector.StartIndexInclusive, _bytesBuffer, 0, bytesToWrite);
             }
+            else if (array.Selector.Indices != null && array.Array is T[])
+            {
+                // Gather the indexed values contiguously, then copy them in one block
+                Allocator.RentToSize(ref _gatherBuffer, array.Count);
+                Gatherer<T>.Gather((T[])array.Array, 0, array.Selector.Indices, array.Selector.StartIndexInclusive, array.Count, _gatherBuffer);
+                Buffer.BlockCopy(_gatherBuffer, 0, _bytesBuffer, 0, bytesToWrite);
+            }
             else
             {
                 for (int i = 0; i < array.Count; ++i)
@@ -205,6 +262,9 @@ namespace XForm.Types
                 _stream.Dispose();
                 _stream = null;
             }
+
+            Allocator.Return(ref _bytesBuffer);
+            Allocator.Return(ref _gatherBuffer);
         }
     }
 }
@@ -47,7 +47,7 @@ namespace XForm.Types
             if (targetType == typeof(String8))
             {
                 if (sourceType == typeof(string)) return new StringToString8Converter(defaultValue).StringToString8;
-                if (sourceType == typeof(DateTime)) return new ToString8Converter<DateTime>(defaultValue, 20, String8.FromDateTime).Convert;
+                if (sourceType == typeof(DateTime)) return new ToString8Converter<DateTime>(defaultValue, 20, String8.FromDateTime, (value) => value.Ticks).Convert;
                 if (sourceType == typeof(bool)) return new ToString8Converter<bool>(defaultValue, 0, (value, buffer, index) => String8.FromBoolean(value)).Convert;
                 if (sourceType == typeof(TimeSpan)) return new ToString8Converter<TimeSpan>(defaultValue, 21, String8.FromTimeSpan).Convert;
 
@@ -75,12 +75,12 @@ namespace XForm.Types
                 }
                 else if (targetType == typeof(DateTime))
                 {
-                    return new FromString8Converter<DateTime>(defaultValue, (String8 value, out DateTime result) => value.TryToDateTime(out result)).Convert;
+                    return new FromString8Converter<DateTime>(defaultValue, (String8 value, out DateTime result) => value.TryToDateTime(out result), (ticks) => new DateTime(ticks, DateTimeKind.Utc)).Convert;
                 }
                 else if (targetType == typeof(TimeSpan))
                 {
                     // Support TimeSpan conversions from .NET Format (DDD.HH:MM:SS.mmm) and 'friendly' format (24h, 7d)
-                    return new FromString8Converter<TimeSpan>(defaultValue, (String8 value, out TimeSpan result) => value.TryToTimeSpanFriendly(out result)).Convert;
+                    return new FromString8Converter<TimeSpan>(defaultValue, (String8 value, out TimeSpan result) => value.TryToTimeSpanFriendly(out result), (ticks) => new TimeSpan(ticks)).Convert;
                 }
                 else if (targetType == typeof(bool))
                 {
@@ -153,6 +153,9 @@ namespace XForm.Types
 
     internal class String8ColumnReader : IColumnReader
     {
+        internal delegate void GatherRangesSignature(int[] ends, int[] indices, int indicesIndex, int count, int[] starts, int[] lengths);
+        internal static GatherRangesSignature s_GatherRangesNative;
+
         private string _columnPath;
 
         private IStreamProvider _streamProvider;
@@ -163,6 +166,8 @@ namespace XForm.Types
         private XArray _currentArray;
         private ArraySelector _currentSelector;
         private String8[] _resultArray;
+        private int[] _startsBuffer;
+        private int[] _lengthsBuffer;
 
         public String8ColumnReader(IStreamProvider streamProvider, string columnPath, CachingOption option)
         {
@@ -245,13 +250,28 @@ namespace XForm.Types
             XArray bytes = _bytesReader.Read(ArraySelector.All(_bytesReader.Count));
             byte[] textArray = (byte[])bytes.Array;
 
-            // Update the String8 array to point to them
-            for (int i = 0; i < selector.Count; ++i)
+            // Gather the row ranges natively, if available
+            if (s_GatherRangesNative != null)
+            {
+                Allocator.AllocateToSize(ref _startsBuffer, selector.Count);
+                Allocator.AllocateToSize(ref _lengthsBuffer, selector.Count);
+                s_GatherRangesNative(positionArray, selector.Indices, selector.StartIndexInclusive, selector.Count, _startsBuffer, _lengthsBuffer);
+
+                for (int i = 0; i < selector.Count; ++i)
+                {
+                    _resultArray[i] = new String8(textArray, _startsBuffer[i], _lengthsBuffer[i]);
+                }
+            }
+            else
             {
-                int rowIndex = selector.Index(i);
-                int valueStart = (rowIndex == 0 ? 0 : positionArray[rowIndex - 1]);
-                int valueEnd = positionArray[rowIndex];
-                _resultArray[i] = new String8(textArray, valueStart, valueEnd - valueStart);
+                // Update the String8 array to point to them
+                for (int i = 0; i < selector.Count; ++i)
+                {
+                    int rowIndex = selector.Index(i);
+                    int valueStart = (rowIndex == 0 ? 0 : positionArray[rowIndex - 1]);
+                    int valueEnd = positionArray[rowIndex];
+                    _resultArray[i] = new String8(textArray, valueStart, valueEnd - valueStart);
+                }
             }
 
             // Cache the xarray and return it
@@ -280,7 +300,7 @@ namespace XForm.Types
     {
         private IStreamProvider _streamProvider;
         private Stream _bytesWriter;
-        private PrimitiveArrayWriter<int> _positionsWriter;
+        private IColumnWriter _positionsWriter;
 
         private int[] _positionsBuffer;
         private int _position;
@@ -289,7 +309,7 @@ namespace XForm.Types
         {
             _streamProvider = streamProvider;
             _bytesWriter = _streamProvider.OpenWrite(Path.Combine(columnPath, "V.s.bin"));
-            _positionsWriter = new PrimitiveArrayWriter<int>(streamProvider.OpenWrite(Path.Combine(columnPath, "Vp.i32.bin")));
+            _positionsWriter = TypeProviderFactory.Get(typeof(int)).BinaryWriter(streamProvider, Path.Combine(columnPath, "Vp.i32.bin"));
         }
 
         public Type WritingAsType => typeof(String8);
@@ -311,7 +331,7 @@ namespace XForm.Types
 
         public void Append(XArray xarray)
         {
-            Allocator.AllocateToSize(ref _positionsBuffer, xarray.Count);
+            Allocator.RentToSize(ref _positionsBuffer, xarray.Count);
 
             String8[] array = (String8[])xarray.Array;
             for (int i = 0; i < xarray.Count; ++i)
@@ -338,6 +358,8 @@ namespace XForm.Types
                 _positionsWriter.Dispose();
                 _positionsWriter = null;
             }
+
+            Allocator.Return(ref _positionsBuffer);
         }
     }
 
@@ -347,10 +369,16 @@ namespace XForm.Types
         private Func<T, byte[], int, String8> _converter;
         private int _bytesPerItem;
 
+        public delegate int FormatTicksBatch(long[] ticks, int count, byte[] buffer, int[] ends);
+        internal static FormatTicksBatch s_FormatTicksBatchNative = null;
+        private Func<T, long> _toTicks;
+
         private byte[] _buffer;
         private String8[] _string8Array;
+        private long[] _ticksArray;
+        private int[] _endsArray;
 
-        public ToString8Converter(object defaultValue, int bytesPerItem, Func<T, byte[], int, String8> converter)
+        public ToString8Converter(object defaultValue, int bytesPerItem, Func<T, byte[], int, String8> converter, Func<T, long> toTicks = null)
         {
             if (defaultValue == null)
             {
@@ -368,6 +396,7 @@ namespace XForm.Types
 
             _converter = converter;
             _bytesPerItem = bytesPerItem;
+            _toTicks = toTicks;
         }
 
         public bool[] Convert(XArray xarray, out Array result)
@@ -375,6 +404,13 @@ namespace XForm.Types
             Allocator.AllocateToSize(ref _string8Array, xarray.Count);
             Allocator.AllocateToSize(ref _buffer, xarray.Count * _bytesPerItem);
 
+            if (s_FormatTicksBatchNative != null && _toTicks != null)
+            {
+                ConvertTicksNative(xarray);
+                result = _string8Array;
+                return null;
+            }
+
             int bufferBytesUsed = 0;
             T[] sourceArray = (T[])xarray.Array;
             for (int i = 0; i < xarray.Count; ++i)
@@ -396,6 +432,43 @@ namespace XForm.Types
             result = _string8Array;
             return null;
         }
+
+        private void ConvertTicksNative(XArray xarray)
+        {
+            Allocator.AllocateToSize(ref _ticksArray, xarray.Count);
+            Allocator.AllocateToSize(ref _endsArray, xarray.Count);
+
+            // Get the ticks for the non-null values
+            int valueCount = 0;
+            T[] sourceArray = (T[])xarray.Array;
+            for (int i = 0; i < xarray.Count; ++i)
+            {
+                int index = xarray.Index(i);
+                if (xarray.HasNulls && xarray.NullRows[index]) continue;
+                _ticksArray[valueCount++] = _toTicks(sourceArray[index]);
+            }
+
+            // Format them all natively
+            s_FormatTicksBatchNative(_ticksArray, valueCount, _buffer, _endsArray);
+
+            // Build String8s for each value, using the default for nulls
+            int valueIndex = 0;
+            int start = 0;
+            for (int i = 0; i < xarray.Count; ++i)
+            {
+                int index = xarray.Index(i);
+                if (xarray.HasNulls && xarray.NullRows[index])
+                {
+                    _string8Array[i] = _defaultValue;
+                }
+                else
+                {
+                    int end = _endsArray[valueIndex++];
+                    _string8Array[i] = new String8(_buffer, start, end - start);
+                    start = end;
+                }
+            }
+        }
     }
 
     internal class StringToString8Converter
@@ -462,14 +535,25 @@ namespace XForm.Types
         public delegate bool TryConvert(String8 value, out T result);
         private TryConvert _tryConvert;
 
+        public delegate int ParseBatch(byte[] text, int[] starts, int[] lengths, int count, T[] result, bool[] couldNotConvert);
+        internal static ParseBatch s_ParseBatchNative = null;
+
+        public delegate int ParseTicksBatch(byte[] text, int[] starts, int[] lengths, int count, long[] ticks, bool[] couldNotParse);
+        internal static ParseTicksBatch s_ParseTicksBatchNative = null;
+        private Func<long, T> _fromTicks;
+
         private T _defaultValue;
 
         private T[] _array;
         private bool[] _couldNotConvertArray;
+        private int[] _startsArray;
+        private int[] _lengthsArray;
+        private long[] _ticksArray;
 
-        public FromString8Converter(object defaultValue, TryConvert tryConvert)
+        public FromString8Converter(object defaultValue, TryConvert tryConvert, Func<long, T> fromTicks = null)
         {
             _tryConvert = tryConvert;
+            _fromTicks = fromTicks;
             _defaultValue = (T)(TypeConverterFactory.ConvertSingle(defaultValue, typeof(T)) ?? default(T));
         }
 
@@ -480,8 +564,19 @@ namespace XForm.Types
 
             bool anyCouldNotConvert = false;
             String8[] sourceArray = (String8[])xarray.Array;
+            byte[] text;
 
-            if (!xarray.Selector.IsSingleValue)
+            if (!xarray.Selector.IsSingleValue && s_ParseBatchNative != null && TryGetText(xarray, out text))
+            {
+                // Convert natively as a batch
+                anyCouldNotConvert = ConvertNative(text, xarray.Count);
+            }
+            else if (!xarray.Selector.IsSingleValue && s_ParseTicksBatchNative != null && _fromTicks != null && TryGetText(xarray, out text))
+            {
+                // Convert common layouts natively as a batch and the rest individually
+                anyCouldNotConvert = ConvertTicksNative(text, xarray);
+            }
+            else if (!xarray.Selector.IsSingleValue)
             {
                 for (int i = 0; i < xarray.Count; ++i)
                 {
@@ -507,5 +602,70 @@ namespace XForm.Types
             result = _array;
             return (anyCouldNotConvert ? _couldNotConvertArray : null);
         }
+
+        private bool TryGetText(XArray xarray, out byte[] text)
+        {
+            text = null;
+            String8[] sourceArray = (String8[])xarray.Array;
+
+            Allocator.AllocateToSize(ref _startsArray, xarray.Count);
+            Allocator.AllocateToSize(ref _lengthsArray, xarray.Count);
+
+            // Native parsing needs every value in one byte[] (true for values read from files)
+            for (int i = 0; i < xarray.Count; ++i)
+            {
+                String8 value = sourceArray[xarray.Index(i)];
+                _startsArray[i] = 0;
+                _lengthsArray[i] = value.Length;
+                if (value.Length == 0) continue;
+
+                if (text == null) text = value.Array;
+                if (value.Array != text) return false;
+                _startsArray[i] = value.Index;
+            }
+
+            return (text != null);
+        }
+
+        private bool ConvertNative(byte[] text, int count)
+        {
+            int couldNotConvertCount = s_ParseBatchNative(text, _startsArray, _lengthsArray, count, _array, _couldNotConvertArray);
+            if (couldNotConvertCount == 0) return false;
+
+            // Replace values which could not be converted with the default
+            for (int i = 0; i < count; ++i)
+            {
+                if (_couldNotConvertArray[i]) _array[i] = _defaultValue;
+            }
+
+            return true;
+        }
+
+        private bool ConvertTicksNative(byte[] text, XArray xarray)
+        {
+            Allocator.AllocateToSize(ref _ticksArray, xarray.Count);
+            s_ParseTicksBatchNative(text, _startsArray, _lengthsArray, xarray.Count, _ticksArray, _couldNotConvertArray);
+
+            bool anyCouldNotConvert = false;
+            String8[] sourceArray = (String8[])xarray.Array;
+            for (int i = 0; i < xarray.Count; ++i)
+            {
+                if (!_couldNotConvertArray[i])
+                {
+                    _array[i] = _fromTicks(_ticksArray[i]);
+                    continue;
+                }
+
+                // Parse values in other layouts individually
+                _couldNotConvertArray[i] = !_tryConvert(sourceArray[xarray.Index(i)], out _array[i]);
+                if (_couldNotConvertArray[i])
+                {
+                    _array[i] = _defaultValue;
+                    anyCouldNotConvert = true;
+                }
+            }
+
+            return anyCouldNotConvert;
+        }
     }
 }
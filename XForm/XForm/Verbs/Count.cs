@@ -5,8 +5,8 @@ using System;
 using System.Collections.Generic;
 using System.Linq;
 using System.Threading;
-using System.Threading.Tasks;
 using XForm.Columns;
+using XForm.Core;
 using XForm.Data;
 using XForm.Extensions;
 using XForm.IO;
@@ -75,15 +75,32 @@ namespace XForm.Verbs
                 // If this is a List, just get the count
                 return ((ISeekableXTable)source).Count;
             }
+            else if (source is Where && ((Where)source).CanCountAll)
+            {
+                // If this is a Where compiled to a whole-column predicate, count matches without building pages
+                return ((Where)source).CountAll(cancellationToken);
+            }
             else if(source is ConcatenatedTable)
             {
                 // If this is multiple tables, count them in parallel
                 ConcatenatedTable cSource = (ConcatenatedTable)source;
                 List<IXTable> parts = cSource.Sources.ToList();
 
-                long[] counts = new long[parts.Count];
-                Parallel.For(0, parts.Count, (i) => counts[i] = CountSource(parts[i], desiredCount, cancellationToken));
-                return counts.Sum();
+                return MorselScheduler.Default.Run<long>(
+                    0,
+                    parts.Count,
+                    () => 0,
+                    (start, end, count) =>
+                    {
+                        for (int i = start; i < end; ++i)
+                        {
+                            count += CountSource(parts[i], desiredCount, cancellationToken);
+                        }
+
+                        return count;
+                    },
+                    (left, right) => left + right,
+                    new MorselOptions() { MorselLength = 1, MaxParallelism = ParallelRunner.ParallelCount, CancellationToken = cancellationToken });
             }
             else
             {
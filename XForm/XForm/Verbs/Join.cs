@@ -5,7 +5,10 @@ using System;
 using System.Collections.Generic;
 using System.Threading;
 
+using Microsoft.CodeAnalysis.Elfie.Model.Strings;
+
 using XForm.Columns;
+using XForm.Core;
 using XForm.Data;
 using XForm.Extensions;
 using XForm.Query;
@@ -51,6 +54,23 @@ namespace XForm.Verbs
 
         private IJoinDictionary _joinDictionary;
 
+        // The Bloom filter of right side values rejects most non-matching left rows before the dictionary lookup
+        private const uint BloomFilterSeed = 0;
+        private BloomFilter _bloomFilter;
+
+        // Hashing every left row costs about as much as a dictionary lookup, so the filter only pays off when most rows miss.
+        // It's built only if the right side is small relative to the left (when the left row count is known),
+        // and dropped if it passes more than half of the first BloomFilterTrialRowCount rows.
+        private const int MinimumLeftRowsPerRightRow = 4;
+        private const int BloomFilterTrialRowCount = 64 * 1024;
+        private long _bloomRowsProbed;
+        private long _bloomRowsPassed;
+        private ulong[] _joinFromHashes;
+        private BitVector _candidateRows;
+
+        // Floating point and DateTime values can be equal with different bits (0.0 and -0.0, DateTimeKind), so they aren't filtered
+        private static readonly Type[] s_bloomFilterTypes = new Type[] { typeof(byte), typeof(sbyte), typeof(ushort), typeof(short), typeof(uint), typeof(int), typeof(ulong), typeof(long), typeof(Guid), typeof(TimeSpan), typeof(String8) };
+
         private RowRemapper _sourceJoinedRowsFilter;
         private ArraySelector _currentRightSideSelector;
 
@@ -118,8 +138,28 @@ namespace XForm.Verbs
                 // Get values to join from
                 XArray joinFromValues = _joinFromColumnGetter();
 
+                // Probe the Bloom filter first; skip batches with no possible matches without any dictionary lookups
+                BitVector candidateRows = null;
+                if (_bloomFilter != null)
+                {
+                    Allocator.AllocateToSize(ref _joinFromHashes, joinFromValues.Count);
+                    Allocator.AllocateToSize(ref _candidateRows, joinFromValues.Count);
+                    Hashing.Hash(joinFromValues, _joinFromHashes, BloomFilterSeed);
+                    int candidateCount = _bloomFilter.Contains(_joinFromHashes, 0, joinFromValues.Count, _candidateRows);
+
+                    if (_bloomRowsProbed < BloomFilterTrialRowCount)
+                    {
+                        _bloomRowsProbed += joinFromValues.Count;
+                        _bloomRowsPassed += candidateCount;
+                        if (_bloomRowsProbed >= BloomFilterTrialRowCount && 2 * _bloomRowsPassed > _bloomRowsProbed) _bloomFilter = null;
+                    }
+
+                    if (candidateCount == 0) continue;
+                    candidateRows = _candidateRows;
+                }
+
                 // Find which rows matched and to what right-side row indices
-                matchedRows = _joinDictionary.TryGetValues(joinFromValues, out _currentRightSideSelector);
+                matchedRows = _joinDictionary.TryGetValues(joinFromValues, candidateRows, out _currentRightSideSelector);
 
                 if (_currentRightSideSelector.Count > 0) break;
             }
@@ -146,6 +186,18 @@ namespace XForm.Verbs
             XArray allJoinToValues = _joinToSeekGetter(ArraySelector.All(joinToSource.Count));
             _joinDictionary = (IJoinDictionary)Allocator.ConstructGenericOf(typeof(JoinDictionary<>), _joinColumnType, allJoinToValues.Count);
             _joinDictionary.Add(allJoinToValues, 0);
+
+            // Build a Bloom filter of the right side values, if equal values of the type always have equal bytes to hash
+            // and the right side isn't large relative to the left
+            ISeekableXTable seekableSource = _source as ISeekableXTable;
+            if (Array.IndexOf(s_bloomFilterTypes, _joinColumnType) != -1
+                && (seekableSource == null || (long)allJoinToValues.Count * MinimumLeftRowsPerRightRow <= seekableSource.Count))
+            {
+                ulong[] hashes = new ulong[allJoinToValues.Count];
+                Hashing.Hash(allJoinToValues, hashes, BloomFilterSeed);
+                _bloomFilter = new BloomFilter(allJoinToValues.Count);
+                _bloomFilter.Add(hashes, 0, hashes.Length);
+            }
         }
 
         public void Reset()
@@ -173,6 +225,7 @@ namespace XForm.Verbs
     {
         void Add(XArray keys, int firstRowIndex);
         BitVector TryGetValues(XArray keys, out ArraySelector rightSideSelector);
+        BitVector TryGetValues(XArray keys, BitVector candidateRows, out ArraySelector rightSideSelector);
     }
 
     public class JoinDictionary<T> : IJoinDictionary
@@ -220,6 +273,14 @@ namespace XForm.Verbs
         }
 
         public BitVector TryGetValues(XArray keys, out ArraySelector rightSideSelector)
+        {
+            return TryGetValues(keys, null, out rightSideSelector);
+        }
+
+        /// <summary>
+        ///  Look up keys in the dictionary, only for rows set in candidateRows (or all rows, if null).
+        /// </summary>
+        public BitVector TryGetValues(XArray keys, BitVector candidateRows, out ArraySelector rightSideSelector)
         {
             Allocator.AllocateToSize(ref _returnedVector, keys.Count);
             Allocator.AllocateToSize(ref _returnedIndicesBuffer, keys.Count);
@@ -230,6 +291,8 @@ namespace XForm.Verbs
             T[] keyArray = (T[])keys.Array;
             for (int i = 0; i < keys.Count; ++i)
             {
+                if (candidateRows != null && !candidateRows[i]) continue;
+
                 int index = keys.Index(i);
                 int foundAtIndex;
                 if ((keys.HasNulls && keys.NullRows[index]) || !_dictionary.TryGetValue(keyArray[index], out foundAtIndex))
@@ -16,14 +16,22 @@ using XForm.Query;
 
 namespace XForm.Verbs
 {
+    public enum PeekMode
+    {
+        Exact,
+        Approximate
+    }
+
     internal class PeekBuilder : IVerbBuilder
     {
         public string Verb => "peek";
-        public string Usage => "peek {Column}";
+        public string Usage => "peek {Column} {Exact|Approximate?}";
 
         public IXTable Build(IXTable source, XDatabaseContext context)
         {
-            return new Peek(source, context.Parser.NextColumn(source, context));
+            IXColumn column = context.Parser.NextColumn(source, context);
+            PeekMode mode = (context.Parser.HasAnotherArgument ? context.Parser.NextEnum<PeekMode>() : PeekMode.Exact);
+            return new Peek(source, column, mode);
         }
     }
 
@@ -33,6 +41,10 @@ namespace XForm.Verbs
     ///  of rows, only the top 20, and only accurate to +/- 1% with 95% confidence.
     ///  
     ///  9,604 samples required to see a 50% value within +/- 1% with 95% confidence.
+    ///  
+    ///  In Approximate mode, Peek reads every row into fixed-size sketches instead: a HyperLogLog for the
+    ///  distinct count and a count-min sketch for value counts. Values are kept only once their estimated
+    ///  count reaches the reporting threshold, so memory stays bounded for high cardinality columns.
     /// </summary>
     public class Peek : IXTable
     {
@@ -43,6 +55,7 @@ namespace XForm.Verbs
 
         private IXTable _source;
         private IXColumn _column;
+        private PeekMode _mode;
         private DeferredArrayColumn[] _columns;
 
         private bool _isDictionaryBuilt;
@@ -50,11 +63,13 @@ namespace XForm.Verbs
 
         private ArraySelector _currentEnumerateSelector;
 
-        public Peek(IXTable source, IXColumn column)
+        public Peek(IXTable source, IXColumn column, PeekMode mode = PeekMode.Exact)
         {
             if (source == null) throw new ArgumentNullException("source");
             _source = source;
             _column = column;
+            _mode = mode;
+            DistinctCountEstimate = -1;
 
             // Build a DeferredArrayColumn for each key and for the aggregator
             _columns = new DeferredArrayColumn[]
@@ -68,6 +83,11 @@ namespace XForm.Verbs
         public IReadOnlyList<IXColumn> Columns => _columns;
         public int CurrentRowCount { get; private set; }
 
+        /// <summary>
+        ///  Estimated count of distinct values in the column, once rows are retrieved in Approximate mode (-1 otherwise).
+        /// </summary>
+        public long DistinctCountEstimate { get; private set; }
+
         public int Next(int desiredCount, CancellationToken cancellationToken)
         {
             // If this is the first call, walk all rows once to group them
@@ -168,6 +188,12 @@ namespace XForm.Verbs
                 return;
             }
 
+            if (_mode == PeekMode.Approximate)
+            {
+                BuildApproximateDictionary(cancellationToken);
+                return;
+            }
+
             // Build a Random instance to sample rows
             Random r = new Random();
 
@@ -250,6 +276,74 @@ namespace XForm.Verbs
             return true;
         }
 
+        private void BuildApproximateDictionary(CancellationToken cancellationToken)
+        {
+            HyperLogLog distinct = new HyperLogLog();
+            CountMinSketch counts = new CountMinSketch();
+
+            // Track values which have reached the reporting threshold, and the hash of each one
+            GroupByDictionary candidates = new GroupByDictionary(new ColumnDetails[] { _column.ColumnDetails });
+            ulong[] candidateHashes = new ulong[16];
+
+            // Retrieve the column getter
+            Func<XArray> columnGetter = _column.CurrentGetter();
+
+            XArray[] arrays = new XArray[1];
+            ulong[] hashes = null;
+            uint[] estimates = null;
+            int[] candidateRows = null;
+            int[] remapArray = null;
+            long totalRowCount = 0;
+
+            int count;
+            while ((count = _source.Next(XTableExtensions.DefaultBatchSize, cancellationToken)) != 0)
+            {
+                XArray values = columnGetter();
+
+                // Hash the values and add them to both sketches, getting the running count estimate for each row
+                Allocator.AllocateToSize(ref hashes, count);
+                Allocator.AllocateToSize(ref estimates, count);
+                Hashing.Hash(values, hashes, 0);
+                distinct.Add(hashes, 0, count);
+                counts.Add(hashes, 0, count, estimates);
+                totalRowCount += count;
+
+                // Find rows whose value is now at the threshold. Few distinct values can ever cross a fraction of the rows so far,
+                // so the candidates stay small even when the column has millions of distinct values.
+                uint threshold = Math.Max(1U, (uint)(totalRowCount * MinimumPercentageToReport));
+                Allocator.AllocateToSize(ref candidateRows, count);
+                int candidateCount = 0;
+                for (int i = 0; i < count; ++i)
+                {
+                    if (estimates[i] >= threshold) candidateRows[candidateCount++] = i;
+                }
+
+                if (candidateCount == 0) continue;
+
+                // Add them to the candidates and record the hash for each
+                arrays[0] = values.Select(ArraySelector.Map(candidateRows, candidateCount), ref remapArray);
+                XArray indices = candidates.FindOrAdd(arrays);
+                int[] indicesArray = (int[])indices.Array;
+
+                Allocator.ExpandToSize(ref candidateHashes, candidates.Count);
+                for (int i = 0; i < candidateCount; ++i)
+                {
+                    candidateHashes[indicesArray[indices.Index(i)]] = hashes[candidateRows[i]];
+                }
+            }
+
+            DistinctCountEstimate = distinct.Estimate();
+
+            // Look up the final count estimate for each candidate
+            int[] candidateCounts = new int[candidates.Count];
+            for (int i = 0; i < candidateCounts.Length; ++i)
+            {
+                candidateCounts[i] = (int)Math.Min(int.MaxValue, counts.Estimate(candidateHashes[i]));
+            }
+
+            PostSortAndFilter(candidates.DistinctKeys()[0], XArray.All(candidateCounts), (int)Math.Min(int.MaxValue, totalRowCount), true);
+        }
+
         private void BuildSingleEnumColumnDictionary(CancellationToken cancellationToken)
         {
             // Build a CountAggregator for the enum GroupBy
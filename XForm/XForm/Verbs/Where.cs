@@ -8,6 +8,7 @@ using System.Threading;
 using XForm.Columns;
 using XForm.Data;
 using XForm.Extensions;
+using XForm.IO;
 using XForm.Query;
 using XForm.Query.Expression;
 using XForm.Transforms;
@@ -28,7 +29,14 @@ namespace XForm.Verbs
 
     public class Where : XTableWrapper
     {
+        // Whole-column matches are computed this many rows ahead of the current page
+        private const int WholeColumnSegmentRowCount = 1024 * 1024;
+
         private IExpression _expression;
+        private BinaryTableReader _table;
+        private ColumnPredicate _predicate;
+        private ulong[] _wholeVector;
+        private int _wholeVectorEvaluatedCount;
         private BitVector _vector;
         private RowRemapper _mapper;
 
@@ -40,13 +48,17 @@ namespace XForm.Verbs
         private int _nextCountToReturn;
 
         // Track the total rows we've gotten and returned
-        private int _totalRowsRetrieved;
-        private int _totalRowsMatched;
+        private long _totalRowsRetrieved;
+        private long _totalRowsMatched;
 
         public Where(IXTable source, IExpression expression) : base(source)
         {
             _expression = expression;
 
+            // Directly over a binary table, simple predicates are evaluated natively over whole columns
+            _table = source as BinaryTableReader;
+            if (_table != null) _predicate = ColumnPredicate.TryBuild(expression, _table.Count);
+
             // Build a mapper to hold matching rows and remap source arrays
             _mapper = new RowRemapper();
 
@@ -98,6 +110,15 @@ namespace XForm.Verbs
             _nextCountToReturn = 0;
         }
 
+        public override void Dispose()
+        {
+            // Expressions may hold native matchers
+            (_expression as IDisposable)?.Dispose();
+            Allocator.Return(ref _vector);
+            Allocator.Return(ref _wholeVector);
+            base.Dispose();
+        }
+
         public override int Next(int desiredCount, CancellationToken cancellationToken)
         {
             _currentMatchesReturned += _nextCountToReturn;
@@ -120,11 +141,18 @@ namespace XForm.Verbs
                 // Track the total retrieved from the source
                 _totalRowsRetrieved += outerCount;
 
-                Allocator.AllocateToSize(ref _vector, outerCount);
+                Allocator.RentToSize(ref _vector, outerCount);
                 _vector.None();
 
                 // Match the query expression and count all matches
-                _expression.Evaluate(_vector);
+                if (_predicate != null)
+                {
+                    CopyWholeColumnMatches(_table.CurrentSelector.StartIndexInclusive, outerCount, cancellationToken);
+                }
+                else
+                {
+                    _expression.Evaluate(_vector);
+                }
 
                 _currentMatchesTotal = _vector.Count;
                 _totalRowsMatched += _currentMatchesTotal;
@@ -142,7 +170,7 @@ namespace XForm.Verbs
             }
 
             // Tell the mapper there are no more matches
-            Allocator.AllocateToSize(ref _vector, desiredCount);
+            Allocator.RentToSize(ref _vector, desiredCount);
             _vector.None();
             _mapper.SetMatches(_vector, 0);
 
@@ -170,5 +198,52 @@ namespace XForm.Verbs
 
             //return 0;
         }
+
+        /// <summary>
+        ///  Return whether the expression was compiled to a whole-column predicate, so CountAll can count without paging.
+        /// </summary>
+        internal bool CanCountAll => _predicate != null;
+
+        internal long CountAll(CancellationToken cancellationToken)
+        {
+            return _predicate.Count(cancellationToken);
+        }
+
+        private void CopyWholeColumnMatches(int startRow, int rowCount, CancellationToken cancellationToken)
+        {
+            int endRow = startRow + rowCount;
+
+            // Evaluate the next segment of the table if this page goes past the rows evaluated so far
+            if (endRow > _wholeVectorEvaluatedCount)
+            {
+                if (_wholeVector == null)
+                {
+                    Allocator.RentToSize(ref _wholeVector, (_predicate.RowCount + 63) >> 6);
+                    Array.Clear(_wholeVector, 0, _wholeVector.Length);
+                }
+
+                int segmentStart = _wholeVectorEvaluatedCount;
+                // Segments end on 64-row boundaries, so the next one starts on a whole vector word
+                int segmentEnd = Math.Min(_predicate.RowCount, (Math.Max(endRow, segmentStart + WholeColumnSegmentRowCount) + 63) & ~63);
+                _predicate.Evaluate(_wholeVector, segmentStart, segmentEnd, cancellationToken);
+                _wholeVectorEvaluatedCount = segmentEnd;
+            }
+
+            // Copy the bits for this page, shifting them down if the page doesn't start on a 64-row boundary
+            ulong[] page = _vector.Array;
+            int wordIndex = startRow >> 6;
+            int shift = startRow & 63;
+            int pageWordCount = (rowCount + 63) >> 6;
+
+            for (int i = 0; i < pageWordCount; ++i)
+            {
+                ulong word = _wholeVector[wordIndex + i] >> shift;
+                if (shift != 0 && wordIndex + i + 1 < _wholeVector.Length) word |= _wholeVector[wordIndex + i + 1] << (64 - shift);
+                page[i] = word;
+            }
+
+            // Clear bits past the end of the page
+            if ((rowCount & 63) != 0) page[pageWordCount - 1] &= ulong.MaxValue >> (64 - (rowCount & 63));
+        }
     }
 }